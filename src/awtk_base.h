@@ -79,6 +79,9 @@
 #include "base/widget_animator_manager.h"
 #include "base/widget_consts.h"
 #include "base/widget_factory.h"
+#include "base/widget_layer.h"
+#include "base/widget_pool.h"
+#include "base/widget_hit_grid.h"
 #include "base/widget_vtable.h"
 #include "base/window_animator.h"
 #include "base/window_animator_factory.h"
@@ -33,6 +33,7 @@
 #include "base/input_method.h"
 #include "base/image_manager.h"
 #include "base/window_manager.h"
+#include "base/widget_pool.h"
 #include "base/widget_factory.h"
 #include "base/assets_manager.h"
 #include "fscript_ext/fscript_ext.h"
@@ -318,6 +319,7 @@ ret_t tk_deinit_internal(void) {
 
   idle_manager_dispatch(idle_manager());
   window_manager_set(NULL);
+  widget_pool_clear();
 #ifndef WITHOUT_INPUT_METHOD
   input_method_destroy(input_method());
   input_method_set(NULL);
@@ -31,6 +31,7 @@
 #define RAW_DIR "raw"
 #define ASSETS_DIR "assets"
 #define THEME_DEFAULT "default"
+#define ASSETS_INDEX_MIN_BUCKETS 32
 
 static int asset_cache_cmp_type(const void* a, const void* b) {
   const asset_info_t* aa = (const asset_info_t*)a;
@@ -60,6 +61,103 @@ static int asset_cache_cmp_type_and_name(const void* a, const void* b) {
 
 static assets_manager_t* s_assets_manager = NULL;
 
+static uint32_t assets_manager_index_hash(uint16_t type, const char* name) {
+  uint32_t h = 2166136261u ^ type;
+
+  /*FNV-1a。subtype不参与计算，因为查找时subtype为0表示匹配任意子类型。*/
+  while (*name) {
+    h ^= (uint8_t)(*name++);
+    h *= 16777619u;
+  }
+
+  return h;
+}
+
+static ret_t assets_manager_index_reserve(assets_manager_t* am, uint32_t buckets_nr,
+                                          uint32_t capacity) {
+  if (am->index_buckets_nr < buckets_nr) {
+    uint32_t* buckets = TKMEM_REALLOCT(uint32_t, am->index_buckets, buckets_nr);
+    return_value_if_fail(buckets != NULL, RET_OOM);
+
+    am->index_buckets = buckets;
+    am->index_buckets_nr = buckets_nr;
+  }
+
+  if (am->index_next_capacity < capacity) {
+    uint32_t* next = NULL;
+
+    capacity = tk_max(capacity, am->index_next_capacity * 2);
+    next = TKMEM_REALLOCT(uint32_t, am->index_next, capacity);
+    return_value_if_fail(next != NULL, RET_OOM);
+
+    am->index_next = next;
+    am->index_next_capacity = capacity;
+  }
+
+  return RET_OK;
+}
+
+static ret_t assets_manager_index_rebuild(assets_manager_t* am) {
+  uint32_t i = 0;
+  uint32_t buckets_nr = ASSETS_INDEX_MIN_BUCKETS;
+  uint32_t nr = am->assets.size;
+  const asset_info_t** all = (const asset_info_t**)(am->assets.elms);
+
+  am->index_valid = FALSE;
+  while (buckets_nr < nr) {
+    buckets_nr <<= 1;
+  }
+  return_value_if_fail(assets_manager_index_reserve(am, buckets_nr, nr) == RET_OK, RET_OOM);
+  memset(am->index_buckets, 0x00, sizeof(uint32_t) * am->index_buckets_nr);
+
+  /*倒序插入到链表头，保证同一个链表中的下标是递增的，与顺序查找时的匹配顺序一致。*/
+  for (i = nr; i > 0; i--) {
+    const asset_info_t* iter = all[i - 1];
+    uint32_t b = assets_manager_index_hash(iter->type, iter->name) & (am->index_buckets_nr - 1);
+
+    am->index_next[i - 1] = am->index_buckets[b];
+    am->index_buckets[b] = i;
+  }
+
+  am->index_size = nr;
+  am->index_valid = TRUE;
+
+  return RET_OK;
+}
+
+static ret_t assets_manager_index_append(assets_manager_t* am) {
+  uint32_t b = 0;
+  uint32_t* p = NULL;
+  uint32_t nr = am->assets.size;
+  const asset_info_t* info = NULL;
+
+  if (!am->index_valid || am->index_size + 1 != nr || nr > am->index_buckets_nr ||
+      assets_manager_index_reserve(am, am->index_buckets_nr, nr) != RET_OK) {
+    am->index_valid = FALSE;
+    return RET_OK;
+  }
+
+  info = (const asset_info_t*)(am->assets.elms[nr - 1]);
+  b = assets_manager_index_hash(info->type, info->name) & (am->index_buckets_nr - 1);
+
+  p = am->index_buckets + b;
+  while (*p != 0) {
+    p = am->index_next + *p - 1;
+  }
+  *p = nr;
+  am->index_next[nr - 1] = 0;
+  am->index_size = nr;
+
+  return RET_OK;
+}
+
+static ret_t assets_manager_index_invalidate(assets_manager_t* am) {
+  am->index_size = 0;
+  am->index_valid = FALSE;
+
+  return RET_OK;
+}
+
 static ret_t assets_manager_dispatch_event(assets_manager_t* am, int32_t etype,
                                            asset_info_t* info) {
   assets_event_t e;
@@ -568,6 +666,13 @@ assets_manager_t* assets_manager_init(assets_manager_t* am, uint32_t init_nr) {
 
   darray_init(&(am->assets), init_nr, (tk_destroy_t)asset_info_unref,
               (tk_compare_t)asset_cache_cmp_type);
+  am->cache_hits = 0;
+  am->cache_misses = 0;
+  am->index_next = NULL;
+  am->index_buckets = NULL;
+  am->index_buckets_nr = 0;
+  am->index_next_capacity = 0;
+  assets_manager_index_invalidate(am);
   assets_manager_set_theme(am, THEME_DEFAULT);
 
 #ifdef WITH_ASSET_LOADER
@@ -591,6 +696,7 @@ ret_t assets_manager_clear_all(assets_manager_t* am) {
   assets_manager_clear_cache(am, ASSET_TYPE_UI);
   assets_manager_clear_cache(am, ASSET_TYPE_STYLE);
   assets_manager_clear_cache(am, ASSET_TYPE_FONT);
+  assets_manager_index_invalidate(am);
 
   return darray_clear(&(am->assets));
 }
@@ -636,7 +742,9 @@ ret_t assets_manager_add(assets_manager_t* am, const void* info) {
   }
 #endif
   asset_info_ref((asset_info_t*)r);
-  return darray_push(&(am->assets), (void*)r);
+  return_value_if_fail(darray_push(&(am->assets), (void*)r) == RET_OK, RET_OOM);
+
+  return assets_manager_index_append(am);
 }
 
 ret_t assets_manager_add_data(assets_manager_t* am, const char* name, uint16_t type,
@@ -660,14 +768,22 @@ const asset_info_t* assets_manager_find_in_cache(assets_manager_t* am, asset_typ
 
   assets_name = asset_info_get_formatted_name(name);
 
+  /*assets可能被外部直接修改，数量不一致时重建索引。*/
+  if (!am->index_valid || am->index_size != am->assets.size) {
+    return_value_if_fail(assets_manager_index_rebuild(am) == RET_OK, NULL);
+  }
+
   all = (const asset_info_t**)(am->assets.elms);
+  i = am->index_buckets[assets_manager_index_hash(type, assets_name) &
+                        (am->index_buckets_nr - 1)];
 
-  for (i = 0; i < am->assets.size; i++) {
-    iter = all[i];
+  while (i != 0) {
+    iter = all[i - 1];
     if (type == iter->type && strcmp(assets_name, iter->name) == 0 &&
         (subtype == 0 || (subtype != 0 && subtype == iter->subtype))) {
       return iter;
     }
+    i = am->index_next[i - 1];
   }
 
   return NULL;
@@ -678,8 +794,10 @@ static const asset_info_t* assets_manager_ref_impl(assets_manager_t* am, asset_t
   const asset_info_t* info = assets_manager_find_in_cache(am, type, subtype, name);
 
   if (info == NULL) {
+    am->cache_misses++;
     info = assets_manager_load_ex(am, type, subtype, name);
   } else {
+    am->cache_hits++;
     asset_info_ref((asset_info_t*)info);
   }
 
@@ -769,6 +887,7 @@ ret_t assets_manager_clear_cache_ex(assets_manager_t* am, asset_type_t type, con
 
   size = am->assets.size;
   ret = darray_remove_all(&(am->assets), asset_cache_cmp_type_and_name, &info);
+  assets_manager_index_invalidate(am);
 
   if (am->assets.size < size) {
     assets_manager_dispatch_event(am, EVT_ASSET_MANAGER_UNLOAD_ASSET, &info);
@@ -788,6 +907,7 @@ ret_t assets_manager_clear_cache(assets_manager_t* am, asset_type_t type) {
 
   size = am->assets.size;
   ret = darray_remove_all(&(am->assets), NULL, &info);
+  assets_manager_index_invalidate(am);
 
   if (am->assets.size < size) {
     assets_manager_dispatch_event(am, EVT_ASSET_MANAGER_CLEAR_CACHE, &info);
@@ -809,6 +929,11 @@ ret_t assets_manager_deinit(assets_manager_t* am) {
 
   asset_loader_destroy(am->loader);
   darray_deinit(&(am->assets));
+  assets_manager_index_invalidate(am);
+  TKMEM_FREE(am->index_next);
+  TKMEM_FREE(am->index_buckets);
+  am->index_buckets_nr = 0;
+  am->index_next_capacity = 0;
 
   return RET_OK;
 }
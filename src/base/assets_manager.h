@@ -76,7 +76,30 @@ struct _assets_manager_t {
   emitter_t emitter;
 
   darray_t assets;
+
+  /**
+   * @property {uint32_t} cache_hits
+   * @annotation ["readable"]
+   * 引用资源时，在缓存中找到的次数。
+   */
+  uint32_t cache_hits;
+
+  /**
+   * @property {uint32_t} cache_misses
+   * @annotation ["readable"]
+   * 引用资源时，在缓存中没有找到的次数。
+   */
+  uint32_t cache_misses;
+
   /*private*/
+  /*缓存的哈希索引(按type和name)，保存assets中的下标+1，0表示链表结束。*/
+  uint32_t* index_buckets;
+  uint32_t* index_next;
+  uint32_t index_buckets_nr;
+  uint32_t index_next_capacity;
+  uint32_t index_size;
+  bool_t index_valid;
+
   char* theme;
   char* res_root;
   locale_info_t* locale_info;
@@ -246,6 +269,8 @@ ret_t assets_manager_unref(assets_manager_t* am, const asset_info_t* info);
 /**
  * @method assets_manager_find_in_cache
  * 在资源管理器的缓存中查找指定的资源(不引用)。
+ *
+ * > 通过哈希索引查找，subtype为0时匹配任意子类型，有多个匹配时返回最先加入的。
  * @param {assets_manager_t*} am asset manager对象。
  * @param {asset_type_t} type 资源的类型。
  * @param {uint16_t} subtype 资源的子类型。
@@ -451,6 +451,25 @@ ret_t bitmap_init_from_bgra(bitmap_t* bitmap, uint32_t w, uint32_t h, bitmap_for
   }
 }
 
+static ret_t bitmap_convert_from_rgba(bitmap_t* bitmap, uint32_t w, uint32_t h,
+                                       bitmap_format_t format, const uint8_t* data, uint32_t comp) {
+  if (format == BITMAP_FMT_BGRA8888) {
+    return bitmap_init_bgra8888(bitmap, w, h, data, comp);
+  } else if (format == BITMAP_FMT_RGBA8888) {
+    return bitmap_init_rgba8888(bitmap, w, h, data, comp);
+  } else if (format == BITMAP_FMT_BGR565) {
+    return bitmap_init_bgr565(bitmap, w, h, data, comp);
+  } else if (format == BITMAP_FMT_RGB565) {
+    return bitmap_init_rgb565(bitmap, w, h, data, comp);
+  } else if (format == BITMAP_FMT_MONO) {
+    return bitmap_init_mono(bitmap, w, h, data, comp);
+  } else if (format == BITMAP_FMT_GRAY) {
+    return bitmap_init_gray(bitmap, w, h, data, comp);
+  } else {
+    return RET_NOT_IMPL;
+  }
+}
+
 ret_t bitmap_init_from_rgba(bitmap_t* bitmap, uint32_t w, uint32_t h, bitmap_format_t format,
                             const uint8_t* data, uint32_t comp) {
   return_value_if_fail(bitmap != NULL && data != NULL && (comp == 3 || comp == 4), RET_BAD_PARAMS);
@@ -468,21 +487,22 @@ ret_t bitmap_init_from_rgba(bitmap_t* bitmap, uint32_t w, uint32_t h, bitmap_for
     bitmap->flags |= BITMAP_FLAG_OPAQUE;
   }
 
-  if (format == BITMAP_FMT_BGRA8888) {
-    return bitmap_init_bgra8888(bitmap, w, h, data, comp);
-  } else if (format == BITMAP_FMT_RGBA8888) {
-    return bitmap_init_rgba8888(bitmap, w, h, data, comp);
-  } else if (format == BITMAP_FMT_BGR565) {
-    return bitmap_init_bgr565(bitmap, w, h, data, comp);
-  } else if (format == BITMAP_FMT_RGB565) {
-    return bitmap_init_rgb565(bitmap, w, h, data, comp);
-  } else if (format == BITMAP_FMT_MONO) {
-    return bitmap_init_mono(bitmap, w, h, data, comp);
-  } else if (format == BITMAP_FMT_GRAY) {
-    return bitmap_init_gray(bitmap, w, h, data, comp);
+  return bitmap_convert_from_rgba(bitmap, w, h, format, data, comp);
+}
+
+ret_t bitmap_update_from_rgba(bitmap_t* bitmap, const uint8_t* data, uint32_t comp) {
+  return_value_if_fail(bitmap != NULL && bitmap->buffer != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(data != NULL && (comp == 3 || comp == 4), RET_BAD_PARAMS);
+
+  if (rgba_data_is_opaque(data, bitmap->w, bitmap->h, comp)) {
+    bitmap->flags |= BITMAP_FLAG_OPAQUE;
   } else {
-    return RET_NOT_IMPL;
+    bitmap->flags &= ~BITMAP_FLAG_OPAQUE;
   }
+  bitmap->flags |= BITMAP_FLAG_CHANGED;
+
+  return bitmap_convert_from_rgba(bitmap, bitmap->w, bitmap->h, (bitmap_format_t)(bitmap->format),
+                                  data, comp);
 }
 
 ret_t bitmap_init(bitmap_t* bitmap, uint32_t w, uint32_t h, bitmap_format_t format, uint8_t* data) {
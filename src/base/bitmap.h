@@ -219,6 +219,17 @@ uint32_t bitmap_get_line_length(bitmap_t* bitmap);
 ret_t bitmap_init_from_rgba(bitmap_t* bitmap, uint32_t w, uint32_t h, bitmap_format_t format,
                             const uint8_t* data, uint32_t comp);
 
+/**
+ * @method bitmap_update_from_rgba
+ * 用RGBA数据更新图片的内容(不重新分配内存，用于逐帧更新的图片)。
+ * @param {bitmap_t*} bitmap bitmap对象。
+ * @param {const uint8_t*} data 数据。3通道时为RGB888格式，4通道时为RGBA888格式，大小与图片一致。
+ * @param {uint32_t} comp 颜色通道数(目前支持3(rgb)和4(rgba))。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t bitmap_update_from_rgba(bitmap_t* bitmap, const uint8_t* data, uint32_t comp);
+
 /**
  * @method bitmap_init_from_bgra
  * 初始化图片。
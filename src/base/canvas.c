@@ -296,12 +296,29 @@ ret_t canvas_set_text_align(canvas_t* c, align_h_t align_h, align_v_t align_v) {
   return RET_OK;
 }
 
+static const text_run_t* canvas_get_text_run(canvas_t* c, const wchar_t* str, uint32_t nr) {
+  if (c->font_manager == NULL || c->font_manager->text_run_cache == NULL) {
+    return NULL;
+  }
+
+  return text_run_cache_get(c->font_manager->text_run_cache, c->font, c->font_size, str, nr);
+}
+
 static float_t canvas_measure_text_default(canvas_t* c, const wchar_t* str, uint32_t nr) {
   glyph_t g;
   float_t w = 0;
   uint32_t i = 0;
+  const text_run_t* run = NULL;
   return_value_if_fail(c != NULL && str != NULL && c->font != NULL, 0);
 
+  /*只测量时不排版和缓存文本段，已经绘制过的文本直接使用缓存的宽度。*/
+  if (c->font_manager != NULL && c->font_manager->text_run_cache != NULL) {
+    run = text_run_cache_find(c->font_manager->text_run_cache, c->font, c->font_size, str, nr);
+    if (run != NULL) {
+      return run->width;
+    }
+  }
+
   for (i = 0; i < nr; i++) {
     wchar_t chr = str[i];
     if (font_get_glyph(c->font, chr, c->font_size, &g) == RET_OK) {
@@ -659,11 +676,47 @@ static ret_t canvas_draw_text_impl(canvas_t* c, const wchar_t* str, uint32_t nr,
   return RET_OK;
 }
 
+/*使用缓存的文本段绘制，只需为可见的字形从glyph cache中取位图。*/
+static ret_t canvas_draw_text_run(canvas_t* c, const text_run_t* run, xy_t x, xy_t y) {
+  glyph_t g;
+  uint32_t i = 0;
+  font_vmetrics_t vmetrics = font_get_vmetrics(c->font, c->font_size);
+  int32_t baseline = vmetrics.ascent;
+
+  if (run->glyphs_nr == 0 || (y + baseline + run->bottom) <= c->clip_top ||
+      (y + baseline + run->top) > c->clip_bottom) {
+    return RET_OK;
+  }
+
+  for (i = 0; i < run->glyphs_nr; i++) {
+    const text_run_glyph_t* iter = run->glyphs + i;
+    xy_t xx = x + iter->x;
+
+    if (xx > c->clip_right || (xx + iter->w) <= c->clip_left) {
+      continue;
+    }
+
+    if (font_get_glyph(c->font, iter->code, c->font_size, &g) == RET_OK) {
+      canvas_draw_glyph(c, &g, xx, y + g.y + baseline);
+    }
+  }
+
+  return RET_OK;
+}
+
 ret_t canvas_draw_text(canvas_t* c, const wchar_t* str, uint32_t nr, xy_t x, xy_t y) {
   return_value_if_fail(c != NULL && c->lcd != NULL && str != NULL, RET_BAD_PARAMS);
   if (c->lcd->draw_text != NULL) {
     return lcd_draw_text(c->lcd, str, nr, c->ox + x, c->oy + y);
   } else {
+    const text_run_t* run = NULL;
+    return_value_if_fail(c->font != NULL, RET_BAD_PARAMS);
+
+    run = canvas_get_text_run(c, str, nr);
+    if (run != NULL) {
+      return canvas_draw_text_run(c, run, c->ox + x, c->oy + y);
+    }
+
     return canvas_draw_text_impl(c, str, nr, c->ox + x, c->oy + y, FALSE);
   }
 }
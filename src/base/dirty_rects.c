@@ -0,0 +1,193 @@
+﻿/**
+ * File:   dirty_rects.c
+ * Author: AWTK Develop Team
+ * Brief:  multiple dirty rects
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#include "base/dirty_rects.h"
+
+static int64_t dirty_rects_area(const rect_t* r) {
+  return (int64_t)(r->w) * (int64_t)(r->h);
+}
+
+static int64_t dirty_rects_merge_waste(const rect_t* r1, const rect_t* r2) {
+  rect_t u = *r1;
+  rect_t i = rect_intersect(r1, r2);
+
+  rect_merge(&u, r2);
+
+  return dirty_rects_area(&u) - dirty_rects_area(r1) - dirty_rects_area(r2) +
+         dirty_rects_area(&i);
+}
+
+static bool_t dirty_rects_should_merge(const rect_t* r1, const rect_t* r2) {
+  int64_t a1 = dirty_rects_area(r1);
+  int64_t a2 = dirty_rects_area(r2);
+
+  if (rect_has_intersect(r1, r2)) {
+    return TRUE;
+  }
+
+  /*多画一点比多遍历一次控件树更划算。*/
+  return dirty_rects_merge_waste(r1, r2) <= tk_min(a1, a2);
+}
+
+static ret_t dirty_rects_remove_at(dirty_rects_t* dirty_rects, uint32_t index) {
+  uint32_t i = 0;
+
+  for (i = index; i + 1 < dirty_rects->nr; i++) {
+    dirty_rects->rects[i] = dirty_rects->rects[i + 1];
+  }
+  dirty_rects->nr--;
+
+  return RET_OK;
+}
+
+ret_t dirty_rects_init(dirty_rects_t* dirty_rects) {
+  return_value_if_fail(dirty_rects != NULL, RET_BAD_PARAMS);
+
+  memset(dirty_rects, 0x00, sizeof(dirty_rects_t));
+
+  return RET_OK;
+}
+
+ret_t dirty_rects_reset(dirty_rects_t* dirty_rects) {
+  return_value_if_fail(dirty_rects != NULL, RET_BAD_PARAMS);
+
+  dirty_rects->nr = 0;
+  dirty_rects->max = rect_init(0, 0, 0, 0);
+
+  return RET_OK;
+}
+
+ret_t dirty_rects_add(dirty_rects_t* dirty_rects, const rect_t* r) {
+  uint32_t i = 0;
+  bool_t merged = FALSE;
+  rect_t rr;
+  return_value_if_fail(dirty_rects != NULL && r != NULL, RET_BAD_PARAMS);
+
+  if (r->w <= 0 || r->h <= 0) {
+    return RET_OK;
+  }
+
+  rect_merge(&(dirty_rects->max), r);
+  if (dirty_rects->disable_multiple) {
+    dirty_rects->nr = 1;
+    dirty_rects->rects[0] = dirty_rects->max;
+
+    return RET_OK;
+  }
+
+  rr = *r;
+  do {
+    merged = FALSE;
+    for (i = 0; i < dirty_rects->nr; i++) {
+      rect_t* iter = dirty_rects->rects + i;
+
+      if (rect_contains(iter, rr.x, rr.y) &&
+          rect_contains(iter, rr.x + rr.w - 1, rr.y + rr.h - 1)) {
+        return RET_OK;
+      }
+
+      if (dirty_rects_should_merge(iter, &rr)) {
+        /*合并后的矩形可能和其它矩形相交，取出来从头重新检查一遍。*/
+        rect_merge(&rr, iter);
+        dirty_rects_remove_at(dirty_rects, i);
+        merged = TRUE;
+        break;
+      }
+    }
+  } while (merged);
+
+  if (dirty_rects->nr < TK_MAX_DIRTY_RECT_NR) {
+    dirty_rects->rects[dirty_rects->nr++] = rr;
+  } else {
+    uint32_t best = 0;
+    int64_t best_waste = dirty_rects_merge_waste(dirty_rects->rects, &rr);
+
+    for (i = 1; i < dirty_rects->nr; i++) {
+      int64_t waste = dirty_rects_merge_waste(dirty_rects->rects + i, &rr);
+      if (waste < best_waste) {
+        best = i;
+        best_waste = waste;
+      }
+    }
+
+    rect_merge(&rr, dirty_rects->rects + best);
+    dirty_rects_remove_at(dirty_rects, best);
+
+    return dirty_rects_add(dirty_rects, &rr);
+  }
+
+  return RET_OK;
+}
+
+ret_t dirty_rects_merge(dirty_rects_t* dirty_rects, const dirty_rects_t* other) {
+  uint32_t i = 0;
+  return_value_if_fail(dirty_rects != NULL && other != NULL, RET_BAD_PARAMS);
+
+  for (i = 0; i < other->nr; i++) {
+    dirty_rects_add(dirty_rects, other->rects + i);
+  }
+
+  return RET_OK;
+}
+
+ret_t dirty_rects_fix(dirty_rects_t* dirty_rects, wh_t max_w, wh_t max_h) {
+  uint32_t i = 0;
+  rect_t bounds = rect_init(0, 0, max_w, max_h);
+  return_value_if_fail(dirty_rects != NULL, RET_BAD_PARAMS);
+
+  dirty_rects->max = rect_init(0, 0, 0, 0);
+  while (i < dirty_rects->nr) {
+    rect_t* iter = dirty_rects->rects + i;
+
+    *iter = rect_intersect(iter, &bounds);
+    if (iter->w <= 0 || iter->h <= 0) {
+      dirty_rects_remove_at(dirty_rects, i);
+    } else {
+      rect_merge(&(dirty_rects->max), iter);
+      i++;
+    }
+  }
+
+  return RET_OK;
+}
+
+bool_t dirty_rects_should_paint_separately(const dirty_rects_t* dirty_rects) {
+  uint32_t i = 0;
+  int64_t sum = 0;
+  return_value_if_fail(dirty_rects != NULL, FALSE);
+
+  if (dirty_rects->nr < 2) {
+    return FALSE;
+  }
+
+  for (i = 0; i < dirty_rects->nr; i++) {
+    sum += dirty_rects_area(dirty_rects->rects + i);
+  }
+
+  /*外接矩形比面积之和大不到1/3时，多画一点比多遍历几次控件树更划算。*/
+  return dirty_rects_area(&(dirty_rects->max)) * 3 > sum * 4;
+}
+
+const rect_t* dirty_rects_get(const dirty_rects_t* dirty_rects, uint32_t index) {
+  return_value_if_fail(dirty_rects != NULL && index < dirty_rects->nr, NULL);
+
+  return dirty_rects->rects + index;
+}
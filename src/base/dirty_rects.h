@@ -0,0 +1,139 @@
+﻿/**
+ * File:   dirty_rects.h
+ * Author: AWTK Develop Team
+ * Brief:  multiple dirty rects
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_DIRTY_RECTS_H
+#define TK_DIRTY_RECTS_H
+
+#include "tkc/rect.h"
+
+BEGIN_C_DECLS
+
+#ifndef TK_MAX_DIRTY_RECT_NR
+#define TK_MAX_DIRTY_RECT_NR 8
+#endif /*TK_MAX_DIRTY_RECT_NR*/
+
+/**
+ * @class dirty_rects_t
+ * 多个脏矩形。
+ *
+ * 把多次invalidate的区域保存为最多TK_MAX_DIRTY_RECT_NR个矩形，只有在相交、
+ * 或者合并后浪费的面积不超过较小矩形面积时才合并。
+ * 这样屏幕两个角落分别有变化时，不用重绘整个屏幕。
+ *
+ */
+typedef struct _dirty_rects_t {
+  /**
+   * @property {uint32_t} nr
+   * @annotation ["readable"]
+   * 脏矩形的个数。
+   */
+  uint32_t nr;
+  /**
+   * @property {rect_t} max
+   * @annotation ["readable"]
+   * 包含全部脏矩形的最小矩形。
+   */
+  rect_t max;
+  /**
+   * @property {bool_t} disable_multiple
+   * @annotation ["readable"]
+   * 禁用多脏矩形(所有区域合并为一个矩形)。
+   */
+  bool_t disable_multiple;
+
+  /*private*/
+  rect_t rects[TK_MAX_DIRTY_RECT_NR];
+} dirty_rects_t;
+
+/**
+ * @method dirty_rects_init
+ * 初始化dirty_rects对象。
+ * @param {dirty_rects_t*} dirty_rects dirty_rects对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t dirty_rects_init(dirty_rects_t* dirty_rects);
+
+/**
+ * @method dirty_rects_reset
+ * 清除全部脏矩形。
+ * @param {dirty_rects_t*} dirty_rects dirty_rects对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t dirty_rects_reset(dirty_rects_t* dirty_rects);
+
+/**
+ * @method dirty_rects_add
+ * 增加一个脏矩形。
+ * @param {dirty_rects_t*} dirty_rects dirty_rects对象。
+ * @param {const rect_t*} r 脏矩形。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t dirty_rects_add(dirty_rects_t* dirty_rects, const rect_t* r);
+
+/**
+ * @method dirty_rects_merge
+ * 把other中的脏矩形全部加入dirty_rects。
+ * @param {dirty_rects_t*} dirty_rects dirty_rects对象。
+ * @param {const dirty_rects_t*} other 另外一个dirty_rects对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t dirty_rects_merge(dirty_rects_t* dirty_rects, const dirty_rects_t* other);
+
+/**
+ * @method dirty_rects_fix
+ * 把脏矩形限制在(0, 0, max_w, max_h)范围内，并去掉空矩形。
+ * @param {dirty_rects_t*} dirty_rects dirty_rects对象。
+ * @param {wh_t} max_w 最大宽度。
+ * @param {wh_t} max_h 最大高度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t dirty_rects_fix(dirty_rects_t* dirty_rects, wh_t max_w, wh_t max_h);
+
+/**
+ * @method dirty_rects_should_paint_separately
+ * 是否应该为每个脏矩形分别设置裁剪区绘制(而不是只绘制一次外接矩形)。
+ *
+ * > 脏矩形相距较远，外接矩形中大部分区域没有变化时返回TRUE。
+ *
+ * @param {const dirty_rects_t*} dirty_rects dirty_rects对象。
+ *
+ * @return {bool_t} 返回TRUE表示分别绘制，否则表示绘制外接矩形。
+ */
+bool_t dirty_rects_should_paint_separately(const dirty_rects_t* dirty_rects);
+
+/**
+ * @method dirty_rects_get
+ * 获取指定序数的脏矩形。
+ * @param {const dirty_rects_t*} dirty_rects dirty_rects对象。
+ * @param {uint32_t} index 序数。
+ *
+ * @return {const rect_t*} 返回脏矩形，失败返回NULL。
+ */
+const rect_t* dirty_rects_get(const dirty_rects_t* dirty_rects, uint32_t index);
+
+END_C_DECLS
+
+#endif /*TK_DIRTY_RECTS_H*/
@@ -40,6 +40,16 @@ static int32_t font_cmp(font_t* font, font_cmp_info_t* info) {
   return -1;
 }
 
+static ret_t font_manager_remove_font(font_manager_t* fm, font_cmp_info_t* info) {
+  font_t* font = (font_t*)darray_find(&(fm->fonts), info);
+
+  if (font != NULL && fm->text_run_cache != NULL) {
+    text_run_cache_remove_font(fm->text_run_cache, font);
+  }
+
+  return darray_remove(&(fm->fonts), info);
+}
+
 font_manager_t* font_manager(void) {
   return s_font_manager;
 }
@@ -62,6 +72,11 @@ font_manager_t* font_manager_init(font_manager_t* fm, font_loader_t* loader) {
 
   fm->loader = loader;
   fm->assets_manager = NULL;
+#if TK_TEXT_RUN_CACHE_NR > 0
+  fm->text_run_cache = text_run_cache_create(TK_TEXT_RUN_CACHE_NR);
+#else
+  fm->text_run_cache = NULL;
+#endif /*TK_TEXT_RUN_CACHE_NR > 0*/
 
   return fm;
 }
@@ -199,10 +214,10 @@ ret_t font_manager_unload_font(font_manager_t* fm, const char* name, font_size_t
 #if WITH_BITMAP_FONT
   info_bitmap.name = font_manager_fix_bitmap_font_name(font_name, name, size);
   info_bitmap.size = size;
-  ret = darray_remove(&(fm->fonts), &info_bitmap);
+  ret = font_manager_remove_font(fm, &info_bitmap);
 #endif
 
-  ret = darray_remove(&(fm->fonts), &info);
+  ret = font_manager_remove_font(fm, &info);
   if (ret == RET_OK) {
     assets_manager_clear_cache_ex(assets_manager(), ASSET_TYPE_FONT, name);
   }
@@ -213,12 +228,21 @@ ret_t font_manager_unload_font(font_manager_t* fm, const char* name, font_size_t
 ret_t font_manager_unload_all(font_manager_t* fm) {
   return_value_if_fail(fm != NULL, RET_FAIL);
 
+  if (fm->text_run_cache != NULL) {
+    text_run_cache_clear(fm->text_run_cache);
+  }
+
   return darray_clear(&(fm->fonts));
 }
 
 ret_t font_manager_deinit(font_manager_t* fm) {
   return_value_if_fail(fm != NULL, RET_BAD_PARAMS);
 
+  if (fm->text_run_cache != NULL) {
+    text_run_cache_destroy(fm->text_run_cache);
+    fm->text_run_cache = NULL;
+  }
+
   return darray_deinit(&(fm->fonts));
 }
 
@@ -25,6 +25,7 @@
 #include "tkc/darray.h"
 #include "base/types_def.h"
 #include "base/font_loader.h"
+#include "base/text_run_cache.h"
 #include "base/assets_manager.h"
 
 BEGIN_C_DECLS
@@ -51,6 +52,13 @@ typedef struct _font_manager_t {
    * 资源管理器。
    */
   assets_manager_t* assets_manager;
+
+  /**
+   * @property {text_run_cache_t*} text_run_cache
+   * @annotation ["private"]
+   * 文本段缓存(供canvas绘制和测量文本时使用)。
+   */
+  text_run_cache_t* text_run_cache;
 } font_manager_t;
 
 /**
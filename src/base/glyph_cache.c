@@ -27,83 +27,203 @@
     }                                                 \
   }
 
+#define GLYPH_CACHE_NIL 0xffffffff
+
 #include "tkc/mem.h"
-#include "tkc/time_now.h"
 #include "base/glyph_cache.h"
 
+static uint32_t glyph_cache_hash(wchar_t code, font_size_t size) {
+  uint32_t h = ((uint32_t)code) * 2654435761u;
+
+  h ^= (((uint32_t)size) * 40503u) + (h >> 16);
+
+  return h;
+}
+
+static uint32_t glyph_cache_find_bucket(glyph_cache_t* cache, wchar_t code, font_size_t size) {
+  uint32_t mask = cache->buckets_mask;
+  uint32_t i = glyph_cache_hash(code, size) & mask;
+
+  while (cache->buckets[i] != 0) {
+    glyph_cache_item_t* item = cache->items + cache->buckets[i] - 1;
+    if (item->code == code && item->size == size) {
+      break;
+    }
+    i = (i + 1) & mask;
+  }
+
+  return i;
+}
+
+static void glyph_cache_remove_bucket(glyph_cache_t* cache, uint32_t i) {
+  uint32_t j = i;
+  uint32_t mask = cache->buckets_mask;
+
+  cache->buckets[i] = 0;
+  /*线性探测的删除：把后续冲突的元素往前移，避免出现断链。*/
+  for (j = (i + 1) & mask; cache->buckets[j] != 0; j = (j + 1) & mask) {
+    glyph_cache_item_t* item = cache->items + cache->buckets[j] - 1;
+    uint32_t k = glyph_cache_hash(item->code, item->size) & mask;
+
+    if ((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j))) {
+      cache->buckets[i] = cache->buckets[j];
+      cache->buckets[j] = 0;
+      i = j;
+    }
+  }
+}
+
+static void glyph_cache_lru_unlink(glyph_cache_t* cache, uint32_t index) {
+  glyph_cache_item_t* item = cache->items + index;
+
+  if (item->prev != GLYPH_CACHE_NIL) {
+    cache->items[item->prev].next = item->next;
+  } else {
+    cache->head = item->next;
+  }
+
+  if (item->next != GLYPH_CACHE_NIL) {
+    cache->items[item->next].prev = item->prev;
+  } else {
+    cache->tail = item->prev;
+  }
+
+  item->prev = GLYPH_CACHE_NIL;
+  item->next = GLYPH_CACHE_NIL;
+}
+
+static void glyph_cache_lru_append(glyph_cache_t* cache, uint32_t index) {
+  glyph_cache_item_t* item = cache->items + index;
+
+  item->next = GLYPH_CACHE_NIL;
+  item->prev = cache->tail;
+  if (cache->tail != GLYPH_CACHE_NIL) {
+    cache->items[cache->tail].next = index;
+  } else {
+    cache->head = index;
+  }
+  cache->tail = index;
+}
+
+static void glyph_cache_lru_prepend(glyph_cache_t* cache, uint32_t index) {
+  glyph_cache_item_t* item = cache->items + index;
+
+  item->prev = GLYPH_CACHE_NIL;
+  item->next = cache->head;
+  if (cache->head != GLYPH_CACHE_NIL) {
+    cache->items[cache->head].prev = index;
+  } else {
+    cache->tail = index;
+  }
+  cache->head = index;
+}
+
+static void glyph_cache_touch(glyph_cache_t* cache, uint32_t index) {
+  if (cache->head != index) {
+    glyph_cache_lru_unlink(cache, index);
+    glyph_cache_lru_prepend(cache, index);
+  }
+
+  cache->items[index].last_access_time = ++cache->access_clock;
+}
+
 glyph_cache_t* glyph_cache_init(glyph_cache_t* cache, uint32_t capacity,
                                 tk_destroy_t destroy_glyph) {
+  uint32_t buckets_nr = 8;
   return_value_if_fail(cache != NULL && capacity > 0, NULL);
 
+  /*负载因子不超过0.5，保证探测序列足够短。*/
+  while (buckets_nr < capacity * 2) {
+    buckets_nr <<= 1;
+  }
+
+  memset(cache, 0x00, sizeof(glyph_cache_t));
   cache->items = TKMEM_ZALLOCN(glyph_cache_item_t, capacity);
   return_value_if_fail(cache->items != NULL, NULL);
 
+  cache->buckets = TKMEM_ZALLOCN(uint32_t, buckets_nr);
+  if (cache->buckets == NULL) {
+    TKMEM_FREE(cache->items);
+    return NULL;
+  }
+
   cache->size = 0;
   cache->capacity = capacity;
+  cache->buckets_mask = buckets_nr - 1;
+  cache->head = GLYPH_CACHE_NIL;
+  cache->tail = GLYPH_CACHE_NIL;
   cache->destroy_glyph = destroy_glyph;
 
   return cache;
 }
 
-static glyph_cache_item_t* glyph_cache_get_empty(glyph_cache_t* cache) {
-  uint32_t i = 0;
-  uint32_t nr = 0;
+static uint32_t glyph_cache_get_empty(glyph_cache_t* cache) {
   uint32_t oldest = 0;
   glyph_cache_item_t* item = NULL;
-  uint32_t oldest_time = 0xffffffff;
-
-  return_value_if_fail(cache != NULL && cache->items != NULL, NULL);
 
   if (cache->size < cache->capacity) {
-    oldest = cache->size++;
-    return cache->items + oldest;
-  }
-
-  for (i = 0, nr = cache->size; i < nr; i++) {
-    glyph_cache_item_t* item = cache->items + i;
-    if (item->last_access_time < oldest_time) {
-      oldest_time = item->last_access_time;
-      oldest = i;
-      if (oldest_time == 0) {
-        break;
-      }
-    }
+    return cache->size++;
   }
 
+  oldest = cache->tail;
   item = cache->items + oldest;
+  glyph_cache_remove_bucket(cache, glyph_cache_find_bucket(cache, item->code, item->size));
+  glyph_cache_lru_unlink(cache, oldest);
   GLYPH_CACHE_FREE_ITEM(cache, item);
 
-  return item;
+  return oldest;
 }
 
 ret_t glyph_cache_add(glyph_cache_t* cache, wchar_t code, font_size_t size, glyph_t* g) {
-  glyph_cache_item_t* item = glyph_cache_get_empty(cache);
-  return_value_if_fail(cache != NULL && g != NULL && item != NULL, RET_BAD_PARAMS);
+  uint32_t b = 0;
+  uint32_t index = 0;
+  glyph_cache_item_t* item = NULL;
+  return_value_if_fail(cache != NULL && cache->items != NULL && g != NULL, RET_BAD_PARAMS);
+
+  b = glyph_cache_find_bucket(cache, code, size);
+  if (cache->buckets[b] != 0) {
+    index = cache->buckets[b] - 1;
+    item = cache->items + index;
+    if (item->g != g && item->g != NULL && cache->destroy_glyph != NULL) {
+      cache->destroy_glyph(item->g);
+    }
+    item->g = g;
+    glyph_cache_touch(cache, index);
+
+    return RET_OK;
+  }
 
+  index = glyph_cache_get_empty(cache);
+  item = cache->items + index;
   item->g = g;
   item->size = size;
   item->code = code;
-  item->last_access_time = time_now_ms();
+  item->last_access_time = ++cache->access_clock;
+
+  /*淘汰会移动哈希桶中的元素，需要重新查找插入位置。*/
+  b = glyph_cache_find_bucket(cache, code, size);
+  cache->buckets[b] = index + 1;
+  glyph_cache_lru_prepend(cache, index);
 
   return RET_OK;
 }
 
 ret_t glyph_cache_lookup(glyph_cache_t* cache, wchar_t code, font_size_t size, glyph_t* g) {
-  uint32_t i = 0;
-  uint32_t nr = 0;
+  uint32_t b = 0;
+  uint32_t index = 0;
 
-  return_value_if_fail(cache != NULL && g != NULL, RET_BAD_PARAMS);
-  for (i = 0, nr = cache->size; i < nr; i++) {
-    glyph_cache_item_t* item = cache->items + i;
-    if (item->code == code && item->size == size) {
-      *g = *(item->g);
-      item->last_access_time = time_now_ms();
+  return_value_if_fail(cache != NULL && cache->items != NULL && g != NULL, RET_BAD_PARAMS);
 
-      return RET_OK;
-    }
+  b = glyph_cache_find_bucket(cache, code, size);
+  if (cache->buckets[b] == 0) {
+    return RET_NOT_FOUND;
   }
 
-  return RET_NOT_FOUND;
+  index = cache->buckets[b] - 1;
+  *g = *(cache->items[index].g);
+  glyph_cache_touch(cache, index);
+
+  return RET_OK;
 }
 
 ret_t glyph_cache_deinit(glyph_cache_t* cache) {
@@ -121,6 +241,7 @@ ret_t glyph_cache_deinit(glyph_cache_t* cache) {
   }
 
   TKMEM_FREE(cache->items);
+  TKMEM_FREE(cache->buckets);
   memset(cache, 0x00, sizeof(glyph_cache_t));
 
   return RET_OK;
@@ -133,6 +254,24 @@ static int glyph_cache_item_compare_by_time(const void* a, const void* b) {
   return bb->last_access_time - aa->last_access_time;
 }
 
+static ret_t glyph_cache_rebuild_index(glyph_cache_t* cache) {
+  uint32_t i = 0;
+
+  memset(cache->buckets, 0x00, sizeof(uint32_t) * (cache->buckets_mask + 1));
+  cache->head = GLYPH_CACHE_NIL;
+  cache->tail = GLYPH_CACHE_NIL;
+
+  for (i = 0; i < cache->size; i++) {
+    glyph_cache_item_t* item = cache->items + i;
+    uint32_t b = glyph_cache_find_bucket(cache, item->code, item->size);
+
+    cache->buckets[b] = i + 1;
+    glyph_cache_lru_append(cache, i);
+  }
+
+  return RET_OK;
+}
+
 ret_t glyph_cache_shrink(glyph_cache_t* cache, uint32_t cache_size) {
   return_value_if_fail(cache != NULL && cache->items != NULL, RET_BAD_PARAMS);
 
@@ -146,6 +285,7 @@ ret_t glyph_cache_shrink(glyph_cache_t* cache, uint32_t cache_size) {
     }
 
     cache->size = cache_size;
+    glyph_cache_rebuild_index(cache);
   }
 
   return RET_OK;
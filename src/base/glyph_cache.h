@@ -27,21 +27,37 @@
 BEGIN_C_DECLS
 
 typedef struct _glyph_cache_item_t {
+  /*最近访问序号(逻辑时钟，越大表示越新)*/
   uint32_t last_access_time;
   font_size_t size;
   wchar_t code;
   glyph_t* g;
+
+  /*LRU链表(以items的下标链接)*/
+  uint32_t prev;
+  uint32_t next;
 } glyph_cache_item_t;
 
 /**
  * @class glyph_cache_t
  * glyph cache
+ *
+ * 以(code, size)为键的开放寻址哈希表，配合侵入式LRU链表，查找和淘汰都是O(1)。
  */
 typedef struct _glyph_cache_t {
   uint32_t size;
   uint32_t capacity;
   glyph_cache_item_t* items;
   tk_destroy_t destroy_glyph;
+
+  /*private*/
+  /*哈希桶，保存items下标+1，0表示空桶。*/
+  uint32_t* buckets;
+  uint32_t buckets_mask;
+  /*LRU链表头(最近使用)和尾(最久未使用)。*/
+  uint32_t head;
+  uint32_t tail;
+  uint32_t access_clock;
 } glyph_cache_t;
 
 /**
@@ -22,32 +22,213 @@
 #include "tkc/mem.h"
 #include "tkc/utils.h"
 #include "tkc/time_now.h"
+#include "base/idle.h"
 #include "base/locale_info.h"
 #include "base/image_manager.h"
 
+#define IMAGE_CACHE_MIN_BUCKETS 16
+
 typedef struct _bitmap_cache_t {
   bitmap_t image;
   char* name;
   uint32_t access_count;
   uint32_t created_time;
   uint32_t last_access_time;
+
+  image_manager_t* imm;
+  uint32_t hash;
+  uint32_t mem_size;
+  uint32_t last_access_frame;
+  bool_t raster;
+  struct _bitmap_cache_t* next;
+  struct _bitmap_cache_t* lru_prev;
+  struct _bitmap_cache_t* lru_next;
 } bitmap_cache_t;
 
 static int bitmap_cache_cmp_time(bitmap_cache_t* a, bitmap_cache_t* b) {
   return (a->last_access_time <= b->last_access_time) ? 0 : -1;
 }
 
-static int bitmap_cache_cmp_name(bitmap_cache_t* a, bitmap_cache_t* b) {
-  return strcmp(a->name, b->name);
-}
-
 static int bitmap_cache_cmp_data(bitmap_cache_t* a, bitmap_cache_t* b) {
   return (char*)(a->image.buffer) - (char*)(b->image.buffer);
 }
 
+static uint32_t bitmap_cache_hash(const char* name) {
+  uint32_t h = 2166136261u;
+
+  while (*name) {
+    h ^= (uint8_t)(*name++);
+    h *= 16777619u;
+  }
+
+  return h;
+}
+
+static uint32_t bitmap_cache_mem_size(bitmap_t* image) {
+  if (image->buffer == NULL) {
+    return 0;
+  }
+
+  return bitmap_get_line_length(image) * image->h;
+}
+
+static ret_t image_manager_cache_resize(image_manager_t* imm, uint32_t buckets_nr) {
+  uint32_t i = 0;
+  bitmap_cache_t* iter = NULL;
+  bitmap_cache_t** buckets = TKMEM_ZALLOCN(bitmap_cache_t*, buckets_nr);
+  return_value_if_fail(buckets != NULL, RET_OOM);
+
+  for (iter = (bitmap_cache_t*)(imm->lru_first); iter != NULL; iter = iter->lru_next) {
+    i = iter->hash & (buckets_nr - 1);
+    iter->next = buckets[i];
+    buckets[i] = iter;
+  }
+
+  TKMEM_FREE(imm->cache_buckets);
+  imm->cache_buckets = (void**)buckets;
+  imm->cache_buckets_nr = buckets_nr;
+
+  return RET_OK;
+}
+
+static ret_t image_manager_cache_link(image_manager_t* imm, bitmap_cache_t* cache) {
+  bitmap_cache_t** bucket = NULL;
+
+  if (imm->images.size >= imm->cache_buckets_nr) {
+    uint32_t buckets_nr = tk_max(imm->cache_buckets_nr * 2, IMAGE_CACHE_MIN_BUCKETS);
+    return_value_if_fail(image_manager_cache_resize(imm, buckets_nr) == RET_OK, RET_OOM);
+  }
+
+  bucket = (bitmap_cache_t**)(imm->cache_buckets) + (cache->hash & (imm->cache_buckets_nr - 1));
+  cache->next = *bucket;
+  *bucket = cache;
+
+  cache->lru_prev = NULL;
+  cache->lru_next = (bitmap_cache_t*)(imm->lru_first);
+  if (imm->lru_first != NULL) {
+    ((bitmap_cache_t*)(imm->lru_first))->lru_prev = cache;
+  } else {
+    imm->lru_last = cache;
+  }
+  imm->lru_first = cache;
+  imm->cache_mem_size += cache->mem_size;
+  if (cache->raster) {
+    imm->raster_mem_size += cache->mem_size;
+  }
+
+  return RET_OK;
+}
+
+static ret_t image_manager_cache_unlink_lru(image_manager_t* imm, bitmap_cache_t* cache) {
+  if (cache->lru_prev != NULL) {
+    cache->lru_prev->lru_next = cache->lru_next;
+  } else {
+    imm->lru_first = cache->lru_next;
+  }
+
+  if (cache->lru_next != NULL) {
+    cache->lru_next->lru_prev = cache->lru_prev;
+  } else {
+    imm->lru_last = cache->lru_prev;
+  }
+
+  cache->lru_prev = NULL;
+  cache->lru_next = NULL;
+
+  return RET_OK;
+}
+
+static ret_t image_manager_cache_unlink(image_manager_t* imm, bitmap_cache_t* cache) {
+  bitmap_cache_t** p = NULL;
+
+  if (imm->cache_buckets == NULL) {
+    return RET_OK;
+  }
+
+  p = (bitmap_cache_t**)(imm->cache_buckets) + (cache->hash & (imm->cache_buckets_nr - 1));
+  while (*p != NULL) {
+    if (*p == cache) {
+      *p = cache->next;
+      break;
+    }
+    p = &((*p)->next);
+  }
+
+  image_manager_cache_unlink_lru(imm, cache);
+  imm->cache_mem_size -= cache->mem_size;
+  if (cache->raster) {
+    imm->raster_mem_size -= cache->mem_size;
+  }
+
+  return RET_OK;
+}
+
+static bitmap_cache_t* image_manager_cache_find(image_manager_t* imm, const char* name) {
+  uint32_t hash = 0;
+  bitmap_cache_t* iter = NULL;
+
+  if (imm->cache_buckets == NULL) {
+    return NULL;
+  }
+
+  hash = bitmap_cache_hash(name);
+  iter = ((bitmap_cache_t**)(imm->cache_buckets))[hash & (imm->cache_buckets_nr - 1)];
+  for (; iter != NULL; iter = iter->next) {
+    if (iter->hash == hash && tk_str_eq(iter->name, name)) {
+      return iter;
+    }
+  }
+
+  return NULL;
+}
+
+/*光栅化的位图单独计算内存，超过时淘汰最久没有使用的光栅化位图。*/
+static ret_t image_manager_raster_shrink(image_manager_t* imm) {
+  bitmap_cache_t* iter = (bitmap_cache_t*)(imm->lru_last);
+  bitmap_cache_t* prev = NULL;
+
+  while (iter != NULL && imm->raster_mem_size > imm->raster_max_size) {
+    prev = iter->lru_prev;
+    if (iter->raster && iter->last_access_frame != imm->frame) {
+      imm->cache_evictions++;
+      darray_remove_all(&(imm->images), pointer_compare, iter);
+    }
+    iter = prev;
+  }
+
+  return RET_OK;
+}
+
+/*超过最大内存时，从最久没有使用的图片开始淘汰，跳过当前帧中用过的图片。*/
+static ret_t image_manager_cache_shrink(image_manager_t* imm) {
+  bitmap_cache_t* iter = NULL;
+  bitmap_cache_t* prev = NULL;
+
+  image_manager_raster_shrink(imm);
+  if (imm->cache_max_size == 0) {
+    return RET_OK;
+  }
+
+  iter = (bitmap_cache_t*)(imm->lru_last);
+  while (iter != NULL && imm->cache_mem_size > imm->cache_max_size) {
+    prev = iter->lru_prev;
+    if (iter->last_access_frame != imm->frame) {
+      imm->cache_evictions++;
+      darray_remove_all(&(imm->images), pointer_compare, iter);
+    }
+    iter = prev;
+  }
+
+  return RET_OK;
+}
+
 static ret_t bitmap_cache_destroy(bitmap_cache_t* cache) {
   return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
 
+  if (cache->imm != NULL) {
+    image_manager_cache_unlink(cache->imm, cache);
+  }
+
   log_debug("unload image %s\n", cache->name);
   bitmap_destroy(&(cache->image));
   TKMEM_FREE(cache->name);
@@ -89,16 +270,18 @@ image_manager_t* image_manager_init(image_manager_t* imm) {
   return_value_if_fail(imm != NULL, NULL);
 
   darray_init(&(imm->images), 0, (tk_destroy_t)bitmap_cache_destroy, NULL);
+  darray_init(&(imm->async_jobs), 0, NULL, NULL);
+  darray_init(&(imm->async_failed), 0, default_destroy, (tk_compare_t)tk_str_cmp);
   imm->assets_manager = assets_manager();
+  imm->cache_max_size = TK_IMAGE_CACHE_MAX_SIZE;
+  imm->raster_max_size = TK_IMAGE_RASTER_CACHE_MAX_SIZE;
 
   return imm;
 }
 
-ret_t image_manager_add(image_manager_t* imm, const char* name, const bitmap_t* image) {
-  bitmap_cache_t* cache = NULL;
-  return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
-
-  cache = TKMEM_ZALLOC(bitmap_cache_t);
+static ret_t image_manager_add_impl(image_manager_t* imm, const char* name,
+                                    const bitmap_t* image, bool_t raster) {
+  bitmap_cache_t* cache = TKMEM_ZALLOC(bitmap_cache_t);
   return_value_if_fail(cache != NULL, RET_OOM);
 
   cache->image = *image;
@@ -108,20 +291,46 @@ ret_t image_manager_add(image_manager_t* imm, const char* name, const bitmap_t*
   cache->name = tk_strdup(name);
   cache->image.name = cache->name;
   cache->last_access_time = cache->created_time;
+  cache->imm = imm;
+  cache->hash = bitmap_cache_hash(cache->name);
+  cache->mem_size = bitmap_cache_mem_size(&(cache->image));
+  cache->last_access_frame = imm->frame;
+  cache->raster = raster;
+
+  if (image_manager_cache_link(imm, cache) != RET_OK) {
+    cache->imm = NULL;
+    bitmap_cache_destroy(cache);
+    return RET_OOM;
+  }
 
-  return darray_push(&(imm->images), cache);
+  if (darray_push(&(imm->images), cache) != RET_OK) {
+    bitmap_cache_destroy(cache);
+    return RET_OOM;
+  }
+
+  return image_manager_cache_shrink(imm);
 }
 
-ret_t image_manager_lookup(image_manager_t* imm, const char* name, bitmap_t* image) {
-  bitmap_cache_t info;
-  bitmap_cache_t* iter = NULL;
+ret_t image_manager_add(image_manager_t* imm, const char* name, const bitmap_t* image) {
   return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
 
-  memset(&info, 0x00, sizeof(info));
+  return image_manager_add_impl(imm, name, image, FALSE);
+}
 
-  info.name = (char*)name;
-  imm->images.compare = (tk_compare_t)bitmap_cache_cmp_name;
-  iter = darray_find(&(imm->images), &info);
+ret_t image_manager_add_raster(image_manager_t* imm, const char* key, bitmap_t* image) {
+  return_value_if_fail(image != NULL, RET_BAD_PARAMS);
+
+  if (imm == NULL || key == NULL || bitmap_cache_mem_size(image) > imm->raster_max_size) {
+    bitmap_destroy(image);
+    return imm == NULL || key == NULL ? RET_BAD_PARAMS : RET_FAIL;
+  }
+
+  return image_manager_add_impl(imm, key, image, TRUE);
+}
+
+static ret_t image_manager_lookup_impl(image_manager_t* imm, const char* name, bitmap_t* image,
+                                       bool_t stat) {
+  bitmap_cache_t* iter = image_manager_cache_find(imm, name);
 
   if (iter != NULL) {
     *image = iter->image;
@@ -132,13 +341,65 @@ ret_t image_manager_lookup(image_manager_t* imm, const char* name, bitmap_t* ima
 
     iter->access_count++;
     iter->last_access_time = time_now_s();
+    iter->last_access_frame = imm->frame;
+    if (imm->lru_first != iter) {
+      image_manager_cache_unlink_lru(imm, iter);
+      iter->lru_next = (bitmap_cache_t*)(imm->lru_first);
+      ((bitmap_cache_t*)(imm->lru_first))->lru_prev = iter;
+      imm->lru_first = iter;
+    }
+
+    if (stat) {
+      imm->cache_hits++;
+    }
 
     return RET_OK;
   }
 
+  if (stat) {
+    imm->cache_misses++;
+  }
+
   return RET_NOT_FOUND;
 }
 
+ret_t image_manager_lookup(image_manager_t* imm, const char* name, bitmap_t* image) {
+  return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
+
+  return image_manager_lookup_impl(imm, name, image, TRUE);
+}
+
+ret_t image_manager_get_raster(image_manager_t* imm, const char* key, bitmap_t* image) {
+  return_value_if_fail(imm != NULL && key != NULL && image != NULL, RET_BAD_PARAMS);
+
+  memset(image, 0x00, sizeof(bitmap_t));
+  return image_manager_lookup_impl(imm, key, image, TRUE);
+}
+
+ret_t image_manager_set_raster_cache_max_size(image_manager_t* imm, uint32_t max_size) {
+  return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
+
+  imm->raster_max_size = max_size;
+
+  return image_manager_raster_shrink(imm);
+}
+
+ret_t image_manager_set_cache_max_size(image_manager_t* imm, uint32_t max_size) {
+  return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
+
+  imm->cache_max_size = max_size;
+
+  return image_manager_cache_shrink(imm);
+}
+
+ret_t image_manager_begin_frame(image_manager_t* imm) {
+  return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
+
+  imm->frame++;
+
+  return image_manager_cache_shrink(imm);
+}
+
 ret_t image_manager_update_specific(image_manager_t* imm, bitmap_t* image) {
   bitmap_cache_t info;
   bitmap_cache_t* iter = NULL;
@@ -209,7 +470,7 @@ static ret_t image_manager_get_bitmap_impl(image_manager_t* imm, const char* nam
       assets_manager_unref(imm->assets_manager, res);
     }
 
-    return image_manager_lookup(imm, name, image);
+    return image_manager_lookup_impl(imm, name, image, FALSE);
   } else {
     return RET_NOT_FOUND;
   }
@@ -269,6 +530,294 @@ ret_t image_manager_get_bitmap(image_manager_t* imm, const char* name, bitmap_t*
   }
 }
 
+typedef struct _image_async_listener_t {
+  image_manager_on_loaded_t on_loaded;
+  void* ctx;
+} image_async_listener_t;
+
+typedef struct _image_async_job_t {
+  image_manager_t* imm;
+  char* name;
+  const asset_info_t* res;
+  bitmap_t image;
+  ret_t result;
+  darray_t listeners;
+  struct _image_async_job_t* next;
+} image_async_job_t;
+
+static image_async_job_t* image_async_job_create(image_manager_t* imm, const char* name,
+                                                 const asset_info_t* res) {
+  image_async_job_t* job = TKMEM_ZALLOC(image_async_job_t);
+  return_value_if_fail(job != NULL, NULL);
+
+  job->imm = imm;
+  job->res = res;
+  job->result = RET_FAIL;
+  job->name = tk_strdup(name);
+  darray_init(&(job->listeners), 1, default_destroy, NULL);
+
+  return job;
+}
+
+static image_async_listener_t* image_async_job_find_listener(image_async_job_t* job,
+                                                             image_manager_on_loaded_t on_loaded,
+                                                             void* ctx) {
+  uint32_t i = 0;
+
+  for (i = 0; i < job->listeners.size; i++) {
+    image_async_listener_t* iter = (image_async_listener_t*)(job->listeners.elms[i]);
+    if (iter->on_loaded == on_loaded && iter->ctx == ctx) {
+      return iter;
+    }
+  }
+
+  return NULL;
+}
+
+static ret_t image_async_job_add_listener(image_async_job_t* job,
+                                          image_manager_on_loaded_t on_loaded, void* ctx) {
+  image_async_listener_t* listener = NULL;
+
+  /*同一个监听者只注册一次，避免每次绘制都重复添加。*/
+  if (on_loaded == NULL || image_async_job_find_listener(job, on_loaded, ctx) != NULL) {
+    return RET_OK;
+  }
+
+  listener = TKMEM_ZALLOC(image_async_listener_t);
+  return_value_if_fail(listener != NULL, RET_OOM);
+
+  listener->ctx = ctx;
+  listener->on_loaded = on_loaded;
+
+  return darray_push(&(job->listeners), listener);
+}
+
+static ret_t image_async_job_notify(image_async_job_t* job, ret_t result) {
+  uint32_t i = 0;
+
+  for (i = 0; i < job->listeners.size; i++) {
+    image_async_listener_t* iter = (image_async_listener_t*)(job->listeners.elms[i]);
+    iter->on_loaded(iter->ctx, job->name, result);
+  }
+
+  return RET_OK;
+}
+
+static ret_t image_async_job_destroy(image_async_job_t* job) {
+  darray_deinit(&(job->listeners));
+  TKMEM_FREE(job->name);
+  TKMEM_FREE(job);
+
+  return RET_OK;
+}
+
+static image_async_job_t* image_manager_find_async_job(image_manager_t* imm, const char* name) {
+  uint32_t i = 0;
+
+  for (i = 0; i < imm->async_jobs.size; i++) {
+    image_async_job_t* iter = (image_async_job_t*)(imm->async_jobs.elms[i]);
+    if (tk_str_eq(iter->name, name)) {
+      return iter;
+    }
+  }
+
+  return NULL;
+}
+
+static ret_t image_manager_async_on_idle(const idle_info_t* info) {
+  image_manager_dispatch_async((image_manager_t*)(info->ctx));
+
+  return RET_REMOVE;
+}
+
+/*在后台线程中执行：只解码，放入缓存的工作交给GUI线程。*/
+static ret_t image_manager_async_exec(qaction_t* action) {
+  bool_t first = FALSE;
+  image_async_job_t* job = *(image_async_job_t**)(action->args);
+  image_manager_t* imm = job->imm;
+
+  job->result = image_loader_load_image(job->res, &(job->image));
+
+  tk_mutex_lock(imm->async_mutex);
+  first = imm->async_done == NULL;
+  job->next = (image_async_job_t*)(imm->async_done);
+  imm->async_done = job;
+  tk_mutex_unlock(imm->async_mutex);
+
+  if (first) {
+    idle_queue(image_manager_async_on_idle, imm);
+  }
+
+  return RET_OK;
+}
+
+static ret_t image_manager_async_init(image_manager_t* imm) {
+  if (imm->async_pool != NULL) {
+    return RET_OK;
+  }
+
+  if (imm->async_mutex == NULL) {
+    imm->async_mutex = tk_mutex_create();
+    return_value_if_fail(imm->async_mutex != NULL, RET_NOT_IMPL);
+  }
+
+  imm->async_pool = action_thread_pool_create(TK_IMAGE_ASYNC_THREAD_NR, 1);
+  return_value_if_fail(imm->async_pool != NULL, RET_NOT_IMPL);
+
+  return RET_OK;
+}
+
+ret_t image_manager_get_bitmap_async(image_manager_t* imm, const char* name, bitmap_t* image,
+                                     image_manager_on_loaded_t on_loaded, void* ctx) {
+  qaction_t* action = NULL;
+  image_async_job_t* job = NULL;
+  const asset_info_t* res = NULL;
+  return_value_if_fail(imm != NULL && name != NULL && image != NULL, RET_BAD_PARAMS);
+
+  if (strstr(name, TK_LOCALE_MAGIC) != NULL || strchr(name, '$') != NULL ||
+      strchr(name, ',') != NULL) {
+    return image_manager_get_bitmap(imm, name, image);
+  }
+
+  memset(image, 0x00, sizeof(bitmap_t));
+  if (image_manager_lookup(imm, name, image) == RET_OK) {
+    return RET_OK;
+  }
+
+  /*解码失败过的图片不再重复解码。*/
+  if (darray_find(&(imm->async_failed), (void*)name) != NULL) {
+    return RET_FAIL;
+  }
+
+  job = image_manager_find_async_job(imm, name);
+  if (job != NULL) {
+    image_async_job_add_listener(job, on_loaded, ctx);
+    return RET_BUSY;
+  }
+
+  if (image_manager_async_init(imm) != RET_OK) {
+    return image_manager_get_bitmap_impl(imm, name, image);
+  }
+
+  res = assets_manager_ref(imm->assets_manager, ASSET_TYPE_IMAGE, name);
+  if (res == NULL) {
+    return RET_NOT_FOUND;
+  }
+
+  /*位图数据无需解码，矢量图不由image_manager加载。*/
+  if (res->subtype == ASSET_TYPE_IMAGE_RAW || res->subtype == ASSET_TYPE_IMAGE_BSVG) {
+    assets_manager_unref(imm->assets_manager, res);
+    return image_manager_get_bitmap_impl(imm, name, image);
+  }
+
+  job = image_async_job_create(imm, name, res);
+  goto_error_if_fail(job != NULL);
+  image_async_job_add_listener(job, on_loaded, ctx);
+
+  action = qaction_create(image_manager_async_exec, &job, sizeof(job));
+  goto_error_if_fail(action != NULL);
+  goto_error_if_fail(darray_push(&(imm->async_jobs), job) == RET_OK);
+
+  if (action_thread_pool_exec(imm->async_pool, action) != RET_OK) {
+    darray_remove(&(imm->async_jobs), job);
+    goto error;
+  }
+
+  return RET_BUSY;
+error:
+  if (action != NULL) {
+    qaction_destroy(action);
+  }
+  if (job != NULL) {
+    image_async_job_destroy(job);
+  }
+  assets_manager_unref(imm->assets_manager, res);
+
+  return image_manager_get_bitmap_impl(imm, name, image);
+}
+
+bool_t image_manager_is_async_loading(image_manager_t* imm, const char* name,
+                                      image_manager_on_loaded_t on_loaded, void* ctx) {
+  image_async_job_t* job = NULL;
+  return_value_if_fail(imm != NULL && name != NULL, FALSE);
+
+  job = image_manager_find_async_job(imm, name);
+
+  return job != NULL && image_async_job_find_listener(job, on_loaded, ctx) != NULL;
+}
+
+ret_t image_manager_dispatch_async(image_manager_t* imm) {
+  bitmap_t image;
+  image_async_job_t* job = NULL;
+  image_async_job_t* next = NULL;
+  return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
+
+  if (imm->async_mutex == NULL) {
+    return RET_OK;
+  }
+
+  tk_mutex_lock(imm->async_mutex);
+  job = (image_async_job_t*)(imm->async_done);
+  imm->async_done = NULL;
+  tk_mutex_unlock(imm->async_mutex);
+
+  for (; job != NULL; job = next) {
+    next = job->next;
+    darray_remove(&(imm->async_jobs), job);
+    assets_manager_unref(imm->assets_manager, job->res);
+
+    if (job->result == RET_OK) {
+      if (image_manager_lookup_impl(imm, job->name, &image, FALSE) == RET_OK) {
+        bitmap_destroy(&(job->image));
+      } else {
+        image_manager_add(imm, job->name, &(job->image));
+      }
+    } else {
+      darray_push(&(imm->async_failed), tk_strdup(job->name));
+    }
+
+    image_async_job_notify(job, job->result);
+    image_async_job_destroy(job);
+  }
+
+  return RET_OK;
+}
+
+static ret_t image_manager_async_deinit(image_manager_t* imm) {
+  uint32_t i = 0;
+
+  if (imm->async_pool != NULL) {
+    action_thread_pool_destroy(imm->async_pool);
+    imm->async_pool = NULL;
+  }
+
+  /*
+   * 线程池已经停止，剩下的任务(包括已经解码完成的)直接释放。
+   * 监听者可能持有引用(如控件)，以RET_FAIL通知它们，让它们释放引用。
+   */
+  for (i = 0; i < imm->async_jobs.size; i++) {
+    image_async_job_t* iter = (image_async_job_t*)(imm->async_jobs.elms[i]);
+
+    if (iter->result == RET_OK) {
+      bitmap_destroy(&(iter->image));
+    }
+    assets_manager_unref(imm->assets_manager, iter->res);
+    image_async_job_notify(iter, RET_FAIL);
+    image_async_job_destroy(iter);
+  }
+  darray_deinit(&(imm->async_jobs));
+  darray_deinit(&(imm->async_failed));
+  imm->async_done = NULL;
+
+  if (imm->async_mutex != NULL) {
+    tk_mutex_destroy(imm->async_mutex);
+    imm->async_mutex = NULL;
+  }
+  idle_remove_all_by_ctx(imm);
+
+  return RET_OK;
+}
+
 ret_t image_manager_preload(image_manager_t* imm, const char* name) {
   bitmap_t image;
   return_value_if_fail(imm != NULL && name != NULL && *name, RET_BAD_PARAMS);
@@ -280,6 +829,7 @@ ret_t image_manager_set_assets_manager(image_manager_t* imm, assets_manager_t* a
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
 
   imm->assets_manager = am;
+  darray_clear(&(imm->async_failed));
 
   return RET_OK;
 }
@@ -296,6 +846,8 @@ ret_t image_manager_unload_unused(image_manager_t* imm, uint32_t time_delta_s) {
 ret_t image_manager_unload_all(image_manager_t* imm) {
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
 
+  darray_clear(&(imm->async_failed));
+
   return darray_clear(&(imm->images));
 }
 
@@ -312,7 +864,10 @@ ret_t image_manager_unload_bitmap(image_manager_t* imm, bitmap_t* image) {
 ret_t image_manager_deinit(image_manager_t* imm) {
   return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
 
+  image_manager_async_deinit(imm);
   darray_deinit(&(imm->images));
+  TKMEM_FREE(imm->cache_buckets);
+  imm->cache_buckets_nr = 0;
 
   return RET_OK;
 }
@@ -22,7 +22,9 @@
 #ifndef TK_IMAGE_MANAGER_H
 #define TK_IMAGE_MANAGER_H
 
+#include "tkc/mutex.h"
 #include "tkc/darray.h"
+#include "tkc/action_thread_pool.h"
 #include "base/image_loader.h"
 #include "base/assets_manager.h"
 
@@ -39,6 +41,27 @@ typedef struct _bitmap_header_t {
   uint8_t data[4];
 } bitmap_header_t;
 
+/*缓存图片的最大内存(字节)，为0时不限制。可以用image_manager_set_cache_max_size修改。*/
+#ifndef TK_IMAGE_CACHE_MAX_SIZE
+#define TK_IMAGE_CACHE_MAX_SIZE 0
+#endif /*TK_IMAGE_CACHE_MAX_SIZE*/
+
+/*缓存矢量图光栅化结果(如svg_image)的最大内存(字节)，为0时不缓存。可以用image_manager_set_raster_cache_max_size修改。*/
+#ifndef TK_IMAGE_RASTER_CACHE_MAX_SIZE
+#define TK_IMAGE_RASTER_CACHE_MAX_SIZE (512 * 1024)
+#endif /*TK_IMAGE_RASTER_CACHE_MAX_SIZE*/
+
+/*后台解码图片的线程数。*/
+#ifndef TK_IMAGE_ASYNC_THREAD_NR
+#define TK_IMAGE_ASYNC_THREAD_NR 2
+#endif /*TK_IMAGE_ASYNC_THREAD_NR*/
+
+/**
+ * 异步加载的图片解码完成(在GUI线程中调用)。
+ * result为RET_OK时，图片已经放入缓存，可以用image_manager_get_bitmap获取。
+ */
+typedef ret_t (*image_manager_on_loaded_t)(void* ctx, const char* name, ret_t result);
+
 /**
  * @class image_manager_t
  * @annotation ["scriptable"]
@@ -58,6 +81,73 @@ struct _image_manager_t {
    * 资源管理器。
    */
   assets_manager_t* assets_manager;
+
+  /**
+   * @property {uint32_t} cache_max_size
+   * @annotation ["readable"]
+   * 缓存图片的最大内存(字节)，为0时不限制。
+   */
+  uint32_t cache_max_size;
+
+  /**
+   * @property {uint32_t} cache_mem_size
+   * @annotation ["readable"]
+   * 缓存图片占用的内存(字节，按line_length * h计算)。
+   */
+  uint32_t cache_mem_size;
+
+  /**
+   * @property {uint32_t} cache_hits
+   * @annotation ["readable"]
+   * 缓存命中次数。
+   */
+  uint32_t cache_hits;
+
+  /**
+   * @property {uint32_t} cache_misses
+   * @annotation ["readable"]
+   * 缓存未命中次数。
+   */
+  uint32_t cache_misses;
+
+  /**
+   * @property {uint32_t} cache_evictions
+   * @annotation ["readable"]
+   * 超过最大内存时被淘汰的图片数。
+   */
+  uint32_t cache_evictions;
+
+  /**
+   * @property {uint32_t} raster_max_size
+   * @annotation ["readable"]
+   * 缓存光栅化位图的最大内存(字节)，为0时不缓存。
+   */
+  uint32_t raster_max_size;
+
+  /**
+   * @property {uint32_t} raster_mem_size
+   * @annotation ["readable"]
+   * 缓存的光栅化位图占用的内存(字节，也计入cache_mem_size)。
+   */
+  uint32_t raster_mem_size;
+
+  /*private*/
+  /*按名称索引的哈希表和按访问顺序排列的链表(最近访问的在前)*/
+  void** cache_buckets;
+  uint32_t cache_buckets_nr;
+  void* lru_first;
+  void* lru_last;
+  /*当前帧的序号，当前帧中用过的图片不会被淘汰*/
+  uint32_t frame;
+
+  /*正在后台解码的图片(只在GUI线程中访问)*/
+  darray_t async_jobs;
+  /*解码失败的图片名，不再重复解码(只在GUI线程中访问)*/
+  darray_t async_failed;
+  /*解码完成，等待GUI线程放入缓存的图片(由async_mutex保护)*/
+  void* async_done;
+  tk_mutex_t* async_mutex;
+  action_thread_pool_t* async_pool;
 };
 
 /**
@@ -111,6 +201,120 @@ image_manager_t* image_manager_init(image_manager_t* imm);
  */
 ret_t image_manager_get_bitmap(image_manager_t* imm, const char* name, bitmap_t* image);
 
+/**
+ * @method image_manager_set_cache_max_size
+ * 设置缓存图片的最大内存。
+ *
+ * 超过最大内存时，淘汰最久没有使用的图片，但当前帧中用过的图片不会被淘汰。
+ *
+ * @param {image_manager_t*} imm 图片管理器对象。
+ * @param {uint32_t} max_size 最大内存(字节)，为0时不限制。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_set_cache_max_size(image_manager_t* imm, uint32_t max_size);
+
+/**
+ * @method image_manager_set_raster_cache_max_size
+ * 设置缓存光栅化位图的最大内存，超过时从最久没有使用的位图开始淘汰。
+ * @annotation ["scriptable"]
+ * @param {image_manager_t*} imm 图片管理器对象。
+ * @param {uint32_t} max_size 最大内存(字节)，为0时不缓存。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_set_raster_cache_max_size(image_manager_t* imm, uint32_t max_size);
+
+/**
+ * @method image_manager_add_raster
+ * 缓存矢量图光栅化的位图。
+ *
+ * > 无论成功与否，位图的数据都交给图片管理器释放，调用者不能再使用和销毁image。
+ * 成功之后用image\_manager\_get\_raster获取缓存的位图。
+ *
+ * @param {image_manager_t*} imm 图片管理器对象。
+ * @param {const char*} key 位图的键值(包括资源名称、大小和颜色等影响光栅化结果的参数)。
+ * @param {bitmap_t*} image 位图对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败(如位图超过最大内存)。
+ */
+ret_t image_manager_add_raster(image_manager_t* imm, const char* key, bitmap_t* image);
+
+/**
+ * @method image_manager_get_raster
+ * 获取缓存的光栅化位图。
+ * @param {image_manager_t*} imm 图片管理器对象。
+ * @param {const char*} key 位图的键值。
+ * @param {bitmap_t*} image 用于返回位图对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_get_raster(image_manager_t* imm, const char* key, bitmap_t* image);
+
+/**
+ * @method image_manager_begin_frame
+ * 开始新的一帧。
+ *
+ * 之前获取的图片不再被引用，可以被淘汰。如果缓存超过最大内存，淘汰最久没有使用的图片。
+ *
+ * > 由窗口管理器在每次绘制前调用，一般不需要直接调用。
+ *
+ * @param {image_manager_t*} imm 图片管理器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_begin_frame(image_manager_t* imm);
+
+/**
+ * @method image_manager_get_bitmap_async
+ * 获取指定的图片，如果没有缓存，在后台线程中解码。
+ *
+ * * 已经缓存(或者无需解码)的图片直接返回RET_OK，与image\_manager\_get\_bitmap相同。
+ * * 否则在后台线程中解码，返回RET_BUSY，调用者可以先绘制占位内容。
+ * 解码完成后，在GUI线程中放入缓存，再调用on\_loaded。
+ * 同一图片的多次请求只解码一次，每个请求的on\_loaded都会被调用(相同的on\_loaded和ctx只调用一次)。
+ * 解码失败的图片会被记住，再次请求时直接返回RET_FAIL，直到image\_manager\_unload\_all。
+ * 图片管理器销毁时，还没有完成的请求以RET_FAIL调用on\_loaded。
+ *
+ * > 带有语言或者表达式的图片名，以及不支持多线程的平台，仍然同步加载。
+ *
+ * @param {image_manager_t*} imm 图片管理器对象。
+ * @param {char*} name 图片名称。
+ * @param {bitmap_t*} image 用于返回图片。
+ * @param {image_manager_on_loaded_t} on_loaded 解码完成的回调函数(可以为NULL)。
+ * @param {void*} ctx 回调函数的上下文。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，返回RET_BUSY表示正在解码，否则表示失败。
+ */
+ret_t image_manager_get_bitmap_async(image_manager_t* imm, const char* name, bitmap_t* image,
+                                     image_manager_on_loaded_t on_loaded, void* ctx);
+
+/**
+ * @method image_manager_is_async_loading
+ * 检查指定的on\_loaded和ctx是否已经在等待指定图片解码完成。
+ *
+ * @param {image_manager_t*} imm 图片管理器对象。
+ * @param {char*} name 图片名称。
+ * @param {image_manager_on_loaded_t} on_loaded 解码完成的回调函数。
+ * @param {void*} ctx 回调函数的上下文。
+ *
+ * @return {bool_t} 返回TRUE表示已经在等待，否则表示没有。
+ */
+bool_t image_manager_is_async_loading(image_manager_t* imm, const char* name,
+                                      image_manager_on_loaded_t on_loaded, void* ctx);
+
+/**
+ * @method image_manager_dispatch_async
+ * 把后台解码完成的图片放入缓存，并调用对应的on\_loaded。
+ *
+ * > 解码完成后会通过idle\_queue在GUI线程中自动调用，一般不需要直接调用。
+ *
+ * @param {image_manager_t*} imm 图片管理器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t image_manager_dispatch_async(image_manager_t* imm);
+
 /**
  * @method image_manager_preload
  * 预加载指定的图片。
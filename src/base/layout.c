@@ -22,9 +22,15 @@
 #include "tkc/utils.h"
 #include "base/widget.h"
 #include "base/layout.h"
+#include "base/widget_hit_grid.h"
 #include "base/self_layouter_factory.h"
 #include "base/children_layouter_factory.h"
 
+/*大于0时只布局需要重新布局的控件，参考widget_layout_if_needed。*/
+static uint32_t s_layout_if_needed = 0;
+
+static ret_t widget_layout_dirty_children(widget_t* widget);
+
 ret_t widget_auto_adjust_size(widget_t* widget) {
   int32_t w = 0;
   int32_t h = 0;
@@ -62,6 +68,8 @@ ret_t widget_auto_adjust_size(widget_t* widget) {
 }
 
 ret_t widget_layout(widget_t* widget) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
   widget_layout_self(widget);
   widget_layout_children(widget);
 
@@ -69,6 +77,11 @@ ret_t widget_layout(widget_t* widget) {
     widget_auto_adjust_size(widget);
   }
 
+  /*自动调整大小时会直接修改控件的宽高。*/
+  widget_hit_grid_invalidate(widget->parent);
+  widget->need_relayout = FALSE;
+  widget->child_need_relayout = FALSE;
+
   return RET_OK;
 }
 
@@ -107,13 +120,65 @@ ret_t widget_layout_children_default(widget_t* widget) {
 }
 
 ret_t widget_layout_children(widget_t* widget) {
+  ret_t ret = RET_OK;
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
+  if (s_layout_if_needed > 0 && !widget->need_relayout) {
+    /*大小和子控件都没有变化，只需要处理被标记的后代控件。*/
+    return widget->child_need_relayout ? widget_layout_dirty_children(widget) : RET_OK;
+  }
+
   if (widget->vt->on_layout_children != NULL) {
-    return widget->vt->on_layout_children(widget);
+    ret = widget->vt->on_layout_children(widget);
   } else {
-    return widget_layout_children_default(widget);
+    ret = widget_layout_children_default(widget);
+  }
+
+  widget->need_relayout = FALSE;
+  widget->child_need_relayout = FALSE;
+
+  return ret;
+}
+
+static ret_t widget_layout_dirty_children(widget_t* widget) {
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  if (iter->need_relayout) {
+    if (widget->children_layout != NULL || widget->vt->on_layout_children != NULL) {
+      /*子控件的位置和大小由父控件决定，重新布局全部子控件。*/
+      widget->need_relayout = TRUE;
+      return widget_layout_children(widget);
+    }
+    widget_layout(iter);
+  } else if (iter->child_need_relayout) {
+    widget_layout_dirty_children(iter);
+  }
+  WIDGET_FOR_EACH_CHILD_END()
+
+  /*布局子控件时产生的标记已经处理，只保留仍然需要重新布局的子控件的标记。*/
+  widget->child_need_relayout = FALSE;
+  WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
+  if (iter->need_relayout || iter->child_need_relayout) {
+    widget->child_need_relayout = TRUE;
+    break;
+  }
+  WIDGET_FOR_EACH_CHILD_END()
+
+  return RET_OK;
+}
+
+ret_t widget_layout_if_needed(widget_t* widget) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  s_layout_if_needed++;
+  if (widget->need_relayout) {
+    ret = widget_layout(widget);
+  } else if (widget->child_need_relayout) {
+    ret = widget_layout_dirty_children(widget);
   }
+  s_layout_if_needed--;
+
+  return ret;
 }
 
 ret_t widget_set_self_layout(widget_t* widget, const char* params) {
@@ -134,6 +199,7 @@ ret_t widget_set_self_layout(widget_t* widget, const char* params) {
   if (widget->self_layout != NULL) {
     str_set(&(widget->self_layout->params), params);
   }
+  widget_set_need_relayout(widget);
 
   return RET_OK;
 }
@@ -152,6 +218,31 @@ ret_t widget_set_children_layout(widget_t* widget, const char* params) {
   if (widget->children_layout != NULL) {
     str_set(&(widget->children_layout->params), params);
   }
+  widget_set_need_relayout(widget);
+
+  return RET_OK;
+}
+
+ret_t widget_set_self_layouter(widget_t* widget, self_layouter_t* layouter) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->self_layout != NULL && widget->self_layout != layouter) {
+    self_layouter_destroy(widget->self_layout);
+  }
+  widget->self_layout = layouter;
+  widget_set_need_relayout(widget);
+
+  return RET_OK;
+}
+
+ret_t widget_set_children_layouter(widget_t* widget, children_layouter_t* layouter) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->children_layout != NULL && widget->children_layout != layouter) {
+    children_layouter_destroy(widget->children_layout);
+  }
+  widget->children_layout = layouter;
+  widget_set_need_relayout(widget);
 
   return RET_OK;
 }
@@ -34,6 +34,7 @@ ret_t lcd_begin_frame(lcd_t* lcd, const rect_t* dirty_rect, lcd_draw_mode_t draw
   return_value_if_fail(lcd != NULL && lcd->begin_frame != NULL, RET_BAD_PARAMS);
 
   lcd->draw_mode = draw_mode;
+  lcd->dirty_rects = NULL;
   if (dirty_rect == NULL) {
     lcd->dirty_rect.x = 0;
     lcd->dirty_rect.y = 0;
@@ -68,6 +69,14 @@ ret_t lcd_get_dirty_rect(lcd_t* lcd, rect_t* r) {
   return RET_OK;
 }
 
+ret_t lcd_set_dirty_rects(lcd_t* lcd, const dirty_rects_t* dirty_rects) {
+  return_value_if_fail(lcd != NULL, RET_BAD_PARAMS);
+
+  lcd->dirty_rects = dirty_rects;
+
+  return RET_OK;
+}
+
 ret_t lcd_set_clip_rect(lcd_t* lcd, const rect_t* rect) {
   return_value_if_fail(lcd != NULL && lcd->set_clip_rect != NULL, RET_BAD_PARAMS);
 
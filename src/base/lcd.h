@@ -27,6 +27,7 @@
 #include "tkc/matrix.h"
 #include "base/bitmap.h"
 #include "base/vgcanvas.h"
+#include "base/dirty_rects.h"
 
 BEGIN_C_DECLS
 
@@ -293,6 +294,8 @@ struct _lcd_t {
   /*private*/
   rect_t fps_rect;
   rect_t dirty_rect;
+  /*本帧的多个脏矩形(可选)，dirty_rect为它们的外接矩形。*/
+  const dirty_rects_t* dirty_rects;
   void* impl_data;
 };
 
@@ -684,6 +687,7 @@ bool_t lcd_is_dirty(lcd_t* lcd);
 bool_t lcd_is_compositor(lcd_t* lcd);
 ret_t lcd_set_canvas(lcd_t* lcd, canvas_t* c);
 ret_t lcd_get_dirty_rect(lcd_t* lcd, rect_t* r);
+ret_t lcd_set_dirty_rects(lcd_t* lcd, const dirty_rects_t* dirty_rects);
 ret_t lcd_set_curr_lcd(lcd_t* lcd, uint32_t lcd_id);
 ret_t lcd_invalidate_by_id(lcd_t* lcd, const rect_t* r, uint32_t lcd_id);
 
@@ -86,6 +86,7 @@ ret_t main_loop_destroy(main_loop_t* l);
 
 ret_t main_loop_step(main_loop_t* l);
 ret_t main_loop_sleep(main_loop_t* l);
+ret_t main_loop_sleep_default(main_loop_t* l);
 
 /*event_source*/
 event_source_manager_t* main_loop_get_event_source_manager(main_loop_t* l);
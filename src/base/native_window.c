@@ -60,6 +60,7 @@ ret_t native_window_update_last_dirty_rect(native_window_t* win) {
   return_value_if_fail(win != NULL, RET_BAD_PARAMS);
 
   win->last_dirty_rect = win->dirty_rect;
+  win->last_dirty_rects = win->dirty_rects;
 
   return RET_OK;
 }
@@ -77,6 +78,19 @@ rect_t native_window_calc_dirty_rect(native_window_t* win) {
   return rect_fix(&r, win->rect.w, win->rect.h);
 }
 
+ret_t native_window_calc_dirty_rects(native_window_t* win, dirty_rects_t* dirty_rects) {
+  return_value_if_fail(win != NULL && dirty_rects != NULL, RET_BAD_PARAMS);
+
+  *dirty_rects = win->dirty_rects;
+  dirty_rects_merge(dirty_rects, &(win->last_dirty_rects));
+  if (dirty_rects->nr == 0) {
+    dirty_rects_add(dirty_rects, &(win->dirty_rect));
+    dirty_rects_add(dirty_rects, &(win->last_dirty_rect));
+  }
+
+  return dirty_rects_fix(dirty_rects, win->rect.w, win->rect.h);
+}
+
 ret_t native_window_invalidate(native_window_t* win, const rect_t* r) {
   rect_t* dr = NULL;
   return_value_if_fail(win != NULL, RET_BAD_PARAMS);
@@ -91,6 +105,7 @@ ret_t native_window_invalidate(native_window_t* win, const rect_t* r) {
     dr->w = win->rect.w;
     dr->h = win->rect.h;
   }
+  dirty_rects_add(&(win->dirty_rects), r != NULL ? r : dr);
 
   return RET_OK;
 }
@@ -136,6 +151,14 @@ ret_t native_window_begin_frame(native_window_t* win, lcd_draw_mode_t mode) {
     if (r.w > 0 && r.h > 0) {
       canvas_t* c = native_window_get_canvas(win);
       canvas_begin_frame(c, &r, mode);
+      native_window_calc_dirty_rects(win, &(win->paint_rects));
+      if (c->lcd->support_dirty_rect && c->lcd->type != LCD_VGCANVAS) {
+        lcd_set_dirty_rects(c->lcd, &(win->paint_rects));
+      } else {
+        /*vgcanvas整帧提交，只保留一个矩形。*/
+        dirty_rects_reset(&(win->paint_rects));
+        dirty_rects_add(&(win->paint_rects), &r);
+      }
       win->dirty = TRUE;
 
       return RET_OK;
@@ -162,6 +185,47 @@ ret_t native_window_end_frame(native_window_t* win) {
   if (win->dirty) {
     canvas_t* c = native_window_get_canvas(win);
     canvas_end_frame(c);
+    lcd_set_dirty_rects(c->lcd, NULL);
+    native_window_update_last_dirty_rect(win);
+  }
+  native_window_clear_dirty_rect(win);
+
+  return RET_OK;
+}
+
+ret_t native_window_paint_fragments(native_window_t* win, uint32_t fragment_size,
+                                    tk_visit_t on_paint, void* ctx) {
+  uint32_t i = 0;
+  canvas_t* c = NULL;
+  dirty_rects_t* dirty_rects = NULL;
+  return_value_if_fail(win != NULL && fragment_size > 0 && on_paint != NULL, RET_BAD_PARAMS);
+
+  if (win->dirty_rect.w <= 0 || win->dirty_rect.h <= 0) {
+    return RET_OK;
+  }
+
+  c = native_window_get_canvas(win);
+  dirty_rects = &(win->paint_rects);
+  native_window_calc_dirty_rects(win, dirty_rects);
+
+  /*每个脏矩形单独分块，不绘制脏矩形之间没有变化的区域。*/
+  for (i = 0; i < dirty_rects->nr; i++) {
+    rect_t r = *dirty_rects_get(dirty_rects, i);
+    int32_t bottom = r.y + r.h;
+    int32_t fragment_h = 0;
+
+    assert(r.w <= fragment_size);
+    fragment_h = tk_max((int32_t)(fragment_size / r.w), 1);
+    for (; r.y < bottom; r.y += fragment_h) {
+      r.h = tk_min(fragment_h, bottom - r.y);
+      canvas_begin_frame(c, &r, LCD_DRAW_NORMAL);
+      win->dirty = TRUE;
+      on_paint(ctx, c);
+      canvas_end_frame(c);
+    }
+  }
+
+  if (dirty_rects->nr > 0) {
     native_window_update_last_dirty_rect(win);
   }
   native_window_clear_dirty_rect(win);
@@ -174,6 +238,7 @@ ret_t native_window_clear_dirty_rect(native_window_t* win) {
 
   win->dirty = FALSE;
   win->dirty_rect = rect_init(win->rect.w, win->rect.h, 0, 0);
+  dirty_rects_reset(&(win->dirty_rects));
 
   return RET_OK;
 }
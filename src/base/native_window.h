@@ -93,6 +93,10 @@ struct _native_window_t {
   bool_t dirty;
   rect_t dirty_rect;
   rect_t last_dirty_rect;
+  dirty_rects_t dirty_rects;
+  dirty_rects_t last_dirty_rects;
+  /*本帧需要绘制的脏矩形(dirty_rects + last_dirty_rects)，在begin_frame中计算。*/
+  dirty_rects_t paint_rects;
 
   const native_window_vtable_t* vt;
 };
@@ -246,8 +250,12 @@ ret_t native_window_get_info(native_window_t* win, native_window_info_t* info);
 ret_t native_window_begin_frame(native_window_t* win, lcd_draw_mode_t mode);
 ret_t native_window_paint(native_window_t* win, widget_t* widget);
 ret_t native_window_end_frame(native_window_t* win);
+/*帧缓冲只有fragment_size个像素时，把每个脏矩形分成多块，分别调用on_paint(ctx, canvas)绘制。*/
+ret_t native_window_paint_fragments(native_window_t* win, uint32_t fragment_size,
+                                    tk_visit_t on_paint, void* ctx);
 
 rect_t native_window_calc_dirty_rect(native_window_t* win);
+ret_t native_window_calc_dirty_rects(native_window_t* win, dirty_rects_t* dirty_rects);
 ret_t native_window_clear_dirty_rect(native_window_t* win);
 ret_t native_window_update_last_dirty_rect(native_window_t* win);
 ret_t native_window_on_resized(native_window_t* win, wh_t w, wh_t h);
@@ -175,7 +175,7 @@ ret_t style_normalize_value(const char* name, const char* value, value_t* out) {
   } else if (strcmp(name, "border") == 0) {
     value_set_int(v, to_border(value));
   } else if (strcmp(name, "icon_at") == 0) {
-    value_set_int(v, to_icon_at(value));
+    value_set_int(v, isdigit(*value) ? tk_atoi(value) : to_icon_at(value));
   } else if (strstr(name, "color") != NULL) {
     color_t c = color_parse(value);
     value_set_uint32(v, c.color);
@@ -194,6 +194,9 @@ ret_t style_normalize_value(const char* name, const char* value, value_t* out) {
 
   if (dt != NULL) {
     value_set_int(v, dt->value);
+  } else if (v->type == VALUE_TYPE_INT32 && isdigit(*value)) {
+    /*枚举值也可以直接用数字表示(如二进制UI数据转换回来的XML)。*/
+    value_set_int(v, tk_atoi(value));
   }
 
   return RET_OK;
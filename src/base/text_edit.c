@@ -111,6 +111,26 @@ typedef struct _text_edit_impl_t {
   bool_t is_first_time_layout;
   void* on_state_changed_ctx;
   text_edit_on_state_changed_t on_state_changed;
+
+  /*上次排版时的文本长度和参数，多行编辑时只重新排版修改过的行*/
+  uint32_t cached_size;
+  bool_t cached_valid;
+  bool_t cached_wrap_word;
+  uint32_t cached_w;
+  font_size_t cached_font_size;
+  char cached_font_name[TK_NAME_LEN + 1];
+
+  /*上次排版后通过编辑器修改过的范围[dirty_start, dirty_end)(当前文本中的位置)和长度的变化*/
+  bool_t dirty;
+  uint32_t dirty_start;
+  uint32_t dirty_end;
+  int32_t dirty_delta;
+
+  /*重新排版时暂存原来的行*/
+  rows_t* spare_rows;
+
+  /*line_find_by_offset上次找到的行*/
+  uint32_t found_row;
 } text_edit_impl_t;
 
 #define DECL_IMPL(te) text_edit_impl_t* impl = (text_edit_impl_t*)(te)
@@ -171,16 +191,21 @@ static rows_t* rows_create(uint32_t capacity) {
   return rows;
 }
 
-static line_info_t* line_find_by_offset(rows_t* rows, uint32_t offset) {
+/*stb_textedit按顺序逐行查找，从上次找到的行开始查找。*/
+static line_info_t* line_find_by_offset(rows_t* rows, uint32_t offset, uint32_t* found_row) {
   uint32_t i = 0;
-  return_value_if_fail(rows != NULL, NULL);
+  uint32_t start = 0;
+  return_value_if_fail(rows != NULL && found_row != NULL, NULL);
 
+  start = *found_row < rows->size ? *found_row : 0;
   for (i = 0; i < rows->size; i++) {
     uint32_t j = 0;
-    row_info_t* row = rows->row + i;
+    uint32_t r = (start + i) % rows->size;
+    row_info_t* row = rows->row + r;
     for (j = 0; j < row->line_num; j++) {
       line_info_t* line = (line_info_t*)darray_get(&row->info, j);
       if (line->offset == offset) {
+        *found_row = r;
         return line;
       }
     }
@@ -189,6 +214,16 @@ static line_info_t* line_find_by_offset(rows_t* rows, uint32_t offset) {
   return NULL;
 }
 
+/*交换两行的内容，每行的darray一起交换，不会丢失。*/
+static ret_t rows_swap(rows_t* rows, uint32_t i, rows_t* other, uint32_t j) {
+  row_info_t tmp = rows->row[i];
+
+  rows->row[i] = other->row[j];
+  other->row[j] = tmp;
+
+  return RET_OK;
+}
+
 static ret_t rows_destroy(rows_t* rows) {
   uint32_t i = 0;
   return_value_if_fail(rows != NULL, RET_BAD_PARAMS);
@@ -442,6 +477,216 @@ static row_info_t* text_edit_layout_line(text_edit_t* text_edit, uint32_t row_nu
   }
 }
 
+static bool_t text_edit_cache_is_valid(text_edit_t* text_edit, canvas_t* c) {
+  DECL_IMPL(text_edit);
+
+  return impl->cached_valid && impl->cached_w == impl->layout_info.w &&
+         impl->cached_wrap_word == impl->wrap_word && impl->cached_font_size == c->font_size &&
+         tk_str_eq(impl->cached_font_name, c->font_name);
+}
+
+static ret_t text_edit_cache_update(text_edit_t* text_edit, canvas_t* c) {
+  DECL_IMPL(text_edit);
+
+  impl->dirty = FALSE;
+  impl->dirty_delta = 0;
+  impl->cached_valid = TRUE;
+  impl->cached_size = text_edit->widget->text.size;
+  impl->cached_w = impl->layout_info.w;
+  impl->cached_wrap_word = impl->wrap_word;
+  impl->cached_font_size = c->font_size;
+  tk_strncpy(impl->cached_font_name, c->font_name != NULL ? c->font_name : "", TK_NAME_LEN);
+
+  return RET_OK;
+}
+
+/*记录通过编辑器修改的范围：在pos处删除removed个字符，再插入inserted个字符。*/
+static ret_t text_edit_mark_dirty(text_edit_impl_t* impl, uint32_t pos, uint32_t removed,
+                                  uint32_t inserted) {
+  uint32_t end = pos + inserted;
+
+  if (impl->dirty) {
+    if (impl->dirty_end >= pos + removed) {
+      end = tk_max(end, impl->dirty_end - removed + inserted);
+    }
+    impl->dirty_start = tk_min(impl->dirty_start, pos);
+  } else {
+    impl->dirty = TRUE;
+    impl->dirty_start = pos;
+  }
+
+  impl->dirty_end = end;
+  impl->dirty_delta += (int32_t)inserted - (int32_t)removed;
+
+  return RET_OK;
+}
+
+/*重新排版光标所在的行(计算光标的位置)，并根据最后一行更新行数和虚拟高度。*/
+static ret_t text_edit_multi_line_layout_caret(text_edit_t* text_edit) {
+  uint32_t i = 0;
+  uint32_t offset = 0;
+  uint32_t line_index = 0;
+  DECL_IMPL(text_edit);
+  rows_t* rows = impl->rows;
+  row_info_t* last = rows->row + rows->size - 1;
+  wstr_t* text = &(text_edit->widget->text);
+  uint32_t cursor = impl->state.cursor;
+  text_layout_info_t* layout_info = &(impl->layout_info);
+
+  impl->caret.x = 0;
+  impl->caret.y = 0;
+  for (i = 0; i < rows->size; i++) {
+    row_info_t* row = rows->row + i;
+
+    if (cursor < offset + row->length || (row == last && cursor == offset + row->length)) {
+      text_edit_multi_line_layout_line(text_edit, i, line_index, offset);
+      break;
+    }
+
+    line_index += row->line_num;
+    offset += row->length;
+  }
+
+  for (line_index = 0, offset = 0, i = 0; i + 1 < rows->size; i++) {
+    line_index += rows->row[i].line_num;
+    offset += rows->row[i].length;
+  }
+
+  layout_info->virtual_h = tk_max(line_index * impl->line_height, layout_info->widget_h);
+  line_index += last->line_num - 1;
+  if (text->str[offset + last->length - 1] == STB_TEXTEDIT_NEWLINE) {
+    impl->last_row_number = rows->size;
+    impl->last_line_number = line_index + 1;
+  } else {
+    impl->last_row_number = rows->size - 1;
+    impl->last_line_number = line_index;
+  }
+
+  return RET_OK;
+}
+
+/*
+ * 只重新排版修改过的行：从修改处的前一个字符所在的行开始排版，排到修改部分之后，
+ * 且新的行首正好是原来某一行的行首时，后面的行直接使用原来的结果，只调整偏移量。
+ * 原来的行先换到spare_rows中，排版完成后再把后面没有变化的行换回来。
+ * 返回RET_OK表示成功，否则需要全部重新排版。
+ */
+static ret_t text_edit_multi_line_relayout(text_edit_t* text_edit, canvas_t* c) {
+  uint32_t k = 0;
+  uint32_t n = 0;
+  uint32_t r = 0;
+  uint32_t q = 0;
+  uint32_t first = 0;
+  uint32_t start = 0;
+  uint32_t prefix = 0;
+  uint32_t offset = 0;
+  uint32_t old_start = 0;
+  uint32_t line_index = 0;
+  uint32_t changed_end = 0;
+  DECL_IMPL(text_edit);
+  rows_t* rows = impl->rows;
+  rows_t* spare = impl->spare_rows;
+  uint32_t old_size = rows->size;
+  int32_t delta = impl->dirty_delta;
+  wstr_t* text = &(text_edit->widget->text);
+
+  /*文本长度与记录的修改对不上，说明文本被直接修改过。*/
+  if (!text_edit_cache_is_valid(text_edit, c) || old_size == 0 || impl->cached_size == 0 ||
+      text->size == 0 || (int64_t)(impl->cached_size) + delta != (int64_t)(text->size)) {
+    return RET_FAIL;
+  }
+
+  if (!impl->dirty) {
+    return text_edit_multi_line_layout_caret(text_edit);
+  }
+
+  prefix = impl->dirty_start;
+  changed_end = impl->dirty_end;
+  return_value_if_fail(prefix <= changed_end && changed_end <= text->size, RET_FAIL);
+
+  if (spare == NULL) {
+    spare = impl->spare_rows = rows_create(rows->capacity);
+    return_value_if_fail(spare != NULL, RET_OOM);
+  }
+
+  /*前一行的换行判断会看下一个字符，所以从修改处的前一个字符所在的行开始。*/
+  for (first = 0; first + 1 < old_size; first++) {
+    row_info_t* row = rows->row + first;
+    if (prefix < start + row->length + 1) {
+      break;
+    }
+    start += row->length;
+    line_index += row->line_num;
+  }
+
+  /*原来的行换到spare_rows中，空出来的行用于排版修改过的部分。*/
+  n = old_size - first;
+  for (k = 0; k < n; k++) {
+    rows_swap(rows, first + k, spare, k);
+  }
+
+  q = first;
+  r = first;
+  offset = start;
+  old_start = start;
+
+  while (TRUE) {
+    row_info_t* row = NULL;
+
+    if (r >= rows->capacity) {
+      return RET_FAIL;
+    }
+
+    row = text_edit_multi_line_layout_line(text_edit, r, line_index, offset);
+    if (row->length == 0) {
+      return RET_FAIL;
+    }
+
+    r++;
+    offset += row->length;
+    line_index += row->line_num;
+    if (offset >= text->size) {
+      q = old_size;
+      break;
+    }
+
+    if (offset >= changed_end) {
+      uint32_t old_offset = offset - delta;
+      while (q < old_size && old_start < old_offset) {
+        old_start += spare->row[q - first].length;
+        q++;
+      }
+
+      if (q < old_size && old_start == old_offset) {
+        break;
+      }
+    }
+  }
+
+  /*后面的行保持不变，调整偏移量后换回来。*/
+  if (r + (old_size - q) > rows->capacity) {
+    return RET_FAIL;
+  }
+
+  for (k = 0; q + k < old_size; k++) {
+    uint32_t j = 0;
+    row_info_t* row = spare->row + (q - first + k);
+
+    for (j = 0; j < row->line_num; j++) {
+      line_info_t* line = (line_info_t*)darray_get(&row->info, j);
+      line->offset += delta;
+    }
+    rows_swap(rows, r + k, spare, q - first + k);
+  }
+  rows->size = r + k;
+
+  impl->dirty = FALSE;
+  impl->dirty_delta = 0;
+  impl->cached_size = text->size;
+
+  return text_edit_multi_line_layout_caret(text_edit);
+}
+
 static ret_t text_edit_layout_impl(text_edit_t* text_edit) {
   uint32_t i = 0;
   uint32_t offset = 0;
@@ -454,9 +699,6 @@ static ret_t text_edit_layout_impl(text_edit_t* text_edit) {
   text_layout_info_t* layout_info = &(impl->layout_info);
   uint32_t char_w = canvas_measure_text(c, text->str, 1) + CHAR_SPACING;
   uint32_t line_index = 0;
-  impl->caret.x = 0;
-  impl->caret.y = 0;
-  impl->rows->size = 0;
 
   return_value_if_fail(c != NULL, RET_BAD_PARAMS);
 
@@ -464,6 +706,21 @@ static ret_t text_edit_layout_impl(text_edit_t* text_edit) {
   impl->line_height = c->font_size * FONT_BASELINE;
   widget_get_text_layout_info(text_edit->widget, layout_info);
 
+  if (layout_info->w >= char_w && !impl->single_line &&
+      text_edit_multi_line_relayout(text_edit, c) == RET_OK) {
+    text_edit_fix_oy(impl);
+    text_edit_notify(text_edit);
+
+    return RET_OK;
+  }
+
+  impl->caret.x = 0;
+  impl->caret.y = 0;
+  impl->rows->size = 0;
+  impl->dirty = FALSE;
+  impl->dirty_delta = 0;
+  impl->cached_valid = FALSE;
+
   if (layout_info->w < char_w) {
     return RET_OK;
   }
@@ -484,6 +741,9 @@ static ret_t text_edit_layout_impl(text_edit_t* text_edit) {
   }
 
   impl->rows->size = i;
+  if (!impl->single_line) {
+    text_edit_cache_update(text_edit, c);
+  }
 
   text_edit_fix_oy(impl);
 
@@ -501,12 +761,21 @@ ret_t text_edit_layout(text_edit_t* text_edit) {
   return text_edit_layout_impl(text_edit);
 }
 
+ret_t text_edit_invalidate_layout(text_edit_t* text_edit) {
+  DECL_IMPL(text_edit);
+  return_value_if_fail(text_edit != NULL, RET_BAD_PARAMS);
+
+  impl->cached_valid = FALSE;
+
+  return RET_OK;
+}
+
 static void text_edit_layout_for_stb(StbTexteditRow* row, STB_TEXTEDIT_STRING* str, int offset) {
   DECL_IMPL(str);
   canvas_t* c = GET_CANVAS(str);
   if (c == NULL) return;
   uint32_t font_size = c->font_size;
-  line_info_t* info = line_find_by_offset(impl->rows, offset);
+  line_info_t* info = line_find_by_offset(impl->rows, offset, &(impl->found_row));
 
   if (info != NULL) {
     row->x0 = info->x;
@@ -831,7 +1100,13 @@ ret_t text_edit_paint(text_edit_t* text_edit, canvas_t* c) {
 
 static int text_edit_remove(STB_TEXTEDIT_STRING* str, int pos, int num) {
   wstr_t* text = &(str->widget->text);
-  wstr_remove(text, pos, num);
+  DECL_IMPL(str);
+
+  if (pos >= 0 && num > 0 && (uint32_t)pos < text->size) {
+    num = tk_min((uint32_t)num, text->size - pos);
+    wstr_remove(text, pos, num);
+    text_edit_mark_dirty(impl, pos, num, 0);
+  }
 
   return TRUE;
 }
@@ -877,6 +1152,7 @@ static int text_edit_insert(STB_TEXTEDIT_STRING* str, int pos, STB_TEXTEDIT_CHAR
 
   if (num > 0) {
     wstr_insert(text, pos, newtext, num);
+    text_edit_mark_dirty(impl, pos, 0, num);
     ret = TRUE;
   }
 
@@ -967,6 +1243,11 @@ ret_t text_edit_set_max_rows(text_edit_t* text_edit, uint32_t max_rows) {
     impl->rows = NULL;
   }
 
+  if (impl->spare_rows != NULL) {
+    rows_destroy(impl->spare_rows);
+    impl->spare_rows = NULL;
+  }
+
   if (impl->rows == NULL) {
     impl->rows = rows_create(max_rows);
   }
@@ -1521,6 +1802,9 @@ ret_t text_edit_destroy(text_edit_t* text_edit) {
 
   wstr_reset(&(impl->tips));
   rows_destroy(impl->rows);
+  if (impl->spare_rows != NULL) {
+    rows_destroy(impl->spare_rows);
+  }
   TKMEM_FREE(text_edit);
 
   return RET_OK;
@@ -353,6 +353,18 @@ ret_t text_edit_paint(text_edit_t* text_edit, canvas_t* c);
  */
 ret_t text_edit_layout(text_edit_t* text_edit);
 
+/**
+ * @method text_edit_invalidate_layout
+ * 使排版结果失效，下次排版时重新排版全部文本。
+ *
+ * > 多行编辑时只重新排版通过text\_edit修改过的行，直接修改控件的文本后需要调用本函数。
+ *
+ * @param {text_edit_t*} text_edit text_edit对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t text_edit_invalidate_layout(text_edit_t* text_edit);
+
 /**
  * @method text_edit_set_offset
  * 设置滚动偏移。
@@ -0,0 +1,308 @@
+/**
+ * File:   text_run_cache.c
+ * Author: AWTK Develop Team
+ * Brief:  text run cache
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "base/text_run_cache.h"
+
+static uint32_t text_run_hash(font_t* font, font_size_t font_size, const wchar_t* str,
+                              uint32_t nr) {
+  uint32_t i = 0;
+  uint32_t h = 2166136261u;
+
+  h = (h ^ (uint32_t)(((uintptr_t)font) >> 3)) * 16777619u;
+  h = (h ^ (uint32_t)font_size) * 16777619u;
+  for (i = 0; i < nr; i++) {
+    h = (h ^ (uint32_t)str[i]) * 16777619u;
+  }
+
+  /*0表示seen中的空位。*/
+  return h != 0 ? h : 1;
+}
+
+static void text_run_cache_lru_unlink(text_run_cache_t* cache, text_run_t* run) {
+  if (run->lru_prev != NULL) {
+    run->lru_prev->lru_next = run->lru_next;
+  } else {
+    cache->lru_first = run->lru_next;
+  }
+
+  if (run->lru_next != NULL) {
+    run->lru_next->lru_prev = run->lru_prev;
+  } else {
+    cache->lru_last = run->lru_prev;
+  }
+
+  run->lru_prev = NULL;
+  run->lru_next = NULL;
+}
+
+static void text_run_cache_lru_push_front(text_run_cache_t* cache, text_run_t* run) {
+  run->lru_prev = NULL;
+  run->lru_next = cache->lru_first;
+
+  if (cache->lru_first != NULL) {
+    cache->lru_first->lru_prev = run;
+  } else {
+    cache->lru_last = run;
+  }
+  cache->lru_first = run;
+}
+
+static ret_t text_run_cache_remove_run(text_run_cache_t* cache, text_run_t* run) {
+  text_run_t** pp = cache->buckets + (run->hash & (cache->buckets_nr - 1));
+
+  while (*pp != NULL) {
+    if (*pp == run) {
+      *pp = run->next;
+      break;
+    }
+    pp = &((*pp)->next);
+  }
+
+  text_run_cache_lru_unlink(cache, run);
+  cache->size--;
+  TKMEM_FREE(run);
+
+  return RET_OK;
+}
+
+/*字形的位置与canvas_draw_text一致，宽度与canvas_measure_text一致。*/
+static text_run_t* text_run_create(font_t* font, font_size_t font_size, const wchar_t* str,
+                                   uint32_t nr) {
+  glyph_t g;
+  uint32_t i = 0;
+  xy_t x = 0;
+  float_t w = 0;
+  text_run_t* run = NULL;
+  uint32_t size = sizeof(text_run_t) + nr * (sizeof(text_run_glyph_t) + sizeof(wchar_t));
+
+  run = (text_run_t*)TKMEM_ALLOC(size);
+  return_value_if_fail(run != NULL, NULL);
+
+  memset(run, 0x00, sizeof(text_run_t));
+  run->font = font;
+  run->font_size = font_size;
+  run->size = nr;
+  run->glyphs = (text_run_glyph_t*)(run + 1);
+  run->str = (wchar_t*)(run->glyphs + nr);
+  memcpy(run->str, str, nr * sizeof(wchar_t));
+
+  for (i = 0; i < nr; i++) {
+    wchar_t chr = str[i];
+
+    if (font_get_glyph(font, chr, font_size, &g) == RET_OK) {
+      w += g.advance + 1;
+    } else {
+      w += 4;
+    }
+  }
+  run->width = w;
+
+  for (i = 0; i < nr; i++) {
+    wchar_t chr = str[i];
+
+    if (chr == '\r' || chr == '\n') {
+      if ((i + 1) == nr) {
+        break;
+      }
+
+      if (chr == '\r' && str[i + 1] == '\n') {
+        i++;
+      }
+      chr = ' ';
+    }
+
+    if (font_get_glyph(font, chr, font_size, &g) == RET_OK) {
+      if (g.data != NULL && g.w > 0 && g.h > 0) {
+        text_run_glyph_t* iter = run->glyphs + run->glyphs_nr;
+
+        iter->code = chr;
+        iter->x = x + g.x;
+        iter->y = g.y;
+        iter->w = g.w;
+        iter->h = g.h;
+
+        if (run->glyphs_nr == 0) {
+          run->top = iter->y;
+          run->bottom = iter->y + iter->h;
+        } else {
+          run->top = tk_min(run->top, iter->y);
+          run->bottom = tk_max(run->bottom, iter->y + iter->h);
+        }
+        run->glyphs_nr++;
+      }
+      x += g.advance + 1;
+    } else {
+      x += 4;
+    }
+  }
+
+  return run;
+}
+
+text_run_cache_t* text_run_cache_create(uint32_t capacity) {
+  uint32_t buckets_nr = 16;
+  text_run_cache_t* cache = NULL;
+  return_value_if_fail(capacity > 0, NULL);
+
+  cache = TKMEM_ZALLOC(text_run_cache_t);
+  return_value_if_fail(cache != NULL, NULL);
+
+  while (buckets_nr < capacity) {
+    buckets_nr <<= 1;
+  }
+
+  cache->buckets = TKMEM_ZALLOCN(text_run_t*, buckets_nr);
+  goto_error_if_fail(cache->buckets != NULL);
+
+  cache->seen = TKMEM_ZALLOCN(uint32_t, buckets_nr);
+  goto_error_if_fail(cache->seen != NULL);
+
+  cache->capacity = capacity;
+  cache->buckets_nr = buckets_nr;
+
+  return cache;
+error:
+  TKMEM_FREE(cache->buckets);
+  TKMEM_FREE(cache);
+
+  return NULL;
+}
+
+static text_run_t* text_run_cache_lookup(text_run_cache_t* cache, uint32_t hash, font_t* font,
+                                         font_size_t font_size, const wchar_t* str, uint32_t nr) {
+  text_run_t* iter = cache->buckets[hash & (cache->buckets_nr - 1)];
+
+  for (; iter != NULL; iter = iter->next) {
+    if (iter->hash == hash && iter->font == font && iter->font_size == font_size &&
+        iter->size == nr && memcmp(iter->str, str, nr * sizeof(wchar_t)) == 0) {
+      if (cache->lru_first != iter) {
+        text_run_cache_lru_unlink(cache, iter);
+        text_run_cache_lru_push_front(cache, iter);
+      }
+      cache->hits++;
+
+      return iter;
+    }
+  }
+
+  return NULL;
+}
+
+const text_run_t* text_run_cache_find(text_run_cache_t* cache, font_t* font, font_size_t font_size,
+                                      const wchar_t* str, uint32_t nr) {
+  return_value_if_fail(cache != NULL && font != NULL && str != NULL, NULL);
+
+  if (nr < TK_TEXT_RUN_MIN_CHARS || nr > TK_TEXT_RUN_MAX_CHARS || cache->size == 0) {
+    return NULL;
+  }
+
+  return text_run_cache_lookup(cache, text_run_hash(font, font_size, str, nr), font, font_size,
+                               str, nr);
+}
+
+const text_run_t* text_run_cache_get(text_run_cache_t* cache, font_t* font, font_size_t font_size,
+                                     const wchar_t* str, uint32_t nr) {
+  uint32_t hash = 0;
+  uint32_t* seen = NULL;
+  text_run_t* iter = NULL;
+  text_run_t** bucket = NULL;
+  return_value_if_fail(cache != NULL && font != NULL && str != NULL, NULL);
+
+  if (nr < TK_TEXT_RUN_MIN_CHARS || nr > TK_TEXT_RUN_MAX_CHARS) {
+    return NULL;
+  }
+
+  hash = text_run_hash(font, font_size, str, nr);
+  iter = text_run_cache_lookup(cache, hash, font, font_size, str, nr);
+  if (iter != NULL) {
+    return iter;
+  }
+
+  cache->misses++;
+  seen = cache->seen + (hash & (cache->buckets_nr - 1));
+  if (*seen != hash) {
+    *seen = hash;
+    return NULL;
+  }
+
+  *seen = 0;
+  bucket = cache->buckets + (hash & (cache->buckets_nr - 1));
+  iter = text_run_create(font, font_size, str, nr);
+  return_value_if_fail(iter != NULL, NULL);
+
+  if (cache->size >= cache->capacity) {
+    text_run_cache_remove_run(cache, cache->lru_last);
+  }
+
+  iter->hash = hash;
+  iter->next = *bucket;
+  *bucket = iter;
+  text_run_cache_lru_push_front(cache, iter);
+  cache->size++;
+
+  return iter;
+}
+
+ret_t text_run_cache_remove_font(text_run_cache_t* cache, font_t* font) {
+  text_run_t* iter = NULL;
+  text_run_t* next = NULL;
+  return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
+
+  for (iter = cache->lru_first; iter != NULL; iter = next) {
+    next = iter->lru_next;
+    if (iter->font == font) {
+      text_run_cache_remove_run(cache, iter);
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t text_run_cache_clear(text_run_cache_t* cache) {
+  text_run_t* iter = NULL;
+  text_run_t* next = NULL;
+  return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
+
+  for (iter = cache->lru_first; iter != NULL; iter = next) {
+    next = iter->lru_next;
+    TKMEM_FREE(iter);
+  }
+
+  memset(cache->buckets, 0x00, sizeof(text_run_t*) * cache->buckets_nr);
+  memset(cache->seen, 0x00, sizeof(uint32_t) * cache->buckets_nr);
+  cache->lru_first = NULL;
+  cache->lru_last = NULL;
+  cache->size = 0;
+
+  return RET_OK;
+}
+
+ret_t text_run_cache_destroy(text_run_cache_t* cache) {
+  return_value_if_fail(cache != NULL, RET_BAD_PARAMS);
+
+  text_run_cache_clear(cache);
+  TKMEM_FREE(cache->seen);
+  TKMEM_FREE(cache->buckets);
+  TKMEM_FREE(cache);
+
+  return RET_OK;
+}
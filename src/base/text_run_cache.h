@@ -0,0 +1,268 @@
+/**
+ * File:   text_run_cache.h
+ * Author: AWTK Develop Team
+ * Brief:  text run cache
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_TEXT_RUN_CACHE_H
+#define TK_TEXT_RUN_CACHE_H
+
+#include "base/font.h"
+
+BEGIN_C_DECLS
+
+/*缓存的文本段个数，定义为0时禁用文本段缓存。*/
+#ifndef TK_TEXT_RUN_CACHE_NR
+#define TK_TEXT_RUN_CACHE_NR 64
+#endif /*TK_TEXT_RUN_CACHE_NR*/
+
+/*短于该长度的文本(如逐个字符测量)不缓存，直接计算比查找缓存更快。*/
+#ifndef TK_TEXT_RUN_MIN_CHARS
+#define TK_TEXT_RUN_MIN_CHARS 2
+#endif /*TK_TEXT_RUN_MIN_CHARS*/
+
+/*超过该长度的文本不缓存。*/
+#ifndef TK_TEXT_RUN_MAX_CHARS
+#define TK_TEXT_RUN_MAX_CHARS 128
+#endif /*TK_TEXT_RUN_MAX_CHARS*/
+
+/**
+ * @class text_run_glyph_t
+ * 文本段中的一个字形。
+ */
+typedef struct _text_run_glyph_t {
+  /**
+   * @property {wchar_t} code
+   * @annotation ["readable"]
+   * 字符。
+   */
+  wchar_t code;
+  /**
+   * @property {xy_t} x
+   * @annotation ["readable"]
+   * 相对于文本段起点的x坐标。
+   */
+  xy_t x;
+  /**
+   * @property {xy_t} y
+   * @annotation ["readable"]
+   * 相对于基线的y坐标。
+   */
+  xy_t y;
+  /**
+   * @property {wh_t} w
+   * @annotation ["readable"]
+   * 宽度。
+   */
+  wh_t w;
+  /**
+   * @property {wh_t} h
+   * @annotation ["readable"]
+   * 高度。
+   */
+  wh_t h;
+} text_run_glyph_t;
+
+/**
+ * @class text_run_t
+ * 文本段。
+ *
+ * 保存一段文本排版的结果(字形的位置和大小，以及文本的宽度)，绘制时不再逐个计算字形的位置。
+ *
+ * > 字形的位图仍然由字体的glyph cache管理，文本段中只保存字符和位置。
+ */
+typedef struct _text_run_t {
+  /**
+   * @property {font_t*} font
+   * @annotation ["readable"]
+   * 字体。
+   */
+  font_t* font;
+  /**
+   * @property {font_size_t} font_size
+   * @annotation ["readable"]
+   * 字体大小。
+   */
+  font_size_t font_size;
+  /**
+   * @property {uint32_t} size
+   * @annotation ["readable"]
+   * 字符个数。
+   */
+  uint32_t size;
+  /**
+   * @property {wchar_t*} str
+   * @annotation ["readable"]
+   * 文本。
+   */
+  wchar_t* str;
+  /**
+   * @property {float_t} width
+   * @annotation ["readable"]
+   * 文本的宽度(与canvas_measure_text的结果一致)。
+   */
+  float_t width;
+  /**
+   * @property {xy_t} top
+   * @annotation ["readable"]
+   * 全部字形相对于基线的最小y坐标。
+   */
+  xy_t top;
+  /**
+   * @property {xy_t} bottom
+   * @annotation ["readable"]
+   * 全部字形相对于基线的最大y坐标(不含)。
+   */
+  xy_t bottom;
+  /**
+   * @property {uint32_t} glyphs_nr
+   * @annotation ["readable"]
+   * 有位图的字形个数。
+   */
+  uint32_t glyphs_nr;
+  /**
+   * @property {text_run_glyph_t*} glyphs
+   * @annotation ["readable"]
+   * 有位图的字形。
+   */
+  text_run_glyph_t* glyphs;
+
+  /*private*/
+  uint32_t hash;
+  struct _text_run_t* next;
+  struct _text_run_t* lru_prev;
+  struct _text_run_t* lru_next;
+} text_run_t;
+
+/**
+ * @class text_run_cache_t
+ * 文本段缓存。
+ *
+ * 以(字体, 字体大小, 文本)为键缓存文本段，超过容量时淘汰最久没有使用的文本段。
+ *
+ * 文本段第二次未命中时才加入缓存，只出现一次的文本(如滚动的数字)不会把常用的文本段挤出缓存。
+ */
+typedef struct _text_run_cache_t {
+  /**
+   * @property {uint32_t} capacity
+   * @annotation ["readable"]
+   * 最大缓存的文本段个数。
+   */
+  uint32_t capacity;
+  /**
+   * @property {uint32_t} size
+   * @annotation ["readable"]
+   * 当前缓存的文本段个数。
+   */
+  uint32_t size;
+  /**
+   * @property {uint32_t} hits
+   * @annotation ["readable"]
+   * 命中次数。
+   */
+  uint32_t hits;
+  /**
+   * @property {uint32_t} misses
+   * @annotation ["readable"]
+   * 未命中次数。
+   */
+  uint32_t misses;
+
+  /*private*/
+  text_run_t** buckets;
+  uint32_t buckets_nr;
+  text_run_t* lru_first;
+  text_run_t* lru_last;
+  uint32_t* seen;
+} text_run_cache_t;
+
+/**
+ * @method text_run_cache_create
+ * 创建文本段缓存。
+ * @annotation ["constructor"]
+ * @param {uint32_t} capacity 最大缓存的文本段个数。
+ *
+ * @return {text_run_cache_t*} 返回文本段缓存对象。
+ */
+text_run_cache_t* text_run_cache_create(uint32_t capacity);
+
+/**
+ * @method text_run_cache_get
+ * 获取文本段，如果没有缓存，且最近未命中过，则排版并缓存。
+ *
+ * > 第一次未命中时只记录下来并返回NULL，由调用者直接绘制。
+ * > 文本短于TK\_TEXT\_RUN\_MIN\_CHARS或者超过TK\_TEXT\_RUN\_MAX\_CHARS时不缓存，返回NULL。
+ * > 返回的文本段在下一次调用text\_run\_cache\_get之前有效。
+ *
+ * @param {text_run_cache_t*} cache 文本段缓存对象。
+ * @param {font_t*} font 字体。
+ * @param {font_size_t} font_size 字体大小。
+ * @param {const wchar_t*} str 文本。
+ * @param {uint32_t} nr 字符个数。
+ *
+ * @return {const text_run_t*} 返回文本段。
+ */
+const text_run_t* text_run_cache_get(text_run_cache_t* cache, font_t* font, font_size_t font_size,
+                                     const wchar_t* str, uint32_t nr);
+
+/**
+ * @method text_run_cache_find
+ * 查找已经缓存的文本段，没有缓存时返回NULL，不会排版和缓存(用于只需测量文本的场景)。
+ *
+ * @param {text_run_cache_t*} cache 文本段缓存对象。
+ * @param {font_t*} font 字体。
+ * @param {font_size_t} font_size 字体大小。
+ * @param {const wchar_t*} str 文本。
+ * @param {uint32_t} nr 字符个数。
+ *
+ * @return {const text_run_t*} 返回文本段。
+ */
+const text_run_t* text_run_cache_find(text_run_cache_t* cache, font_t* font, font_size_t font_size,
+                                      const wchar_t* str, uint32_t nr);
+
+/**
+ * @method text_run_cache_remove_font
+ * 删除指定字体的全部文本段(字体被卸载时调用)。
+ * @param {text_run_cache_t*} cache 文本段缓存对象。
+ * @param {font_t*} font 字体。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t text_run_cache_remove_font(text_run_cache_t* cache, font_t* font);
+
+/**
+ * @method text_run_cache_clear
+ * 清除全部文本段。
+ * @param {text_run_cache_t*} cache 文本段缓存对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t text_run_cache_clear(text_run_cache_t* cache);
+
+/**
+ * @method text_run_cache_destroy
+ * 销毁文本段缓存。
+ * @param {text_run_cache_t*} cache 文本段缓存对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t text_run_cache_destroy(text_run_cache_t* cache);
+
+END_C_DECLS
+
+#endif /*TK_TEXT_RUN_CACHE_H*/
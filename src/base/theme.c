@@ -30,16 +30,52 @@ color_t style_data_get_color(const uint8_t* s, const char* name, color_t defval)
   return defval;
 }
 
+static const style_name_value_t* style_data_get_by_index(const uint8_t* s, uint32_t nr,
+                                                         const char* name) {
+  int32_t low = 0;
+  int32_t mid = 0;
+  int32_t result = 0;
+  int32_t high = nr - 1;
+  uint16_t offset = 0;
+  const uint8_t* p = NULL;
+  const style_name_value_t* iter = NULL;
+  const style_name_value_t* found = NULL;
+
+  while (low <= high) {
+    mid = low + ((high - low) >> 1);
+    p = s + sizeof(uint32_t) + mid * sizeof(uint16_t);
+    load_uint16(p, offset);
+    iter = (const style_name_value_t*)(s + offset);
+    result = tk_str_cmp(name, iter->name);
+
+    if (result == 0) {
+      /*同名的取第一个，和顺序查找的结果一致*/
+      found = iter;
+      high = mid - 1;
+    } else if (result > 0) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return found;
+}
+
 static const style_name_value_t* style_data_get(const uint8_t* s, const char* name) {
   uint32_t i = 0;
   uint32_t nr = 0;
   const uint8_t* p = s;
 
-  if (s == NULL) {
+  if (s == NULL || name == NULL) {
     return NULL;
   }
 
   load_uint32(p, nr);
+  if (nr & STYLE_DATA_FLAG_INDEXED) {
+    return style_data_get_by_index(s, nr & ~STYLE_DATA_FLAG_INDEXED, name);
+  }
+
   for (i = 0; i < nr; i++) {
     const style_name_value_t* iter = (const style_name_value_t*)p;
 
@@ -92,6 +128,55 @@ const char* style_data_get_str(const uint8_t* s, const char* name, const char* d
   return value;
 }
 
+static int32_t theme_item_compare(const theme_item_t* iter, const char* widget_type,
+                                  const char* name, const char* widget_state) {
+  int32_t result = tk_str_cmp(widget_type, iter->widget_type);
+
+  if (result == 0) {
+    result = tk_str_cmp(name, iter->name);
+    if (result == 0) {
+      result = tk_str_cmp(widget_state, iter->state);
+    }
+  }
+
+  return result;
+}
+
+static const theme_item_t* theme_find_item_by_index(const uint8_t* data, const char* widget_type,
+                                                    const char* name, const char* widget_state) {
+  int32_t low = 0;
+  int32_t mid = 0;
+  int32_t result = 0;
+  uint32_t index = 0;
+  const uint8_t* p = NULL;
+  const theme_item_t* iter = NULL;
+  const theme_item_t* found = NULL;
+  const theme_header_t* header = (const theme_header_t*)data;
+  const theme_item_t* items = (const theme_item_t*)(data + sizeof(theme_header_t));
+  const uint8_t* indexes = (const uint8_t*)(items + header->nr);
+  int32_t high = header->nr - 1;
+
+  while (low <= high) {
+    mid = low + ((high - low) >> 1);
+    p = indexes + mid * sizeof(uint32_t);
+    load_uint32(p, index);
+    iter = items + index;
+    result = theme_item_compare(iter, widget_type, name, widget_state);
+
+    if (result == 0) {
+      /*有重复的取第一个，和顺序查找的结果一致*/
+      found = iter;
+      high = mid - 1;
+    } else if (result > 0) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return found;
+}
+
 const uint8_t* theme_find_style(theme_t* theme, const char* widget_type, const char* name,
                                 const char* widget_state) {
   return_value_if_fail(theme != NULL, NULL);
@@ -108,6 +193,11 @@ const uint8_t* theme_find_style(theme_t* theme, const char* widget_type, const c
       name = TK_DEFAULT_STYLE;
     }
 
+    if (header->version >= THEME_VERSION_INDEXED) {
+      iter = theme_find_item_by_index(theme->data, widget_type, name, widget_state);
+      return iter != NULL ? theme->data + iter->offset : NULL;
+    }
+
     iter = (const theme_item_t*)(theme->data + sizeof(theme_header_t));
     for (i = 0; i < header->nr; i++) {
       if (tk_str_eq(widget_type, iter->widget_type)) {
@@ -134,6 +134,15 @@ const char* style_data_get_str(const uint8_t* s, const char* name, const char* d
 
 /*public for tools only*/
 #define THEME_MAGIC 0xFAFBFCFD
+
+/*
+ * THEME_VERSION_INDEXED:
+ * theme_item_t数组之后是按(widget_type, name, state)排序的索引(uint32_t[nr])。
+ * style数据的个数带有STYLE_DATA_FLAG_INDEXED标志，个数之后是按名称排序的偏移量(uint16_t[nr])。
+ * 查找时用二分查找，version为0的旧数据仍然顺序查找。
+ */
+#define THEME_VERSION_INDEXED 1
+#define STYLE_DATA_FLAG_INDEXED 0x80000000
 #define TK_DEFAULT_STYLE "default"
 
 #pragma pack(push, 1)
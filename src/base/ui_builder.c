@@ -34,6 +34,25 @@ ret_t ui_builder_on_widget_prop(ui_builder_t* b, const char* name, const char* v
   return b->on_widget_prop(b, name, value);
 }
 
+ret_t ui_builder_on_widget_prop_value(ui_builder_t* b, widget_prop_id_t id, const char* name,
+                                      const value_t* value) {
+  char str[64];
+  return_value_if_fail(b != NULL && name != NULL && value != NULL, RET_BAD_PARAMS);
+
+  if (b->on_widget_prop_value != NULL) {
+    return b->on_widget_prop_value(b, id, name, value);
+  }
+
+  if (value->type == VALUE_TYPE_UINT32 && strstr(name, "color") != NULL) {
+    color_t c = color_init(0, 0, 0, 0);
+    c.color = value_uint32(value);
+
+    return ui_builder_on_widget_prop(b, name, color_hex_str(c, str));
+  }
+
+  return ui_builder_on_widget_prop(b, name, value_str_ex(value, str, sizeof(str)));
+}
+
 ret_t ui_builder_on_widget_prop_end(ui_builder_t* b) {
   return_value_if_fail(b != NULL && b->on_widget_prop_end != NULL, RET_BAD_PARAMS);
 
@@ -75,3 +94,71 @@ ret_t ui_builder_destroy(ui_builder_t* b) {
     return RET_OK;
   }
 }
+
+/*
+ * UI_DATA_MAGIC_V2中常用属性的编号，以编号为下标。
+ * 编号写在UI数据中，与widget_prop_id_t的值无关(widget_prop_id_t按名称排序，增加属性时会变)。
+ * 只能在末尾追加，不能删除、修改或者调整顺序。
+ */
+static const widget_prop_id_t s_ui_prop_wire_ids[] = {
+    WIDGET_PROP_ID_NONE,                 /*0*/
+    WIDGET_PROP_ID_ANIMATION,            /*1*/
+    WIDGET_PROP_ID_AUTO_ADJUST_SIZE,     /*2*/
+    WIDGET_PROP_ID_CHILDREN_LAYOUT,      /*3*/
+    WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE, /*4*/
+    WIDGET_PROP_ID_ENABLE,               /*5*/
+    WIDGET_PROP_ID_EXEC,                 /*6*/
+    WIDGET_PROP_ID_FEEDBACK,             /*7*/
+    WIDGET_PROP_ID_FLOATING,             /*8*/
+    WIDGET_PROP_ID_FOCUS,                /*9*/
+    WIDGET_PROP_ID_FOCUSABLE,            /*10*/
+    WIDGET_PROP_ID_FOCUSED,              /*11*/
+    WIDGET_PROP_ID_FORMAT,               /*12*/
+    WIDGET_PROP_ID_GRAB_KEYS,            /*13*/
+    WIDGET_PROP_ID_H,                    /*14*/
+    WIDGET_PROP_ID_LAYOUT,               /*15*/
+    WIDGET_PROP_ID_LAYOUT_H,             /*16*/
+    WIDGET_PROP_ID_LAYOUT_W,             /*17*/
+    WIDGET_PROP_ID_MAX,                  /*18*/
+    WIDGET_PROP_ID_MIN,                  /*19*/
+    WIDGET_PROP_ID_NAME,                 /*20*/
+    WIDGET_PROP_ID_OPACITY,              /*21*/
+    WIDGET_PROP_ID_POINTER_CURSOR,       /*22*/
+    WIDGET_PROP_ID_REVERSE,              /*23*/
+    WIDGET_PROP_ID_SELF_LAYOUT,          /*24*/
+    WIDGET_PROP_ID_SENSITIVE,            /*25*/
+    WIDGET_PROP_ID_SHOW_TEXT,            /*26*/
+    WIDGET_PROP_ID_STATE_FOR_STYLE,      /*27*/
+    WIDGET_PROP_ID_STEP,                 /*28*/
+    WIDGET_PROP_ID_STYLE,                /*29*/
+    WIDGET_PROP_ID_TEXT,                 /*30*/
+    WIDGET_PROP_ID_TR_TEXT,              /*31*/
+    WIDGET_PROP_ID_TYPE,                 /*32*/
+    WIDGET_PROP_ID_VALUE,                /*33*/
+    WIDGET_PROP_ID_VERTICAL,             /*34*/
+    WIDGET_PROP_ID_VISIBLE,              /*35*/
+    WIDGET_PROP_ID_W,                    /*36*/
+    WIDGET_PROP_ID_WITH_FOCUS_STATE,     /*37*/
+    WIDGET_PROP_ID_X,                    /*38*/
+    WIDGET_PROP_ID_Y,                    /*39*/
+};
+
+uint8_t ui_builder_prop_id_to_wire_id(widget_prop_id_t id) {
+  uint32_t i = 0;
+
+  for (i = 1; i < ARRAY_SIZE(s_ui_prop_wire_ids); i++) {
+    if (s_ui_prop_wire_ids[i] == id) {
+      return (uint8_t)i;
+    }
+  }
+
+  return UI_PROP_WIRE_ID_NONE;
+}
+
+widget_prop_id_t ui_builder_prop_id_from_wire_id(uint8_t wire_id) {
+  if (wire_id >= ARRAY_SIZE(s_ui_prop_wire_ids)) {
+    return WIDGET_PROP_ID_NONE;
+  }
+
+  return s_ui_prop_wire_ids[wire_id];
+}
@@ -38,6 +38,8 @@ typedef struct _widget_desc_t {
 typedef ret_t (*ui_builder_on_start_t)(ui_builder_t* b);
 typedef ret_t (*ui_builder_on_widget_start_t)(ui_builder_t* b, const widget_desc_t* desc);
 typedef ret_t (*ui_builder_on_widget_prop_t)(ui_builder_t* b, const char* name, const char* value);
+typedef ret_t (*ui_builder_on_widget_prop_value_t)(ui_builder_t* b, widget_prop_id_t id,
+                                                   const char* name, const value_t* value);
 typedef ret_t (*ui_builder_on_widget_prop_end_t)(ui_builder_t* b);
 typedef ret_t (*ui_builder_on_widget_end_t)(ui_builder_t* b);
 typedef ret_t (*ui_builder_on_end_t)(ui_builder_t* b);
@@ -68,6 +70,7 @@ struct _ui_builder_t {
   ui_builder_on_start_t on_start;
   ui_builder_on_widget_start_t on_widget_start;
   ui_builder_on_widget_prop_t on_widget_prop;
+  ui_builder_on_widget_prop_value_t on_widget_prop_value;
   ui_builder_on_widget_prop_end_t on_widget_prop_end;
   ui_builder_on_widget_end_t on_widget_end;
   ui_builder_on_end_t on_end;
@@ -102,6 +105,23 @@ ret_t ui_builder_on_widget_start(ui_builder_t* builder, const widget_desc_t* des
  */
 ret_t ui_builder_on_widget_prop(ui_builder_t* builder, const char* name, const char* value);
 
+/**
+ * @method ui_builder_on_widget_prop_value
+ * ui\_loader在解析到已经转换好类型的widget属性时，调用本函数进一步处理。
+ *
+ * > builder没有实现on\_widget\_prop\_value时，把属性值转换成字符串，再调用on\_widget\_prop。
+ *
+ * @param {ui_builder_t*} builder builder对象。
+ * @param {widget_prop_id_t} id 属性ID，不是常用属性时为WIDGET\_PROP\_ID\_NONE。
+ * @param {const char*} name 属性名。
+ * @param {const value_t*} value 属性值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ *
+ */
+ret_t ui_builder_on_widget_prop_value(ui_builder_t* builder, widget_prop_id_t id, const char* name,
+                                      const value_t* value);
+
 /**
  * @method ui_builder_on_widget_prop_end
  * ui\_loader在解析到widget全部属性结束时，调用本函数进一步处理。
@@ -159,6 +179,42 @@ ret_t ui_builder_destroy(ui_builder_t* builder);
 
 #define UI_DATA_MAGIC 0x11221212
 
+/*属性名用ID表示，属性值预先转换好类型的二进制UI数据。*/
+#define UI_DATA_MAGIC_V2 0x11221213
+
+/*UI_DATA_MAGIC_V2中属性值的类型。*/
+#define UI_PROP_TYPE_END 0
+#define UI_PROP_TYPE_STR 1
+#define UI_PROP_TYPE_INT 2
+#define UI_PROP_TYPE_FLOAT 3
+#define UI_PROP_TYPE_BOOL 4
+#define UI_PROP_TYPE_COLOR 5
+#define UI_PROP_TYPE_SELF_LAYOUT 6
+#define UI_PROP_TYPE_CHILDREN_LAYOUT 7
+
+/*UI_DATA_MAGIC_V2中不是常用属性，属性名用字符串表示。*/
+#define UI_PROP_WIRE_ID_NONE 0
+
+/**
+ * @method ui_builder_prop_id_to_wire_id
+ * 获取属性ID在UI_DATA_MAGIC_V2数据中的编号。
+ * @annotation ["static"]
+ * @param {widget_prop_id_t} id 属性ID。
+ *
+ * @return {uint8_t} 返回编号，没有编号时返回UI_PROP_WIRE_ID_NONE。
+ */
+uint8_t ui_builder_prop_id_to_wire_id(widget_prop_id_t id);
+
+/**
+ * @method ui_builder_prop_id_from_wire_id
+ * 获取UI_DATA_MAGIC_V2数据中的编号对应的属性ID。
+ * @annotation ["static"]
+ * @param {uint8_t} wire_id 编号。
+ *
+ * @return {widget_prop_id_t} 返回属性ID，无效的编号返回WIDGET_PROP_ID_NONE。
+ */
+widget_prop_id_t ui_builder_prop_id_from_wire_id(uint8_t wire_id);
+
 END_C_DECLS
 
 #endif /*TK_UI_BUILDER_H*/
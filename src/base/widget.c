@@ -34,6 +34,9 @@
 #include "base/widget.h"
 #include "base/layout.h"
 #include "native_window.h"
+#include "base/widget_pool.h"
+#include "base/widget_layer.h"
+#include "base/widget_hit_grid.h"
 #include "base/main_loop.h"
 #include "base/ui_feedback.h"
 #include "base/system_info.h"
@@ -128,18 +131,22 @@ static ret_t widget_real_destroy(widget_t* widget) {
   wstr_reset(&(widget->text));
   style_destroy(widget->astyle);
 
-  memset(widget, 0x00, sizeof(widget_t));
-  TKMEM_FREE(widget);
+  if (widget->pooled) {
+    widget_pool_free(widget);
+  } else {
+    memset(widget, 0x00, sizeof(widget_t));
+    TKMEM_FREE(widget);
+  }
 
   return RET_OK;
 }
 
 static widget_t* widget_real_create(const widget_vtable_t* vt) {
-  widget_t* widget = TKMEM_ALLOC(vt->size);
+  widget_t* widget = widget_pool_alloc(vt);
   return_value_if_fail(widget != NULL, NULL);
 
-  memset(widget, 0x00, vt->size);
   widget->vt = vt;
+  widget->pooled = TRUE;
 
   return widget;
 }
@@ -178,6 +185,7 @@ ret_t widget_move(widget_t* widget, xy_t x, xy_t y) {
     widget->x = x;
     widget->y = y;
     widget_invalidate_force(widget, NULL);
+    widget_hit_grid_invalidate(widget->parent);
 
     e.type = EVT_MOVE;
     widget_dispatch(widget, &e);
@@ -198,6 +206,7 @@ ret_t widget_resize(widget_t* widget, wh_t w, wh_t h) {
     widget->h = h;
     widget_invalidate_force(widget, NULL);
     widget_set_need_relayout_children(widget);
+    widget_hit_grid_invalidate(widget->parent);
 
     e.type = EVT_RESIZE;
     widget_dispatch(widget, &e);
@@ -220,6 +229,7 @@ ret_t widget_move_resize(widget_t* widget, xy_t x, xy_t y, wh_t w, wh_t h) {
     widget->h = h;
     widget_invalidate_force(widget, NULL);
     widget_set_need_relayout_children(widget);
+    widget_hit_grid_invalidate(widget->parent);
 
     e.type = EVT_MOVE_RESIZE;
     widget_dispatch(widget, &e);
@@ -663,6 +673,17 @@ ret_t widget_set_enable(widget_t* widget, bool_t enable) {
   return RET_OK;
 }
 
+ret_t widget_set_hit_grid(widget_t* widget, bool_t hit_grid) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  widget->hit_grid = hit_grid;
+  if (!hit_grid) {
+    widget_hit_grid_destroy(widget);
+  }
+
+  return RET_OK;
+}
+
 ret_t widget_set_feedback(widget_t* widget, bool_t feedback) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
@@ -671,6 +692,20 @@ ret_t widget_set_feedback(widget_t* widget, bool_t feedback) {
   return RET_OK;
 }
 
+ret_t widget_set_cache(widget_t* widget, bool_t cache) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->cache != cache) {
+    widget->cache = cache;
+    if (!cache) {
+      widget_layer_destroy(widget);
+    }
+    widget_invalidate(widget, NULL);
+  }
+
+  return RET_OK;
+}
+
 ret_t widget_set_auto_adjust_size(widget_t* widget, bool_t auto_adjust_size) {
   return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
 
@@ -828,6 +863,7 @@ ret_t widget_destroy_children(widget_t* widget) {
 
     WIDGET_FOR_EACH_CHILD_END();
     widget->children->size = 0;
+    widget_hit_grid_invalidate(widget);
   }
 
   return RET_OK;
@@ -906,6 +942,7 @@ ret_t widget_add_child(widget_t* widget, widget_t* child) {
   }
 
   ENSURE(darray_push(widget->children, child) == RET_OK);
+  widget_hit_grid_invalidate(widget);
 
   if (!widget_is_window_manager(widget)) {
     widget_set_need_relayout_children(widget);
@@ -964,6 +1001,7 @@ ret_t widget_remove_child(widget_t* widget, widget_t* child) {
 
   widget_remove_child_prepare(widget, child);
   ret = darray_remove(widget->children, child);
+  widget_hit_grid_invalidate(widget);
 
   if (ret == RET_OK) {
     widget_dispatch(widget, &e);
@@ -1009,6 +1047,7 @@ ret_t widget_restack(widget_t* widget, uint32_t index) {
     }
   }
   children[index] = widget;
+  widget_hit_grid_invalidate(widget->parent);
 
   return RET_OK;
 }
@@ -1253,7 +1292,7 @@ uint32_t widget_on_with_tag(widget_t* widget, uint32_t type, event_func_t on_eve
                             uint32_t tag) {
   return_value_if_fail(widget != NULL && on_event != NULL, RET_BAD_PARAMS);
   if (widget->emitter == NULL) {
-    widget->emitter = emitter_create();
+    widget->emitter = widget_pool_create_emitter();
   }
 
   return emitter_on_with_tag(widget->emitter, type, on_event, ctx, tag);
@@ -1623,6 +1662,59 @@ ret_t widget_paint_helper(widget_t* widget, canvas_t* c, const char* icon, wstr_
   return RET_OK;
 }
 
+static ret_t widget_paint_content(widget_t* widget, canvas_t* c) {
+  widget_on_paint_begin(widget, c);
+  widget_on_paint_background(widget, c);
+  widget_on_paint_self(widget, c);
+  widget_on_paint_children(widget, c);
+  widget_on_paint_border(widget, c);
+  widget_on_paint_end(widget, c);
+
+  return RET_OK;
+}
+
+/*图层无效时先把控件绘制到图层中，然后绘制图层的位图。失败时返回RET_FAIL，由调用者直接绘制控件。*/
+static ret_t widget_paint_with_layer(widget_t* widget, canvas_t* c) {
+  rect_t src;
+  rect_t dst;
+  int32_t ox = widget->x;
+  int32_t oy = widget->y;
+  uint8_t save_alpha = c->global_alpha;
+  bitmap_t* img = widget_layer_get_bitmap(widget);
+
+  if (img == NULL) {
+    canvas_t* oc = widget_layer_begin_update(widget, c);
+    if (oc == NULL) {
+      return RET_FAIL;
+    }
+
+    widget_paint_content(widget, oc);
+    img = widget_layer_end_update(widget);
+    return_value_if_fail(img != NULL, RET_FAIL);
+  }
+
+  if (widget->opacity < TK_OPACITY_ALPHA) {
+    canvas_set_global_alpha(c, (widget->opacity * save_alpha) / 0xff);
+  }
+
+  if (widget->astyle != NULL) {
+    ox += style_get_int(widget->astyle, STYLE_ID_X_OFFSET, 0);
+    oy += style_get_int(widget->astyle, STYLE_ID_Y_OFFSET, 0);
+  }
+
+  src = rect_init(0, 0, img->w, img->h);
+  dst = rect_init(ox, oy, widget->w, widget->h);
+  canvas_draw_image(c, img, &src, &dst);
+
+  if (widget->opacity < TK_OPACITY_ALPHA) {
+    canvas_set_global_alpha(c, save_alpha);
+  }
+
+  widget_on_paint_done(widget, c);
+
+  return RET_OK;
+}
+
 static ret_t widget_paint_impl(widget_t* widget, canvas_t* c) {
   int32_t ox = widget->x;
   int32_t oy = widget->y;
@@ -1638,13 +1730,7 @@ static ret_t widget_paint_impl(widget_t* widget, canvas_t* c) {
   }
 
   canvas_translate(c, ox, oy);
-  widget_on_paint_begin(widget, c);
-  widget_on_paint_background(widget, c);
-  widget_on_paint_self(widget, c);
-  widget_on_paint_children(widget, c);
-  widget_on_paint_border(widget, c);
-  widget_on_paint_end(widget, c);
-
+  widget_paint_content(widget, c);
   canvas_untranslate(c, ox, oy);
   if (widget->opacity < TK_OPACITY_ALPHA) {
     canvas_set_global_alpha(c, save_alpha);
@@ -1668,7 +1754,9 @@ ret_t widget_paint(widget_t* widget, canvas_t* c) {
   }
 
   canvas_save(c);
-  widget_paint_impl(widget, c);
+  if (!widget->cache || widget_paint_with_layer(widget, c) != RET_OK) {
+    widget_paint_impl(widget, c);
+  }
   canvas_restore(c);
 
   widget->dirty = FALSE;
@@ -1819,13 +1907,19 @@ static ret_t widget_free_code(void* ctx, event_t* evt) {
   return RET_REMOVE;
 }
 
-ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
+static bool_t widget_need_prop_event(widget_t* widget) {
+  /*没有事件处理函数时，不需要分发属性变化事件。*/
+  return widget->emitter != NULL ||
+         (widget->vt->on_event != NULL && widget->vt->on_event != widget_on_event_default);
+}
+
+static ret_t widget_set_prop_impl(widget_t* widget, widget_prop_id_t id, const char* name,
+                                  const value_t* v) {
   ret_t ret = RET_OK;
   prop_change_event_t e;
-  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
-  return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
+  bool_t need_event = widget_need_prop_event(widget);
 
-  if (tk_str_eq(name, WIDGET_PROP_EXEC)) {
+  if (id == WIDGET_PROP_ID_EXEC) {
     ret = widget_exec(widget, value_str(v));
     if (ret != RET_NOT_FOUND) {
       return ret;
@@ -1835,71 +1929,136 @@ ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
   e.value = v;
   e.name = name;
   e.e = event_init(EVT_PROP_WILL_CHANGE, widget);
-  widget_dispatch(widget, (event_t*)&e);
+  if (need_event) {
+    widget_dispatch(widget, (event_t*)&e);
+  }
 
-  if (tk_str_eq(name, WIDGET_PROP_X)) {
-    widget->x = (wh_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_Y)) {
-    widget->y = (wh_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_W)) {
-    widget->w = (wh_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_H)) {
-    widget->h = (wh_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_OPACITY)) {
-    widget->opacity = (uint8_t)value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_VISIBLE)) {
-    widget_set_visible(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_SENSITIVE)) {
-    widget->sensitive = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_FLOATING)) {
-    widget->floating = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_FOCUSABLE)) {
-    widget->focusable = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_WITH_FOCUS_STATE)) {
-    widget->with_focus_state = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_DIRTY_RECT_TOLERANCE)) {
-    widget->dirty_rect_tolerance = value_int(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_STYLE)) {
-    const char* name = value_str(v);
-    return widget_use_style(widget, name);
-  } else if (tk_str_eq(name, WIDGET_PROP_ENABLE)) {
-    widget_set_enable(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_FEEDBACK)) {
-    widget->feedback = value_bool(v);
-  } else if (tk_str_eq(name, WIDGET_PROP_AUTO_ADJUST_SIZE)) {
-    widget_set_auto_adjust_size(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_NAME)) {
-    widget_set_name(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_TR_TEXT)) {
-    widget_set_tr_text(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_ANIMATION)) {
-    widget_set_animation(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_SELF_LAYOUT)) {
-    widget_set_self_layout(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_LAYOUT) || tk_str_eq(name, WIDGET_PROP_CHILDREN_LAYOUT)) {
-    widget_set_children_layout(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_POINTER_CURSOR)) {
-    widget_set_pointer_cursor(widget, value_str(v));
-  } else {
-    ret = RET_NOT_FOUND;
+  switch (id) {
+    case WIDGET_PROP_ID_X: {
+      widget->x = (wh_t)value_int(v);
+      widget_hit_grid_invalidate(widget->parent);
+      break;
+    }
+    case WIDGET_PROP_ID_Y: {
+      widget->y = (wh_t)value_int(v);
+      widget_hit_grid_invalidate(widget->parent);
+      break;
+    }
+    case WIDGET_PROP_ID_W: {
+      widget->w = (wh_t)value_int(v);
+      widget_hit_grid_invalidate(widget->parent);
+      break;
+    }
+    case WIDGET_PROP_ID_H: {
+      widget->h = (wh_t)value_int(v);
+      widget_hit_grid_invalidate(widget->parent);
+      break;
+    }
+    case WIDGET_PROP_ID_OPACITY: {
+      widget->opacity = (uint8_t)value_int(v);
+      break;
+    }
+    case WIDGET_PROP_ID_VISIBLE: {
+      widget_set_visible(widget, value_bool(v));
+      break;
+    }
+    case WIDGET_PROP_ID_SENSITIVE: {
+      widget->sensitive = value_bool(v);
+      break;
+    }
+    case WIDGET_PROP_ID_FLOATING: {
+      widget->floating = value_bool(v);
+      break;
+    }
+    case WIDGET_PROP_ID_FOCUSABLE: {
+      widget->focusable = value_bool(v);
+      break;
+    }
+    case WIDGET_PROP_ID_WITH_FOCUS_STATE: {
+      widget->with_focus_state = value_bool(v);
+      break;
+    }
+    case WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE: {
+      widget->dirty_rect_tolerance = value_int(v);
+      break;
+    }
+    case WIDGET_PROP_ID_STYLE: {
+      return widget_use_style(widget, value_str(v));
+    }
+    case WIDGET_PROP_ID_ENABLE: {
+      widget_set_enable(widget, value_bool(v));
+      break;
+    }
+    case WIDGET_PROP_ID_FEEDBACK: {
+      widget->feedback = value_bool(v);
+      break;
+    }
+    case WIDGET_PROP_ID_AUTO_ADJUST_SIZE: {
+      widget_set_auto_adjust_size(widget, value_bool(v));
+      break;
+    }
+    case WIDGET_PROP_ID_NAME: {
+      widget_set_name(widget, value_str(v));
+      break;
+    }
+    case WIDGET_PROP_ID_TR_TEXT: {
+      widget_set_tr_text(widget, value_str(v));
+      break;
+    }
+    case WIDGET_PROP_ID_ANIMATION: {
+      widget_set_animation(widget, value_str(v));
+      break;
+    }
+    case WIDGET_PROP_ID_SELF_LAYOUT: {
+      widget_set_self_layout(widget, value_str(v));
+      break;
+    }
+    case WIDGET_PROP_ID_LAYOUT:
+    case WIDGET_PROP_ID_CHILDREN_LAYOUT: {
+      widget_set_children_layout(widget, value_str(v));
+      break;
+    }
+    case WIDGET_PROP_ID_POINTER_CURSOR: {
+      widget_set_pointer_cursor(widget, value_str(v));
+      break;
+    }
+    default: {
+      ret = RET_NOT_FOUND;
+      break;
+    }
   }
 
-  if (widget->vt->set_prop) {
-    ret_t ret1 = widget->vt->set_prop(widget, name, v);
+  if (widget->vt->set_prop_by_id != NULL || widget->vt->set_prop != NULL) {
+    ret_t ret1 = RET_NOT_FOUND;
+
+    if (widget->vt->set_prop_by_id != NULL && id != WIDGET_PROP_ID_NONE) {
+      ret1 = widget->vt->set_prop_by_id(widget, id, v);
+    }
+
+    if (ret1 == RET_NOT_FOUND && widget->vt->set_prop != NULL) {
+      ret1 = widget->vt->set_prop(widget, name, v);
+    }
+
     if (ret == RET_NOT_FOUND) {
       ret = ret1;
     }
   }
 
   if (ret == RET_NOT_FOUND) {
-    if (tk_str_eq(name, WIDGET_PROP_FOCUSED) || tk_str_eq(name, WIDGET_PROP_FOCUS)) {
+    if (id == WIDGET_PROP_ID_FOCUSED || id == WIDGET_PROP_ID_FOCUS) {
       widget_set_focused(widget, value_bool(v));
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_TEXT)) {
+    } else if (id == WIDGET_PROP_ID_TEXT) {
       wstr_from_value(&(widget->text), v);
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_EXEC)) {
+    } else if (id == WIDGET_PROP_ID_EXEC) {
       ret = RET_NOT_FOUND;
+    } else if (tk_str_eq(name, WIDGET_PROP_CACHE)) {
+      widget_set_cache(widget, value_bool(v));
+      ret = RET_OK;
+    } else if (tk_str_eq(name, WIDGET_PROP_HIT_GRID)) {
+      widget_set_hit_grid(widget, value_bool(v));
+      ret = RET_OK;
     } else if (tk_str_start_with(name, "style:")) {
       return widget_set_style(widget, name + 6, v);
     } else {
@@ -1907,7 +2066,7 @@ ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
         widget->custom_props = object_default_create();
       }
 
-      if (tk_str_eq(name, WIDGET_PROP_GRAB_KEYS)) {
+      if (id == WIDGET_PROP_ID_GRAB_KEYS) {
         window_manager_t* wm = WINDOW_MANAGER(widget_get_window_manager(widget));
 
         if (value_bool(v)) {
@@ -1942,95 +2101,166 @@ ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
   }
 
   if (ret != RET_NOT_FOUND) {
-    e.e.type = EVT_PROP_CHANGED;
-    widget_dispatch(widget, (event_t*)&e);
+    /*设置属性的过程中可能注册了事件处理函数(如on:click)*/
+    if (need_event || widget_need_prop_event(widget)) {
+      e.e.type = EVT_PROP_CHANGED;
+      widget_dispatch(widget, (event_t*)&e);
+    }
     widget_invalidate(widget, NULL);
   }
 
   return ret;
 }
 
-ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v) {
-  ret_t ret = RET_OK;
+ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v) {
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
   return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_X)) {
-    value_set_int32(v, widget->x);
-  } else if (tk_str_eq(name, WIDGET_PROP_Y)) {
-    value_set_int32(v, widget->y);
-  } else if (tk_str_eq(name, WIDGET_PROP_W)) {
-    value_set_int32(v, widget->w);
-  } else if (tk_str_eq(name, WIDGET_PROP_H)) {
-    value_set_int32(v, widget->h);
-  } else if (tk_str_eq(name, WIDGET_PROP_OPACITY)) {
-    value_set_int32(v, widget->opacity);
-  } else if (tk_str_eq(name, WIDGET_PROP_VISIBLE)) {
-    value_set_bool(v, widget->visible);
-  } else if (tk_str_eq(name, WIDGET_PROP_SENSITIVE)) {
-    value_set_bool(v, widget->sensitive);
-  } else if (tk_str_eq(name, WIDGET_PROP_FLOATING)) {
-    value_set_bool(v, widget->floating);
-  } else if (tk_str_eq(name, WIDGET_PROP_FOCUSABLE)) {
-    value_set_bool(v, widget_is_focusable(widget));
-  } else if (tk_str_eq(name, WIDGET_PROP_FOCUSED)) {
-    value_set_bool(v, widget->focused);
-  } else if (tk_str_eq(name, WIDGET_PROP_WITH_FOCUS_STATE)) {
-    value_set_bool(v, widget->with_focus_state);
-  } else if (tk_str_eq(name, WIDGET_PROP_DIRTY_RECT_TOLERANCE)) {
-    value_set_int(v, widget->dirty_rect_tolerance);
-  } else if (tk_str_eq(name, WIDGET_PROP_STYLE)) {
-    value_set_str(v, widget->style);
-  } else if (tk_str_eq(name, WIDGET_PROP_ENABLE)) {
-    value_set_bool(v, widget->enable);
-  } else if (tk_str_eq(name, WIDGET_PROP_FEEDBACK)) {
-    value_set_bool(v, widget->feedback);
-  } else if (tk_str_eq(name, WIDGET_PROP_AUTO_ADJUST_SIZE)) {
-    value_set_bool(v, widget->auto_adjust_size);
-  } else if (tk_str_eq(name, WIDGET_PROP_NAME)) {
-    value_set_str(v, widget->name);
-  } else if (tk_str_eq(name, WIDGET_PROP_ANIMATION)) {
-    value_set_str(v, widget->animation);
-  } else if (tk_str_eq(name, WIDGET_PROP_POINTER_CURSOR)) {
-    value_set_str(v, widget->pointer_cursor);
-  } else if (tk_str_eq(name, WIDGET_PROP_SELF_LAYOUT)) {
-    if (widget->self_layout != NULL) {
-      value_set_str(v, self_layouter_to_string(widget->self_layout));
-    } else {
-      ret = RET_NOT_FOUND;
+  return widget_set_prop_impl(widget, widget_prop_id_from_name(name), name, v);
+}
+
+ret_t widget_set_prop_by_id(widget_t* widget, widget_prop_id_t id, const value_t* v) {
+  const char* name = widget_prop_id_to_name(id);
+  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
+
+  return widget_set_prop_impl(widget, id, name, v);
+}
+
+static ret_t widget_get_prop_impl(widget_t* widget, widget_prop_id_t id, const char* name,
+                                  value_t* v) {
+  ret_t ret = RET_OK;
+
+  switch (id) {
+    case WIDGET_PROP_ID_X: {
+      value_set_int32(v, widget->x);
+      break;
     }
-  } else if (tk_str_eq(name, WIDGET_PROP_CHILDREN_LAYOUT)) {
-    if (widget->children_layout != NULL) {
-      value_set_str(v, children_layouter_to_string(widget->children_layout));
-    } else {
-      ret = RET_NOT_FOUND;
+    case WIDGET_PROP_ID_Y: {
+      value_set_int32(v, widget->y);
+      break;
     }
-  } else {
-    if (widget->vt->get_prop) {
-      ret = widget->vt->get_prop(widget, name, v);
-    } else {
+    case WIDGET_PROP_ID_W: {
+      value_set_int32(v, widget->w);
+      break;
+    }
+    case WIDGET_PROP_ID_H: {
+      value_set_int32(v, widget->h);
+      break;
+    }
+    case WIDGET_PROP_ID_OPACITY: {
+      value_set_int32(v, widget->opacity);
+      break;
+    }
+    case WIDGET_PROP_ID_VISIBLE: {
+      value_set_bool(v, widget->visible);
+      break;
+    }
+    case WIDGET_PROP_ID_SENSITIVE: {
+      value_set_bool(v, widget->sensitive);
+      break;
+    }
+    case WIDGET_PROP_ID_FLOATING: {
+      value_set_bool(v, widget->floating);
+      break;
+    }
+    case WIDGET_PROP_ID_FOCUSABLE: {
+      value_set_bool(v, widget_is_focusable(widget));
+      break;
+    }
+    case WIDGET_PROP_ID_FOCUSED: {
+      value_set_bool(v, widget->focused);
+      break;
+    }
+    case WIDGET_PROP_ID_WITH_FOCUS_STATE: {
+      value_set_bool(v, widget->with_focus_state);
+      break;
+    }
+    case WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE: {
+      value_set_int(v, widget->dirty_rect_tolerance);
+      break;
+    }
+    case WIDGET_PROP_ID_STYLE: {
+      value_set_str(v, widget->style);
+      break;
+    }
+    case WIDGET_PROP_ID_ENABLE: {
+      value_set_bool(v, widget->enable);
+      break;
+    }
+    case WIDGET_PROP_ID_FEEDBACK: {
+      value_set_bool(v, widget->feedback);
+      break;
+    }
+    case WIDGET_PROP_ID_AUTO_ADJUST_SIZE: {
+      value_set_bool(v, widget->auto_adjust_size);
+      break;
+    }
+    case WIDGET_PROP_ID_NAME: {
+      value_set_str(v, widget->name);
+      break;
+    }
+    case WIDGET_PROP_ID_ANIMATION: {
+      value_set_str(v, widget->animation);
+      break;
+    }
+    case WIDGET_PROP_ID_POINTER_CURSOR: {
+      value_set_str(v, widget->pointer_cursor);
+      break;
+    }
+    case WIDGET_PROP_ID_SELF_LAYOUT: {
+      if (widget->self_layout != NULL) {
+        value_set_str(v, self_layouter_to_string(widget->self_layout));
+      } else {
+        ret = RET_NOT_FOUND;
+      }
+      break;
+    }
+    case WIDGET_PROP_ID_CHILDREN_LAYOUT: {
+      if (widget->children_layout != NULL) {
+        value_set_str(v, children_layouter_to_string(widget->children_layout));
+      } else {
+        ret = RET_NOT_FOUND;
+      }
+      break;
+    }
+    default: {
       ret = RET_NOT_FOUND;
+      if (widget->vt->get_prop_by_id != NULL && id != WIDGET_PROP_ID_NONE) {
+        ret = widget->vt->get_prop_by_id(widget, id, v);
+      }
+
+      if (ret == RET_NOT_FOUND && widget->vt->get_prop != NULL) {
+        ret = widget->vt->get_prop(widget, name, v);
+      }
+      break;
     }
   }
 
   /*default*/
   if (ret == RET_NOT_FOUND) {
-    if (tk_str_eq(name, WIDGET_PROP_LAYOUT_W)) {
+    if (id == WIDGET_PROP_ID_LAYOUT_W) {
       value_set_int32(v, widget->w);
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_LAYOUT_H)) {
+    } else if (id == WIDGET_PROP_ID_LAYOUT_H) {
       value_set_int32(v, widget->h);
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_TEXT)) {
+    } else if (id == WIDGET_PROP_ID_TEXT) {
       wchar_t* text = widget->text.str;
       if (text != NULL) {
         text[widget->text.size] = 0;
       }
       value_set_wstr(v, text);
       ret = RET_OK;
-    } else if (tk_str_eq(name, WIDGET_PROP_STATE_FOR_STYLE)) {
+    } else if (id == WIDGET_PROP_ID_STATE_FOR_STYLE) {
       value_set_str(v, widget_get_state_for_style(widget, FALSE, FALSE));
       ret = RET_OK;
+    } else if (tk_str_eq(name, WIDGET_PROP_CACHE)) {
+      value_set_bool(v, widget->cache);
+      ret = RET_OK;
+    } else if (tk_str_eq(name, WIDGET_PROP_HIT_GRID)) {
+      value_set_bool(v, widget->hit_grid);
+      ret = RET_OK;
     }
   }
 
@@ -2041,7 +2271,7 @@ ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v) {
   }
 
   if (ret == RET_NOT_FOUND) {
-    if (tk_str_eq(name, WIDGET_PROP_TYPE)) {
+    if (id == WIDGET_PROP_ID_TYPE) {
       value_set_str(v, widget->vt->type);
       ret = RET_OK;
     }
@@ -2050,6 +2280,21 @@ ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v) {
   return ret;
 }
 
+ret_t widget_get_prop(widget_t* widget, const char* name, value_t* v) {
+  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
+
+  return widget_get_prop_impl(widget, widget_prop_id_from_name(name), name, v);
+}
+
+ret_t widget_get_prop_by_id(widget_t* widget, widget_prop_id_t id, value_t* v) {
+  const char* name = widget_prop_id_to_name(id);
+  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(widget->vt != NULL, RET_BAD_PARAMS);
+
+  return widget_get_prop_impl(widget, id, name, v);
+}
+
 ret_t widget_set_prop_str(widget_t* widget, const char* name, const char* str) {
   value_t v;
   value_set_str(&v, str);
@@ -3116,7 +3361,7 @@ static ret_t widget_destroy_sync(widget_t* widget) {
 
   if (widget->emitter != NULL) {
     widget_dispatch(widget, &e);
-    emitter_destroy(widget->emitter);
+    widget_pool_destroy_emitter(widget->emitter);
     widget->emitter = NULL;
   }
 
@@ -3136,6 +3381,14 @@ static ret_t widget_destroy_sync(widget_t* widget) {
     widget->self_layout = NULL;
   }
 
+  if (widget->layer != NULL) {
+    widget_layer_destroy(widget);
+  }
+
+  if (widget->grid != NULL) {
+    widget_hit_grid_destroy(widget);
+  }
+
   widget->destroying = FALSE;
 
   return widget_real_destroy(widget);
@@ -3249,6 +3502,7 @@ widget_t* widget_init(widget_t* widget, widget_t* parent, const widget_vtable_t*
   widget->with_focus_state = FALSE;
   widget->dirty_rect_tolerance = 4;
   widget->need_update_style = TRUE;
+  widget->need_relayout = TRUE;
 
   if (parent) {
     widget_add_child(parent, widget);
@@ -3320,6 +3574,10 @@ ret_t widget_get_prop_default_value(widget_t* widget, const char* name, value_t*
     value_set_bool(v, FALSE);
   } else if (tk_str_eq(name, WIDGET_PROP_FEEDBACK)) {
     value_set_bool(v, FALSE);
+  } else if (tk_str_eq(name, WIDGET_PROP_CACHE)) {
+    value_set_bool(v, FALSE);
+  } else if (tk_str_eq(name, WIDGET_PROP_HIT_GRID)) {
+    value_set_bool(v, FALSE);
   } else if (tk_str_eq(name, WIDGET_PROP_AUTO_ADJUST_SIZE)) {
     value_set_bool(v, FALSE);
   } else {
@@ -3461,6 +3719,8 @@ static const char* const s_widget_persistent_props[] = {WIDGET_PROP_NAME,
                                                         WIDGET_PROP_OPACITY,
                                                         WIDGET_PROP_FOCUSED,
                                                         WIDGET_PROP_FEEDBACK,
+                                                        WIDGET_PROP_CACHE,
+                                                        WIDGET_PROP_HIT_GRID,
                                                         WIDGET_PROP_AUTO_ADJUST_SIZE,
                                                         WIDGET_PROP_FOCUSABLE,
                                                         WIDGET_PROP_SENSITIVE,
@@ -3489,6 +3749,8 @@ static ret_t widget_copy_base_props(widget_t* widget, widget_t* other) {
   widget->floating = other->floating;
   widget->opacity = other->opacity;
   widget->feedback = other->feedback;
+  widget->cache = other->cache;
+  widget->hit_grid = other->hit_grid;
   widget->auto_adjust_size = other->auto_adjust_size;
   widget->focusable = other->focusable;
   widget->sensitive = other->sensitive;
@@ -3661,6 +3923,40 @@ ret_t widget_load_image(widget_t* widget, const char* name, bitmap_t* bitmap) {
   return image_manager_get_bitmap(imm, name, bitmap);
 }
 
+static ret_t widget_on_image_loaded(void* ctx, const char* name, ret_t result) {
+  widget_t* widget = WIDGET(ctx);
+
+  /*解码失败时保持占位内容，不必重绘。*/
+  if (result == RET_OK) {
+    widget_invalidate_force(widget, NULL);
+  }
+  widget_unref(widget);
+
+  return RET_OK;
+}
+
+ret_t widget_load_image_async(widget_t* widget, const char* name, bitmap_t* bitmap) {
+  ret_t ret = RET_OK;
+  image_manager_t* imm = widget_get_image_manager(widget);
+
+  return_value_if_fail(imm != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(widget != NULL && name != NULL && bitmap != NULL, RET_BAD_PARAMS);
+
+  /*正在解码时每次绘制都会请求，只在第一次注册时增加引用。*/
+  if (image_manager_is_async_loading(imm, name, widget_on_image_loaded, widget)) {
+    return RET_BUSY;
+  }
+
+  /*解码完成前控件可能被销毁，在回调函数中释放引用。*/
+  widget_ref(widget);
+  ret = image_manager_get_bitmap_async(imm, name, bitmap, widget_on_image_loaded, widget);
+  if (ret != RET_BUSY) {
+    widget_unref(widget);
+  }
+
+  return ret;
+}
+
 ret_t widget_unload_image(widget_t* widget, bitmap_t* bitmap) {
   image_manager_t* imm = widget_get_image_manager(widget);
 
@@ -4189,11 +4485,38 @@ bool_t widget_is_window_manager(widget_t* widget) {
   return widget->vt->is_window_manager;
 }
 
+static bool_t widget_layout_depends_on_children(widget_t* widget) {
+  return widget->auto_adjust_size || widget->children_layout != NULL ||
+         widget->vt->on_layout_children != NULL;
+}
+
 ret_t widget_set_need_relayout(widget_t* widget) {
-  widget_t* win = widget_get_window(widget);
-  if (win != NULL) {
-    return window_base_set_need_relayout(win, TRUE);
+  widget_t* iter = NULL;
+  bool_t propagate = TRUE;
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  widget->need_relayout = TRUE;
+  for (iter = widget; iter->parent != NULL && !widget_is_window(iter); iter = iter->parent) {
+    widget_t* parent = iter->parent;
+
+    /*父控件的布局依赖子控件的大小，父控件也需要重新布局，父控件自动调整大小时继续向上传递。*/
+    if (propagate && widget_layout_depends_on_children(parent)) {
+      parent->need_relayout = TRUE;
+      propagate = parent->auto_adjust_size;
+    } else {
+      propagate = FALSE;
+    }
+
+    parent->child_need_relayout = TRUE;
   }
+
+  if (widget_is_window(iter)) {
+    window_base_t* win = WINDOW_BASE(iter);
+    if (win != NULL) {
+      win->need_relayout = TRUE;
+    }
+  }
+
   return RET_OK;
 }
 
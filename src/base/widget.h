@@ -43,6 +43,7 @@
 #include "base/locale_info.h"
 #include "base/image_manager.h"
 #include "base/widget_consts.h"
+#include "base/widget_prop_id.h"
 #include "base/self_layouter.h"
 #include "base/widget_animator.h"
 #include "base/children_layouter.h"
@@ -78,6 +79,9 @@ typedef ret_t (*widget_auto_adjust_size_t)(widget_t* widget);
 typedef ret_t (*widget_get_prop_t)(widget_t* widget, const char* name, value_t* v);
 typedef ret_t (*widget_get_prop_default_value_t)(widget_t* widget, const char* name, value_t* v);
 typedef ret_t (*widget_set_prop_t)(widget_t* widget, const char* name, const value_t* v);
+typedef ret_t (*widget_get_prop_by_id_t)(widget_t* widget, widget_prop_id_t id, value_t* v);
+typedef ret_t (*widget_set_prop_by_id_t)(widget_t* widget, widget_prop_id_t id,
+                                         const value_t* v);
 typedef ret_t (*widget_on_copy_t)(widget_t* widget, widget_t* other);
 typedef bool_t (*widget_is_point_in_t)(widget_t* widget, xy_t x, xy_t y);
 typedef widget_t* (*widget_find_target_t)(widget_t* widget, xy_t x, xy_t y);
@@ -165,6 +169,11 @@ struct _widget_vtable_t {
   widget_create_t create;
   widget_get_prop_t get_prop;
   widget_set_prop_t set_prop;
+  /**
+   * 按ID访问常用属性(可选)。返回RET_NOT_FOUND时，再调用get_prop/set_prop。
+   */
+  widget_get_prop_by_id_t get_prop_by_id;
+  widget_set_prop_by_id_t set_prop_by_id;
   widget_invalidate_t invalidate;
   widget_find_target_t find_target;
   widget_is_point_in_t is_point_in;
@@ -364,6 +373,24 @@ struct _widget_t {
    */
   uint8_t auto_adjust_size : 1;
 
+  /**
+   * @property {bool_t} cache
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 是否把控件(包括子控件)缓存到图层的位图中，内容没有变化时直接绘制位图。
+   *
+   *> 适合内容复杂但很少变化的控件，请参考[widget\_layer](widget_layer_t.md)。
+   */
+  uint8_t cache : 1;
+
+  /**
+   * @property {bool_t} hit_grid
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 是否为子控件建立网格索引，加快查找指针所在的子控件。
+   *
+   *> 适合子控件很多的容器，请参考[widget\_hit\_grid](widget_hit_grid_t.md)。
+   */
+  uint8_t hit_grid : 1;
+
   /**
    * @property {bool_t} focused
    * @annotation ["readable"]
@@ -419,6 +446,24 @@ struct _widget_t {
    * 标识控件正在被销毁。
    */
   uint8_t destroying : 1;
+  /**
+   * @property {bool_t} need_relayout
+   * @annotation ["readable"]
+   * 标识控件(包括子控件)需要重新布局。
+   */
+  uint8_t need_relayout : 1;
+  /**
+   * @property {bool_t} child_need_relayout
+   * @annotation ["readable"]
+   * 标识控件的某个后代控件需要重新布局。
+   */
+  uint8_t child_need_relayout : 1;
+  /**
+   * @property {bool_t} pooled
+   * @annotation ["private"]
+   * 控件对象由widget\_pool分配，销毁时放回对象池。
+   */
+  uint8_t pooled : 1;
   /**
    * @property {uint8_t} state
    * @annotation ["readable"]
@@ -521,6 +566,8 @@ struct _widget_t {
   const widget_vtable_t* vt;
   /*private*/
   assets_manager_t* assets_manager;
+  struct _widget_layer_t* layer;
+  struct _widget_hit_grid_t* grid;
 };
 
 /**
@@ -1307,6 +1354,28 @@ ret_t widget_set_enable(widget_t* widget, bool_t enable);
  */
 ret_t widget_set_feedback(widget_t* widget, bool_t feedback);
 
+/**
+ * @method widget_set_cache
+ * 设置控件是否缓存到图层的位图中。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget 控件对象。
+ * @param {bool_t} cache 是否缓存。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_set_cache(widget_t* widget, bool_t cache);
+
+/**
+ * @method widget_set_hit_grid
+ * 设置是否为子控件建立网格索引。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget 控件对象。
+ * @param {bool_t} hit_grid 是否建立网格索引。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_set_hit_grid(widget_t* widget, bool_t hit_grid);
+
 /**
  * @method widget_set_auto_adjust_size
  * 设置控件是否根据子控件和文本自动调整控件自身大小。
@@ -1737,6 +1806,32 @@ ret_t widget_get_prop_default_value(widget_t* widget, const char* name, value_t*
  */
 ret_t widget_set_prop(widget_t* widget, const char* name, const value_t* v);
 
+/**
+ * @method widget_get_prop_by_id
+ * 按ID获取控件常用属性的值。
+ *
+ * > 与widget\_get\_prop功能相同，但不用比较属性名，适合频繁访问的场景。
+ * @param {widget_t*} widget 控件对象。
+ * @param {widget_prop_id_t} id 属性的ID。
+ * @param {value_t*} v 返回属性的值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_get_prop_by_id(widget_t* widget, widget_prop_id_t id, value_t* v);
+
+/**
+ * @method widget_set_prop_by_id
+ * 按ID设置控件常用属性的值。
+ *
+ * > 与widget\_set\_prop功能相同，但不用比较属性名，适合频繁访问的场景(如动画)。
+ * @param {widget_t*} widget 控件对象。
+ * @param {widget_prop_id_t} id 属性的ID。
+ * @param {const value_t*} v 属性的值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_set_prop_by_id(widget_t* widget, widget_prop_id_t id, const value_t* v);
+
 /**
  * @method widget_set_prop_str
  * 设置字符串格式的属性。
@@ -2157,6 +2252,21 @@ ret_t widget_remove_idle(widget_t* widget, uint32_t idle_id);
  */
 ret_t widget_load_image(widget_t* widget, const char* name, bitmap_t* bitmap);
 
+/**
+ * @method widget_load_image_async
+ * 加载图片，如果图片还没有缓存，在后台线程中解码。
+ * 返回的bitmap对象只在当前调用有效，请不保存对bitmap对象的引用。
+ *
+ * > 返回RET\_BUSY时，可以先绘制占位内容，解码完成后控件会被重绘。
+ *
+ * @param {widget_t*} widget 控件对象。
+ * @param {const char*}  name 图片名(不带扩展名)。
+ * @param {bitmap_t*} bitmap 返回图片对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，返回RET_BUSY表示正在解码，否则表示失败。
+ */
+ret_t widget_load_image_async(widget_t* widget, const char* name, bitmap_t* bitmap);
+
 /**
  * @method widget_unload_image
  * 卸载图片。
@@ -2588,6 +2698,17 @@ ret_t widget_layout(widget_t* widget);
  */
 ret_t widget_layout_children(widget_t* widget);
 
+/**
+ * @method widget_layout_if_needed
+ * 只布局需要重新布局的控件(参考widget\_set\_need\_relayout)。
+ *
+ * > 没有被标记的子树直接跳过，窗口绘制前调用。
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layout_if_needed(widget_t* widget);
+
 /**
  * @method widget_set_self_layout
  * 设置控件自己的布局参数。
@@ -2610,6 +2731,30 @@ ret_t widget_set_self_layout(widget_t* widget, const char* params);
  */
 ret_t widget_set_children_layout(widget_t* widget, const char* params);
 
+/**
+ * @method widget_set_self_layouter
+ * 设置控件自己的布局器对象(不用再解析布局参数)。
+ *
+ * > 控件接管layouter，layouter的params需要事先设置好。
+ * @param {widget_t*} widget 控件对象。
+ * @param {self_layouter_t*} layouter 布局器对象，为NULL时清除布局器。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_set_self_layouter(widget_t* widget, self_layouter_t* layouter);
+
+/**
+ * @method widget_set_children_layouter
+ * 设置子控件的布局器对象(不用再解析布局参数)。
+ *
+ * > 控件接管layouter，layouter的params需要事先设置好。
+ * @param {widget_t*} widget 控件对象。
+ * @param {children_layouter_t*} layouter 布局器对象，为NULL时清除布局器。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_set_children_layouter(widget_t* widget, children_layouter_t* layouter);
+
 /**
  * @method widget_set_self_layout_params
  * 设置控件自己的布局(缺省布局器)参数(过时，请用widget\_set\_self\_layout)。
@@ -2783,6 +2928,10 @@ bool_t widget_is_instance_of(widget_t* widget, const widget_vtable_t* vt);
 /**
  * @method widget_set_need_relayout_children
  * 设置控件需要relayout标识。
+ *
+ * > 只标记控件本身，如果父控件的布局依赖子控件的大小，父控件也会被标记。
+ * > 绘制窗口前只重新布局被标记的控件，其它控件保持不变(参考widget\_layout\_if\_needed)。
+ *
  * @param {widget_t*} widget 控件对象。
  *
  *  @return {ret_t} 返回。
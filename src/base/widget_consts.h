@@ -335,6 +335,18 @@ BEGIN_C_DECLS
  */
 #define WIDGET_PROP_FEEDBACK "feedback"
 
+/**
+ * @const WIDGET_PROP_CACHE
+ * 是否缓存到图层的位图中。
+ */
+#define WIDGET_PROP_CACHE "cache"
+
+/**
+ * @const WIDGET_PROP_HIT_GRID
+ * 是否为子控件建立网格索引。
+ */
+#define WIDGET_PROP_HIT_GRID "hit_grid"
+
 /**
  * @const WIDGET_PROP_FLOATING
  * 是否启用floating布局。
@@ -767,6 +779,12 @@ BEGIN_C_DECLS
  */
 #define WIDGET_PROP_DRAW_TYPE "draw_type"
 
+/**
+ * @const WIDGET_PROP_ASYNC_LOAD
+ * 是否在后台线程中解码图片。
+ */
+#define WIDGET_PROP_ASYNC_LOAD "async_load"
+
 /**
  * @const WIDGET_PROP_SELECTABLE
  * 是否可选择。
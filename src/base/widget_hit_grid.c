@@ -0,0 +1,260 @@
+/**
+ * File:   widget_hit_grid.c
+ * Author: AWTK Develop Team
+ * Brief:  grid index of children for hit testing
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "base/widget_hit_grid.h"
+
+static widget_hit_grid_stats_t s_hit_grid_stats;
+
+static ret_t widget_hit_grid_ensure(uint32_t** buff, uint32_t* capacity, uint32_t nr) {
+  if (*capacity < nr) {
+    uint32_t* p = TKMEM_REALLOCT(uint32_t, *buff, nr);
+    return_value_if_fail(p != NULL, RET_OOM);
+
+    *buff = p;
+    *capacity = nr;
+  }
+
+  return RET_OK;
+}
+
+/*计算子控件占用的单元格范围，返回FALSE表示子控件不可能被点中。*/
+static bool_t widget_hit_grid_get_range(widget_hit_grid_t* grid, widget_t* iter, uint32_t* c0,
+                                        uint32_t* r0, uint32_t* c1, uint32_t* r1) {
+  if (iter->w <= 0 || iter->h <= 0) {
+    return FALSE;
+  }
+
+  *c0 = (iter->x - grid->x) / grid->cell_w;
+  *r0 = (iter->y - grid->y) / grid->cell_h;
+  *c1 = (iter->x + iter->w - 1 - grid->x) / grid->cell_w;
+  *r1 = (iter->y + iter->h - 1 - grid->y) / grid->cell_h;
+
+  return TRUE;
+}
+
+static ret_t widget_hit_grid_build(widget_hit_grid_t* grid) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  uint32_t k = 0;
+  uint32_t cells = 0;
+  int32_t bw = 0;
+  int32_t bh = 0;
+  int32_t right = 0;
+  int32_t bottom = 0;
+  uint32_t c = 0, r = 0, c0 = 0, r0 = 0, c1 = 0, r1 = 0;
+  widget_t* widget = grid->widget;
+  uint32_t children_nr = widget_count_children(widget);
+  widget_t** children = children_nr > 0 ? (widget_t**)(widget->children->elms) : NULL;
+
+  s_hit_grid_stats.builds++;
+  grid->valid = TRUE;
+  grid->usable = FALSE;
+  grid->cols = 0;
+  grid->rows = 0;
+  grid->children_nr = children_nr;
+
+  if (children_nr < TK_WIDGET_HIT_GRID_MIN_CHILDREN) {
+    return RET_OK;
+  }
+
+  for (i = 0; i < children_nr; i++) {
+    widget_t* iter = children[i];
+
+    if (iter->vt->is_point_in != NULL) {
+      return RET_OK;
+    }
+
+    if (iter->w <= 0 || iter->h <= 0) {
+      continue;
+    }
+
+    if (n == 0) {
+      grid->x = iter->x;
+      grid->y = iter->y;
+      right = iter->x + iter->w;
+      bottom = iter->y + iter->h;
+    } else {
+      grid->x = tk_min(grid->x, iter->x);
+      grid->y = tk_min(grid->y, iter->y);
+      right = tk_max(right, iter->x + iter->w);
+      bottom = tk_max(bottom, iter->y + iter->h);
+    }
+    n++;
+  }
+
+  grid->usable = TRUE;
+  if (n == 0) {
+    return RET_OK;
+  }
+
+  /*按子控件区域的宽高比划分，平均每个单元格一个子控件。*/
+  bw = right - grid->x;
+  bh = bottom - grid->y;
+  grid->cols = 1;
+  while (grid->cols < TK_WIDGET_HIT_GRID_MAX_CELLS &&
+         (uint64_t)(grid->cols) * grid->cols * bh < (uint64_t)n * bw) {
+    grid->cols++;
+  }
+  grid->rows = tk_min((n + grid->cols - 1) / grid->cols, TK_WIDGET_HIT_GRID_MAX_CELLS);
+  grid->cell_w = (bw + grid->cols - 1) / grid->cols;
+  grid->cell_h = (bh + grid->rows - 1) / grid->rows;
+  grid->cols = (bw + grid->cell_w - 1) / grid->cell_w;
+  grid->rows = (bh + grid->cell_h - 1) / grid->cell_h;
+
+  cells = grid->cols * grid->rows;
+  if (widget_hit_grid_ensure(&(grid->starts), &(grid->starts_capacity), cells + 1) != RET_OK) {
+    grid->usable = FALSE;
+    return RET_OOM;
+  }
+  memset(grid->starts, 0x00, (cells + 1) * sizeof(uint32_t));
+
+  /*第一遍统计每个单元格的子控件个数，第二遍填入子控件的序号。*/
+  for (i = 0; i < children_nr; i++) {
+    if (widget_hit_grid_get_range(grid, children[i], &c0, &r0, &c1, &r1)) {
+      for (r = r0; r <= r1; r++) {
+        for (c = c0; c <= c1; c++) {
+          grid->starts[r * grid->cols + c + 1]++;
+        }
+      }
+    }
+  }
+
+  for (k = 0; k < cells; k++) {
+    grid->starts[k + 1] += grid->starts[k];
+  }
+
+  if (widget_hit_grid_ensure(&(grid->items), &(grid->items_capacity), grid->starts[cells]) !=
+      RET_OK) {
+    grid->usable = FALSE;
+    return RET_OOM;
+  }
+
+  for (i = 0; i < children_nr; i++) {
+    if (widget_hit_grid_get_range(grid, children[i], &c0, &r0, &c1, &r1)) {
+      for (r = r0; r <= r1; r++) {
+        for (c = c0; c <= c1; c++) {
+          grid->items[grid->starts[r * grid->cols + c]++] = i;
+        }
+      }
+    }
+  }
+
+  /*填入后starts[k]变成了第k个单元格的结束位置，恢复为开始位置。*/
+  for (k = cells; k > 0; k--) {
+    grid->starts[k] = grid->starts[k - 1];
+  }
+  grid->starts[0] = 0;
+
+  return RET_OK;
+}
+
+ret_t widget_hit_grid_find_target(widget_t* widget, xy_t x, xy_t y, widget_t** target) {
+  uint32_t c = 0;
+  uint32_t r = 0;
+  uint32_t k = 0;
+  uint32_t cell = 0;
+  widget_t** children = NULL;
+  widget_hit_grid_t* grid = NULL;
+  return_value_if_fail(widget != NULL && target != NULL, RET_BAD_PARAMS);
+
+  *target = NULL;
+  if (!widget->hit_grid) {
+    return RET_FAIL;
+  }
+
+  grid = widget->grid;
+  if (grid == NULL) {
+    grid = TKMEM_ZALLOC(widget_hit_grid_t);
+    return_value_if_fail(grid != NULL, RET_OOM);
+
+    grid->widget = widget;
+    widget->grid = grid;
+  }
+
+  if (!grid->valid || grid->children_nr != widget_count_children(widget)) {
+    widget_hit_grid_build(grid);
+  }
+
+  if (!grid->usable) {
+    return RET_FAIL;
+  }
+
+  s_hit_grid_stats.queries++;
+  if (grid->cols == 0 || x < grid->x || y < grid->y) {
+    return RET_OK;
+  }
+
+  c = (x - grid->x) / grid->cell_w;
+  r = (y - grid->y) / grid->cell_h;
+  if (c >= grid->cols || r >= grid->rows) {
+    return RET_OK;
+  }
+
+  cell = r * grid->cols + c;
+  children = (widget_t**)(widget->children->elms);
+  for (k = grid->starts[cell + 1]; k > grid->starts[cell]; k--) {
+    widget_t* iter = children[grid->items[k - 1]];
+
+    s_hit_grid_stats.tests++;
+    if (!iter->sensitive || !iter->enable) {
+      continue;
+    }
+
+    if (widget_is_point_in(iter, x - iter->x, y - iter->y, TRUE)) {
+      *target = iter;
+      break;
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_hit_grid_invalidate(widget_t* widget) {
+  if (widget != NULL && widget->grid != NULL) {
+    widget->grid->valid = FALSE;
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_hit_grid_destroy(widget_t* widget) {
+  widget_hit_grid_t* grid = NULL;
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  grid = widget->grid;
+  if (grid != NULL) {
+    TKMEM_FREE(grid->starts);
+    TKMEM_FREE(grid->items);
+    TKMEM_FREE(grid);
+    widget->grid = NULL;
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_hit_grid_get_stats(widget_hit_grid_stats_t* stats) {
+  return_value_if_fail(stats != NULL, RET_BAD_PARAMS);
+
+  *stats = s_hit_grid_stats;
+
+  return RET_OK;
+}
@@ -0,0 +1,166 @@
+/**
+ * File:   widget_hit_grid.h
+ * Author: AWTK Develop Team
+ * Brief:  grid index of children for hit testing
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WIDGET_HIT_GRID_H
+#define TK_WIDGET_HIT_GRID_H
+
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+/*子控件少于该个数时，直接遍历子控件比查找网格更快。*/
+#ifndef TK_WIDGET_HIT_GRID_MIN_CHILDREN
+#define TK_WIDGET_HIT_GRID_MIN_CHILDREN 16
+#endif /*TK_WIDGET_HIT_GRID_MIN_CHILDREN*/
+
+/*网格每个方向最多的单元格数。*/
+#ifndef TK_WIDGET_HIT_GRID_MAX_CELLS
+#define TK_WIDGET_HIT_GRID_MAX_CELLS 64
+#endif /*TK_WIDGET_HIT_GRID_MAX_CELLS*/
+
+/**
+ * @class widget_hit_grid_t
+ * 子控件的网格索引。
+ *
+ * 控件的hit\_grid属性为TRUE时，把子控件所在的区域划分为网格，每个单元格按z序记录与之相交的子控件。
+ * widget\_find\_target\_default只需要检查指针所在单元格中的子控件，
+ * 适合子控件很多(如几百个图标或按钮)的容器，结果与遍历全部子控件相同。
+ *
+ * * 网格在子控件移动、改变大小、增加、删除、调整顺序以及布局后标记为无效，下次查找时重新生成。
+ * * 有子控件自定义了is\_point\_in时，无法确定它的范围，仍然遍历全部子控件。
+ * * 直接修改子控件的x/y/w/h(不通过widget\_move等函数)后，需要调用widget\_hit\_grid\_invalidate。
+ */
+typedef struct _widget_hit_grid_t {
+  /**
+   * @property {widget_t*} widget
+   * @annotation ["readable"]
+   * 网格所属的控件。
+   */
+  widget_t* widget;
+  /**
+   * @property {bool_t} valid
+   * @annotation ["readable"]
+   * 网格是否有效。
+   */
+  bool_t valid;
+  /**
+   * @property {bool_t} usable
+   * @annotation ["readable"]
+   * 网格是否可用(子控件太少或有自定义is\_point\_in的子控件时不可用)。
+   */
+  bool_t usable;
+  /**
+   * @property {uint32_t} cols
+   * @annotation ["readable"]
+   * 列数。
+   */
+  uint32_t cols;
+  /**
+   * @property {uint32_t} rows
+   * @annotation ["readable"]
+   * 行数。
+   */
+  uint32_t rows;
+
+  /*private*/
+  int32_t x;
+  int32_t y;
+  int32_t cell_w;
+  int32_t cell_h;
+  uint32_t children_nr;
+  /*第i个单元格的子控件序号为items[starts[i]]到items[starts[i+1]-1]，按z序从低到高排列。*/
+  uint32_t* starts;
+  uint32_t starts_capacity;
+  uint32_t* items;
+  uint32_t items_capacity;
+} widget_hit_grid_t;
+
+/**
+ * @class widget_hit_grid_stats_t
+ * 网格索引的统计信息。
+ */
+typedef struct _widget_hit_grid_stats_t {
+  /**
+   * @property {uint32_t} builds
+   * @annotation ["readable"]
+   * 生成网格的次数。
+   */
+  uint32_t builds;
+  /**
+   * @property {uint32_t} queries
+   * @annotation ["readable"]
+   * 使用网格查找的次数。
+   */
+  uint32_t queries;
+  /**
+   * @property {uint32_t} tests
+   * @annotation ["readable"]
+   * 使用网格查找时，检查子控件的次数。
+   */
+  uint32_t tests;
+} widget_hit_grid_stats_t;
+
+/**
+ * @method widget_hit_grid_find_target
+ * 通过网格查找指定位置的子控件。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件对象。
+ * @param {xy_t} x X坐标(相对于控件)。
+ * @param {xy_t} y Y坐标(相对于控件)。
+ * @param {widget_t**} target 用于返回找到的子控件，没有找到时为NULL。
+ *
+ * @return {ret_t} 返回RET_OK表示查找完成，返回其它值表示网格不可用，需要遍历子控件。
+ */
+ret_t widget_hit_grid_find_target(widget_t* widget, xy_t x, xy_t y, widget_t** target);
+
+/**
+ * @method widget_hit_grid_invalidate
+ * 标识控件的网格无效，下次查找时重新生成。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件对象(可以为NULL)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_hit_grid_invalidate(widget_t* widget);
+
+/**
+ * @method widget_hit_grid_destroy
+ * 销毁控件的网格。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_hit_grid_destroy(widget_t* widget);
+
+/**
+ * @method widget_hit_grid_get_stats
+ * 获取网格索引的统计信息。
+ * @annotation ["static"]
+ * @param {widget_hit_grid_stats_t*} stats 用于返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_hit_grid_get_stats(widget_hit_grid_stats_t* stats);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_HIT_GRID_H*/
@@ -0,0 +1,276 @@
+/**
+ * File:   widget_layer.c
+ * Author: AWTK Develop Team
+ * Brief:  retained render layer of widget
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "base/system_info.h"
+#include "base/canvas_offline.h"
+#include "base/widget_layer.h"
+
+/*按最近绘制的顺序排列持有位图的图层，first为最近绘制的图层。*/
+static widget_layer_t* s_layers_first = NULL;
+static widget_layer_t* s_layers_last = NULL;
+static widget_layer_stats_t s_layer_stats = {0, 0, TK_WIDGET_LAYER_MAX_MEM_SIZE, 0, 0, 0};
+
+static void widget_layer_unlink(widget_layer_t* layer) {
+  if (layer->prev != NULL) {
+    layer->prev->next = layer->next;
+  } else {
+    s_layers_first = layer->next;
+  }
+
+  if (layer->next != NULL) {
+    layer->next->prev = layer->prev;
+  } else {
+    s_layers_last = layer->prev;
+  }
+
+  layer->prev = NULL;
+  layer->next = NULL;
+}
+
+static void widget_layer_push_front(widget_layer_t* layer) {
+  layer->prev = NULL;
+  layer->next = s_layers_first;
+
+  if (s_layers_first != NULL) {
+    s_layers_first->prev = layer;
+  } else {
+    s_layers_last = layer;
+  }
+  s_layers_first = layer;
+}
+
+static void widget_layer_touch(widget_layer_t* layer) {
+  if (s_layers_first != layer) {
+    widget_layer_unlink(layer);
+    widget_layer_push_front(layer);
+  }
+}
+
+/*canvas_offline创建和销毁时会修改system_info中LCD的信息，图层长期存在，需要恢复原来的值。*/
+typedef struct _lcd_info_t {
+  uint32_t lcd_w;
+  uint32_t lcd_h;
+  lcd_type_t lcd_type;
+  float_t device_pixel_ratio;
+} lcd_info_t;
+
+static void lcd_info_save(lcd_info_t* saved) {
+  system_info_t* info = system_info();
+
+  saved->lcd_w = info->lcd_w;
+  saved->lcd_h = info->lcd_h;
+  saved->lcd_type = info->lcd_type;
+  saved->device_pixel_ratio = info->device_pixel_ratio;
+}
+
+static void lcd_info_restore(const lcd_info_t* saved) {
+  system_info_t* info = system_info();
+
+  system_info_set_lcd_w(info, saved->lcd_w);
+  system_info_set_lcd_h(info, saved->lcd_h);
+  system_info_set_lcd_type(info, saved->lcd_type);
+  system_info_set_device_pixel_ratio(info, saved->device_pixel_ratio);
+}
+
+static ret_t widget_layer_release(widget_layer_t* layer) {
+  lcd_info_t saved;
+
+  if (layer->canvas != NULL) {
+    lcd_info_save(&saved);
+    canvas_offline_destroy(layer->canvas);
+    lcd_info_restore(&saved);
+
+    widget_layer_unlink(layer);
+    s_layer_stats.nr--;
+    s_layer_stats.mem_size -= layer->mem_size;
+
+    layer->canvas = NULL;
+    layer->mem_size = 0;
+  }
+  layer->valid = FALSE;
+
+  return RET_OK;
+}
+
+/*淘汰最久没有绘制的图层，直到可以再分配size字节，except是正在更新的图层，不能被淘汰。*/
+static bool_t widget_layer_reserve(uint32_t size, widget_layer_t* except) {
+  widget_layer_t* iter = s_layers_last;
+
+  while (iter != NULL && s_layer_stats.mem_size + size > s_layer_stats.max_mem_size) {
+    widget_layer_t* prev = iter->prev;
+
+    if (iter != except) {
+      widget_layer_release(iter);
+      s_layer_stats.evictions++;
+    }
+    iter = prev;
+  }
+
+  return s_layer_stats.mem_size + size <= s_layer_stats.max_mem_size;
+}
+
+static bitmap_format_t widget_layer_get_format(canvas_t* c) {
+#ifdef WITH_NANOVG_GPU
+  return BITMAP_FMT_RGBA8888;
+#else
+  bitmap_format_t format = BITMAP_FMT_RGBA8888;
+
+  if (c->lcd->get_desired_bitmap_format != NULL) {
+    format = lcd_get_desired_bitmap_format(c->lcd);
+  }
+
+  /*图层需要透明度，只使用32位的格式。*/
+  return format == BITMAP_FMT_BGRA8888 ? BITMAP_FMT_BGRA8888 : BITMAP_FMT_RGBA8888;
+#endif /*WITH_NANOVG_GPU*/
+}
+
+ret_t widget_layer_set_max_mem_size(uint32_t max_mem_size) {
+  s_layer_stats.max_mem_size = max_mem_size;
+  widget_layer_reserve(0, NULL);
+
+  return RET_OK;
+}
+
+ret_t widget_layer_get_stats(widget_layer_stats_t* stats) {
+  return_value_if_fail(stats != NULL, RET_BAD_PARAMS);
+
+  *stats = s_layer_stats;
+
+  return RET_OK;
+}
+
+ret_t widget_layer_clear(void) {
+  while (s_layers_first != NULL) {
+    widget_layer_release(s_layers_first);
+  }
+
+  return RET_OK;
+}
+
+bitmap_t* widget_layer_get_bitmap(widget_t* widget) {
+  widget_layer_t* layer = NULL;
+  return_value_if_fail(widget != NULL, NULL);
+
+  layer = widget->layer;
+  if (layer == NULL || !layer->valid || layer->canvas == NULL) {
+    return NULL;
+  }
+
+  widget_layer_touch(layer);
+  s_layer_stats.hits++;
+
+  return canvas_offline_get_bitmap(layer->canvas);
+}
+
+canvas_t* widget_layer_begin_update(widget_t* widget, canvas_t* c) {
+  lcd_info_t saved;
+  uint32_t size = 0;
+  bitmap_t* bitmap = NULL;
+  widget_layer_t* layer = NULL;
+  return_value_if_fail(widget != NULL && c != NULL && c->lcd != NULL, NULL);
+  return_value_if_fail(widget->w > 0 && widget->h > 0, NULL);
+
+  layer = widget->layer;
+  if (layer == NULL) {
+    layer = TKMEM_ZALLOC(widget_layer_t);
+    return_value_if_fail(layer != NULL, NULL);
+
+    layer->widget = widget;
+    widget->layer = layer;
+  }
+
+  s_layer_stats.misses++;
+  layer->valid = FALSE;
+  if (layer->canvas != NULL && (layer->w != widget->w || layer->h != widget->h)) {
+    widget_layer_release(layer);
+  }
+
+  if (layer->canvas == NULL) {
+    /*超过上限的控件不使用图层，也不淘汰其它图层。*/
+    size = widget->w * widget->h * 4;
+    if (size > s_layer_stats.max_mem_size || !widget_layer_reserve(size, layer)) {
+      return NULL;
+    }
+
+    lcd_info_save(&saved);
+    layer->canvas = canvas_offline_create(widget->w, widget->h, widget_layer_get_format(c));
+    lcd_info_restore(&saved);
+    if (layer->canvas == NULL) {
+      return NULL;
+    }
+
+    bitmap = canvas_offline_get_bitmap(layer->canvas);
+    layer->w = widget->w;
+    layer->h = widget->h;
+    layer->mem_size = bitmap->line_length * bitmap->h;
+    s_layer_stats.nr++;
+    s_layer_stats.mem_size += layer->mem_size;
+    widget_layer_push_front(layer);
+  } else {
+    widget_layer_touch(layer);
+  }
+
+  /*绘制子控件时可能调用widget_invalidate，这时图层在下次绘制时重新生成。*/
+  layer->valid = TRUE;
+  canvas_offline_begin_draw(layer->canvas);
+  canvas_offline_clear_canvas(layer->canvas);
+
+  return layer->canvas;
+}
+
+bitmap_t* widget_layer_end_update(widget_t* widget) {
+  bitmap_t* bitmap = NULL;
+  widget_layer_t* layer = NULL;
+  return_value_if_fail(widget != NULL && widget->layer != NULL, NULL);
+
+  layer = widget->layer;
+  return_value_if_fail(layer->canvas != NULL, NULL);
+
+  canvas_offline_end_draw(layer->canvas);
+  bitmap = canvas_offline_get_bitmap(layer->canvas);
+#ifndef WITH_NANOVG_GPU
+  bitmap->flags |= BITMAP_FLAG_CHANGED;
+#endif /*WITH_NANOVG_GPU*/
+
+  return bitmap;
+}
+
+ret_t widget_layer_invalidate(widget_t* widget) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->layer != NULL) {
+    widget->layer->valid = FALSE;
+  }
+
+  return RET_OK;
+}
+
+ret_t widget_layer_destroy(widget_t* widget) {
+  return_value_if_fail(widget != NULL, RET_BAD_PARAMS);
+
+  if (widget->layer != NULL) {
+    widget_layer_release(widget->layer);
+    TKMEM_FREE(widget->layer);
+  }
+
+  return RET_OK;
+}
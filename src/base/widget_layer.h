@@ -0,0 +1,205 @@
+/**
+ * File:   widget_layer.h
+ * Author: AWTK Develop Team
+ * Brief:  retained render layer of widget
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WIDGET_LAYER_H
+#define TK_WIDGET_LAYER_H
+
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+/*全部图层位图占用内存的上限(字节)，定义为0时禁用图层缓存。*/
+#ifndef TK_WIDGET_LAYER_MAX_MEM_SIZE
+#define TK_WIDGET_LAYER_MAX_MEM_SIZE (2 * 1024 * 1024)
+#endif /*TK_WIDGET_LAYER_MAX_MEM_SIZE*/
+
+/**
+ * @class widget_layer_t
+ * 控件的图层。
+ *
+ * 控件的cache属性为TRUE时，控件(包括子控件)先绘制到离线画布(canvas\_offline)中，
+ * 之后每次绘制直接贴图层的位图，直到控件或子控件调用widget\_invalidate(包括状态和样式变化)。
+ *
+ * * 全部图层位图占用的内存不超过widget\_layer\_set\_max\_mem\_size设置的上限，超过时淘汰最久没有绘制的图层。
+ * * 创建离线画布失败或者控件太大时，控件按原来的方式直接绘制。
+ * * 控件绘制到自身区域之外的内容(如阴影)不会保存到图层中。
+ *
+ * > 适合内容复杂但很少变化的控件，经常变化的控件(如有动画的控件)不要启用。
+ */
+typedef struct _widget_layer_t {
+  /**
+   * @property {widget_t*} widget
+   * @annotation ["readable"]
+   * 图层所属的控件。
+   */
+  widget_t* widget;
+  /**
+   * @property {canvas_t*} canvas
+   * @annotation ["readable"]
+   * 离线画布，被淘汰后为NULL。
+   */
+  canvas_t* canvas;
+  /**
+   * @property {uint32_t} mem_size
+   * @annotation ["readable"]
+   * 位图占用的内存(字节)。
+   */
+  uint32_t mem_size;
+  /**
+   * @property {bool_t} valid
+   * @annotation ["readable"]
+   * 位图的内容是否有效。
+   */
+  bool_t valid;
+
+  /*private*/
+  wh_t w;
+  wh_t h;
+  struct _widget_layer_t* prev;
+  struct _widget_layer_t* next;
+} widget_layer_t;
+
+/**
+ * @class widget_layer_stats_t
+ * 图层缓存的统计信息。
+ */
+typedef struct _widget_layer_stats_t {
+  /**
+   * @property {uint32_t} nr
+   * @annotation ["readable"]
+   * 持有位图的图层个数。
+   */
+  uint32_t nr;
+  /**
+   * @property {uint32_t} mem_size
+   * @annotation ["readable"]
+   * 全部图层位图占用的内存(字节)。
+   */
+  uint32_t mem_size;
+  /**
+   * @property {uint32_t} max_mem_size
+   * @annotation ["readable"]
+   * 内存上限(字节)。
+   */
+  uint32_t max_mem_size;
+  /**
+   * @property {uint32_t} hits
+   * @annotation ["readable"]
+   * 直接使用图层绘制的次数。
+   */
+  uint32_t hits;
+  /**
+   * @property {uint32_t} misses
+   * @annotation ["readable"]
+   * 需要重新绘制图层的次数。
+   */
+  uint32_t misses;
+  /**
+   * @property {uint32_t} evictions
+   * @annotation ["readable"]
+   * 因为内存不足淘汰图层的次数。
+   */
+  uint32_t evictions;
+} widget_layer_stats_t;
+
+/**
+ * @method widget_layer_set_max_mem_size
+ * 设置全部图层位图占用内存的上限，超过上限的图层会被淘汰。
+ * @annotation ["static"]
+ * @param {uint32_t} max_mem_size 内存上限(字节)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layer_set_max_mem_size(uint32_t max_mem_size);
+
+/**
+ * @method widget_layer_get_stats
+ * 获取图层缓存的统计信息。
+ * @annotation ["static"]
+ * @param {widget_layer_stats_t*} stats 用于返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layer_get_stats(widget_layer_stats_t* stats);
+
+/**
+ * @method widget_layer_clear
+ * 释放全部图层的位图(如内存不足时)，下次绘制时重新生成。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layer_clear(void);
+
+/**
+ * @method widget_layer_get_bitmap
+ * 获取控件图层的位图，图层无效时返回NULL。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {bitmap_t*} 返回位图对象。
+ */
+bitmap_t* widget_layer_get_bitmap(widget_t* widget);
+
+/**
+ * @method widget_layer_begin_update
+ * 开始重新绘制控件的图层。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件对象。
+ * @param {canvas_t*} c 屏幕画布对象，用于确定位图的格式。
+ *
+ * @return {canvas_t*} 返回已经清除的离线画布，失败(需要直接绘制控件)时返回NULL。
+ */
+canvas_t* widget_layer_begin_update(widget_t* widget, canvas_t* c);
+
+/**
+ * @method widget_layer_end_update
+ * 结束重新绘制控件的图层。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {bitmap_t*} 返回图层的位图。
+ */
+bitmap_t* widget_layer_end_update(widget_t* widget);
+
+/**
+ * @method widget_layer_invalidate
+ * 标识控件图层的内容无效。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layer_invalidate(widget_t* widget);
+
+/**
+ * @method widget_layer_destroy
+ * 销毁控件的图层。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_layer_destroy(widget_t* widget);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_LAYER_H*/
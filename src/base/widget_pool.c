@@ -0,0 +1,193 @@
+/**
+ * File:   widget_pool.c
+ * Author: AWTK Develop Team
+ * Brief:  free lists of widget objects
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "base/widget_pool.h"
+
+/*空闲对象的开头用来链接下一个空闲对象。*/
+typedef struct _widget_pool_node_t {
+  struct _widget_pool_node_t* next;
+} widget_pool_node_t;
+
+typedef struct _widget_pool_list_t {
+  const widget_vtable_t* vt;
+  uint32_t nr;
+  widget_pool_node_t* first;
+  struct _widget_pool_list_t* next;
+} widget_pool_list_t;
+
+static widget_pool_list_t* s_pool_lists = NULL;
+static widget_pool_node_t* s_pool_emitters = NULL;
+static uint32_t s_pool_emitters_nr = 0;
+static widget_pool_stats_t s_pool_stats;
+
+/*控件的种类不多，顺序查找，找到后移到最前面。*/
+static widget_pool_list_t* widget_pool_find_list(const widget_vtable_t* vt, bool_t create) {
+  widget_pool_list_t* iter = s_pool_lists;
+  widget_pool_list_t* prev = NULL;
+
+  while (iter != NULL) {
+    if (iter->vt == vt) {
+      if (prev != NULL) {
+        prev->next = iter->next;
+        iter->next = s_pool_lists;
+        s_pool_lists = iter;
+      }
+      return iter;
+    }
+
+    prev = iter;
+    iter = iter->next;
+  }
+
+  if (create) {
+    iter = TKMEM_ZALLOC(widget_pool_list_t);
+    return_value_if_fail(iter != NULL, NULL);
+
+    iter->vt = vt;
+    iter->next = s_pool_lists;
+    s_pool_lists = iter;
+  }
+
+  return iter;
+}
+
+widget_t* widget_pool_alloc(const widget_vtable_t* vt) {
+  widget_t* widget = NULL;
+  widget_pool_list_t* list = NULL;
+  return_value_if_fail(vt != NULL && vt->size >= sizeof(widget_t), NULL);
+
+  s_pool_stats.allocs++;
+  list = widget_pool_find_list(vt, FALSE);
+  if (list != NULL && list->first != NULL) {
+    widget = (widget_t*)(list->first);
+    list->first = list->first->next;
+    list->nr--;
+
+    s_pool_stats.reuses++;
+    s_pool_stats.cached_nr--;
+    s_pool_stats.cached_size -= vt->size;
+  } else {
+    widget = (widget_t*)TKMEM_ALLOC(vt->size);
+    return_value_if_fail(widget != NULL, NULL);
+  }
+
+  memset(widget, 0x00, vt->size);
+
+  return widget;
+}
+
+ret_t widget_pool_free(widget_t* widget) {
+  widget_pool_node_t* node = NULL;
+  widget_pool_list_t* list = NULL;
+  const widget_vtable_t* vt = NULL;
+  return_value_if_fail(widget != NULL && widget->vt != NULL, RET_BAD_PARAMS);
+
+  vt = widget->vt;
+  memset(widget, 0x00, sizeof(widget_t));
+
+  list = widget_pool_find_list(vt, TK_WIDGET_POOL_MAX_NR > 0);
+  if (list == NULL || list->nr >= TK_WIDGET_POOL_MAX_NR) {
+    TKMEM_FREE(widget);
+    return RET_OK;
+  }
+
+  node = (widget_pool_node_t*)widget;
+  node->next = list->first;
+  list->first = node;
+  list->nr++;
+
+  s_pool_stats.cached_nr++;
+  s_pool_stats.cached_size += vt->size;
+
+  return RET_OK;
+}
+
+emitter_t* widget_pool_create_emitter(void) {
+  emitter_t* emitter = NULL;
+
+  s_pool_stats.emitter_allocs++;
+  if (s_pool_emitters != NULL) {
+    emitter = (emitter_t*)s_pool_emitters;
+    s_pool_emitters = s_pool_emitters->next;
+    s_pool_emitters_nr--;
+    s_pool_stats.emitter_reuses++;
+
+    return emitter_init(emitter);
+  }
+
+  return emitter_create();
+}
+
+ret_t widget_pool_destroy_emitter(emitter_t* emitter) {
+  widget_pool_node_t* node = NULL;
+  return_value_if_fail(emitter != NULL, RET_BAD_PARAMS);
+
+  if (s_pool_emitters_nr >= TK_WIDGET_POOL_MAX_EMITTER_NR) {
+    return emitter_destroy(emitter);
+  }
+
+  emitter_deinit(emitter);
+  node = (widget_pool_node_t*)emitter;
+  node->next = s_pool_emitters;
+  s_pool_emitters = node;
+  s_pool_emitters_nr++;
+
+  return RET_OK;
+}
+
+ret_t widget_pool_clear(void) {
+  widget_pool_node_t* node = NULL;
+  widget_pool_list_t* list = s_pool_lists;
+
+  while (list != NULL) {
+    widget_pool_list_t* next = list->next;
+
+    while (list->first != NULL) {
+      node = list->first;
+      list->first = node->next;
+      TKMEM_FREE(node);
+    }
+    TKMEM_FREE(list);
+
+    list = next;
+  }
+  s_pool_lists = NULL;
+  s_pool_stats.cached_nr = 0;
+  s_pool_stats.cached_size = 0;
+
+  while (s_pool_emitters != NULL) {
+    node = s_pool_emitters;
+    s_pool_emitters = node->next;
+    TKMEM_FREE(node);
+  }
+  s_pool_emitters_nr = 0;
+
+  return RET_OK;
+}
+
+ret_t widget_pool_get_stats(widget_pool_stats_t* stats) {
+  return_value_if_fail(stats != NULL, RET_BAD_PARAMS);
+
+  *stats = s_pool_stats;
+
+  return RET_OK;
+}
@@ -0,0 +1,156 @@
+/**
+ * File:   widget_pool.h
+ * Author: AWTK Develop Team
+ * Brief:  free lists of widget objects
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WIDGET_POOL_H
+#define TK_WIDGET_POOL_H
+
+#include "tkc/emitter.h"
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+/*每种控件缓存的空闲对象个数上限，定义为0时禁用控件对象池。*/
+#ifndef TK_WIDGET_POOL_MAX_NR
+#define TK_WIDGET_POOL_MAX_NR 16
+#endif /*TK_WIDGET_POOL_MAX_NR*/
+
+/*缓存的空闲事件分发器(emitter)个数上限。*/
+#ifndef TK_WIDGET_POOL_MAX_EMITTER_NR
+#define TK_WIDGET_POOL_MAX_EMITTER_NR 32
+#endif /*TK_WIDGET_POOL_MAX_EMITTER_NR*/
+
+/**
+ * @class widget_pool_stats_t
+ * 控件对象池的统计信息。
+ */
+typedef struct _widget_pool_stats_t {
+  /**
+   * @property {uint32_t} allocs
+   * @annotation ["readable"]
+   * 分配控件对象的次数。
+   */
+  uint32_t allocs;
+  /**
+   * @property {uint32_t} reuses
+   * @annotation ["readable"]
+   * 其中重用空闲对象的次数。
+   */
+  uint32_t reuses;
+  /**
+   * @property {uint32_t} emitter_allocs
+   * @annotation ["readable"]
+   * 分配事件分发器的次数。
+   */
+  uint32_t emitter_allocs;
+  /**
+   * @property {uint32_t} emitter_reuses
+   * @annotation ["readable"]
+   * 其中重用空闲事件分发器的次数。
+   */
+  uint32_t emitter_reuses;
+  /**
+   * @property {uint32_t} cached_nr
+   * @annotation ["readable"]
+   * 缓存的空闲控件对象个数。
+   */
+  uint32_t cached_nr;
+  /**
+   * @property {uint32_t} cached_size
+   * @annotation ["readable"]
+   * 缓存的空闲控件对象占用的内存(字节)。
+   */
+  uint32_t cached_size;
+} widget_pool_stats_t;
+
+/**
+ * @class widget_pool_t
+ * @annotation ["fake"]
+ * 控件对象池。
+ *
+ * 按控件的vtable分别保存已经销毁的控件对象(大小为vt->size)，创建同类控件时重用，
+ * 避免频繁创建和销毁控件(如重建列表)时反复分配和释放内存，产生内存碎片。
+ *
+ * * 重用的对象全部清零，与新分配的对象相同。
+ * * 只有widget\_create创建的控件放回对象池，自己分配内存再调用widget\_init的控件直接释放。
+ * * 控件的事件分发器(emitter)也放入对象池重用。
+ */
+
+/**
+ * @method widget_pool_alloc
+ * 分配控件对象(已经清零)。
+ * @annotation ["static"]
+ * @param {const widget_vtable_t*} vt 控件的虚函数表。
+ *
+ * @return {widget_t*} 返回控件对象。
+ */
+widget_t* widget_pool_alloc(const widget_vtable_t* vt);
+
+/**
+ * @method widget_pool_free
+ * 释放控件对象，对象池没有满时放回对象池。
+ * @annotation ["static"]
+ * @param {widget_t*} widget 控件对象(必须是widget\_pool\_alloc分配的，且其它资源已经释放)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_pool_free(widget_t* widget);
+
+/**
+ * @method widget_pool_create_emitter
+ * 创建控件的事件分发器。
+ * @annotation ["static"]
+ *
+ * @return {emitter_t*} 返回事件分发器对象。
+ */
+emitter_t* widget_pool_create_emitter(void);
+
+/**
+ * @method widget_pool_destroy_emitter
+ * 销毁控件的事件分发器，对象池没有满时放回对象池。
+ * @annotation ["static"]
+ * @param {emitter_t*} emitter 事件分发器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_pool_destroy_emitter(emitter_t* emitter);
+
+/**
+ * @method widget_pool_clear
+ * 释放对象池中全部空闲的对象。
+ * @annotation ["static"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_pool_clear(void);
+
+/**
+ * @method widget_pool_get_stats
+ * 获取控件对象池的统计信息。
+ * @annotation ["static"]
+ * @param {widget_pool_stats_t*} stats 用于返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t widget_pool_get_stats(widget_pool_stats_t* stats);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_POOL_H*/
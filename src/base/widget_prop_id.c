@@ -0,0 +1,98 @@
+/**
+ * File:   widget_prop_id.c
+ * Author: AWTK Develop Team
+ * Brief:  widget property ids
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "base/widget_consts.h"
+#include "base/widget_prop_id.h"
+
+/*以ID为下标，同时也是按名称排序的，可以直接二分查找。*/
+static const char* const s_widget_prop_names[WIDGET_PROP_ID_NR] = {
+    NULL,
+    WIDGET_PROP_ANIMATION,
+    WIDGET_PROP_AUTO_ADJUST_SIZE,
+    WIDGET_PROP_CHILDREN_LAYOUT,
+    WIDGET_PROP_DIRTY_RECT_TOLERANCE,
+    WIDGET_PROP_ENABLE,
+    WIDGET_PROP_EXEC,
+    WIDGET_PROP_FEEDBACK,
+    WIDGET_PROP_FLOATING,
+    WIDGET_PROP_FOCUS,
+    WIDGET_PROP_FOCUSABLE,
+    WIDGET_PROP_FOCUSED,
+    WIDGET_PROP_FORMAT,
+    WIDGET_PROP_GRAB_KEYS,
+    WIDGET_PROP_H,
+    WIDGET_PROP_LAYOUT,
+    WIDGET_PROP_LAYOUT_H,
+    WIDGET_PROP_LAYOUT_W,
+    WIDGET_PROP_MAX,
+    WIDGET_PROP_MIN,
+    WIDGET_PROP_NAME,
+    WIDGET_PROP_OPACITY,
+    WIDGET_PROP_POINTER_CURSOR,
+    WIDGET_PROP_REVERSE,
+    WIDGET_PROP_SELF_LAYOUT,
+    WIDGET_PROP_SENSITIVE,
+    WIDGET_PROP_SHOW_TEXT,
+    WIDGET_PROP_STATE_FOR_STYLE,
+    WIDGET_PROP_STEP,
+    WIDGET_PROP_STYLE,
+    WIDGET_PROP_TEXT,
+    WIDGET_PROP_TR_TEXT,
+    WIDGET_PROP_TYPE,
+    WIDGET_PROP_VALUE,
+    WIDGET_PROP_VERTICAL,
+    WIDGET_PROP_VISIBLE,
+    WIDGET_PROP_W,
+    WIDGET_PROP_WITH_FOCUS_STATE,
+    WIDGET_PROP_X,
+    WIDGET_PROP_Y,
+};
+
+widget_prop_id_t widget_prop_id_from_name(const char* name) {
+  int32_t low = WIDGET_PROP_ID_NONE + 1;
+  int32_t high = WIDGET_PROP_ID_NR - 1;
+
+  if (name == NULL) {
+    return WIDGET_PROP_ID_NONE;
+  }
+
+  while (low <= high) {
+    int32_t mid = low + ((high - low) >> 1);
+    int32_t result = strcmp(name, s_widget_prop_names[mid]);
+
+    if (result == 0) {
+      return (widget_prop_id_t)mid;
+    } else if (result > 0) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+
+  return WIDGET_PROP_ID_NONE;
+}
+
+const char* widget_prop_id_to_name(widget_prop_id_t id) {
+  return_value_if_fail(id > WIDGET_PROP_ID_NONE && id < WIDGET_PROP_ID_NR, NULL);
+
+  return s_widget_prop_names[id];
+}
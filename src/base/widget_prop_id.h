@@ -0,0 +1,115 @@
+/**
+ * File:   widget_prop_id.h
+ * Author: AWTK Develop Team
+ * Brief:  widget property ids
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_WIDGET_PROP_ID_H
+#define TK_WIDGET_PROP_ID_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @enum widget_prop_id_t
+ * @prefix WIDGET_PROP_ID_
+ * 常用控件属性的ID。
+ *
+ * 属性名只需要用widget\_prop\_id\_from\_name转换一次，之后用widget\_set\_prop\_by\_id/
+ * widget\_get\_prop\_by\_id访问，不用每次都比较字符串。适用于动画和数据绑定等频繁访问属性的场景。
+ *
+ * > 按属性名的字母顺序排列，增加时请保持顺序。
+ * > 值会随着增加属性而变化，不能直接保存。二进制UI数据中使用ui\_builder\_prop\_id\_to\_wire\_id的编号，
+ * > 新增的属性需要在ui\_builder.c编号表的末尾追加。
+ */
+typedef enum _widget_prop_id_t {
+  /**
+   * @const WIDGET_PROP_ID_NONE
+   * 不是常用属性。
+   */
+  WIDGET_PROP_ID_NONE = 0,
+  WIDGET_PROP_ID_ANIMATION,
+  WIDGET_PROP_ID_AUTO_ADJUST_SIZE,
+  WIDGET_PROP_ID_CHILDREN_LAYOUT,
+  WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE,
+  WIDGET_PROP_ID_ENABLE,
+  WIDGET_PROP_ID_EXEC,
+  WIDGET_PROP_ID_FEEDBACK,
+  WIDGET_PROP_ID_FLOATING,
+  WIDGET_PROP_ID_FOCUS,
+  WIDGET_PROP_ID_FOCUSABLE,
+  WIDGET_PROP_ID_FOCUSED,
+  WIDGET_PROP_ID_FORMAT,
+  WIDGET_PROP_ID_GRAB_KEYS,
+  WIDGET_PROP_ID_H,
+  WIDGET_PROP_ID_LAYOUT,
+  WIDGET_PROP_ID_LAYOUT_H,
+  WIDGET_PROP_ID_LAYOUT_W,
+  WIDGET_PROP_ID_MAX,
+  WIDGET_PROP_ID_MIN,
+  WIDGET_PROP_ID_NAME,
+  WIDGET_PROP_ID_OPACITY,
+  WIDGET_PROP_ID_POINTER_CURSOR,
+  WIDGET_PROP_ID_REVERSE,
+  WIDGET_PROP_ID_SELF_LAYOUT,
+  WIDGET_PROP_ID_SENSITIVE,
+  WIDGET_PROP_ID_SHOW_TEXT,
+  WIDGET_PROP_ID_STATE_FOR_STYLE,
+  WIDGET_PROP_ID_STEP,
+  WIDGET_PROP_ID_STYLE,
+  WIDGET_PROP_ID_TEXT,
+  WIDGET_PROP_ID_TR_TEXT,
+  WIDGET_PROP_ID_TYPE,
+  WIDGET_PROP_ID_VALUE,
+  WIDGET_PROP_ID_VERTICAL,
+  WIDGET_PROP_ID_VISIBLE,
+  WIDGET_PROP_ID_W,
+  WIDGET_PROP_ID_WITH_FOCUS_STATE,
+  WIDGET_PROP_ID_X,
+  WIDGET_PROP_ID_Y,
+  /**
+   * @const WIDGET_PROP_ID_NR
+   * 属性ID的个数。
+   */
+  WIDGET_PROP_ID_NR
+} widget_prop_id_t;
+
+/**
+ * @method widget_prop_id_from_name
+ * 获取属性名对应的ID。
+ * @annotation ["static"]
+ * @param {const char*} name 属性名。
+ *
+ * @return {widget_prop_id_t} 返回属性ID，不是常用属性时返回WIDGET_PROP_ID_NONE。
+ */
+widget_prop_id_t widget_prop_id_from_name(const char* name);
+
+/**
+ * @method widget_prop_id_to_name
+ * 获取属性ID对应的属性名。
+ * @annotation ["static"]
+ * @param {widget_prop_id_t} id 属性ID。
+ *
+ * @return {const char*} 返回属性名，无效的ID返回NULL。
+ */
+const char* widget_prop_id_to_name(widget_prop_id_t id);
+
+END_C_DECLS
+
+#endif /*TK_WIDGET_PROP_ID_H*/
@@ -20,11 +20,19 @@
  */
 
 #include "base/widget_vtable.h"
+#include "base/widget_layer.h"
+#include "base/widget_hit_grid.h"
 #include "tkc/mem.h"
 
 ret_t widget_invalidate_default(widget_t* widget, const rect_t* rect) {
   rect_t t = *rect;
   rect_t* r = &t;
+
+  /*控件或子控件的内容变化时，图层需要重新生成。*/
+  if (widget->layer != NULL) {
+    widget_layer_invalidate(widget);
+  }
+
   if (widget->vt->scrollable) {
     int32_t ox = widget_get_prop_int(widget, WIDGET_PROP_XOFFSET, 0);
     int32_t oy = widget_get_prop_int(widget, WIDGET_PROP_YOFFSET, 0);
@@ -176,6 +184,13 @@ widget_t* widget_find_target_default(widget_t* widget, xy_t x, xy_t y) {
   }
 
   widget_to_local(widget, &p);
+  if (widget->hit_grid) {
+    widget_t* target = NULL;
+    if (widget_hit_grid_find_target(widget, p.x, p.y, &target) == RET_OK) {
+      return target;
+    }
+  }
+
   WIDGET_FOR_EACH_CHILD_BEGIN_R(widget, iter, i)
   if (!iter->sensitive || !iter->enable) {
     continue;
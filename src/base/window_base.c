@@ -50,7 +50,7 @@ ret_t window_base_on_paint_begin(widget_t* widget, canvas_t* c) {
   image_manager_set_assets_manager(imm, am);
 
   if (win->need_relayout) {
-    widget_layout(widget);
+    widget_layout_if_needed(widget);
   }
 
   return RET_OK;
@@ -559,6 +559,9 @@ ret_t window_base_set_need_relayout(widget_t* widget, bool_t need_relayout) {
   return_value_if_fail(win != NULL, RET_BAD_PARAMS);
 
   win->need_relayout = need_relayout;
+  if (need_relayout) {
+    widget->need_relayout = TRUE;
+  }
 
   return RET_OK;
 }
@@ -406,7 +406,7 @@ widget_t* window_base_cast(widget_t* widget);
 
 /**
  * @method window_base_set_need_relayout
- * 设置是否需要relayout
+ * 设置是否需要relayout(整个窗口重新布局)。
  * @param {widget_t*} widget window_base对象。
  * @param {bool_t} need_relayout
  *
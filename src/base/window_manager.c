@@ -23,6 +23,7 @@
 #include "base/canvas.h"
 #include "base/dialog.h"
 #include "base/window.h"
+#include "base/image_manager.h"
 #include "base/dialog_highlighter.h"
 #include "base/input_device_status.h"
 #include "base/window_manager.h"
@@ -266,6 +267,10 @@ ret_t window_manager_paint(widget_t* widget) {
   return_value_if_fail(wm != NULL && wm->vt != NULL, RET_BAD_PARAMS);
   return_value_if_fail(wm->vt->paint != NULL, RET_BAD_PARAMS);
 
+  if (image_manager() != NULL) {
+    image_manager_begin_frame(image_manager());
+  }
+
   return wm->vt->paint(widget);
 }
 
@@ -0,0 +1,670 @@
+/**
+ * File:   blend_simd.c
+ * Author: AWTK Develop Team
+ * Brief:  simd implemented blend/fill operations
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "base/pixel.h"
+#include "blend/blend_simd.h"
+
+#if defined(WITHOUT_BLEND_SIMD)
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BLEND_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BLEND_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(BLEND_SIMD_SSE2) || defined(BLEND_SIMD_NEON)
+#define BLEND_SIMD 1
+#endif /*BLEND_SIMD_SSE2 || BLEND_SIMD_NEON*/
+
+#ifdef BLEND_SIMD
+
+/*
+ * BGRA8888和RGBA8888只是R/B的位置不同，计算公式对各个通道是一样的，
+ * 所以下面统一按BGRA8888的字节顺序处理，源图片的R/B和目标不同时交换一下即可。
+ */
+#define pixel_t pixel_bgra8888_t
+#define pixel_from_rgb pixel_bgra8888_from_rgb
+#define pixel_from_rgba pixel_bgra8888_from_rgba
+#define pixel_to_rgba pixel_bgra8888_to_rgba
+
+#include "pixel_ops.inc"
+
+/*与blend_image.inc中的blend_a相同，用于处理SIMD不方便处理的像素。*/
+static inline void blend_simd_pixel_8888(uint8_t* dst, const uint8_t* src, uint8_t alpha,
+                                         bool_t premulti_alpha, bool_t swap_rb) {
+  rgba_t s;
+  uint8_t a = 0;
+
+  s.r = swap_rb ? src[0] : src[2];
+  s.g = src[1];
+  s.b = swap_rb ? src[2] : src[0];
+  s.a = src[3];
+  a = alpha == 0xff ? s.a : ((s.a * alpha) >> 8);
+
+  if (a > 0xf8) {
+    pixel_bgra8888_t p = pixel_bgra8888_from_rgba(s.r, s.g, s.b, s.a);
+    *(pixel_bgra8888_t*)dst = p;
+  } else if (a > 0x08) {
+    pixel_bgra8888_t d = *(pixel_bgra8888_t*)dst;
+    rgba_t drgba = pixel_bgra8888_to_rgba(d);
+
+    if (drgba.a < 0x08) {
+      pixel_bgra8888_t p = pixel_bgra8888_from_rgba(s.r, s.g, s.b, s.a);
+      *(pixel_bgra8888_t*)dst = p;
+    } else if (premulti_alpha) {
+      if (alpha <= 0xf8) {
+        s.r = (s.r * alpha) >> 8;
+        s.g = (s.g * alpha) >> 8;
+        s.b = (s.b * alpha) >> 8;
+      }
+      *(pixel_bgra8888_t*)dst = blend_rgba_premulti(drgba, s, 0xff - a);
+    } else {
+      *(pixel_bgra8888_t*)dst = blend_rgba(drgba, s, a);
+    }
+  }
+}
+
+/*与blend_image_bgr565_rgba8888.c中的blend_a相同。*/
+static inline void blend_simd_pixel_565(uint16_t* dst, const uint8_t* src, uint8_t alpha,
+                                        bool_t premulti_alpha) {
+  uint8_t sr = src[0];
+  uint8_t sg = src[1];
+  uint8_t sb = src[2];
+  uint8_t sa = src[3];
+  uint8_t a = alpha > 0xf8 ? sa : ((sa * alpha) >> 8);
+
+  if (a > 0xf8) {
+    *dst = ((sr >> 3) << 11) | ((sg >> 2) << 5) | (sb >> 3);
+  } else if (a > 8) {
+    rgba_t rgba = {.a = a, .r = sr, .g = sg, .b = sb};
+    if (premulti_alpha) {
+      rgba.a = 0xff - a;
+      if (alpha <= 0xf8) {
+        rgba.r = (sr * alpha) >> 8;
+        rgba.g = (sg * alpha) >> 8;
+        rgba.b = (sb * alpha) >> 8;
+      }
+      pixel_bgr565_blend_rgba_premulti(dst, rgba);
+    } else {
+      pixel_bgr565_blend_rgba(dst, rgba);
+    }
+  }
+}
+
+static inline void blend_simd_fill_pixel_8888(uint8_t* p, rgba_t rgba, bool_t dark) {
+  if (dark) {
+    pixel_bgra8888_blend_rgba_dark(p, rgba.a);
+  } else {
+    pixel_bgra8888_blend_rgba_premulti(p, rgba);
+  }
+}
+
+static inline void blend_simd_fill_pixel_565(uint16_t* p, rgba_t rgba, bool_t dark) {
+  if (dark) {
+    pixel_bgr565_blend_rgba_dark(p, rgba.a);
+  } else {
+    pixel_bgr565_blend_rgba_premulti(p, rgba);
+  }
+}
+
+#ifdef BLEND_SIMD_SSE2
+/*
+ * 处理两个像素(每个通道16位)。目标是半透明的像素(公式需要除法)通过slow返回，由调用者用C代码处理。
+ */
+static inline __m128i blend_simd_sse2_8888(__m128i d, __m128i s, uint8_t alpha,
+                                           bool_t premulti_alpha, bool_t swap_rb, int* slow) {
+  __m128i a, sa, da, gt8, copy, minus_a, v;
+  const __m128i c08 = _mm_set1_epi16(0x08);
+  const __m128i cf4 = _mm_set1_epi16(0xf4);
+  const __m128i cf8 = _mm_set1_epi16(0xf8);
+  const __m128i cff = _mm_set1_epi16(0xff);
+  const __m128i ca = _mm_set_epi16(0xff, 0, 0, 0, 0xff, 0, 0, 0);
+  const __m128i valpha = _mm_set1_epi16(alpha);
+
+  if (swap_rb) {
+    s = _mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 0, 1, 2));
+    s = _mm_shufflehi_epi16(s, _MM_SHUFFLE(3, 0, 1, 2));
+  }
+
+  sa = _mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3));
+  sa = _mm_shufflehi_epi16(sa, _MM_SHUFFLE(3, 3, 3, 3));
+  da = _mm_shufflelo_epi16(d, _MM_SHUFFLE(3, 3, 3, 3));
+  da = _mm_shufflehi_epi16(da, _MM_SHUFFLE(3, 3, 3, 3));
+  a = alpha == 0xff ? sa : _mm_srli_epi16(_mm_mullo_epi16(sa, valpha), 8);
+
+  gt8 = _mm_cmpgt_epi16(a, c08);
+  copy = _mm_or_si128(_mm_cmpgt_epi16(a, cf8), _mm_and_si128(gt8, _mm_cmplt_epi16(da, c08)));
+  *slow |= _mm_movemask_epi8(_mm_andnot_si128(
+      _mm_or_si128(_mm_cmpgt_epi16(a, cf8),
+                   _mm_or_si128(_mm_cmplt_epi16(da, c08), _mm_cmpgt_epi16(da, cf4))),
+      gt8));
+
+  minus_a = _mm_sub_epi16(cff, a);
+  if (premulti_alpha) {
+    __m128i sc = s;
+    if (alpha <= 0xf8) {
+      sc = _mm_srli_epi16(_mm_mullo_epi16(s, valpha), 8);
+    }
+    v = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(d, minus_a), 8), sc);
+    v = _mm_and_si128(v, cff);
+  } else {
+    v = _mm_add_epi16(_mm_mullo_epi16(d, minus_a), _mm_mullo_epi16(s, a));
+    v = _mm_srli_epi16(v, 8);
+  }
+  v = _mm_or_si128(v, ca);
+  v = _mm_or_si128(_mm_and_si128(gt8, v), _mm_andnot_si128(gt8, d));
+
+  return _mm_or_si128(_mm_and_si128(copy, s), _mm_andnot_si128(copy, v));
+}
+#endif /*BLEND_SIMD_SSE2*/
+
+static void blend_simd_row_8888(uint8_t* d, const uint8_t* s, uint32_t n, uint8_t alpha,
+                                bool_t premulti_alpha, bool_t swap_rb) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+
+#if defined(BLEND_SIMD_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+
+  for (; i + 4 <= n; i += 4) {
+    int slow = 0;
+    __m128i sv = _mm_loadu_si128((const __m128i*)(s + i * 4));
+    __m128i dv = _mm_loadu_si128((const __m128i*)(d + i * 4));
+    __m128i slo = _mm_unpacklo_epi8(sv, zero);
+    __m128i shi = _mm_unpackhi_epi8(sv, zero);
+    __m128i dlo = _mm_unpacklo_epi8(dv, zero);
+    __m128i dhi = _mm_unpackhi_epi8(dv, zero);
+    __m128i lo = blend_simd_sse2_8888(dlo, slo, alpha, premulti_alpha, swap_rb, &slow);
+    __m128i hi = blend_simd_sse2_8888(dhi, shi, alpha, premulti_alpha, swap_rb, &slow);
+
+    if (slow) {
+      for (k = 0; k < 4; k++) {
+        blend_simd_pixel_8888(d + (i + k) * 4, s + (i + k) * 4, alpha, premulti_alpha, swap_rb);
+      }
+    } else {
+      _mm_storeu_si128((__m128i*)(d + i * 4), _mm_packus_epi16(lo, hi));
+    }
+  }
+#elif defined(BLEND_SIMD_NEON)
+  const uint8x8_t c08 = vdup_n_u8(0x08);
+  const uint8x8_t cf4 = vdup_n_u8(0xf4);
+  const uint8x8_t cf8 = vdup_n_u8(0xf8);
+  const uint8x8_t cff = vdup_n_u8(0xff);
+  const uint8x8_t valpha = vdup_n_u8(alpha);
+
+  for (; i + 8 <= n; i += 8) {
+    uint8x8_t a, gt8, gtf8, lt8, copy, slow, minus_a;
+    uint8x8x4_t sv = vld4_u8(s + i * 4);
+    uint8x8x4_t dv = vld4_u8(d + i * 4);
+    uint8x8x4_t ov;
+
+    if (swap_rb) {
+      uint8x8_t t = sv.val[0];
+      sv.val[0] = sv.val[2];
+      sv.val[2] = t;
+    }
+
+    a = alpha == 0xff ? sv.val[3] : vshrn_n_u16(vmull_u8(sv.val[3], valpha), 8);
+    gt8 = vcgt_u8(a, c08);
+    gtf8 = vcgt_u8(a, cf8);
+    lt8 = vclt_u8(dv.val[3], c08);
+    copy = vorr_u8(gtf8, vand_u8(gt8, lt8));
+    slow = vbic_u8(gt8, vorr_u8(gtf8, vorr_u8(lt8, vcgt_u8(dv.val[3], cf4))));
+
+    if (vget_lane_u64(vreinterpret_u64_u8(slow), 0) != 0) {
+      for (k = 0; k < 8; k++) {
+        blend_simd_pixel_8888(d + (i + k) * 4, s + (i + k) * 4, alpha, premulti_alpha, swap_rb);
+      }
+      continue;
+    }
+
+    minus_a = vmvn_u8(a);
+    for (k = 0; k < 3; k++) {
+      uint8x8_t v;
+      if (premulti_alpha) {
+        uint8x8_t sc = sv.val[k];
+        if (alpha <= 0xf8) {
+          sc = vshrn_n_u16(vmull_u8(sc, valpha), 8);
+        }
+        v = vadd_u8(vshrn_n_u16(vmull_u8(dv.val[k], minus_a), 8), sc);
+      } else {
+        v = vshrn_n_u16(vmlal_u8(vmull_u8(dv.val[k], minus_a), sv.val[k], a), 8);
+      }
+      ov.val[k] = vbsl_u8(copy, sv.val[k], vbsl_u8(gt8, v, dv.val[k]));
+    }
+    ov.val[3] = vbsl_u8(copy, sv.val[3], vbsl_u8(gt8, cff, dv.val[3]));
+
+    vst4_u8(d + i * 4, ov);
+  }
+#endif /*BLEND_SIMD_SSE2*/
+
+  for (; i < n; i++) {
+    blend_simd_pixel_8888(d + i * 4, s + i * 4, alpha, premulti_alpha, swap_rb);
+  }
+}
+
+static void blend_simd_row_565(uint16_t* d, const uint8_t* s, uint32_t n, uint8_t alpha,
+                               bool_t premulti_alpha) {
+  uint32_t i = 0;
+
+#if defined(BLEND_SIMD_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i c08 = _mm_set1_epi32(0x08);
+  const __m128i cf8 = _mm_set1_epi32(0xf8);
+  const __m128i cfc = _mm_set1_epi32(0xfc);
+  const __m128i cff = _mm_set1_epi32(0xff);
+  const __m128i valpha = _mm_set1_epi32(alpha);
+
+  /*每个通道32位，一次处理4个像素，中间结果不会溢出。*/
+  for (; i + 4 <= n; i += 4) {
+    __m128i a, copy, gt8, minus_a, cv, bv, xr, xg, xb, r8, g8, b8, v;
+    __m128i sv = _mm_loadu_si128((const __m128i*)(s + i * 4));
+    __m128i dv = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)(d + i)), zero);
+    __m128i sr = _mm_and_si128(sv, cff);
+    __m128i sg = _mm_and_si128(_mm_srli_epi32(sv, 8), cff);
+    __m128i sb = _mm_and_si128(_mm_srli_epi32(sv, 16), cff);
+    __m128i sa = _mm_srli_epi32(sv, 24);
+
+    a = alpha > 0xf8 ? sa : _mm_srli_epi32(_mm_mullo_epi16(sa, valpha), 8);
+    copy = _mm_cmpgt_epi32(a, cf8);
+    gt8 = _mm_cmpgt_epi32(a, c08);
+    minus_a = _mm_sub_epi32(cff, a);
+
+    cv = _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(sr, 3), 11),
+                      _mm_slli_epi32(_mm_srli_epi32(sg, 2), 5));
+    cv = _mm_or_si128(cv, _mm_srli_epi32(sb, 3));
+
+    r8 = _mm_and_si128(_mm_srli_epi32(dv, 8), cf8);
+    g8 = _mm_and_si128(_mm_srli_epi32(dv, 3), cfc);
+    b8 = _mm_and_si128(_mm_slli_epi32(dv, 3), cf8);
+
+    if (premulti_alpha) {
+      if (alpha <= 0xf8) {
+        sr = _mm_srli_epi32(_mm_mullo_epi16(sr, valpha), 8);
+        sg = _mm_srli_epi32(_mm_mullo_epi16(sg, valpha), 8);
+        sb = _mm_srli_epi32(_mm_mullo_epi16(sb, valpha), 8);
+      }
+      xr = _mm_add_epi32(_mm_mullo_epi16(r8, minus_a), _mm_slli_epi32(sr, 8));
+      xg = _mm_add_epi32(_mm_mullo_epi16(g8, minus_a), _mm_slli_epi32(sg, 8));
+      xb = _mm_add_epi32(_mm_mullo_epi16(b8, minus_a), _mm_slli_epi32(sb, 8));
+    } else {
+      xr = _mm_add_epi32(_mm_mullo_epi16(r8, minus_a), _mm_mullo_epi16(sr, a));
+      xg = _mm_add_epi32(_mm_mullo_epi16(g8, minus_a), _mm_mullo_epi16(sg, a));
+      xb = _mm_add_epi32(_mm_mullo_epi16(b8, minus_a), _mm_mullo_epi16(sb, a));
+    }
+
+    bv = _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(xr, 11), 11),
+                      _mm_slli_epi32(_mm_srli_epi32(xg, 10), 5));
+    bv = _mm_or_si128(bv, _mm_srli_epi32(xb, 11));
+
+    v = _mm_or_si128(_mm_and_si128(gt8, bv), _mm_andnot_si128(gt8, dv));
+    v = _mm_or_si128(_mm_and_si128(copy, cv), _mm_andnot_si128(copy, v));
+
+    /*和C代码一样截断为16位*/
+    v = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+    _mm_storel_epi64((__m128i*)(d + i), _mm_packs_epi32(v, v));
+  }
+#elif defined(BLEND_SIMD_NEON)
+  const uint8x8_t c08 = vdup_n_u8(0x08);
+  const uint8x8_t cf8 = vdup_n_u8(0xf8);
+  const uint16x8_t cf8_16 = vdupq_n_u16(0xf8);
+  const uint16x8_t cfc_16 = vdupq_n_u16(0xfc);
+  const uint8x8_t valpha = vdup_n_u8(alpha);
+
+  for (; i + 8 <= n; i += 8) {
+    uint8x8_t a, r8, g8, b8, minus_a;
+    uint16x8_t copy, gt8, cv, bv, v;
+    uint8x8x4_t sv = vld4_u8(s + i * 4);
+    uint16x8_t dv = vld1q_u16(d + i);
+    uint8x8_t sr = sv.val[0];
+    uint8x8_t sg = sv.val[1];
+    uint8x8_t sb = sv.val[2];
+
+    a = alpha > 0xf8 ? sv.val[3] : vshrn_n_u16(vmull_u8(sv.val[3], valpha), 8);
+    copy = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vcgt_u8(a, cf8))));
+    gt8 = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vcgt_u8(a, c08))));
+    minus_a = vmvn_u8(a);
+
+    cv = vorrq_u16(vshlq_n_u16(vmovl_u8(vshr_n_u8(sr, 3)), 11),
+                   vshlq_n_u16(vmovl_u8(vshr_n_u8(sg, 2)), 5));
+    cv = vorrq_u16(cv, vmovl_u8(vshr_n_u8(sb, 3)));
+
+    r8 = vmovn_u16(vandq_u16(vshrq_n_u16(dv, 8), cf8_16));
+    g8 = vmovn_u16(vandq_u16(vshrq_n_u16(dv, 3), cfc_16));
+    b8 = vmovn_u16(vandq_u16(vshlq_n_u16(dv, 3), cf8_16));
+
+    if (premulti_alpha) {
+      /*(x * a + (s << 8)) >> n 等于 (((x * a) >> 8) + s) >> (n - 8)，这样不会超出16位。*/
+      uint16x8_t tr, tg, tb;
+      if (alpha <= 0xf8) {
+        sr = vshrn_n_u16(vmull_u8(sr, valpha), 8);
+        sg = vshrn_n_u16(vmull_u8(sg, valpha), 8);
+        sb = vshrn_n_u16(vmull_u8(sb, valpha), 8);
+      }
+      tr = vaddw_u8(vshrq_n_u16(vmull_u8(r8, minus_a), 8), sr);
+      tg = vaddw_u8(vshrq_n_u16(vmull_u8(g8, minus_a), 8), sg);
+      tb = vaddw_u8(vshrq_n_u16(vmull_u8(b8, minus_a), 8), sb);
+      bv = vorrq_u16(vshlq_n_u16(vshrq_n_u16(tr, 3), 11), vshlq_n_u16(vshrq_n_u16(tg, 2), 5));
+      bv = vorrq_u16(bv, vshrq_n_u16(tb, 3));
+    } else {
+      uint16x8_t xr = vmlal_u8(vmull_u8(r8, minus_a), sr, a);
+      uint16x8_t xg = vmlal_u8(vmull_u8(g8, minus_a), sg, a);
+      uint16x8_t xb = vmlal_u8(vmull_u8(b8, minus_a), sb, a);
+      bv = vorrq_u16(vshlq_n_u16(vshrq_n_u16(xr, 11), 11), vshlq_n_u16(vshrq_n_u16(xg, 10), 5));
+      bv = vorrq_u16(bv, vshrq_n_u16(xb, 11));
+    }
+
+    v = vbslq_u16(copy, cv, vbslq_u16(gt8, bv, dv));
+    vst1q_u16(d + i, v);
+  }
+#endif /*BLEND_SIMD_SSE2*/
+
+  for (; i < n; i++) {
+    blend_simd_pixel_565(d + i, s + i * 4, alpha, premulti_alpha);
+  }
+}
+
+/*rgba按BGRA8888的字节顺序，rgba.a为1-a。*/
+static void blend_simd_fill_row_8888(uint8_t* p, uint32_t n, rgba_t rgba, bool_t dark) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+
+#if defined(BLEND_SIMD_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i cf4 = _mm_set1_epi32(0xf4);
+  const __m128i cff = _mm_set1_epi16(0xff);
+  const __m128i ca = _mm_set1_epi32(0xff000000);
+  const __m128i minus_a = _mm_set1_epi16(rgba.a);
+  const __m128i c = _mm_set_epi16(0, rgba.r, rgba.g, rgba.b, 0, rgba.r, rgba.g, rgba.b);
+
+  for (; i + 4 <= n; i += 4) {
+    __m128i dv = _mm_loadu_si128((const __m128i*)(p + i * 4));
+    __m128i opaque = _mm_cmpgt_epi32(_mm_srli_epi32(dv, 24), cf4);
+
+    if (_mm_movemask_epi8(opaque) == 0xffff) {
+      __m128i lo = _mm_unpacklo_epi8(dv, zero);
+      __m128i hi = _mm_unpackhi_epi8(dv, zero);
+
+      lo = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(lo, minus_a), 8), c);
+      hi = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(hi, minus_a), 8), c);
+      lo = _mm_and_si128(lo, cff);
+      hi = _mm_and_si128(hi, cff);
+      _mm_storeu_si128((__m128i*)(p + i * 4), _mm_or_si128(_mm_packus_epi16(lo, hi), ca));
+    } else {
+      for (k = 0; k < 4; k++) {
+        blend_simd_fill_pixel_8888(p + (i + k) * 4, rgba, dark);
+      }
+    }
+  }
+#elif defined(BLEND_SIMD_NEON)
+  const uint8x8_t cf4 = vdup_n_u8(0xf4);
+  const uint8x8_t minus_a = vdup_n_u8(rgba.a);
+  const uint8x8_t cb = vdup_n_u8(rgba.b);
+  const uint8x8_t cg = vdup_n_u8(rgba.g);
+  const uint8x8_t cr = vdup_n_u8(rgba.r);
+
+  for (; i + 8 <= n; i += 8) {
+    uint8x8x4_t dv = vld4_u8(p + i * 4);
+    uint8x8_t opaque = vcgt_u8(dv.val[3], cf4);
+
+    if (vget_lane_u64(vreinterpret_u64_u8(opaque), 0) == (uint64_t)(-1)) {
+      dv.val[0] = vadd_u8(vshrn_n_u16(vmull_u8(dv.val[0], minus_a), 8), cb);
+      dv.val[1] = vadd_u8(vshrn_n_u16(vmull_u8(dv.val[1], minus_a), 8), cg);
+      dv.val[2] = vadd_u8(vshrn_n_u16(vmull_u8(dv.val[2], minus_a), 8), cr);
+      dv.val[3] = vdup_n_u8(0xff);
+      vst4_u8(p + i * 4, dv);
+    } else {
+      for (k = 0; k < 8; k++) {
+        blend_simd_fill_pixel_8888(p + (i + k) * 4, rgba, dark);
+      }
+    }
+  }
+#endif /*BLEND_SIMD_SSE2*/
+
+  for (; i < n; i++) {
+    blend_simd_fill_pixel_8888(p + i * 4, rgba, dark);
+  }
+}
+
+/*
+ * (x * a + (c << 8)) >> n 等于 (((x * a) >> 8) + c) >> (n - 8)，都用16位计算。
+ * dark时c为0，和pixel_bgr565_blend_rgba_dark的结果相同。
+ */
+static void blend_simd_fill_row_565(uint16_t* p, uint32_t n, rgba_t rgba, bool_t dark) {
+  uint32_t i = 0;
+
+#if defined(BLEND_SIMD_SSE2)
+  const __m128i cf8 = _mm_set1_epi16(0xf8);
+  const __m128i cfc = _mm_set1_epi16(0xfc);
+  const __m128i minus_a = _mm_set1_epi16(rgba.a);
+  const __m128i cr = _mm_set1_epi16(rgba.r);
+  const __m128i cg = _mm_set1_epi16(rgba.g);
+  const __m128i cb = _mm_set1_epi16(rgba.b);
+
+  for (; i + 8 <= n; i += 8) {
+    __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+    __m128i r = _mm_and_si128(_mm_srli_epi16(v, 8), cf8);
+    __m128i g = _mm_and_si128(_mm_srli_epi16(v, 3), cfc);
+    __m128i b = _mm_and_si128(_mm_slli_epi16(v, 3), cf8);
+
+    r = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(r, minus_a), 8), cr);
+    g = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(g, minus_a), 8), cg);
+    b = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(b, minus_a), 8), cb);
+
+    v = _mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(r, 3), 11),
+                     _mm_slli_epi16(_mm_srli_epi16(g, 2), 5));
+    v = _mm_or_si128(v, _mm_srli_epi16(b, 3));
+    _mm_storeu_si128((__m128i*)(p + i), v);
+  }
+#elif defined(BLEND_SIMD_NEON)
+  const uint16x8_t cf8 = vdupq_n_u16(0xf8);
+  const uint16x8_t cfc = vdupq_n_u16(0xfc);
+  const uint16x8_t minus_a = vdupq_n_u16(rgba.a);
+  const uint16x8_t cr = vdupq_n_u16(rgba.r);
+  const uint16x8_t cg = vdupq_n_u16(rgba.g);
+  const uint16x8_t cb = vdupq_n_u16(rgba.b);
+
+  for (; i + 8 <= n; i += 8) {
+    uint16x8_t v = vld1q_u16(p + i);
+    uint16x8_t r = vandq_u16(vshrq_n_u16(v, 8), cf8);
+    uint16x8_t g = vandq_u16(vshrq_n_u16(v, 3), cfc);
+    uint16x8_t b = vandq_u16(vshlq_n_u16(v, 3), cf8);
+
+    r = vaddq_u16(vshrq_n_u16(vmulq_u16(r, minus_a), 8), cr);
+    g = vaddq_u16(vshrq_n_u16(vmulq_u16(g, minus_a), 8), cg);
+    b = vaddq_u16(vshrq_n_u16(vmulq_u16(b, minus_a), 8), cb);
+
+    v = vorrq_u16(vshlq_n_u16(vshrq_n_u16(r, 3), 11), vshlq_n_u16(vshrq_n_u16(g, 2), 5));
+    v = vorrq_u16(v, vshrq_n_u16(b, 3));
+    vst1q_u16(p + i, v);
+  }
+#endif /*BLEND_SIMD_SSE2*/
+
+  for (; i < n; i++) {
+    blend_simd_fill_pixel_565(p + i, rgba, dark);
+  }
+}
+
+bool_t blend_simd_enabled(void) {
+  return TRUE;
+}
+
+ret_t blend_simd_image(bitmap_t* dst, bitmap_t* src, const rect_t* dst_r, const rect_t* src_r,
+                       uint8_t alpha) {
+  wh_t j = 0;
+  uint8_t* srcp = NULL;
+  uint8_t* dstp = NULL;
+  uint8_t* src_data = NULL;
+  uint8_t* dst_data = NULL;
+  bool_t swap_rb = FALSE;
+  bool_t premulti_alpha = FALSE;
+  uint32_t src_line_length = 0;
+  uint32_t dst_line_length = 0;
+  return_value_if_fail(dst != NULL && src != NULL && src_r != NULL && dst_r != NULL,
+                       RET_BAD_PARAMS);
+
+  if (src_r->w != dst_r->w || src_r->h != dst_r->h) {
+    return RET_NOT_IMPL;
+  }
+
+  switch (dst->format) {
+    case BITMAP_FMT_BGRA8888:
+    case BITMAP_FMT_RGBA8888: {
+      if (src->format != BITMAP_FMT_BGRA8888 && src->format != BITMAP_FMT_RGBA8888) {
+        return RET_NOT_IMPL;
+      }
+      swap_rb = src->format != dst->format;
+      break;
+    }
+    case BITMAP_FMT_BGR565: {
+      if (src->format != BITMAP_FMT_RGBA8888) {
+        return RET_NOT_IMPL;
+      }
+      break;
+    }
+    default: {
+      return RET_NOT_IMPL;
+    }
+  }
+
+  if (alpha > 0xf8) {
+    alpha = 0xff;
+  } else if (alpha <= 8) {
+    return RET_OK;
+  }
+
+  return_value_if_fail(src_r->x >= 0 && src_r->y >= 0 && (src_r->x + src_r->w) <= src->w &&
+                           (src_r->y + src_r->h) <= src->h,
+                       RET_BAD_PARAMS);
+  return_value_if_fail(dst_r->x >= 0 && dst_r->y >= 0 && (dst_r->x + dst_r->w) <= dst->w &&
+                           (dst_r->y + dst_r->h) <= dst->h,
+                       RET_BAD_PARAMS);
+
+  src_data = bitmap_lock_buffer_for_read(src);
+  dst_data = bitmap_lock_buffer_for_write(dst);
+  return_value_if_fail(src_data != NULL && dst_data != NULL, RET_BAD_PARAMS);
+
+  premulti_alpha = src->flags & BITMAP_FLAG_PREMULTI_ALPHA;
+  src_line_length = bitmap_get_line_length(src);
+  dst_line_length = bitmap_get_line_length(dst);
+  srcp = src_data + src_r->y * src_line_length + src_r->x * 4;
+  dstp = dst_data + dst_r->y * dst_line_length + dst_r->x * bitmap_get_bpp(dst);
+
+  for (j = 0; j < dst_r->h; j++) {
+    if (dst->format == BITMAP_FMT_BGR565) {
+      blend_simd_row_565((uint16_t*)dstp, srcp, dst_r->w, alpha, premulti_alpha);
+    } else {
+      blend_simd_row_8888(dstp, srcp, dst_r->w, alpha, premulti_alpha, swap_rb);
+    }
+    dstp += dst_line_length;
+    srcp += src_line_length;
+  }
+
+  bitmap_unlock_buffer(src);
+  bitmap_unlock_buffer(dst);
+
+  return RET_OK;
+}
+
+ret_t blend_simd_fill_rect(bitmap_t* dst, const rect_t* dst_r, color_t c) {
+  wh_t y = 0;
+  rgba_t rgba;
+  uint8_t* p = NULL;
+  bool_t dark = FALSE;
+  uint8_t* dst_data = NULL;
+  uint32_t a = c.rgba.a;
+  uint32_t bpp = 0;
+  uint32_t line_length = 0;
+  return_value_if_fail(dst != NULL && dst_r != NULL, RET_BAD_PARAMS);
+
+  /*不透明时由clear_image处理*/
+  if (a > 0xf8) {
+    return RET_NOT_IMPL;
+  }
+
+  /*和fill_image.inc一样，预先乘以alpha。BGRA8888的顺序，RGBA8888需要交换R/B。*/
+  dark = c.rgba.r == 0 && c.rgba.g == 0 && c.rgba.b == 0;
+  rgba.r = (c.rgba.r * a) >> 8;
+  rgba.g = (c.rgba.g * a) >> 8;
+  rgba.b = (c.rgba.b * a) >> 8;
+  rgba.a = 0xff - a;
+
+  switch (dst->format) {
+    case BITMAP_FMT_BGRA8888:
+    case BITMAP_FMT_BGR565: {
+      break;
+    }
+    case BITMAP_FMT_RGBA8888: {
+      uint8_t t = rgba.r;
+      rgba.r = rgba.b;
+      rgba.b = t;
+      break;
+    }
+    default: {
+      return RET_NOT_IMPL;
+    }
+  }
+
+  dst_data = bitmap_lock_buffer_for_write(dst);
+  return_value_if_fail(dst_data != NULL && dst_r->w > 0 && dst_r->h > 0, RET_BAD_PARAMS);
+
+  bpp = bitmap_get_bpp(dst);
+  line_length = bitmap_get_line_length(dst);
+  for (y = 0; y < dst_r->h; y++) {
+    p = dst_data + (dst_r->y + y) * line_length + dst_r->x * bpp;
+
+    if (bpp == 2) {
+      blend_simd_fill_row_565((uint16_t*)p, dst_r->w, rgba, dark);
+    } else {
+      blend_simd_fill_row_8888(p, dst_r->w, rgba, dark);
+    }
+  }
+  bitmap_unlock_buffer(dst);
+
+  return RET_OK;
+}
+
+#else
+bool_t blend_simd_enabled(void) {
+  return FALSE;
+}
+
+ret_t blend_simd_image(bitmap_t* dst, bitmap_t* src, const rect_t* dst_r, const rect_t* src_r,
+                       uint8_t alpha) {
+  (void)dst;
+  (void)src;
+  (void)dst_r;
+  (void)src_r;
+  (void)alpha;
+
+  return RET_NOT_IMPL;
+}
+
+ret_t blend_simd_fill_rect(bitmap_t* dst, const rect_t* dst_r, color_t c) {
+  (void)dst;
+  (void)dst_r;
+  (void)c;
+
+  return RET_NOT_IMPL;
+}
+#endif /*BLEND_SIMD*/
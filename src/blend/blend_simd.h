@@ -0,0 +1,71 @@
+/**
+ * File:   blend_simd.h
+ * Author: AWTK Develop Team
+ * Brief:  simd implemented blend/fill operations
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_BLEND_SIMD_H
+#define TK_BLEND_SIMD_H
+
+#include "tkc/rect.h"
+#include "base/bitmap.h"
+
+BEGIN_C_DECLS
+
+/*
+ * 编译时根据目标平台选择SSE2(x86)或NEON(ARM)实现，定义WITHOUT_BLEND_SIMD可以禁用。
+ * 结果与blend_image_xxx/fill_image_xxx的C实现逐位一致。
+ */
+
+/**
+ * @method blend_simd_enabled
+ * 是否启用了SIMD实现。
+ *
+ * @return {bool_t} 返回TRUE表示启用，否则表示没有启用(所有操作都返回RET_NOT_IMPL)。
+ */
+bool_t blend_simd_enabled(void);
+
+/**
+ * @method blend_simd_image
+ * 把图片指定的区域合成到目标图片指定的区域。
+ * 支持(BGRA8888|RGBA8888)<-(BGRA8888|RGBA8888)和BGR565<-RGBA8888，不支持缩放。
+ * @param {bitmap_t*} dst 目标图片对象。
+ * @param {bitmap_t*} src 源图片对象。
+ * @param {const rect_t*} dst_r 目标区域。
+ * @param {const rect_t*} src_r 源区域(大小与目标区域相同)。
+ * @param {uint8_t} alpha 全局alpha。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，返回RET_NOT_IMPL表示不支持，调用者应回退到C实现。
+ */
+ret_t blend_simd_image(bitmap_t* dst, bitmap_t* src, const rect_t* dst_r, const rect_t* src_r,
+                       uint8_t alpha);
+
+/**
+ * @method blend_simd_fill_rect
+ * 用半透明颜色填充指定的区域。支持BGRA8888、RGBA8888和BGR565。
+ * @param {bitmap_t*} dst 目标图片对象。
+ * @param {const rect_t*} dst_r 要填充的目标区域。
+ * @param {color_t} c 颜色。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，返回RET_NOT_IMPL表示不支持，调用者应回退到C实现。
+ */
+ret_t blend_simd_fill_rect(bitmap_t* dst, const rect_t* dst_r, color_t c);
+
+END_C_DECLS
+
+#endif /*TK_BLEND_SIMD_H*/
@@ -22,6 +22,7 @@
 #include "tkc/utils.h"
 #include "base/pixel.h"
 #include "blend/soft_g2d.h"
+#include "blend/blend_simd.h"
 #include "base/pixel_pack_unpack.h"
 
 #include "blend_image_bgr565_bgr565.h"
@@ -152,6 +153,10 @@ ret_t soft_clear_rect(bitmap_t* dst, const rect_t* dst_r, color_t c) {
 ret_t soft_fill_rect(bitmap_t* dst, const rect_t* dst_r, color_t c) {
   return_value_if_fail(dst != NULL && dst_r != NULL, RET_BAD_PARAMS);
 
+  if (blend_simd_fill_rect(dst, dst_r, c) == RET_OK) {
+    return RET_OK;
+  }
+
   switch (dst->format) {
     case BITMAP_FMT_BGR565: {
       return fill_bgr565_rect(dst, dst_r, c);
@@ -239,6 +244,9 @@ ret_t soft_blend_image(bitmap_t* dst, bitmap_t* src, const rect_t* dst_r, const
           }
         }
         case BITMAP_FMT_RGBA8888: {
+          if (blend_simd_image(dst, src, dst_r, src_r, alpha) == RET_OK) {
+            return RET_OK;
+          }
           return blend_image_bgr565_rgba8888(dst, src, dst_r, src_r, alpha);
         }
         case BITMAP_FMT_BGRA8888: {
@@ -339,9 +347,15 @@ ret_t soft_blend_image(bitmap_t* dst, bitmap_t* src, const rect_t* dst_r, const
           return blend_image_bgra8888_rgb565(dst, src, dst_r, src_r, alpha);
         }
         case BITMAP_FMT_RGBA8888: {
+          if (blend_simd_image(dst, src, dst_r, src_r, alpha) == RET_OK) {
+            return RET_OK;
+          }
           return blend_image_bgra8888_rgba8888(dst, src, dst_r, src_r, alpha);
         }
         case BITMAP_FMT_BGRA8888: {
+          if (blend_simd_image(dst, src, dst_r, src_r, alpha) == RET_OK) {
+            return RET_OK;
+          }
           return blend_image_bgra8888_bgra8888(dst, src, dst_r, src_r, alpha);
         }
         default:
@@ -358,9 +372,15 @@ ret_t soft_blend_image(bitmap_t* dst, bitmap_t* src, const rect_t* dst_r, const
           return blend_image_rgba8888_rgb565(dst, src, dst_r, src_r, alpha);
         }
         case BITMAP_FMT_RGBA8888: {
+          if (blend_simd_image(dst, src, dst_r, src_r, alpha) == RET_OK) {
+            return RET_OK;
+          }
           return blend_image_rgba8888_rgba8888(dst, src, dst_r, src_r, alpha);
         }
         case BITMAP_FMT_BGRA8888: {
+          if (blend_simd_image(dst, src, dst_r, src_r, alpha) == RET_OK) {
+            return RET_OK;
+          }
           return blend_image_rgba8888_bgra8888(dst, src, dst_r, src_r, alpha);
         }
         default:
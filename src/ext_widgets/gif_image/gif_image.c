@@ -24,6 +24,7 @@
 #include "base/timer.h"
 #include "base/widget_vtable.h"
 #include "gif_image/gif_image.h"
+#include "image_loader/image_loader_stb.h"
 
 #ifdef AWTK_WEB
 static ret_t gif_image_on_timer(const timer_info_t* info) {
@@ -38,12 +39,96 @@ static ret_t gif_image_on_timer(const timer_info_t* info) {
   return RET_REPEAT;
 }
 #else
+static ret_t gif_image_update_frame(gif_image_t* image) {
+  gif_decoder_t* decoder = image->decoder;
+
+  image->index = decoder->index;
+  bitmap_update_from_rgba(image->frame, decoder->data, 4);
+#ifdef WITH_BITMAP_PREMULTI_ALPHA
+  bitmap_premulti_alpha(image->frame);
+#endif /*WITH_BITMAP_PREMULTI_ALPHA*/
+
+  return RET_OK;
+}
+
+static ret_t gif_image_reset_decoder(gif_image_t* image) {
+  if (image->decoder != NULL) {
+    gif_decoder_destroy(image->decoder);
+    image->decoder = NULL;
+  }
+
+  if (image->frame != NULL) {
+    bitmap_destroy(image->frame);
+    image->frame = NULL;
+  }
+
+  if (image->asset != NULL) {
+    widget_unload_asset(WIDGET(image), image->asset);
+    image->asset = NULL;
+  }
+
+  TKMEM_FREE(image->decoder_image);
+
+  return RET_OK;
+}
+
+static bitmap_format_t gif_image_get_frame_format(void) {
+#if defined(WITH_LCD_MONO)
+  return BITMAP_FMT_MONO;
+#elif defined(WITH_BITMAP_BGRA)
+  return BITMAP_FMT_BGRA8888;
+#else
+  return BITMAP_FMT_RGBA8888;
+#endif /*WITH_LCD_MONO*/
+}
+
+/*GIF文件逐帧解码，位图资源(由image_gen生成)仍然一次加载全部帧。*/
+static ret_t gif_image_prepare_decoder(widget_t* widget) {
+  gif_decoder_t* decoder = NULL;
+  gif_image_t* image = GIF_IMAGE(widget);
+  const char* name = IMAGE_BASE(widget)->image;
+
+  if (image->decoder_image != NULL && tk_str_eq(image->decoder_image, name)) {
+    return image->decoder != NULL ? RET_OK : RET_NOT_FOUND;
+  }
+
+  gif_image_reset_decoder(image);
+  image->index = 0;
+  image->decoder_image = tk_strdup(name);
+  image->asset = widget_load_asset(widget, ASSET_TYPE_IMAGE, name);
+  if (image->asset == NULL || image->asset->subtype != ASSET_TYPE_IMAGE_GIF) {
+    return RET_NOT_FOUND;
+  }
+
+  decoder = gif_decoder_create(image->asset->data, image->asset->size);
+  if (decoder == NULL) {
+    return RET_NOT_FOUND;
+  }
+
+  image->decoder = decoder;
+  image->frame = bitmap_create_ex(decoder->w, decoder->h, 0, gif_image_get_frame_format());
+  if (image->frame == NULL) {
+    gif_decoder_destroy(decoder);
+    image->decoder = NULL;
+    return RET_OOM;
+  }
+
+  return gif_image_update_frame(image);
+}
+
 static ret_t gif_image_on_timer(const timer_info_t* info) {
   gif_image_t* image = GIF_IMAGE(info->ctx);
   return_value_if_fail(image != NULL, RET_BAD_PARAMS);
 
   if (image->running) {
-    image->index++;
+    if (image->decoder != NULL) {
+      /*不可见时不解码，再次可见时从当前帧继续。*/
+      if (WIDGET(image)->visible && gif_decoder_next(image->decoder) == RET_OK) {
+        gif_image_update_frame(image);
+      }
+    } else {
+      image->index++;
+    }
   }
 
   if (WIDGET(image)->visible) {
@@ -51,6 +136,45 @@ static ret_t gif_image_on_timer(const timer_info_t* info) {
   }
   return RET_REPEAT;
 }
+
+static ret_t gif_image_paint_frame(widget_t* widget, canvas_t* c) {
+  rect_t src;
+  rect_t dst;
+  gif_image_t* image = GIF_IMAGE(widget);
+  bitmap_t* frame = image->frame;
+  gif_decoder_t* decoder = image->decoder;
+  vgcanvas_t* vg = canvas_get_vgcanvas(c);
+
+  if (decoder->frames_nr != 1) {
+    if (image->timer_id == TK_INVALID_ID) {
+      image->delay = decoder->delay;
+      image->timer_id = timer_add(gif_image_on_timer, image, image->delay);
+    } else if (image->delay != decoder->delay) {
+      image->delay = decoder->delay;
+      timer_modify(image->timer_id, image->delay);
+    }
+  } else if (image->timer_id != TK_INVALID_ID) {
+    timer_remove(image->timer_id);
+    image->timer_id = TK_INVALID_ID;
+  }
+
+  if (vg != NULL) {
+    if (image_need_transform(widget)) {
+      vgcanvas_save(vg);
+      image_transform(widget, c);
+      vgcanvas_draw_icon(vg, frame, 0, 0, frame->w, frame->h, 0, 0, widget->w, widget->h);
+      vgcanvas_restore(vg);
+
+      return RET_OK;
+    }
+  }
+
+  src = rect_init(0, 0, frame->w, frame->h);
+  dst = rect_init(0, 0, widget->w, widget->h);
+  canvas_draw_image_scale_down(c, frame, &src, &dst);
+
+  return RET_OK;
+}
 #endif /*AWTK_WEB*/
 
 static ret_t gif_image_on_paint_self(widget_t* widget, canvas_t* c) {
@@ -71,6 +195,12 @@ static ret_t gif_image_on_paint_self(widget_t* widget, canvas_t* c) {
     return RET_OK;
   }
 
+#ifndef AWTK_WEB
+  if (gif_image_prepare_decoder(widget) == RET_OK) {
+    return gif_image_paint_frame(widget, c);
+  }
+#endif /*AWTK_WEB*/
+
   vg = canvas_get_vgcanvas(c);
   return_value_if_fail(widget_load_image(widget, image_base->image, &bitmap) == RET_OK,
                        RET_BAD_PARAMS);
@@ -108,8 +238,7 @@ static ret_t gif_image_on_paint_self(widget_t* widget, canvas_t* c) {
       image->timer_id = timer_add(gif_image_on_timer, image, image->delay);
     } else if (image->delay != delay) {
       image->delay = delay;
-      timer_info_t* timer = (timer_info_t*)timer_find(image->timer_id);
-      if (timer) timer->duration = image->delay;
+      timer_modify(image->timer_id, image->delay);
     }
   } else if (image->timer_id != TK_INVALID_ID) {
     image->index = 0;
@@ -152,6 +281,9 @@ static ret_t gif_image_on_destroy(widget_t* widget) {
     timer_remove(image->timer_id);
     image->timer_id = TK_INVALID_ID;
   }
+#ifndef AWTK_WEB
+  gif_image_reset_decoder(image);
+#endif /*AWTK_WEB*/
 
   return image_base_on_destroy(widget);
 }
@@ -180,6 +312,12 @@ ret_t gif_image_stop(widget_t* widget) {
 
   gif_image->index = 0;
   gif_image->running = FALSE;
+#ifndef AWTK_WEB
+  if (gif_image->decoder != NULL && gif_decoder_rewind(gif_image->decoder) == RET_OK) {
+    gif_image_update_frame(gif_image);
+    widget_invalidate(widget, NULL);
+  }
+#endif /*AWTK_WEB*/
 
   return RET_OK;
 }
@@ -33,6 +33,9 @@ BEGIN_C_DECLS
  * @annotation ["scriptable","design","widget"]
  * GIF图片控件。
  *
+ * > GIF文件逐帧解码，只保存当前帧和上一帧，内存占用与帧数无关。
+ * 控件不可见时不解码。
+ *
  * > 注意：GIF图片的尺寸大于控件大小时会自动缩小图片，但一般的嵌入式系统的硬件加速都不支持图片缩放，
  * 所以缩放图片会导致性能明显下降。如果性能不满意时，请确认一下GIF图片的尺寸是否小余控件大小。
  *
@@ -91,6 +94,12 @@ typedef struct _gif_image_t {
   uint32_t index;
   uint32_t delay;
   uint32_t timer_id;
+
+  /*逐帧解码(decoder_image为NULL表示还没有创建解码器，decoder为NULL表示不是GIF文件)*/
+  char* decoder_image;
+  struct _gif_decoder_t* decoder;
+  const asset_info_t* asset;
+  bitmap_t* frame;
 } gif_image_t;
 
 /**
@@ -298,6 +298,7 @@ static ret_t mledit_set_text(widget_t* widget, const value_t* v) {
 
   if (!wstr_equal(&(widget->text), &str)) {
     wstr_set(&(widget->text), str.str);
+    text_edit_invalidate_layout(mledit->model);
     mledit_reset_text_edit_layout(mledit->model);
     text_edit_layout(mledit->model);
     mledit_dispatch_event(widget, EVT_VALUE_CHANGED);
@@ -514,6 +515,7 @@ ret_t mledit_clear(mledit_t* mledit) {
   return_value_if_fail(widget != NULL && mledit != NULL, RET_BAD_PARAMS);
 
   widget->text.size = 0;
+  text_edit_invalidate_layout(mledit->model);
   text_edit_set_cursor(mledit->model, 0);
 
   return widget_invalidate_force(widget, NULL);
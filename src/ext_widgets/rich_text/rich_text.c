@@ -46,10 +46,57 @@ static ret_t rich_text_reset(widget_t* widget) {
     rich_text_render_node_destroy(rich_text->render_node);
     rich_text->render_node = NULL;
   }
+  darray_clear(&(rich_text->rows));
 
   return RET_OK;
 }
 
+static ret_t rich_text_update_rows(widget_t* widget, rich_text_render_node_t* iter) {
+  rich_text_render_node_t* last = NULL;
+  rich_text_t* rich_text = RICH_TEXT(widget);
+  darray_t* rows = &(rich_text->rows);
+
+  if (rows->size > 0) {
+    last = (rich_text_render_node_t*)(rows->elms[rows->size - 1]);
+  }
+
+  /*渲染节点按行的顺序排列，同一行节点的y坐标相同。*/
+  while (iter != NULL) {
+    if (last == NULL || last->rect.y != iter->rect.y) {
+      return_value_if_fail(darray_push(rows, iter) == RET_OK, RET_OOM);
+      last = iter;
+    }
+    iter = iter->next;
+  }
+
+  return RET_OK;
+}
+
+static rich_text_render_node_t* rich_text_find_first_visible(widget_t* widget, int32_t yoffset) {
+  uint32_t low = 0;
+  uint32_t high = 0;
+  rich_text_t* rich_text = RICH_TEXT(widget);
+  darray_t* rows = &(rich_text->rows);
+
+  if (rows->size == 0) {
+    return rich_text->render_node;
+  }
+
+  high = rows->size;
+  while (low < high) {
+    uint32_t mid = low + ((high - low) >> 1);
+    rich_text_render_node_t* iter = (rich_text_render_node_t*)(rows->elms[mid]);
+
+    if (iter->rect.y + iter->rect.h <= yoffset) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  return low < rows->size ? (rich_text_render_node_t*)(rows->elms[low]) : NULL;
+}
+
 static ret_t rich_text_get_margin(widget_t* widget) {
   int32_t margin = 0;
   int32_t tmp_margin = 0;
@@ -96,7 +143,7 @@ static ret_t rich_text_on_paint_text(widget_t* widget, canvas_t* c) {
     align_h = style_get_int(widget->astyle, STYLE_ID_TEXT_ALIGN_H, ALIGN_H_LEFT);
   }
 
-  iter = rich_text->render_node;
+  iter = rich_text_find_first_visible(widget, yoffset);
   while (iter != NULL) {
     r = iter->rect;
     r.y -= yoffset;
@@ -191,7 +238,139 @@ static bool_t rich_text_is_need_reset_from_style(rich_text_t* rich_text, const c
   return FALSE;
 }
 
+static bool_t rich_text_font_equal(const rich_text_font_t* f1, const rich_text_font_t* f2) {
+  return f1->size == f2->size && f1->color.color == f2->color.color &&
+         f1->align_v == f2->align_v && f1->bold == f2->bold && f1->italic == f2->italic &&
+         f1->underline == f2->underline && tk_str_cmp(f1->name, f2->name) == 0;
+}
+
+/*prefix为TRUE时，新节点的文本以旧节点的文本开头即可。*/
+static bool_t rich_text_node_is_compatible(rich_text_node_t* old_node, rich_text_node_t* new_node,
+                                           bool_t prefix) {
+  if (new_node == NULL || old_node->type != new_node->type) {
+    return FALSE;
+  }
+
+  if (old_node->type == RICH_TEXT_TEXT) {
+    const wchar_t* old_text = old_node->u.text.text;
+    const wchar_t* new_text = new_node->u.text.text;
+
+    if (!rich_text_font_equal(&(old_node->u.text.font), &(new_node->u.text.font))) {
+      return FALSE;
+    }
+
+    if (prefix) {
+      return wcsncmp(old_text, new_text, wcslen(old_text)) == 0;
+    } else {
+      return wcscmp(old_text, new_text) == 0;
+    }
+  } else if (old_node->type == RICH_TEXT_IMAGE) {
+    /*排版时会把图片的实际大小写回没有指定大小的节点。*/
+    rich_text_image_t* old_image = &(old_node->u.image);
+    rich_text_image_t* new_image = &(new_node->u.image);
+
+    return tk_str_eq(old_image->name, new_image->name) &&
+           old_image->draw_type == new_image->draw_type &&
+           (new_image->w == 0 || new_image->w == old_image->w) &&
+           (new_image->h == 0 || new_image->h == old_image->h);
+  }
+
+  return FALSE;
+}
+
+/*
+ * 新的文本以原来的文本开头时，从最后一个在文本节点中间开始的行重新排版，
+ * 它前面的行不受追加内容的影响，只需要把渲染节点指向新的节点。
+ * 返回RET_OK表示接管了node(渲染节点为NULL时需要完整排版)。
+ */
+static ret_t rich_text_layout_appended(widget_t* widget, canvas_t* c, rich_text_node_t* node) {
+  int32_t y = 0;
+  uint32_t row = 0;
+  uint32_t offset = 0;
+  rich_text_node_t* old_iter = NULL;
+  rich_text_node_t* new_iter = NULL;
+  rich_text_render_node_t* iter = NULL;
+  rich_text_render_node_t* prev = NULL;
+  rich_text_render_node_t* first = NULL;
+  rich_text_t* rich_text = RICH_TEXT(widget);
+
+  if (node == NULL || rich_text->rows.size < 2 || rich_text->layout_w != widget->w ||
+      rich_text->layout_margin != rich_text->margin ||
+      rich_text->layout_line_gap != rich_text->line_gap) {
+    return RET_FAIL;
+  }
+
+  for (row = rich_text->rows.size - 1; row > 0; row--) {
+    iter = (rich_text_render_node_t*)(rich_text->rows.elms[row]);
+    if (iter->node->type == RICH_TEXT_TEXT && iter->text > iter->node->u.text.text) {
+      first = iter;
+      break;
+    }
+  }
+
+  if (first == NULL) {
+    return RET_FAIL;
+  }
+
+  old_iter = rich_text->node;
+  new_iter = node;
+  while (old_iter != first->node) {
+    if (!rich_text_node_is_compatible(old_iter, new_iter, FALSE)) {
+      return RET_FAIL;
+    }
+    old_iter = old_iter->next;
+    new_iter = new_iter->next;
+  }
+
+  if (!rich_text_node_is_compatible(old_iter, new_iter, TRUE)) {
+    return RET_FAIL;
+  }
+
+  y = first->rect.y;
+  offset = first->text - first->node->u.text.text;
+
+  old_iter = rich_text->node;
+  new_iter = node;
+  for (iter = rich_text->render_node; iter != first; iter = iter->next) {
+    while (old_iter != iter->node) {
+      old_iter = old_iter->next;
+      new_iter = new_iter->next;
+    }
+
+    iter->node = new_iter;
+    if (new_iter->type == RICH_TEXT_TEXT) {
+      iter->text = new_iter->u.text.text + (iter->text - old_iter->u.text.text);
+    } else if (new_iter->type == RICH_TEXT_IMAGE) {
+      new_iter->u.image.w = old_iter->u.image.w;
+      new_iter->u.image.h = old_iter->u.image.h;
+    }
+    prev = iter;
+  }
+
+  while (old_iter != first->node) {
+    old_iter = old_iter->next;
+    new_iter = new_iter->next;
+  }
+
+  prev->next = NULL;
+  rich_text_render_node_destroy(first);
+  rich_text_node_destroy(rich_text->node);
+  rich_text->node = node;
+  rich_text->rows.size = row;
+
+  prev->next = rich_text_render_node_layout_from(widget, new_iter, offset, y, c, widget->w,
+                                                 widget->h, rich_text->margin, rich_text->line_gap);
+  if (prev->next == NULL || rich_text_update_rows(widget, prev->next) != RET_OK) {
+    rich_text_render_node_destroy(rich_text->render_node);
+    rich_text->render_node = NULL;
+    darray_clear(&(rich_text->rows));
+  }
+
+  return RET_OK;
+}
+
 static ret_t rich_text_ensure_render_node(widget_t* widget, canvas_t* c) {
+  bool_t style_changed = FALSE;
   rich_text_t* rich_text = RICH_TEXT(widget);
   style_t* style = widget != NULL ? widget->astyle : NULL;
   const char* default_font_name = style_get_str(style, STYLE_ID_FONT_NAME, NULL);
@@ -201,21 +380,25 @@ static ret_t rich_text_ensure_render_node(widget_t* widget, canvas_t* c) {
       (align_v_t)style_get_int(style, STYLE_ID_TEXT_ALIGN_V, ALIGN_V_BOTTOM);
   return_value_if_fail(widget != NULL && rich_text != NULL && style != NULL, RET_BAD_PARAMS);
 
-  rich_text->need_reset =
-      rich_text->need_reset ||
-      rich_text_is_need_reset_from_style(rich_text, default_font_name, default_font_size,
-                                         default_color, default_align_v);
+  style_changed = rich_text_is_need_reset_from_style(rich_text, default_font_name, default_font_size,
+                                                     default_color, default_align_v);
+  rich_text->need_reset = rich_text->need_reset || style_changed;
 
   if (rich_text->need_reset) {
     str_t str;
+    rich_text_node_t* node = NULL;
     str_init(&str, widget->text.size * 4 + 1);
     str_from_wstr(&str, widget->text.str);
-    rich_text_reset(widget);
-    rich_text->node = rich_text_parse(str.str, str.size, default_font_name, default_font_size,
-                                      default_color, default_align_v);
+    node = rich_text_parse(str.str, str.size, default_font_name, default_font_size, default_color,
+                           default_align_v);
     str_reset(&str);
     rich_text->need_reset = FALSE;
 
+    if (style_changed || rich_text_layout_appended(widget, c, node) != RET_OK) {
+      rich_text_reset(widget);
+      rich_text->node = node;
+    }
+
     rich_text->default_color = default_color;
     rich_text->default_align_v = default_align_v;
     rich_text->default_font_size = default_font_size;
@@ -238,6 +421,10 @@ static ret_t rich_text_ensure_render_node(widget_t* widget, canvas_t* c) {
 
     rich_text->render_node =
         rich_text_render_node_layout(widget, rich_text->node, c, w, h, margin, line_gap);
+    rich_text_update_rows(widget, rich_text->render_node);
+    rich_text->layout_w = w;
+    rich_text->layout_margin = margin;
+    rich_text->layout_line_gap = line_gap;
     widget_set_prop_int(WIDGET(rich_text), WIDGET_PROP_YOFFSET, 0);
   }
   return_value_if_fail(rich_text->render_node != NULL, RET_OOM);
@@ -570,7 +757,13 @@ static ret_t rich_text_get_prop(widget_t* widget, const char* name, value_t* v)
 }
 
 static ret_t rich_text_on_destroy(widget_t* widget) {
-  return rich_text_reset(widget);
+  rich_text_t* rich_text = RICH_TEXT(widget);
+  return_value_if_fail(rich_text != NULL, RET_BAD_PARAMS);
+
+  rich_text_reset(widget);
+  darray_deinit(&(rich_text->rows));
+
+  return RET_OK;
 }
 
 ret_t rich_text_set_yslidable(widget_t* widget, bool_t yslidable) {
@@ -601,6 +794,7 @@ widget_t* rich_text_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
   return_value_if_fail(rich_text != NULL, NULL);
 
   rich_text->yslidable = TRUE;
+  darray_init(&(rich_text->rows), 0, NULL, NULL);
 
   return widget;
 }
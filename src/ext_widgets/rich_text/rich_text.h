@@ -22,6 +22,7 @@
 #ifndef TK_RICH_TEXT_H
 #define TK_RICH_TEXT_H
 
+#include "tkc/darray.h"
 #include "base/widget.h"
 #include "base/velocity.h"
 #include "base/widget_animator.h"
@@ -82,6 +83,9 @@ BEGIN_C_DECLS
  *   * italic 斜体(暂不支持)
  *   * underline 下划线(暂不支持)
  *
+ * > 新设置的文本以原来的文本开头(如在实时日志后面追加内容)时，只重新排版末尾的行及追加的内容，
+ * 并保持滚动的位置不变。
+ *
  */
 typedef struct _rich_text_t {
   widget_t widget;
@@ -124,6 +128,12 @@ typedef struct _rich_text_t {
   velocity_t velocity;
   int32_t yoffset_save;
   rich_text_render_node_t* render_node;
+  /*每行第一个渲染节点，用于绘制时二分查找第一个可见的行。*/
+  darray_t rows;
+  /*排版时的参数，参数不变时追加的文本可以只排版最后几行。*/
+  int32_t layout_w;
+  int32_t layout_margin;
+  uint32_t layout_line_gap;
 
   int32_t margin;
   int32_t attribute_margin;
@@ -150,6 +160,9 @@ widget_t* rich_text_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h);
 /**
  * @method rich_text_set_text
  * 设置文本。
+ *
+ * > 新的文本以原来的文本开头时，已经排版的行(末尾的行除外)保持不变。
+ *
  * @annotation ["scriptable"]
  * @param {widget_t*} widget 控件对象。
  * @param {char*}  text 文本。
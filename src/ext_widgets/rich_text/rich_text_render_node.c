@@ -126,21 +126,39 @@ break_type_t rich_text_line_break_check(wchar_t c1, wchar_t c2) {
   return break_type;
 }
 
+/*节点按顺序追加到链表的末尾，记住末尾的节点，避免每次从头查找。*/
+#define APPEND_RENDER_NODE(new_node)   \
+  if (last_node == NULL) {             \
+    render_node = new_node;            \
+  } else {                             \
+    last_node->next = new_node;        \
+  }                                    \
+  last_node = new_node;
+
 rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_text_node_t* node,
                                                       canvas_t* c, int32_t w, int32_t h,
                                                       int32_t margin, int32_t line_gap) {
+  return rich_text_render_node_layout_from(widget, node, 0, margin, c, w, h, margin, line_gap);
+}
+
+rich_text_render_node_t* rich_text_render_node_layout_from(widget_t* widget,
+                                                           rich_text_node_t* node,
+                                                           uint32_t offset, int32_t y,
+                                                           canvas_t* c, int32_t w, int32_t h,
+                                                           int32_t margin, int32_t line_gap) {
   int32_t row_h = 0;
   int32_t x = margin;
-  int32_t y = margin;
   int32_t right = w - margin;
   int32_t client_w = w - 2 * margin;
   int32_t client_h = h - 2 * margin;
   rich_text_node_t* iter = node;
   rich_text_t* rich_text = RICH_TEXT(widget);
   rich_text_render_node_t* new_node = NULL;
+  rich_text_render_node_t* last_node = NULL;
   rich_text_render_node_t* render_node = NULL;
   rich_text_render_node_t* row_first_node = NULL;
   return_value_if_fail(node != NULL && c != NULL && client_w > 0 && client_h > 0, NULL);
+  return_value_if_fail(offset == 0 || node->type == RICH_TEXT_TEXT, NULL);
 
   while (iter != NULL) {
     switch (iter->type) {
@@ -178,7 +196,7 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
           row_h = image->h;
         }
 
-        render_node = rich_text_render_node_append(render_node, new_node);
+        APPEND_RENDER_NODE(new_node);
         if (x + image->w >= right) {
           MOVE_TO_NEXT_ROW();
         } else {
@@ -207,7 +225,16 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
         }
         canvas_set_font(c, iter->u.text.font.name, font_size);
 
-        for (i = 0; str[i]; i++) {
+        if (offset > 0) {
+          /*从文本中间的行首继续排版，状态与上面换行之后相同。*/
+          start = offset;
+          last_breakable = offset;
+          tw = canvas_measure_text(c, str + offset, 1);
+          i = offset + 1;
+          offset = 0;
+        }
+
+        for (; str[i]; i++) {
           cw = canvas_measure_text(c, str + i, 1);
           if (i > 0) {
             break_type = rich_text_line_break_check(str[i - 1], str[i]);
@@ -245,7 +272,7 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
             new_node->size = i - start;
             new_node->rect = rect_init(x, y, tw, font_size);
 
-            render_node = rich_text_render_node_append(render_node, new_node);
+            APPEND_RENDER_NODE(new_node);
             if (row_first_node == NULL) {
               row_first_node = new_node;
             }
@@ -296,7 +323,7 @@ rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_tex
           x += tw + 1;
           tw = 0;
 
-          render_node = rich_text_render_node_append(render_node, new_node);
+          APPEND_RENDER_NODE(new_node);
           if (row_first_node == NULL) {
             row_first_node = new_node;
           }
@@ -62,6 +62,12 @@ bool_t rich_text_is_flexable_w_char(wchar_t c);
 rich_text_render_node_t* rich_text_render_node_layout(widget_t* widget, rich_text_node_t* node,
                                                       canvas_t* c, int32_t w, int32_t h,
                                                       int32_t margin, int32_t line_gap);
+/*从node的第offset个字符开始排版，该字符位于纵坐标为y的行首(offset为0时是节点的开头)。*/
+rich_text_render_node_t* rich_text_render_node_layout_from(widget_t* widget,
+                                                           rich_text_node_t* node,
+                                                           uint32_t offset, int32_t y,
+                                                           canvas_t* c, int32_t w, int32_t h,
+                                                           int32_t margin, int32_t line_gap);
 rich_text_render_node_t* rich_text_render_node_append(rich_text_render_node_t* node,
                                                       rich_text_render_node_t* next);
 
@@ -384,6 +384,44 @@ static ret_t children_layouter_list_view_for_list_view_set_scroll_bar_info(widge
   return RET_OK;
 }
 
+/*虚拟列表模式：虚拟高度由数据个数计算，只布局可见的列表项。*/
+static ret_t children_layouter_list_view_for_list_view_layout_virtual(children_layouter_t* layouter,
+                                                                      widget_t* widget,
+                                                                      int32_t item_height) {
+  rect_t r;
+  int32_t rows = 0;
+  int32_t virtual_h = 0;
+  int32_t scroll_view_w = 0;
+  list_view_t* list_view = LIST_VIEW(widget->parent);
+  children_layouter_list_view_t* l = (children_layouter_list_view_t*)layouter;
+  uint32_t cols = l->cols <= 1 ? 1 : l->cols;
+
+  if (item_height <= 0 && list_view->item_template != NULL) {
+    item_height = list_view->item_template->h;
+  }
+  return_value_if_fail(item_height > 0, RET_BAD_PARAMS);
+
+  rows = (list_view->items_nr + cols - 1) / cols;
+  virtual_h = l->y_margin + rows * (item_height + l->spacing);
+  scroll_view_w =
+      children_layouter_list_view_for_list_view_get_scroll_view_w(list_view, widget, virtual_h);
+  widget_resize(widget, scroll_view_w, widget->h);
+
+  r.x = l->x_margin;
+  r.y = l->y_margin;
+  r.w = (scroll_view_w - 2 * l->x_margin - (cols - 1) * l->spacing) / cols;
+  r.h = item_height;
+  list_view_layout_virtual_items(WIDGET(list_view), &r, l->spacing, cols);
+
+  /*修正偏移量后通过on_scroll重新绑定可见的列表项。*/
+  children_layouter_list_view_for_list_view_set_scroll_view_info(widget, list_view->scroll_bar,
+                                                                 virtual_h);
+  children_layouter_list_view_for_list_view_set_scroll_bar_info(list_view->scroll_bar, list_view,
+                                                                widget, virtual_h, item_height);
+
+  return RET_OK;
+}
+
 static ret_t children_layouter_list_view_for_list_view_layout(children_layouter_t* layouter,
                                                               widget_t* widget) {
   int32_t virtual_h = 0;
@@ -401,6 +439,11 @@ static ret_t children_layouter_list_view_for_list_view_layout(children_layouter_
   default_item_height =
       list_view->default_item_height ? list_view->default_item_height : l->default_item_height;
 
+  if (list_view->get_items_nr != NULL) {
+    item_height = item_height > 0 ? item_height : default_item_height;
+    return children_layouter_list_view_for_list_view_layout_virtual(layouter, widget, item_height);
+  }
+
   if (widget->children != NULL) {
     int32_t scroll_view_w = 0;
     darray_t children_for_layout;
@@ -32,6 +32,7 @@
 
 static ret_t list_view_on_add_child(widget_t* widget, widget_t* child);
 static ret_t list_view_on_remove_child(widget_t* widget, widget_t* child);
+static ret_t list_view_update_virtual_items(list_view_t* list_view);
 
 static ret_t list_view_on_paint_self(widget_t* widget, canvas_t* c) {
   return widget_paint_helper(widget, c, NULL, NULL);
@@ -146,6 +147,29 @@ static ret_t list_view_on_pointer_enter(list_view_t* list_view) {
   return RET_OK;
 }
 
+static ret_t list_view_reset_virtual_items(list_view_t* list_view) {
+  if (list_view->item_template != NULL) {
+    widget_unref(list_view->item_template);
+    list_view->item_template = NULL;
+  }
+
+  TKMEM_FREE(list_view->item_indexes);
+  list_view->item_indexes_capacity = 0;
+  list_view->get_items_nr = NULL;
+  list_view->bind_item = NULL;
+  list_view->data_ctx = NULL;
+  list_view->items_nr = 0;
+
+  return RET_OK;
+}
+
+static ret_t list_view_on_destroy(widget_t* widget) {
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL, RET_BAD_PARAMS);
+
+  return list_view_reset_virtual_items(list_view);
+}
+
 static ret_t list_view_on_event(widget_t* widget, event_t* e) {
   ret_t ret = RET_OK;
   list_view_t* list_view = LIST_VIEW(widget);
@@ -203,7 +227,8 @@ TK_DECL_VTABLE(list_view) = {.type = WIDGET_TYPE_LIST_VIEW,
                              .on_event = list_view_on_event,
                              .on_add_child = list_view_on_add_child,
                              .on_remove_child = list_view_on_remove_child,
-                             .on_paint_self = list_view_on_paint_self};
+                             .on_paint_self = list_view_on_paint_self,
+                             .on_destroy = list_view_on_destroy};
 
 static int32_t scroll_bar_to_scroll_view(list_view_t* list_view, int32_t v) {
   int32_t range = 0;
@@ -231,6 +256,7 @@ static ret_t list_view_on_scroll_bar_value_changed(void* ctx, event_t* e) {
   scroll_bar = SCROLL_BAR(list_view->scroll_bar);
   offset = scroll_bar_to_scroll_view(list_view, scroll_bar->value);
   scroll_view_set_offset(list_view->scroll_view, 0, offset);
+  list_view_update_virtual_items(list_view);
 
   return RET_OK;
 }
@@ -256,6 +282,7 @@ static ret_t list_view_on_scroll_view_scroll(widget_t* widget, int32_t xoffset,
   list_view_t* list_view = LIST_VIEW(widget->parent);
   return_value_if_fail(list_view != NULL, RET_BAD_PARAMS);
 
+  list_view_update_virtual_items(list_view);
   if (list_view->scroll_bar != NULL) {
     int32_t value = scroll_view_to_scroll_bar(list_view, yoffset);
     scroll_bar_set_value_only(list_view->scroll_bar, value);
@@ -304,6 +331,9 @@ static ret_t list_view_on_scroll_view_paint_children(widget_t* widget, canvas_t*
   int32_t right = 0;
   int32_t max_w = canvas_get_width(c);
   int32_t max_h = canvas_get_height(c);
+  list_view_t* list_view = LIST_VIEW(widget->parent);
+  /*虚拟列表的列表项循环使用，不是按位置排序的。*/
+  bool_t sorted = list_view == NULL || list_view->get_items_nr == NULL;
 
   WIDGET_FOR_EACH_CHILD_BEGIN(widget, iter, i)
 
@@ -318,7 +348,11 @@ static ret_t list_view_on_scroll_view_paint_children(widget_t* widget, canvas_t*
   right = left + iter->w;
 
   if (top > max_h || left > max_w) {
-    break;
+    if (sorted) {
+      break;
+    }
+    iter->dirty = FALSE;
+    continue;
   }
 
   if (bottom < 0 || right < 0) {
@@ -490,6 +524,166 @@ ret_t list_view_set_floating_scroll_bar(widget_t* widget, bool_t floating_scroll
   return RET_OK;
 }
 
+static ret_t list_view_ensure_virtual_items(list_view_t* list_view, uint32_t nr) {
+  uint32_t i = 0;
+  widget_t* scroll_view = list_view->scroll_view;
+
+  if (nr > list_view->item_indexes_capacity) {
+    int32_t* item_indexes = TKMEM_REALLOCT(int32_t, list_view->item_indexes, nr);
+    return_value_if_fail(item_indexes != NULL, RET_OOM);
+
+    for (i = list_view->item_indexes_capacity; i < nr; i++) {
+      item_indexes[i] = -1;
+    }
+    list_view->item_indexes = item_indexes;
+    list_view->item_indexes_capacity = nr;
+  }
+
+  for (i = widget_count_children(scroll_view); i < nr; i++) {
+    return_value_if_fail(widget_clone(list_view->item_template, scroll_view) != NULL, RET_OOM);
+  }
+
+  return RET_OK;
+}
+
+/*第index个数据总是由第(index % 列表项个数)个列表项显示，滚动时只需要重新绑定新出现的行。*/
+static ret_t list_view_update_virtual_items(list_view_t* list_view) {
+  int32_t k = 0;
+  int32_t nr = 0;
+  int32_t end = 0;
+  int32_t first = 0;
+  int32_t row_h = 0;
+  int32_t yoffset = 0;
+  int32_t last_row = 0;
+  int32_t first_row = 0;
+  widget_t** children = NULL;
+  rect_t* r = &(list_view->item_rect);
+  int32_t cols = list_view->item_cols;
+  widget_t* scroll_view = list_view->scroll_view;
+
+  if (list_view->get_items_nr == NULL || scroll_view == NULL || r->h <= 0 || cols <= 0) {
+    return RET_OK;
+  }
+
+  row_h = r->h + list_view->item_spacing;
+  yoffset = SCROLL_VIEW(scroll_view)->yoffset;
+  first_row = tk_max(0, (yoffset - r->y) / row_h - TK_LIST_VIEW_VIRTUAL_MARGIN_ROWS);
+  last_row = (yoffset + scroll_view->h - r->y) / row_h + TK_LIST_VIEW_VIRTUAL_MARGIN_ROWS;
+  first = first_row * cols;
+  end = tk_min((int32_t)(list_view->items_nr), (last_row + 1) * cols);
+  if (end > first) {
+    return_value_if_fail(list_view_ensure_virtual_items(list_view, end - first) == RET_OK, RET_OOM);
+  }
+
+  nr = widget_count_children(scroll_view);
+  if (nr == 0) {
+    return RET_OK;
+  }
+
+  children = (widget_t**)(scroll_view->children->elms);
+  for (k = 0; k < nr; k++) {
+    widget_t* iter = children[k];
+    int32_t index = first + (k + nr - first % nr) % nr;
+
+    if (index < end) {
+      bool_t bound = list_view->item_indexes[k] == index;
+      xy_t x = r->x + (index % cols) * (r->w + list_view->item_spacing);
+      xy_t y = r->y + (index / cols) * row_h;
+
+      widget_set_visible_only(iter, TRUE);
+      widget_move_resize(iter, x, y, r->w, r->h);
+      if (!bound) {
+        list_view->item_indexes[k] = index;
+        list_view->bind_item(list_view->data_ctx, iter, index);
+      }
+
+      if (!bound || iter->need_relayout) {
+        widget_layout_children(iter);
+      }
+    } else if (iter->visible) {
+      widget_set_visible_only(iter, FALSE);
+      list_view->item_indexes[k] = -1;
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t list_view_layout_virtual_items(widget_t* widget, const rect_t* item_rect, int32_t spacing,
+                                     uint32_t cols) {
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && item_rect != NULL, RET_BAD_PARAMS);
+
+  list_view->item_rect = *item_rect;
+  list_view->item_spacing = spacing;
+  list_view->item_cols = tk_max(cols, 1);
+
+  return list_view_update_virtual_items(list_view);
+}
+
+ret_t list_view_set_data_source(widget_t* widget, list_view_get_items_nr_t get_items_nr,
+                                list_view_bind_item_t bind_item, void* ctx) {
+  widget_t* scroll_view = NULL;
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && list_view->scroll_view != NULL, RET_BAD_PARAMS);
+  return_value_if_fail((get_items_nr == NULL) == (bind_item == NULL), RET_BAD_PARAMS);
+
+  scroll_view = list_view->scroll_view;
+  if (get_items_nr != NULL && list_view->item_template == NULL) {
+    widget_t* item = widget_get_child(scroll_view, 0);
+    return_value_if_fail(item != NULL, RET_BAD_PARAMS);
+
+    widget_remove_child(scroll_view, item);
+    list_view->item_template = item;
+  }
+
+  widget_destroy_children(scroll_view);
+  if (get_items_nr == NULL) {
+    return list_view_reset_virtual_items(list_view);
+  }
+
+  list_view->data_ctx = ctx;
+  list_view->bind_item = bind_item;
+  list_view->get_items_nr = get_items_nr;
+
+  return list_view_reload(widget);
+}
+
+ret_t list_view_reload(widget_t* widget) {
+  uint32_t i = 0;
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && list_view->get_items_nr != NULL, RET_BAD_PARAMS);
+
+  list_view->items_nr = list_view->get_items_nr(list_view->data_ctx);
+  for (i = 0; i < list_view->item_indexes_capacity; i++) {
+    list_view->item_indexes[i] = -1;
+  }
+
+  if (list_view->scroll_view != NULL) {
+    widget_set_need_relayout_children(list_view->scroll_view);
+    widget_invalidate(list_view->scroll_view, NULL);
+  }
+
+  return RET_OK;
+}
+
+int32_t list_view_get_item_index(widget_t* widget, widget_t* item) {
+  int32_t k = 0;
+  list_view_t* list_view = LIST_VIEW(widget);
+  return_value_if_fail(list_view != NULL && item != NULL, -1);
+
+  while (item != NULL && item->parent != list_view->scroll_view) {
+    item = item->parent;
+  }
+
+  k = item != NULL ? widget_index_of(item) : -1;
+  if (k < 0 || k >= (int32_t)(list_view->item_indexes_capacity)) {
+    return -1;
+  }
+
+  return list_view->item_indexes[k];
+}
+
 widget_t* list_view_cast(widget_t* widget) {
   return_value_if_fail(WIDGET_IS_INSTANCE_OF(widget, list_view), NULL);
 
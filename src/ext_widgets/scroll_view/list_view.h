@@ -26,6 +26,33 @@
 
 BEGIN_C_DECLS
 
+/*虚拟列表在可见的列表项之外额外保留的行数。*/
+#ifndef TK_LIST_VIEW_VIRTUAL_MARGIN_ROWS
+#define TK_LIST_VIEW_VIRTUAL_MARGIN_ROWS 2
+#endif /*TK_LIST_VIEW_VIRTUAL_MARGIN_ROWS*/
+
+/**
+ * @method list_view_get_items_nr_t
+ * 获取虚拟列表数据个数的回调函数。
+ * @annotation ["global"]
+ * @param {void*} ctx 回调函数上下文。
+ *
+ * @return {uint32_t} 返回数据的个数。
+ */
+typedef uint32_t (*list_view_get_items_nr_t)(void* ctx);
+
+/**
+ * @method list_view_bind_item_t
+ * 把虚拟列表的第index个数据绑定到列表项控件的回调函数。
+ * @annotation ["global"]
+ * @param {void*} ctx 回调函数上下文。
+ * @param {widget_t*} item 列表项控件。
+ * @param {uint32_t} index 数据的序号。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+typedef ret_t (*list_view_bind_item_t)(void* ctx, widget_t* item, uint32_t index);
+
 /**
  * @class list_view_t
  * @parent widget_t
@@ -79,6 +106,22 @@ BEGIN_C_DECLS
  * 
  * 备注：list_view 下的 scroll_view 控件不支持遍历所有子控件的效果。
  * 
+ * 数据很多时(如日志)，可以用list\_view\_set\_data\_source启用虚拟列表模式：
+ * scroll\_view的第一个子控件作为列表项模板，只为可见的行(以及上下各TK\_LIST\_VIEW\_VIRTUAL\_MARGIN\_ROWS行)
+ * 创建列表项，滚动时重复使用这些列表项，并通过回调函数绑定对应的数据。虚拟列表模式下所有列表项的高度相同。
+ *
+ * ```c
+ *  static uint32_t log_get_items_nr(void* ctx) {
+ *    return 10000;
+ *  }
+ *
+ *  static ret_t log_bind_item(void* ctx, widget_t* item, uint32_t index) {
+ *    return widget_set_text_utf8(widget_lookup(item, "text", TRUE), log_get_line(index));
+ *  }
+ *
+ *  list_view_set_data_source(list_view, log_get_items_nr, log_bind_item, NULL);
+ * ```
+ *
  * 下面是针对 scroll_bar_d （桌面版）有效果，scroll_bar_m（移动版）没有效果。
  * 如果 floating_scroll_bar 属性为 TRUE 和 auto_hide_scroll_bar 属性为 TRUE，scroll_view 宽默认为 list_view 的 100% 宽，鼠标在 list_view 上滚动条才显示，不在的就自动隐藏，如果 scroll_view 的高比虚拟高要大的话，滚动条变成不可见，scroll_view 宽不会变。
  * 如果 floating_scroll_bar 属性为 TRUE 和 auto_hide_scroll_bar 属性为 FALSE ，scroll_view 宽默认为 list_view 的 100% 宽，滚动条不隐藏，如果 scroll_view 的高比虚拟高要大的话，滚动条变成不可见，scroll_view 宽不会变。
@@ -114,11 +157,29 @@ typedef struct _list_view_t {
    */
   bool_t floating_scroll_bar;
 
+  /**
+   * @property {uint32_t} items_nr
+   * @annotation ["readable"]
+   * 虚拟列表的数据个数(非虚拟列表模式时为0)。
+   */
+  uint32_t items_nr;
+
   /*private*/
   bool_t is_over;
   widget_t* scroll_view;
   widget_t* scroll_bar;
   uint32_t wheel_before_id;
+
+  /*虚拟列表*/
+  void* data_ctx;
+  list_view_get_items_nr_t get_items_nr;
+  list_view_bind_item_t bind_item;
+  widget_t* item_template;
+  int32_t* item_indexes;
+  uint32_t item_indexes_capacity;
+  rect_t item_rect;
+  int32_t item_spacing;
+  uint32_t item_cols;
 } list_view_t;
 
 /**
@@ -179,6 +240,56 @@ ret_t list_view_set_auto_hide_scroll_bar(widget_t* widget, bool_t auto_hide_scro
  */
 ret_t list_view_set_floating_scroll_bar(widget_t* widget, bool_t floating_scroll_bar);
 
+/**
+ * @method list_view_set_data_source
+ * 设置虚拟列表的数据源。
+ *
+ * > scroll\_view的第一个子控件作为列表项模板，其它子控件被删除，列表项由list\_view创建和重复使用。
+ * > get\_items\_nr和bind\_item为NULL时退出虚拟列表模式，删除全部列表项和模板。
+ *
+ * @param {widget_t*} widget 控件对象。
+ * @param {list_view_get_items_nr_t} get_items_nr 获取数据个数的回调函数。
+ * @param {list_view_bind_item_t} bind_item 绑定数据的回调函数。
+ * @param {void*} ctx 回调函数上下文。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_set_data_source(widget_t* widget, list_view_get_items_nr_t get_items_nr,
+                                list_view_bind_item_t bind_item, void* ctx);
+
+/**
+ * @method list_view_reload
+ * 数据变化后重新获取数据个数，并重新绑定全部列表项(虚拟列表模式)。
+ * @param {widget_t*} widget 控件对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_reload(widget_t* widget);
+
+/**
+ * @method list_view_get_item_index
+ * 获取列表项当前绑定的数据的序号(虚拟列表模式)。
+ * @param {widget_t*} widget 控件对象。
+ * @param {widget_t*} item 列表项控件(或者列表项的子控件)。
+ *
+ * @return {int32_t} 返回数据的序号，失败返回-1。
+ */
+int32_t list_view_get_item_index(widget_t* widget, widget_t* item);
+
+/**
+ * @method list_view_layout_virtual_items
+ * 根据滚动的偏移量布局和绑定可见的列表项(供children\_layouter\_list\_view使用)。
+ * @annotation ["private"]
+ * @param {widget_t*} widget 控件对象。
+ * @param {const rect_t*} item_rect 第一个列表项的位置和大小。
+ * @param {int32_t} spacing 列表项之间的间距。
+ * @param {uint32_t} cols 列数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t list_view_layout_virtual_items(widget_t* widget, const rect_t* item_rect, int32_t spacing,
+                                     uint32_t cols);
+
 /**
  * @method list_view_cast
  * 转换为list_view对象(供脚本语言使用)。
@@ -24,6 +24,8 @@
 #include "tkc/utils.h"
 #include "svg/bsvg_draw.h"
 #include "base/widget_vtable.h"
+#include "base/image_manager.h"
+#include "base/widget_animator_manager.h"
 #include "svg_image/svg_image.h"
 
 static ret_t svg_image_load_bsvg(widget_t* widget) {
@@ -49,9 +51,121 @@ static ret_t svg_image_load_bsvg(widget_t* widget) {
   return RET_OK;
 }
 
+#ifndef WITH_NANOVG_GPU
+static bitmap_format_t svg_image_get_raster_format(canvas_t* c) {
+  bitmap_format_t format = BITMAP_FMT_RGBA8888;
+
+  if (c->lcd != NULL && c->lcd->get_desired_bitmap_format != NULL) {
+    format = lcd_get_desired_bitmap_format(c->lcd);
+  }
+
+  /*需要透明度，只使用32位的格式。*/
+  return format == BITMAP_FMT_BGRA8888 ? BITMAP_FMT_BGRA8888 : BITMAP_FMT_RGBA8888;
+}
+
+static ret_t svg_image_rasterize(bsvg_t* bsvg, bitmap_t* bitmap, float_t scale_x, float_t scale_y,
+                                 color_t bg, color_t fg) {
+  rect_t r;
+  uint8_t* data = NULL;
+  vgcanvas_t* vg = NULL;
+
+  data = bitmap_lock_buffer_for_write(bitmap);
+  return_value_if_fail(data != NULL, RET_FAIL);
+
+  memset(data, 0x00, bitmap->line_length * bitmap->h);
+  vg = vgcanvas_create(bitmap->w, bitmap->h, bitmap->line_length, (bitmap_format_t)(bitmap->format),
+                       data);
+  if (vg == NULL) {
+    bitmap_unlock_buffer(bitmap);
+    return RET_OOM;
+  }
+
+  r = rect_init(0, 0, bitmap->w, bitmap->h);
+  vgcanvas_begin_frame(vg, &r);
+  vgcanvas_clip_rect(vg, r.x, r.y, r.w, r.h);
+  vgcanvas_begin_path(vg);
+  vgcanvas_save(vg);
+  vgcanvas_scale(vg, scale_x, scale_y);
+  vgcanvas_set_fill_color(vg, bg);
+  vgcanvas_set_stroke_color(vg, fg);
+  bsvg_draw(bsvg, vg);
+  vgcanvas_restore(vg);
+  vgcanvas_end_frame(vg);
+  vgcanvas_destroy(vg);
+  bitmap_unlock_buffer(bitmap);
+
+  return RET_OK;
+}
+
+/*
+ * 没有旋转和动画时，绘制缓存在图片管理器中的光栅化位图。
+ * 位图按资源、缩放后的大小、颜色和缩放比例区分，没有缓存时光栅化一次。
+ */
+static ret_t svg_image_draw_raster(widget_t* widget, canvas_t* c, bsvg_t* bsvg, int32_t x,
+                                   int32_t y, int32_t svg_w, int32_t svg_h, color_t bg,
+                                   color_t fg) {
+  rect_t src;
+  rect_t dst;
+  bitmap_t bitmap;
+  int32_t w = 0;
+  int32_t h = 0;
+  float_t anchor_x = 0;
+  float_t anchor_y = 0;
+  char key[MAX_PATH + 64];
+  image_manager_t* imm = widget_get_image_manager(widget);
+  svg_image_t* svg_image = SVG_IMAGE(widget);
+  image_base_t* image_base = IMAGE_BASE(widget);
+  float_t scale_x = image_base->scale_x;
+  float_t scale_y = image_base->scale_y;
+
+  if (imm == NULL || imm->raster_max_size == 0 || image_base->rotation != 0 || svg_w <= 0 ||
+      svg_h <= 0 || scale_x <= 0 || scale_y <= 0) {
+    return RET_NOT_IMPL;
+  }
+
+  if (widget_animator_manager() != NULL && widget_find_animator(widget, NULL) != NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  w = (int32_t)(svg_w * scale_x + 0.99f);
+  h = (int32_t)(svg_h * scale_y + 0.99f);
+  if ((uint64_t)w * h * 4 > imm->raster_max_size) {
+    return RET_NOT_IMPL;
+  }
+
+  tk_snprintf(key, sizeof(key), "svg:%s:%dx%d:%08x:%08x", svg_image->bsvg_asset->name, w, h,
+              bg.color, fg.color);
+  if (image_manager_get_raster(imm, key, &bitmap) != RET_OK) {
+    if (bitmap_init(&bitmap, w, h, svg_image_get_raster_format(c), NULL) != RET_OK) {
+      return RET_OOM;
+    }
+
+    if (svg_image_rasterize(bsvg, &bitmap, (float_t)w / svg_w, (float_t)h / svg_h, bg, fg) !=
+        RET_OK) {
+      bitmap_destroy(&bitmap);
+      return RET_FAIL;
+    }
+
+    if (image_manager_add_raster(imm, key, &bitmap) != RET_OK ||
+        image_manager_get_raster(imm, key, &bitmap) != RET_OK) {
+      return RET_FAIL;
+    }
+  }
+
+  /*与image_transform相同：以锚点为中心缩放。*/
+  anchor_x = image_base->anchor_x * widget->w;
+  anchor_y = image_base->anchor_y * widget->h;
+  src = rect_init(0, 0, w, h);
+  dst = rect_init(tk_roundi(anchor_x + (x - anchor_x) * scale_x),
+                  tk_roundi(anchor_y + (y - anchor_y) * scale_y), w, h);
+
+  return canvas_draw_image(c, &bitmap, &src, &dst);
+}
+#endif /*WITH_NANOVG_GPU*/
+
 static ret_t svg_image_on_paint_self(widget_t* widget, canvas_t* c) {
+  vgcanvas_t* vg = NULL;
   svg_image_t* svg_image = SVG_IMAGE(widget);
-  vgcanvas_t* vg = canvas_get_vgcanvas(c);
   image_base_t* image_base = IMAGE_BASE(widget);
   return_value_if_fail(svg_image != NULL && image_base != NULL && widget != NULL, RET_BAD_PARAMS);
 
@@ -64,6 +178,8 @@ static ret_t svg_image_on_paint_self(widget_t* widget, canvas_t* c) {
     bsvg_t bsvg;
     int32_t x = 0;
     int32_t y = 0;
+    int32_t svg_w = 0;
+    int32_t svg_h = 0;
     style_t* style = widget->astyle;
     color_t black = color_init(0, 0, 0, 0xff);
     const asset_info_t* asset = svg_image->bsvg_asset;
@@ -74,13 +190,25 @@ static ret_t svg_image_on_paint_self(widget_t* widget, canvas_t* c) {
     return_value_if_fail(bsvg_init(&bsvg, (const uint32_t*)asset->data, asset->size) != NULL,
                          RET_BAD_PARAMS);
     if (bsvg.header->w && bsvg.header->h) {
-      x = (widget->w - (int32_t)bsvg.header->w) / 2;
-      y = (widget->h - (int32_t)bsvg.header->h) / 2;
+      svg_w = bsvg.header->w;
+      svg_h = bsvg.header->h;
     } else if (bsvg.header->viewport.w && bsvg.header->viewport.h) {
-      x = (widget->w - (int32_t)bsvg.header->viewport.w) / 2;
-      y = (widget->h - (int32_t)bsvg.header->viewport.h) / 2;
+      svg_w = bsvg.header->viewport.w;
+      svg_h = bsvg.header->viewport.h;
+    }
+    if (svg_w > 0 && svg_h > 0) {
+      x = (widget->w - svg_w) / 2;
+      y = (widget->h - svg_h) / 2;
+    }
+
+#ifndef WITH_NANOVG_GPU
+    if (svg_image_draw_raster(widget, c, &bsvg, x, y, svg_w, svg_h, bg, fg) == RET_OK) {
+      widget_paint_helper(widget, c, NULL, NULL);
+      return RET_OK;
     }
+#endif /*WITH_NANOVG_GPU*/
 
+    vg = canvas_get_vgcanvas(c);
     vgcanvas_save(vg);
 
     image_transform(widget, c);
@@ -69,6 +69,9 @@ BEGIN_C_DECLS
  * > 更多用法请参考：[theme default](
  * https://github.com/zlgopen/awtk/blob/master/design/default/styles/default.xml)
  *
+ * > 软件渲染时，没有旋转和动画的SVG图片光栅化成位图后缓存在图片管理器中，之后直接绘制位图。
+ * 缓存的内存上限请参考image\_manager\_set\_raster\_cache\_max\_size。
+ *
  */
 typedef struct _svg_image_t {
   image_base_t image_base;
@@ -174,6 +174,144 @@ static ret_t image_loader_stb_load(image_loader_t* l, const asset_info_t* asset,
   return ret;
 }
 
+typedef struct _gif_decoder_impl_t {
+  stbi__context s;
+  stbi__gif g;
+  const uint8_t* buff;
+  uint32_t buff_size;
+} gif_decoder_impl_t;
+
+static ret_t gif_decoder_impl_reset(gif_decoder_impl_t* impl) {
+  STBI_FREE(impl->g.out);
+  STBI_FREE(impl->g.history);
+  STBI_FREE(impl->g.background);
+  memset(&(impl->g), 0x00, sizeof(impl->g));
+  stbi__start_mem(&(impl->s), impl->buff, impl->buff_size);
+
+  return RET_OK;
+}
+
+/*
+ * stb的处置方式处理不正确(2恢复为绘制上一帧之前的画面，3使用前两帧的画面)，这里自己处理，
+ * 并清除处置方式，让stb保留画面。stb解码每一帧之前，都会把画面拷贝到background中，
+ * 所以background正好是绘制当前帧之前的画面。
+ */
+static ret_t gif_decoder_impl_dispose(gif_decoder_impl_t* impl) {
+  int32_t y = 0;
+  int32_t dispose = 0;
+  int32_t line_size = 0;
+  int32_t row_size = 0;
+  stbi__gif* g = &(impl->g);
+
+  dispose = (g->eflags & 0x1C) >> 2;
+  g->eflags &= ~0x1C;
+  if (g->out == NULL || (dispose != 2 && dispose != 3)) {
+    return RET_OK;
+  }
+
+  line_size = g->w * 4;
+  row_size = g->max_x - g->start_x;
+  for (y = g->start_y; y < g->max_y; y += line_size) {
+    uint8_t* d = g->out + y + g->start_x;
+    if (dispose == 2) {
+      memset(d, 0x00, row_size);
+    } else {
+      memcpy(d, g->background + y + g->start_x, row_size);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t gif_decoder_load_next(gif_decoder_t* decoder) {
+  int comp = 0;
+  uint8_t* data = NULL;
+  gif_decoder_impl_t* impl = (gif_decoder_impl_t*)(decoder->impl);
+
+  gif_decoder_impl_dispose(impl);
+  data = stbi__gif_load_next(&(impl->s), &(impl->g), &comp, 0, NULL);
+  if (data == NULL || data == (uint8_t*)&(impl->s)) {
+    return RET_EOS;
+  }
+
+  decoder->w = impl->g.w;
+  decoder->h = impl->g.h;
+  decoder->data = data;
+  decoder->delay = impl->g.delay;
+
+  return RET_OK;
+}
+
+gif_decoder_t* gif_decoder_create(const uint8_t* buff, uint32_t buff_size) {
+  gif_decoder_t* decoder = NULL;
+  gif_decoder_impl_t* impl = NULL;
+  return_value_if_fail(buff != NULL && buff_size > 0, NULL);
+
+  decoder = TKMEM_ZALLOC(gif_decoder_t);
+  return_value_if_fail(decoder != NULL, NULL);
+
+  impl = TKMEM_ZALLOC(gif_decoder_impl_t);
+  goto_error_if_fail(impl != NULL);
+
+  impl->buff = buff;
+  impl->buff_size = buff_size;
+  decoder->impl = impl;
+
+  stbi__start_mem(&(impl->s), buff, buff_size);
+  goto_error_if_fail(stbi__gif_test(&(impl->s)));
+  goto_error_if_fail(gif_decoder_load_next(decoder) == RET_OK);
+
+  return decoder;
+error:
+  gif_decoder_destroy(decoder);
+
+  return NULL;
+}
+
+ret_t gif_decoder_next(gif_decoder_t* decoder) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(decoder != NULL && decoder->impl != NULL, RET_BAD_PARAMS);
+
+  ret = gif_decoder_load_next(decoder);
+  if (ret == RET_OK) {
+    decoder->index++;
+    return RET_OK;
+  }
+
+  /*数据损坏时，已经解码的帧仍然可以循环播放。*/
+  if (decoder->frames_nr == 0) {
+    decoder->frames_nr = decoder->index + 1;
+  }
+
+  return gif_decoder_rewind(decoder);
+}
+
+ret_t gif_decoder_rewind(gif_decoder_t* decoder) {
+  return_value_if_fail(decoder != NULL && decoder->impl != NULL, RET_BAD_PARAMS);
+
+  decoder->index = 0;
+  decoder->data = NULL;
+  gif_decoder_impl_reset((gif_decoder_impl_t*)(decoder->impl));
+
+  return gif_decoder_load_next(decoder);
+}
+
+ret_t gif_decoder_destroy(gif_decoder_t* decoder) {
+  gif_decoder_impl_t* impl = NULL;
+  return_value_if_fail(decoder != NULL, RET_BAD_PARAMS);
+
+  impl = (gif_decoder_impl_t*)(decoder->impl);
+  if (impl != NULL) {
+    STBI_FREE(impl->g.out);
+    STBI_FREE(impl->g.history);
+    STBI_FREE(impl->g.background);
+    TKMEM_FREE(impl);
+  }
+  TKMEM_FREE(decoder);
+
+  return RET_OK;
+}
+
 static const image_loader_t stb_loader = {.load = image_loader_stb_load};
 
 image_loader_t* image_loader_stb() {
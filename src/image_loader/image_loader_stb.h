@@ -67,6 +67,101 @@ image_loader_t* image_loader_stb(void);
 ret_t stb_load_image(int32_t subtype, const uint8_t* buff, uint32_t buff_size, bitmap_t* image,
                      bool_t require_bgra, bool_t enable_bgr565, bool_t enable_rgb565);
 
+/**
+ * @class gif_decoder_t
+ * 逐帧解码GIF动画。
+ *
+ * 只保存当前帧和上一帧合成后的画面，内存占用与帧数无关。
+ * 解码下一帧前，按照上一帧的处置方式(disposal method)处理画面：
+ *
+ * * 0/1 保留上一帧。
+ * * 2 把上一帧的区域恢复为背景(透明)。
+ * * 3 把上一帧的区域恢复为绘制上一帧之前的画面。
+ *
+ */
+typedef struct _gif_decoder_t {
+  /**
+   * @property {uint32_t} w
+   * @annotation ["readable"]
+   * 宽度。
+   */
+  uint32_t w;
+  /**
+   * @property {uint32_t} h
+   * @annotation ["readable"]
+   * 高度。
+   */
+  uint32_t h;
+  /**
+   * @property {uint32_t} index
+   * @annotation ["readable"]
+   * 当前帧的序号。
+   */
+  uint32_t index;
+  /**
+   * @property {uint32_t} delay
+   * @annotation ["readable"]
+   * 当前帧的显示时间(毫秒)。
+   */
+  uint32_t delay;
+  /**
+   * @property {uint32_t} frames_nr
+   * @annotation ["readable"]
+   * 总帧数(完整解码一遍之后才知道，之前为0)。
+   */
+  uint32_t frames_nr;
+  /**
+   * @property {const uint8_t*} data
+   * @annotation ["readable"]
+   * 当前帧的数据(RGBA8888格式，大小为w * h * 4)。
+   */
+  const uint8_t* data;
+
+  /*private*/
+  void* impl;
+} gif_decoder_t;
+
+/**
+ * @method gif_decoder_create
+ * 创建GIF解码器，并解码第一帧。
+ *
+ * > 解码器引用buff中的数据(不拷贝)，在解码器销毁之前，调用者不能释放buff。
+ *
+ * @annotation ["constructor"]
+ * @param {const uint8_t*} buff GIF数据。
+ * @param {uint32_t} buff_size GIF数据长度。
+ *
+ * @return {gif_decoder_t*} 返回解码器对象，数据无效时返回NULL。
+ */
+gif_decoder_t* gif_decoder_create(const uint8_t* buff, uint32_t buff_size);
+
+/**
+ * @method gif_decoder_next
+ * 解码下一帧。到达最后一帧之后，从第一帧重新开始。
+ * @param {gif_decoder_t*} decoder 解码器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t gif_decoder_next(gif_decoder_t* decoder);
+
+/**
+ * @method gif_decoder_rewind
+ * 回到第一帧。
+ * @param {gif_decoder_t*} decoder 解码器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t gif_decoder_rewind(gif_decoder_t* decoder);
+
+/**
+ * @method gif_decoder_destroy
+ * 销毁解码器。
+ * @param {gif_decoder_t*} decoder 解码器对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t gif_decoder_destroy(gif_decoder_t* decoder);
+
 END_C_DECLS
 
 #endif /*TK_IMAGE_LOADER_STB_H*/
@@ -24,6 +24,7 @@
 
 #include "tkc/event_source_idle.h"
 #include "tkc/event_source_timer.h"
+#include "tkc/event_source_manager_epoll.h"
 #include "tkc/event_source_manager_default.h"
 
 static ret_t main_loop_simple_queue_event_mutex(main_loop_t* l, const event_queue_req_t* r) {
@@ -34,6 +35,10 @@ static ret_t main_loop_simple_queue_event_mutex(main_loop_t* l, const event_queu
   ret = event_queue_send(loop->queue, r);
   tk_mutex_unlock(loop->mutex);
 
+  if (ret == RET_OK) {
+    main_loop_wakeup(l);
+  }
+
   return ret;
 }
 
@@ -222,6 +227,54 @@ static ret_t main_loop_simple_step(main_loop_t* l) {
   return RET_OK;
 }
 
+static bool_t main_loop_simple_has_pending_events(main_loop_simple_t* loop) {
+  bool_t ret = FALSE;
+
+  tk_mutex_lock(loop->mutex);
+  ret = loop->queue->full || loop->queue->r != loop->queue->w;
+  tk_mutex_unlock(loop->mutex);
+
+  return ret;
+}
+
+/*
+ * 事件源管理器支持等待时(epoll)，一直阻塞到下一个定时器到期、文件描述符就绪或者有新的事件。
+ * 需要轮询输入、使用外部事件队列或者正在播放窗口动画时，仍然按帧率睡眠，但是可以被提前唤醒。
+ */
+static ret_t main_loop_simple_sleep(main_loop_t* l) {
+  uint32_t max_time = 0xffffffff;
+  main_loop_simple_t* loop = (main_loop_simple_t*)l;
+  event_source_manager_t* manager = loop->event_source_manager;
+
+  if (manager == NULL || manager->wait == NULL) {
+    return main_loop_sleep_default(l);
+  }
+
+  if (loop->dispatch_input != NULL || loop->mutex == NULL || window_manager_is_animating(l->wm)) {
+    uint32_t gap = time_now_ms() - l->last_loop_time;
+    max_time = gap > TK_MAX_SLEEP_TIME ? 0 : (TK_MAX_SLEEP_TIME - gap);
+  } else if (main_loop_simple_has_pending_events(loop)) {
+    max_time = 0;
+  }
+
+  if (max_time > 0) {
+    event_source_manager_wait(manager, max_time);
+  }
+  l->last_loop_time = time_now_ms();
+
+  return RET_OK;
+}
+
+static ret_t main_loop_simple_wakeup(main_loop_t* l) {
+  main_loop_simple_t* loop = (main_loop_simple_t*)l;
+
+  if (loop->event_source_manager != NULL) {
+    return event_source_manager_wakeup(loop->event_source_manager);
+  }
+
+  return RET_OK;
+}
+
 static ret_t main_loop_simple_run(main_loop_t* l) {
   main_loop_simple_t* loop = (main_loop_simple_t*)l;
 
@@ -264,6 +317,9 @@ main_loop_simple_t* main_loop_simple_init(int w, int h, main_loop_queue_event_t
 
   loop->base.run = main_loop_simple_run;
   loop->base.step = main_loop_simple_step;
+  loop->base.sleep = main_loop_simple_sleep;
+  loop->base.wakeup = main_loop_simple_wakeup;
+  loop->base.quit = main_loop_simple_wakeup;
 
   if (recv_event != NULL && queue_event != NULL) {
     loop->base.recv_event = recv_event;
@@ -280,7 +336,14 @@ main_loop_simple_t* main_loop_simple_init(int w, int h, main_loop_queue_event_t
   window_manager_post_init(loop->base.wm, w, h);
   main_loop_set((main_loop_t*)loop);
 
+#ifdef WITH_EVENT_SOURCE_EPOLL
+  loop->event_source_manager = event_source_manager_epoll_create();
+  if (loop->event_source_manager == NULL) {
+    loop->event_source_manager = event_source_manager_default_create();
+  }
+#else
   loop->event_source_manager = event_source_manager_default_create();
+#endif /*WITH_EVENT_SOURCE_EPOLL*/
 
   idle_source = event_source_idle_create(idle_manager());
   timer_source = event_source_timer_create(timer_manager());
@@ -23,6 +23,7 @@
 #include "compressors/compressor_miniz.h"
 #include "streams/shdlc/shdlc_helper.h"
 #include "streams/shdlc/istream_shdlc.h"
+#include "streams/shdlc/ostream_shdlc.h"
 
 static ret_t tk_istream_shdlc_send_ack(tk_istream_t* stream, bool_t ok, uint8_t seqno) {
   wbuffer_t wb;
@@ -34,9 +35,9 @@ static ret_t tk_istream_shdlc_send_ack(tk_istream_t* stream, bool_t ok, uint8_t
 
   wbuffer_init(&wb, buff, sizeof(buff));
   if (ok) {
-    shdlc_write_ack(&wb, seqno);
+    shdlc_write_ack_ex(&wb, seqno, istream_shdlc->windowed);
   } else {
-    shdlc_write_nack(&wb, seqno);
+    shdlc_write_nack_ex(&wb, seqno, istream_shdlc->windowed);
   }
 
   return tk_ostream_write_len(real_ostream, wb.data, wb.cursor, timeout) == wb.cursor ? RET_OK
@@ -71,15 +72,20 @@ ret_t tk_istream_shdlc_read_frame(tk_istream_t* stream, wbuffer_t* wb, bool_t ex
     if (ret == RET_CRC || ret == RET_TIMEOUT) {
       log_debug("retry_times=%u\n", (retry_times + 1));
       if (expect_data) {
+        if (istream_shdlc->windowed) {
+          /*请求重传期望的包，出错的包可能很多，只请求一次，超时后再请求。*/
+          if (ret == RET_CRC && istream_shdlc->nack_sent) {
+            istream_shdlc->lost_after_nack = TRUE;
+            continue;
+          }
+          seqno = shdlc_seqno_inc(istream_shdlc->last_seqno);
+          istream_shdlc->nack_sent = TRUE;
+        }
         return_value_if_fail(tk_istream_shdlc_send_ack(stream, FALSE, seqno) == RET_OK, RET_IO);
         continue;
       } else {
         break;
       }
-    } else if (ret == RET_OK) {
-      if (header.s.type == SHDLC_DATA) {
-        return_value_if_fail(tk_istream_shdlc_send_ack(stream, TRUE, seqno) == RET_OK, RET_IO);
-      }
     }
 
     break;
@@ -88,57 +94,140 @@ ret_t tk_istream_shdlc_read_frame(tk_istream_t* stream, wbuffer_t* wb, bool_t ex
   return ret;
 }
 
-static ret_t tk_istream_shdlc_save_data_frame(tk_istream_t* stream, wbuffer_t* wb) {
+static ret_t tk_istream_shdlc_deliver_data_frame(tk_istream_t* stream, wbuffer_t* wb) {
   shdlc_header_t header = {0};
   tk_istream_shdlc_t* istream_shdlc = TK_ISTREAM_SHDLC(stream);
   ring_buffer_t* rb = (istream_shdlc->rb);
+  const uint8_t* data = wb->data + 1;
+  uint32_t size = wb->cursor - 1;
 
   header.data = wb->data[0];
-  return_value_if_fail(header.s.type == SHDLC_DATA, RET_FAIL);
+  if (header.s.compressed) {
+    compressor_t* c = istream_shdlc->compressor;
+    wbuffer_t* wb_c = &(istream_shdlc->wb_compress);
+    return_value_if_fail(compressor_uncompress(c, data, size, wb_c) == RET_OK, RET_FAIL);
+    log_debug("compressed data: %u => %u\n", size, wb_c->cursor);
+
+    data = wb_c->data;
+    size = wb_c->cursor;
+  }
 
-  if (istream_shdlc->last_seqno != header.s.seqno) {
-    const uint8_t* data = wb->data + 1;
-    uint32_t size = wb->cursor - 1;
+  return_value_if_fail(ring_buffer_write_len(rb, data, size) == RET_OK, RET_OOM);
+  istream_shdlc->last_seqno = header.s.seqno;
+
+  return RET_OK;
+}
+
+static ret_t tk_istream_shdlc_save_windowed_data_frame(tk_istream_t* stream, wbuffer_t* wb) {
+  uint8_t n = 0;
+  uint8_t expected = 0;
+  shdlc_header_t header = {0};
+  tk_istream_shdlc_t* istream_shdlc = TK_ISTREAM_SHDLC(stream);
+
+  header.data = wb->data[0];
+  expected = shdlc_seqno_inc(istream_shdlc->last_seqno);
+  n = shdlc_seqno_distance(expected, header.s.seqno);
+
+  if (n == 0) {
+    return_value_if_fail(tk_istream_shdlc_deliver_data_frame(stream, wb) == RET_OK, RET_OOM);
+    istream_shdlc->saved_mask &= ~(1 << header.s.seqno);
+
+    /*交付之前提前收到的包。*/
+    expected = shdlc_seqno_inc(istream_shdlc->last_seqno);
+    while (istream_shdlc->saved_mask & (1 << expected)) {
+      istream_shdlc->saved_mask &= ~(1 << expected);
+      return_value_if_fail(
+          tk_istream_shdlc_deliver_data_frame(stream, istream_shdlc->saved + expected) == RET_OK,
+          RET_OOM);
+      expected = shdlc_seqno_inc(expected);
+    }
+
+    /*后面还有丢失的包时，确认之前的包同时请求重传。*/
+    if (istream_shdlc->saved_mask != 0 || istream_shdlc->lost_after_nack) {
+      istream_shdlc->nack_sent = TRUE;
+      istream_shdlc->lost_after_nack = FALSE;
+      return tk_istream_shdlc_send_ack(stream, FALSE, expected);
+    }
+
+    istream_shdlc->nack_sent = FALSE;
+    return tk_istream_shdlc_send_ack(stream, TRUE, istream_shdlc->last_seqno);
+  } else if (n < SHDLC_MAX_WINDOW_SIZE) {
+    /*前面的包丢失了，先保存，请求重传丢失的包。*/
+    wbuffer_t* saved = istream_shdlc->saved + header.s.seqno;
 
-    if (header.s.compressed) {
-      compressor_t* c = istream_shdlc->compressor;
-      wbuffer_t* wb_c = &(istream_shdlc->wb_compress);
-      return_value_if_fail(compressor_uncompress(c, data, size, wb_c) == RET_OK, 0);
-      log_debug("compressed data: %u => %u\n", size, wb_c->cursor);
+    saved->cursor = 0;
+    return_value_if_fail(wbuffer_write_binary(saved, wb->data, wb->cursor) == RET_OK, RET_OOM);
+    istream_shdlc->saved_mask |= (1 << header.s.seqno);
 
-      data = wb_c->data;
-      size = wb_c->cursor;
+    if (!istream_shdlc->nack_sent) {
+      istream_shdlc->nack_sent = TRUE;
+      return tk_istream_shdlc_send_ack(stream, FALSE, expected);
     }
 
-    return_value_if_fail(ring_buffer_write_len(rb, data, size) == RET_OK, RET_OOM);
-    istream_shdlc->last_seqno = header.s.seqno;
+    return RET_OK;
   } else {
+    /*重复的包：对方没有收到确认，重新确认。*/
     log_debug("discard duplicated packet: %d\n", (int)(header.s.seqno));
-    tk_istream_shdlc_send_ack(stream, TRUE, header.s.seqno);
+    return tk_istream_shdlc_send_ack(stream, TRUE, istream_shdlc->last_seqno);
   }
+}
 
-  return RET_OK;
+static ret_t tk_istream_shdlc_save_data_frame(tk_istream_t* stream, wbuffer_t* wb) {
+  shdlc_header_t header = {0};
+  tk_istream_shdlc_t* istream_shdlc = TK_ISTREAM_SHDLC(stream);
+
+  header.data = wb->data[0];
+  return_value_if_fail(header.s.type == SHDLC_DATA, RET_FAIL);
+
+  if (header.s.reserve) {
+    istream_shdlc->windowed = TRUE;
+    return tk_istream_shdlc_save_windowed_data_frame(stream, wb);
+  }
+
+  if (istream_shdlc->last_seqno != header.s.seqno) {
+    return_value_if_fail(tk_istream_shdlc_deliver_data_frame(stream, wb) == RET_OK, RET_OOM);
+  } else {
+    log_debug("discard duplicated packet: %d\n", (int)(header.s.seqno));
+  }
+
+  return tk_istream_shdlc_send_ack(stream, TRUE, header.s.seqno);
 }
 
-ret_t tk_istream_shdlc_read_ack(tk_istream_t* stream, uint8_t seqno) {
+ret_t tk_istream_shdlc_read_ack_ex(tk_istream_t* stream, uint8_t* header) {
   ret_t ret = RET_OK;
-  shdlc_header_t header = {0};
+  shdlc_header_t h = {0};
   tk_istream_shdlc_t* istream_shdlc = TK_ISTREAM_SHDLC(stream);
   wbuffer_t* wb = &(istream_shdlc->wb);
+  return_value_if_fail(istream_shdlc != NULL && header != NULL, RET_BAD_PARAMS);
 
   do {
     ret = tk_istream_shdlc_read_frame(stream, wb, FALSE);
     return_value_if_fail(ret == RET_OK, ret);
 
-    header.data = wb->data[0];
-    if (header.s.type != SHDLC_DATA) {
+    h.data = wb->data[0];
+    if (h.s.type != SHDLC_DATA) {
       break;
     }
 
-    return_value_if_fail(tk_istream_shdlc_save_data_frame(stream, wb) == RET_OK, RET_OOM);
+    ret = tk_istream_shdlc_save_data_frame(stream, wb);
+    return_value_if_fail(ret != RET_IO, RET_IO);
+    return_value_if_fail(ret == RET_OK, RET_OOM);
   } while (TRUE);
 
-  return header.s.type == SHDLC_ACK ? RET_OK : RET_FAIL;
+  *header = h.data;
+
+  return RET_OK;
+}
+
+ret_t tk_istream_shdlc_read_ack(tk_istream_t* stream, uint8_t seqno) {
+  uint8_t header = 0;
+  shdlc_header_t h = {0};
+  ret_t ret = tk_istream_shdlc_read_ack_ex(stream, &header);
+  return_value_if_fail(ret == RET_OK, ret);
+
+  h.data = header;
+
+  return h.s.type == SHDLC_ACK ? RET_OK : RET_FAIL;
 }
 
 static int32_t tk_istream_shdlc_read(tk_istream_t* stream, uint8_t* buff, uint32_t max_size) {
@@ -157,9 +246,12 @@ static int32_t tk_istream_shdlc_read(tk_istream_t* stream, uint8_t* buff, uint32
     header.data = wb->data[0];
     if (header.s.type == SHDLC_DATA) {
       return_value_if_fail(tk_istream_shdlc_save_data_frame(stream, wb) == RET_OK, 0);
-      break;
+      if (ring_buffer_size(rb) > 0) {
+        break;
+      }
     } else {
-      log_debug("unexpected packet %d\n", (int)(header.s.type));
+      /*使用滑动窗口时，write返回后还可能收到对方的确认，重传失败时由之后的write/flush报告。*/
+      tk_ostream_shdlc_on_ack(istream_shdlc->iostream->ostream, header.data);
     }
   } while (1);
 
@@ -168,7 +260,8 @@ static int32_t tk_istream_shdlc_read(tk_istream_t* stream, uint8_t* buff, uint32
 
 static ret_t tk_istream_shdlc_wait_for_data(tk_istream_t* stream, uint32_t timeout_ms) {
   tk_istream_shdlc_t* istream_shdlc = TK_ISTREAM_SHDLC(stream);
-  tk_istream_t* real_istream = tk_iostream_get_istream(istream_shdlc->iostream->real_iostream);
+  /*连续发送时，后面的包可能已经读到缓冲区中，要检查缓冲区。*/
+  tk_istream_t* real_istream = istream_shdlc->iostream->real_istream;
   ring_buffer_t* rb = istream_shdlc->rb;
 
   if (!ring_buffer_is_empty(rb)) {
@@ -211,12 +304,16 @@ static ret_t tk_istream_shdlc_get_prop(object_t* obj, const char* name, value_t*
 }
 
 static ret_t tk_istream_shdlc_on_destroy(object_t* obj) {
+  uint32_t i = 0;
   tk_istream_shdlc_t* istream_shdlc = TK_ISTREAM_SHDLC(obj);
 
   ENSURE(ring_buffer_destroy(istream_shdlc->rb) == RET_OK);
   ENSURE(wbuffer_deinit(&(istream_shdlc->wb)) == RET_OK);
   ENSURE(wbuffer_deinit(&(istream_shdlc->wb_compress)) == RET_OK);
   ENSURE(compressor_destroy(istream_shdlc->compressor) == RET_OK);
+  for (i = 0; i < ARRAY_SIZE(istream_shdlc->saved); i++) {
+    ENSURE(wbuffer_deinit(istream_shdlc->saved + i) == RET_OK);
+  }
 
   return RET_OK;
 }
@@ -229,6 +326,7 @@ static const object_vtable_t s_tk_istream_shdlc_vtable = {.type = "tk_istream_sh
                                                           .set_prop = tk_istream_shdlc_set_prop};
 
 tk_istream_t* tk_istream_shdlc_create(tk_iostream_shdlc_t* iostream) {
+  uint32_t i = 0;
   object_t* obj = NULL;
   tk_istream_shdlc_t* istream_shdlc = NULL;
   return_value_if_fail(iostream != NULL, NULL);
@@ -240,6 +338,9 @@ tk_istream_t* tk_istream_shdlc_create(tk_iostream_shdlc_t* iostream) {
   istream_shdlc->rb = ring_buffer_create(1024, 32 * 1024);
   ENSURE(wbuffer_init_extendable(&(istream_shdlc->wb)) != NULL);
   ENSURE(wbuffer_init_extendable(&(istream_shdlc->wb_compress)) != NULL);
+  for (i = 0; i < ARRAY_SIZE(istream_shdlc->saved); i++) {
+    ENSURE(wbuffer_init_extendable(istream_shdlc->saved + i) != NULL);
+  }
 
   istream_shdlc->timeout = 3000;
   istream_shdlc->retry_times = 10;
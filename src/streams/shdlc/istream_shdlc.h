@@ -57,6 +57,12 @@ struct _tk_istream_shdlc_t {
   ring_buffer_t* rb;
   uint8_t last_seqno;
   wbuffer_t wb_compress;
+  /*对方使用滑动窗口时，按序号顺序接收，提前收到的包按序号保存在saved中。*/
+  bool_t windowed;
+  bool_t nack_sent;
+  bool_t lost_after_nack;
+  uint8_t saved_mask;
+  wbuffer_t saved[8];
   compressor_t* compressor;
   tk_iostream_shdlc_t* iostream;
 };
@@ -77,6 +83,21 @@ tk_istream_t* tk_istream_shdlc_create(tk_iostream_shdlc_t* iostream);
 
 ret_t tk_istream_shdlc_read_ack(tk_istream_t* istream, uint8_t seqno);
 
+/**
+ * @method tk_istream_shdlc_read_ack_ex
+ *
+ * 读取ACK/NACK包，期间收到的数据包保存起来供后续读取。
+ *
+ *> 只能由ostream_shdlc调用。
+ *
+ * @param {tk_istream_t*} istream istream对象。
+ * @param {uint8_t*} header 用于返回ACK/NACK包的包头。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ *
+ */
+ret_t tk_istream_shdlc_read_ack_ex(tk_istream_t* istream, uint8_t* header);
+
 #define TK_ISTREAM_SHDLC(obj) ((tk_istream_shdlc_t*)(obj))
 
 END_C_DECLS
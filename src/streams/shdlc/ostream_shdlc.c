@@ -25,49 +25,181 @@
 #include "streams/shdlc/istream_shdlc.h"
 #include "streams/shdlc/ostream_shdlc.h"
 
-static int32_t tk_ostream_shdlc_write(tk_ostream_t* stream, const uint8_t* buff, uint32_t size) {
-  ret_t ret = 0;
+static shdlc_pending_frame_t* tk_ostream_shdlc_get_pending(tk_ostream_shdlc_t* ostream_shdlc,
+                                                           uint32_t index) {
+  index = (ostream_shdlc->pending_first + index) % SHDLC_MAX_WINDOW_SIZE;
+
+  return ostream_shdlc->pending + index;
+}
+
+static uint32_t tk_ostream_shdlc_get_window(tk_ostream_shdlc_t* ostream_shdlc) {
+  if (!ostream_shdlc->peer_window || ostream_shdlc->window_size < 2) {
+    return 1;
+  }
+
+  return tk_min(ostream_shdlc->window_size, SHDLC_MAX_WINDOW_SIZE);
+}
+
+static ret_t tk_ostream_shdlc_send_frame(tk_ostream_shdlc_t* ostream_shdlc,
+                                         shdlc_pending_frame_t* frame) {
+  wbuffer_t* wb = &(frame->wb);
+  tk_ostream_t* real_ostream = ostream_shdlc->iostream->real_ostream;
+
+  if (!object_get_prop_bool(OBJECT(real_ostream), TK_STREAM_PROP_IS_OK, TRUE)) {
+    return RET_IO;
+  }
+
+  return tk_ostream_write_len(real_ostream, wb->data, wb->cursor, ostream_shdlc->timeout) ==
+                 wb->cursor
+             ? RET_OK
+             : RET_IO;
+}
+
+/*只重传最早发送的包，之后的包接收方已经保存，确认前面的包之后一起确认。*/
+static ret_t tk_ostream_shdlc_resend(tk_ostream_shdlc_t* ostream_shdlc) {
+  shdlc_pending_frame_t* frame = tk_ostream_shdlc_get_pending(ostream_shdlc, 0);
+
+  frame->retry_times++;
+  log_debug("retry_times=%u\n", frame->retry_times);
+  if (frame->retry_times >= ostream_shdlc->retry_times) {
+    log_debug("shdlc write failed\n");
+    return RET_FAIL;
+  }
+
+  return tk_ostream_shdlc_send_frame(ostream_shdlc, frame);
+}
+
+static ret_t tk_ostream_shdlc_remove_pending(tk_ostream_shdlc_t* ostream_shdlc, uint32_t nr) {
+  ostream_shdlc->pending_nr -= nr;
+  ostream_shdlc->pending_seqno = (ostream_shdlc->pending_seqno + nr) & 0x07;
+  ostream_shdlc->pending_first = (ostream_shdlc->pending_first + nr) % SHDLC_MAX_WINDOW_SIZE;
+
+  return RET_OK;
+}
+
+ret_t tk_ostream_shdlc_on_ack(tk_ostream_t* stream, uint8_t data) {
+  uint32_t n = 0;
+  shdlc_header_t header = {0};
   tk_ostream_shdlc_t* ostream_shdlc = TK_OSTREAM_SHDLC(stream);
-  uint8_t seqno = ostream_shdlc->seqno;
-  uint32_t timeout = ostream_shdlc->timeout;
-  uint32_t retry_times = 0;
+  return_value_if_fail(ostream_shdlc != NULL, RET_BAD_PARAMS);
+
+  header.data = data;
+  if (header.s.reserve) {
+    ostream_shdlc->peer_window = TRUE;
+  }
+
+  if (ostream_shdlc->pending_nr == 0) {
+    return RET_OK;
+  }
+
+  if (!header.s.reserve) {
+    /*旧版本的接收方：只有一个包在等待确认，不检查序号。*/
+    if (header.s.type == SHDLC_ACK) {
+      return tk_ostream_shdlc_remove_pending(ostream_shdlc, 1);
+    }
+
+    return tk_ostream_shdlc_resend(ostream_shdlc);
+  }
+
+  n = shdlc_seqno_distance(ostream_shdlc->pending_seqno, header.s.seqno);
+  if (header.s.type == SHDLC_ACK) {
+    /*累积确认：该序号及之前的包都已收到，超出范围的是过时的确认。*/
+    if (n < ostream_shdlc->pending_nr) {
+      tk_ostream_shdlc_remove_pending(ostream_shdlc, n + 1);
+    }
+  } else if (header.s.type == SHDLC_NACK) {
+    if (n <= ostream_shdlc->pending_nr) {
+      tk_ostream_shdlc_remove_pending(ostream_shdlc, n);
+      if (ostream_shdlc->pending_nr > 0) {
+        return tk_ostream_shdlc_resend(ostream_shdlc);
+      }
+    }
+  }
+
+  return RET_OK;
+}
+
+/*等待确认，直到未确认的包不超过max_pending个。*/
+static ret_t tk_ostream_shdlc_wait_ack(tk_ostream_shdlc_t* ostream_shdlc, uint32_t max_pending) {
+  ret_t ret = RET_OK;
+  uint8_t header = 0;
   tk_istream_t* istream = ostream_shdlc->iostream->istream;
-  tk_ostream_t* real_ostream = ostream_shdlc->iostream->real_ostream;
 
-  wbuffer_t* wb = &(ostream_shdlc->wb);
+  while (ostream_shdlc->pending_nr > max_pending) {
+    ret = tk_istream_shdlc_read_ack_ex(istream, &header);
+    if (ret == RET_IO) {
+      return RET_IO;
+    } else if (ret == RET_OK) {
+      ret = tk_ostream_shdlc_on_ack(TK_OSTREAM(ostream_shdlc), header);
+    } else {
+      ret = tk_ostream_shdlc_resend(ostream_shdlc);
+    }
+
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t tk_ostream_shdlc_send_data(tk_ostream_shdlc_t* ostream_shdlc, const uint8_t* buff,
+                                        uint32_t size) {
+  uint8_t seqno = ostream_shdlc->seqno;
+  shdlc_pending_frame_t* frame =
+      tk_ostream_shdlc_get_pending(ostream_shdlc, ostream_shdlc->pending_nr);
+  wbuffer_t* wb = &(frame->wb);
+
   if (ostream_shdlc->compress_threshold <= size) {
     compressor_t* c = ostream_shdlc->compressor;
     wbuffer_t* wb_c = &(ostream_shdlc->wb_compress);
-    return_value_if_fail(compressor_compress(c, buff, size, wb_c) == RET_OK, 0);
-    return_value_if_fail(shdlc_write_data(wb, seqno, TRUE, wb_c->data, wb_c->cursor) == RET_OK, 0);
+    return_value_if_fail(compressor_compress(c, buff, size, wb_c) == RET_OK, RET_FAIL);
+    return_value_if_fail(
+        shdlc_write_data_ex(wb, seqno, TRUE, TRUE, wb_c->data, wb_c->cursor) == RET_OK, RET_OOM);
   } else {
-    return_value_if_fail(shdlc_write_data(wb, seqno, FALSE, buff, size) == RET_OK, 0);
+    return_value_if_fail(shdlc_write_data_ex(wb, seqno, FALSE, TRUE, buff, size) == RET_OK,
+                         RET_OOM);
   }
 
-  while (retry_times < ostream_shdlc->retry_times) {
-    if (!object_get_prop_bool(OBJECT(real_ostream), TK_STREAM_PROP_IS_OK, TRUE)) {
-      return RET_IO;
-    }
+  if (ostream_shdlc->pending_nr == 0) {
+    ostream_shdlc->pending_seqno = seqno;
+  }
+  frame->retry_times = 0;
+  ostream_shdlc->pending_nr++;
+  ostream_shdlc->seqno = shdlc_seqno_inc(seqno);
 
-    return_value_if_fail(
-        tk_ostream_write_len(real_ostream, wb->data, wb->cursor, timeout) == wb->cursor, RET_IO);
+  return tk_ostream_shdlc_send_frame(ostream_shdlc, frame);
+}
 
-    ret = tk_istream_shdlc_read_ack(istream, seqno);
-    if (ret == RET_IO) {
-      return 0;
-    } else if (ret == RET_OK) {
-      ostream_shdlc->seqno = shdlc_seqno_inc(ostream_shdlc->seqno);
+static int32_t tk_ostream_shdlc_write(tk_ostream_t* stream, const uint8_t* buff, uint32_t size) {
+  uint32_t len = 0;
+  uint32_t offset = 0;
+  uint32_t window = 1;
+  tk_ostream_shdlc_t* ostream_shdlc = TK_OSTREAM_SHDLC(stream);
 
-      return size;
-    }
+  while (offset < size) {
+    /*确定对方支持滑动窗口之前，整个数据作为一个包发送。*/
+    window = tk_ostream_shdlc_get_window(ostream_shdlc);
+    len = window > 1 ? tk_min(size - offset, TK_OSTREAM_SHDLC_FRAME_SIZE) : size - offset;
 
-    retry_times++;
-    log_debug("retry_times=%u\n", retry_times);
+    return_value_if_fail(tk_ostream_shdlc_wait_ack(ostream_shdlc, window - 1) == RET_OK, 0);
+    return_value_if_fail(tk_ostream_shdlc_send_data(ostream_shdlc, buff + offset, len) == RET_OK,
+                         0);
+    offset += len;
   }
 
-  log_debug("shdlc write failed\n");
+  /*停等方式：确认后才返回。*/
+  if (tk_ostream_shdlc_get_window(ostream_shdlc) < 2) {
+    return_value_if_fail(tk_ostream_shdlc_wait_ack(ostream_shdlc, 0) == RET_OK, 0);
+  }
 
-  return 0;
+  return size;
+}
+
+static ret_t tk_ostream_shdlc_flush(tk_ostream_t* stream) {
+  tk_ostream_shdlc_t* ostream_shdlc = TK_OSTREAM_SHDLC(stream);
+
+  return tk_ostream_shdlc_wait_ack(ostream_shdlc, 0);
 }
 
 static ret_t tk_ostream_shdlc_set_prop(object_t* obj, const char* name, const value_t* v) {
@@ -83,6 +215,10 @@ static ret_t tk_ostream_shdlc_set_prop(object_t* obj, const char* name, const va
   } else if (tk_str_eq(name, TK_STREAM_PROP_COMPRESS_THRESHOLD)) {
     ostream_shdlc->compress_threshold = value_uint32(v);
     return RET_OK;
+  } else if (tk_str_eq(name, TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE)) {
+    uint32_t window_size = value_uint32(v);
+    ostream_shdlc->window_size = tk_max(1, tk_min(window_size, SHDLC_MAX_WINDOW_SIZE));
+    return RET_OK;
   }
 
   return object_set_prop(OBJECT(real_ostream), name, v);
@@ -101,14 +237,24 @@ static ret_t tk_ostream_shdlc_get_prop(object_t* obj, const char* name, value_t*
   } else if (tk_str_eq(name, TK_STREAM_PROP_COMPRESS_THRESHOLD)) {
     value_set_uint32(v, ostream_shdlc->compress_threshold);
     return RET_OK;
+  } else if (tk_str_eq(name, TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE)) {
+    value_set_uint32(v, ostream_shdlc->window_size);
+    return RET_OK;
+  } else if (tk_str_eq(name, TK_OSTREAM_SHDLC_PROP_PEER_WINDOW)) {
+    value_set_bool(v, ostream_shdlc->peer_window);
+    return RET_OK;
   }
 
   return object_get_prop(OBJECT(real_ostream), name, v);
 }
 
 static ret_t tk_ostream_shdlc_on_destroy(object_t* obj) {
+  uint32_t i = 0;
   tk_ostream_shdlc_t* ostream_shdlc = TK_OSTREAM_SHDLC(obj);
-  ENSURE(wbuffer_deinit(&(ostream_shdlc->wb)) == RET_OK);
+
+  for (i = 0; i < SHDLC_MAX_WINDOW_SIZE; i++) {
+    ENSURE(wbuffer_deinit(&(ostream_shdlc->pending[i].wb)) == RET_OK);
+  }
   ENSURE(wbuffer_deinit(&(ostream_shdlc->wb_compress)) == RET_OK);
   ENSURE(compressor_destroy(ostream_shdlc->compressor) == RET_OK);
 
@@ -123,6 +269,7 @@ static const object_vtable_t s_tk_ostream_shdlc_vtable = {.type = "tk_ostream_sh
                                                           .set_prop = tk_ostream_shdlc_set_prop};
 
 tk_ostream_t* tk_ostream_shdlc_create(tk_iostream_shdlc_t* iostream) {
+  uint32_t i = 0;
   object_t* obj = NULL;
   tk_ostream_shdlc_t* ostream_shdlc = NULL;
   return_value_if_fail(iostream != NULL, NULL);
@@ -135,10 +282,14 @@ tk_ostream_t* tk_ostream_shdlc_create(tk_iostream_shdlc_t* iostream) {
   ostream_shdlc->retry_times = 10;
   ostream_shdlc->iostream = iostream;
   ostream_shdlc->compress_threshold = 512;
+  ostream_shdlc->window_size = 1;
   ostream_shdlc->compressor = compressor_miniz_create(COMPRESSOR_RATIO_FIRST);
-  ENSURE(wbuffer_init_extendable(&(ostream_shdlc->wb)) != NULL);
+  for (i = 0; i < SHDLC_MAX_WINDOW_SIZE; i++) {
+    ENSURE(wbuffer_init_extendable(&(ostream_shdlc->pending[i].wb)) != NULL);
+  }
   ENSURE(wbuffer_init_extendable(&(ostream_shdlc->wb_compress)) != NULL);
   TK_OSTREAM(obj)->write = tk_ostream_shdlc_write;
+  TK_OSTREAM(obj)->flush = tk_ostream_shdlc_flush;
 
   return TK_OSTREAM(obj);
 }
@@ -24,10 +24,34 @@
 
 #include "tkc/buffer.h"
 #include "tkc/compressor.h"
+#include "streams/shdlc/shdlc_helper.h"
 #include "streams/shdlc/iostream_shdlc.h"
 
 BEGIN_C_DECLS
 
+/*使用滑动窗口时，每个数据包最多携带的数据(字节)，较大的数据分成多个包连续发送。*/
+#ifndef TK_OSTREAM_SHDLC_FRAME_SIZE
+#define TK_OSTREAM_SHDLC_FRAME_SIZE 1024
+#endif /*TK_OSTREAM_SHDLC_FRAME_SIZE*/
+
+/**
+ * @const TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE
+ * 发送窗口的大小。
+ */
+#define TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE "window_size"
+
+/**
+ * @const TK_OSTREAM_SHDLC_PROP_PEER_WINDOW
+ * 对方是否支持滑动窗口(只读)。
+ */
+#define TK_OSTREAM_SHDLC_PROP_PEER_WINDOW "peer_window"
+
+/*已经发送但还没有确认的数据包。*/
+typedef struct _shdlc_pending_frame_t {
+  wbuffer_t wb;
+  uint32_t retry_times;
+} shdlc_pending_frame_t;
+
 struct _tk_ostream_shdlc_t;
 typedef struct _tk_ostream_shdlc_t tk_ostream_shdlc_t;
 
@@ -37,6 +61,10 @@ typedef struct _tk_ostream_shdlc_t tk_ostream_shdlc_t;
  *
  * reliable ostream base on simple HDLC
  *
+ * window\_size大于1且对方支持时，最多可以有window\_size个数据包等待确认，
+ * 收到NACK或超时时只重传缺少的包。此时write返回时数据可能还没有被确认，
+ * 需要确认时调用tk\_ostream\_flush。对方不支持时仍然使用停等方式。
+ *
  */
 struct _tk_ostream_shdlc_t {
   tk_ostream_t ostream;
@@ -56,9 +84,23 @@ struct _tk_ostream_shdlc_t {
    * 激活压缩的阈值。
    */
   uint32_t compress_threshold;
+  /**
+   * @property {uint32_t} window_size
+   * 发送窗口的大小(1到SHDLC\_MAX\_WINDOW\_SIZE)，缺省为1(停等方式)。
+   */
+  uint32_t window_size;
+  /**
+   * @property {bool_t} peer_window
+   * 对方是否支持滑动窗口(收到对方的确认后才能确定)。
+   */
+  bool_t peer_window;
 
-  wbuffer_t wb;
   uint8_t seqno;
+  /*pending[pending_first]是最早发送的包，其序号为pending_seqno，之后的包序号依次递增。*/
+  uint8_t pending_seqno;
+  uint32_t pending_first;
+  uint32_t pending_nr;
+  shdlc_pending_frame_t pending[SHDLC_MAX_WINDOW_SIZE];
   wbuffer_t wb_compress;
   compressor_t* compressor;
   tk_iostream_shdlc_t* iostream;
@@ -78,6 +120,21 @@ struct _tk_ostream_shdlc_t {
  */
 tk_ostream_t* tk_ostream_shdlc_create(tk_iostream_shdlc_t* iostream);
 
+/**
+ * @method tk_ostream_shdlc_on_ack
+ *
+ * 处理收到的ACK/NACK包。
+ *
+ *> 只能由istream_shdlc调用。
+ *
+ * @param {tk_ostream_t*} stream ostream对象。
+ * @param {uint8_t} header 包头。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ *
+ */
+ret_t tk_ostream_shdlc_on_ack(tk_ostream_t* stream, uint8_t header);
+
 #define TK_OSTREAM_SHDLC(obj) ((tk_ostream_shdlc_t*)(obj))
 
 END_C_DECLS
@@ -71,9 +71,9 @@ static ret_t shdlc_write(wbuffer_t* wb, shdlc_header_t header, const uint8_t* da
   return RET_OK;
 }
 
-ret_t shdlc_write_ack(wbuffer_t* wb, uint8_t seqno) {
+ret_t shdlc_write_ack_ex(wbuffer_t* wb, uint8_t seqno, bool_t windowed) {
   shdlc_header_t header = {0};
-  header.s.reserve = 0;
+  header.s.reserve = windowed ? 1 : 0;
   header.s.seqno = seqno;
   header.s.type = SHDLC_ACK;
   header.s.compressed = FALSE;
@@ -81,9 +81,9 @@ ret_t shdlc_write_ack(wbuffer_t* wb, uint8_t seqno) {
   return shdlc_write(wb, header, NULL, 0);
 }
 
-ret_t shdlc_write_nack(wbuffer_t* wb, uint8_t seqno) {
+ret_t shdlc_write_nack_ex(wbuffer_t* wb, uint8_t seqno, bool_t windowed) {
   shdlc_header_t header = {0};
-  header.s.reserve = 0;
+  header.s.reserve = windowed ? 1 : 0;
   header.s.seqno = seqno;
   header.s.type = SHDLC_NACK;
   header.s.compressed = FALSE;
@@ -91,12 +91,25 @@ ret_t shdlc_write_nack(wbuffer_t* wb, uint8_t seqno) {
   return shdlc_write(wb, header, NULL, 0);
 }
 
+ret_t shdlc_write_ack(wbuffer_t* wb, uint8_t seqno) {
+  return shdlc_write_ack_ex(wb, seqno, FALSE);
+}
+
+ret_t shdlc_write_nack(wbuffer_t* wb, uint8_t seqno) {
+  return shdlc_write_nack_ex(wb, seqno, FALSE);
+}
+
 ret_t shdlc_write_data(wbuffer_t* wb, uint8_t seqno, bool_t compressed, const void* data,
                        uint32_t len) {
+  return shdlc_write_data_ex(wb, seqno, compressed, FALSE, data, len);
+}
+
+ret_t shdlc_write_data_ex(wbuffer_t* wb, uint8_t seqno, bool_t compressed, bool_t windowed,
+                          const void* data, uint32_t len) {
   shdlc_header_t header = {0};
   return_value_if_fail(data != NULL && len > 0, RET_BAD_PARAMS);
 
-  header.s.reserve = 0;
+  header.s.reserve = windowed ? 1 : 0;
   header.s.seqno = seqno;
   header.s.type = SHDLC_DATA;
   header.s.compressed = compressed;
@@ -186,3 +199,7 @@ ret_t shdlc_read_data(tk_istream_t* istream, wbuffer_t* wb, uint32_t timeout) {
 uint8_t shdlc_seqno_inc(uint8_t seqno) {
   return (seqno + 1) & 0x07;
 }
+
+uint8_t shdlc_seqno_distance(uint8_t from, uint8_t to) {
+  return (to - from) & 0x07;
+}
@@ -31,6 +31,9 @@ BEGIN_C_DECLS
 #define SHDLC_FLAG 0x7E
 #define SHDLC_ESCAPE 0x7D
 
+/*序号只有3位，使用选择重传时，窗口不能超过序号空间的一半。*/
+#define SHDLC_MAX_WINDOW_SIZE 4
+
 typedef enum { SHDLC_INVALID = 0, SHDLC_DATA, SHDLC_ACK, SHDLC_NACK } shdlc_frame_type_t;
 
 #pragma pack(push, 1)
@@ -46,6 +49,12 @@ typedef union _shdlc_header_t {
 #pragma pack(pop)
 
 /**
+ * reserve:
+ * 发送方支持滑动窗口时，DATA包的reserve位为1，接收方此时按序号顺序接收，
+ * 回复的ACK/NACK包的reserve位也为1，ACK表示该序号及之前的包都已收到(累积确认)，
+ * NACK表示该序号的包需要重传(之前的包都已收到)。旧版本的接收方回复的reserve位为0，
+ * 发送方仍然使用停等方式。
+ *
  * normal:
  * | SHDLC_FLAG(1B) | SHDLC_DATA(1B) | ...data... | fcs16(2B) | SHDLC_FLAG(1B) |
  * ack:
@@ -56,10 +65,15 @@ typedef union _shdlc_header_t {
 
 ret_t shdlc_write_ack(wbuffer_t* wb, uint8_t seqno);
 ret_t shdlc_write_nack(wbuffer_t* wb, uint8_t seqno);
+ret_t shdlc_write_ack_ex(wbuffer_t* wb, uint8_t seqno, bool_t windowed);
+ret_t shdlc_write_nack_ex(wbuffer_t* wb, uint8_t seqno, bool_t windowed);
 ret_t shdlc_read_data(tk_istream_t* istream, wbuffer_t* wb, uint32_t timeout);
 ret_t shdlc_write_data(wbuffer_t* wb, uint8_t seqno, bool_t compressed, const void* data,
                        uint32_t len);
+ret_t shdlc_write_data_ex(wbuffer_t* wb, uint8_t seqno, bool_t compressed, bool_t windowed,
+                          const void* data, uint32_t len);
 uint8_t shdlc_seqno_inc(uint8_t seqno);
+uint8_t shdlc_seqno_distance(uint8_t from, uint8_t to);
 
 END_C_DECLS
 
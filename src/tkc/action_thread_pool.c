@@ -21,6 +21,25 @@
 
 #include "tkc/mem.h"
 #include "tkc/action_thread_pool.h"
+
+#define ACTION_THREAD_POOL_WORKER_INIT_CAPACITY 16
+
+struct _action_thread_pool_worker_t {
+  tk_thread_t* thread;
+  uint64_t thread_id;
+  action_thread_pool_t* thread_pool;
+
+  /*双端队列(环形缓冲区)。自己从尾部取，其它线程从头部窃取。*/
+  tk_mutex_t* mutex;
+  qaction_t** actions;
+  uint32_t head;
+  uint32_t size;
+  uint32_t capacity;
+
+  uint32_t seed;
+  uint32_t executed_actions_nr;
+};
+
 action_thread_pool_t* action_thread_pool_create(uint16_t max_thread_nr, uint16_t min_idle_nr) {
   return action_thread_pool_create_ex(max_thread_nr, min_idle_nr, 0, TK_THREAD_PRIORITY_NORMAL);
 }
@@ -130,8 +149,421 @@ static ret_t action_thread_pool_ensure_threads(action_thread_pool_t* thread_pool
   return RET_OK;
 }
 
+static ret_t action_thread_pool_worker_push(action_thread_pool_worker_t* worker,
+                                            qaction_t* action) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(tk_mutex_lock(worker->mutex) == RET_OK, RET_FAIL);
+
+  if (worker->size >= worker->capacity) {
+    uint32_t i = 0;
+    uint32_t capacity = worker->capacity * 2;
+    qaction_t** actions = TKMEM_ZALLOCN(qaction_t*, capacity);
+
+    if (actions != NULL) {
+      for (i = 0; i < worker->size; i++) {
+        actions[i] = worker->actions[(worker->head + i) % worker->capacity];
+      }
+
+      TKMEM_FREE(worker->actions);
+      worker->head = 0;
+      worker->actions = actions;
+      worker->capacity = capacity;
+    } else {
+      ret = RET_OOM;
+    }
+  }
+
+  if (ret == RET_OK) {
+    worker->actions[(worker->head + worker->size) % worker->capacity] = action;
+    worker->size++;
+  }
+  tk_mutex_unlock(worker->mutex);
+
+  return ret;
+}
+
+static qaction_t* action_thread_pool_worker_pop(action_thread_pool_worker_t* worker,
+                                               bool_t steal, bool_t wait) {
+  qaction_t* action = NULL;
+
+  if (wait) {
+    return_value_if_fail(tk_mutex_lock(worker->mutex) == RET_OK, NULL);
+  } else if (tk_mutex_try_lock(worker->mutex) != RET_OK) {
+    return NULL;
+  }
+
+  if (worker->size > 0) {
+    if (steal) {
+      action = worker->actions[worker->head];
+      worker->head = (worker->head + 1) % worker->capacity;
+    } else {
+      action = worker->actions[(worker->head + worker->size - 1) % worker->capacity];
+    }
+    worker->size--;
+  }
+  tk_mutex_unlock(worker->mutex);
+
+  return action;
+}
+
+static uint32_t action_thread_pool_worker_rand(action_thread_pool_worker_t* worker) {
+  uint32_t x = worker->seed;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  worker->seed = x;
+
+  return x;
+}
+
+static qaction_t* action_thread_pool_worker_take(action_thread_pool_worker_t* worker) {
+  uint32_t i = 0;
+  uint32_t pass = 0;
+  qaction_t* action = NULL;
+  action_thread_pool_t* thread_pool = worker->thread_pool;
+  uint32_t nr = thread_pool->max_thread_nr;
+
+  /*
+   * 第一遍跳过被占用的队列，之后等待锁。拿到信号量就说明有一个action属于自己，
+   * 但它可能在扫描过程中被别的线程取走，而新提交的action放到了已经扫描过的队列中，
+   * 所以要一直找到为止，只有退出时才返回NULL。
+   */
+  for (pass = 0; pass < 2 || !thread_pool->quit; pass++) {
+    bool_t wait = pass > 0;
+    uint32_t start = action_thread_pool_worker_rand(worker) % nr;
+
+    action = action_thread_pool_worker_pop(worker, FALSE, TRUE);
+    if (action != NULL) {
+      return action;
+    }
+
+    for (i = 0; i < nr; i++) {
+      action_thread_pool_worker_t* victim = thread_pool->workers + (start + i) % nr;
+
+      if (victim != worker) {
+        action = action_thread_pool_worker_pop(victim, TRUE, wait);
+        if (action != NULL) {
+          return action;
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
+static ret_t action_thread_pool_run_action(qaction_t* action) {
+  done_event_t done;
+  ret_t ret = qaction_exec(action);
+
+  if (qaction_notify(action, done_event_init(&done, ret)) == RET_NOT_IMPL) {
+    qaction_destroy(action);
+  }
+
+  return ret;
+}
+
+static void* action_thread_pool_worker_entry(void* args) {
+  action_thread_pool_worker_t* worker = (action_thread_pool_worker_t*)args;
+  action_thread_pool_t* thread_pool = worker->thread_pool;
+
+  worker->thread_id = tk_thread_self();
+  ENSURE(tk_semaphore_post(thread_pool->sema_ready) == RET_OK);
+  log_debug("action thread pool worker start\n");
+
+  while (TRUE) {
+    qaction_t* action = NULL;
+
+    if (tk_semaphore_wait(thread_pool->sema_work, 1000) != RET_OK) {
+      /*退出的通知可能被其它线程消耗(它们取到了剩余的action)，超时也要检查是否退出。*/
+      if (thread_pool->quit) {
+        break;
+      }
+      continue;
+    }
+
+    /*每次成功等到信号量，队列中就一定有一个action属于自己，除非是退出的通知。*/
+    action = action_thread_pool_worker_take(worker);
+    if (action == NULL) {
+      if (thread_pool->quit) {
+        break;
+      } else {
+        continue;
+      }
+    }
+
+    if (thread_pool->sema_pending != NULL) {
+      ENSURE(tk_semaphore_post(thread_pool->sema_pending) == RET_OK);
+    }
+
+    action_thread_pool_run_action(action);
+    worker->executed_actions_nr++;
+  }
+  log_debug("action thread pool worker done\n");
+
+  return NULL;
+}
+
+static ret_t action_thread_pool_destroy_workers(action_thread_pool_t* thread_pool) {
+  uint32_t i = 0;
+  qaction_t* action = NULL;
+  action_thread_pool_worker_t* worker = NULL;
+
+  thread_pool->quit = TRUE;
+  for (i = 0; i < thread_pool->max_thread_nr; i++) {
+    if (thread_pool->workers[i].thread != NULL) {
+      ENSURE(tk_semaphore_post(thread_pool->sema_work) == RET_OK);
+    }
+  }
+
+  for (i = 0; i < thread_pool->max_thread_nr; i++) {
+    worker = thread_pool->workers + i;
+    if (worker->thread != NULL) {
+      tk_thread_join(worker->thread);
+      tk_thread_destroy(worker->thread);
+    }
+  }
+
+  for (i = 0; i < thread_pool->max_thread_nr; i++) {
+    worker = thread_pool->workers + i;
+    if (worker->mutex != NULL) {
+      while ((action = action_thread_pool_worker_pop(worker, TRUE, TRUE)) != NULL) {
+        qaction_destroy(action);
+      }
+      tk_mutex_destroy(worker->mutex);
+    }
+    TKMEM_FREE(worker->actions);
+  }
+
+  if (thread_pool->sema_work != NULL) {
+    tk_semaphore_destroy(thread_pool->sema_work);
+  }
+
+  if (thread_pool->sema_pending != NULL) {
+    tk_semaphore_destroy(thread_pool->sema_pending);
+  }
+
+  if (thread_pool->sema_ready != NULL) {
+    tk_semaphore_destroy(thread_pool->sema_ready);
+  }
+
+  tk_mutex_destroy(thread_pool->mutex);
+  TKMEM_FREE(thread_pool->workers);
+  TKMEM_FREE(thread_pool);
+
+  return RET_OK;
+}
+
+action_thread_pool_t* action_thread_pool_create_work_stealing(uint16_t thread_nr,
+                                                              uint32_t max_pending_nr) {
+  return action_thread_pool_create_work_stealing_ex(thread_nr, max_pending_nr, 0,
+                                                    TK_THREAD_PRIORITY_NORMAL);
+}
+
+action_thread_pool_t* action_thread_pool_create_work_stealing_ex(uint16_t thread_nr,
+                                                                 uint32_t max_pending_nr,
+                                                                 uint32_t stack_size,
+                                                                 tk_thread_priority_t priority) {
+  uint32_t i = 0;
+  uint32_t started = 0;
+  action_thread_pool_worker_t* worker = NULL;
+  action_thread_pool_t* thread_pool = NULL;
+  return_value_if_fail(thread_nr > 0, NULL);
+
+  thread_pool = TKMEM_ZALLOC(action_thread_pool_t);
+  return_value_if_fail(thread_pool != NULL, NULL);
+
+  thread_pool->work_stealing = TRUE;
+  thread_pool->priority = priority;
+  thread_pool->stack_size = stack_size;
+  thread_pool->min_idle_nr = thread_nr;
+  thread_pool->max_thread_nr = thread_nr;
+  thread_pool->max_pending_nr = max_pending_nr;
+
+  thread_pool->mutex = tk_mutex_create();
+  goto_error_if_fail(thread_pool->mutex != NULL);
+
+  thread_pool->sema_work = tk_semaphore_create(0, NULL);
+  goto_error_if_fail(thread_pool->sema_work != NULL);
+
+  thread_pool->sema_ready = tk_semaphore_create(0, NULL);
+  goto_error_if_fail(thread_pool->sema_ready != NULL);
+
+  if (max_pending_nr > 0) {
+    thread_pool->sema_pending = tk_semaphore_create(max_pending_nr, NULL);
+    goto_error_if_fail(thread_pool->sema_pending != NULL);
+  }
+
+  thread_pool->workers = TKMEM_ZALLOCN(action_thread_pool_worker_t, thread_nr);
+  goto_error_if_fail(thread_pool->workers != NULL);
+
+  for (i = 0; i < thread_nr; i++) {
+    worker = thread_pool->workers + i;
+    worker->seed = 2463534242u + i * 7919u;
+    worker->thread_pool = thread_pool;
+    worker->capacity = ACTION_THREAD_POOL_WORKER_INIT_CAPACITY;
+    worker->actions = TKMEM_ZALLOCN(qaction_t*, worker->capacity);
+    goto_error_if_fail(worker->actions != NULL);
+    worker->mutex = tk_mutex_create();
+    goto_error_if_fail(worker->mutex != NULL);
+  }
+
+  for (i = 0; i < thread_nr; i++) {
+    worker = thread_pool->workers + i;
+    worker->thread = tk_thread_create(action_thread_pool_worker_entry, worker);
+    goto_error_if_fail(worker->thread != NULL);
+
+    if (priority != TK_THREAD_PRIORITY_NORMAL) {
+      tk_thread_set_priority(worker->thread, priority);
+    }
+    if (stack_size != 0) {
+      tk_thread_set_stack_size(worker->thread, stack_size);
+    }
+
+    if (tk_thread_start(worker->thread) != RET_OK) {
+      tk_thread_destroy(worker->thread);
+      worker->thread = NULL;
+      goto error;
+    }
+    started++;
+  }
+
+  /*等待全部线程启动，确保提交action时thread_id已经设置好。*/
+  for (i = 0; i < started; i++) {
+    ENSURE(tk_semaphore_wait(thread_pool->sema_ready, 0xffffffff) == RET_OK);
+  }
+
+  return thread_pool;
+error:
+  if (thread_pool->workers != NULL) {
+    for (i = 0; i < started; i++) {
+      ENSURE(tk_semaphore_wait(thread_pool->sema_ready, 0xffffffff) == RET_OK);
+    }
+    action_thread_pool_destroy_workers(thread_pool);
+  } else {
+    if (thread_pool->mutex != NULL) {
+      tk_mutex_destroy(thread_pool->mutex);
+    }
+    if (thread_pool->sema_work != NULL) {
+      tk_semaphore_destroy(thread_pool->sema_work);
+    }
+    if (thread_pool->sema_ready != NULL) {
+      tk_semaphore_destroy(thread_pool->sema_ready);
+    }
+    if (thread_pool->sema_pending != NULL) {
+      tk_semaphore_destroy(thread_pool->sema_pending);
+    }
+    TKMEM_FREE(thread_pool);
+  }
+
+  return NULL;
+}
+
+static action_thread_pool_worker_t* action_thread_pool_select_worker(
+    action_thread_pool_t* thread_pool) {
+  uint32_t i = 0;
+  uint64_t self = tk_thread_self();
+
+  /*在线程池的线程中提交的action放到自己的队列中。*/
+  for (i = 0; i < thread_pool->max_thread_nr; i++) {
+    if (thread_pool->workers[i].thread_id == self) {
+      return thread_pool->workers + i;
+    }
+  }
+
+  return_value_if_fail(tk_mutex_lock(thread_pool->mutex) == RET_OK, thread_pool->workers);
+  i = thread_pool->next_worker++ % thread_pool->max_thread_nr;
+  tk_mutex_unlock(thread_pool->mutex);
+
+  return thread_pool->workers + i;
+}
+
+static ret_t action_thread_pool_exec_batch_work_stealing(action_thread_pool_t* thread_pool,
+                                                         qaction_t** actions, uint32_t nr) {
+  uint32_t i = 0;
+  uint32_t reserved = nr;
+  action_thread_pool_worker_t* worker = action_thread_pool_select_worker(thread_pool);
+  bool_t in_pool = worker->thread_id == tk_thread_self();
+
+  if (thread_pool->sema_pending != NULL) {
+    if (in_pool) {
+      /*线程池中的线程不能等待，否则可能所有线程都在等待而死锁，放不下的直接在当前线程执行。*/
+      for (reserved = 0; reserved < nr; reserved++) {
+        if (tk_semaphore_wait(thread_pool->sema_pending, 0) != RET_OK) {
+          break;
+        }
+      }
+    } else {
+      return_value_if_fail(nr <= thread_pool->max_pending_nr, RET_BAD_PARAMS);
+      for (reserved = 0; reserved < nr; reserved++) {
+        if (tk_semaphore_wait(thread_pool->sema_pending, 1000) != RET_OK) {
+          break;
+        }
+      }
+
+      if (reserved < nr) {
+        for (i = 0; i < reserved; i++) {
+          ENSURE(tk_semaphore_post(thread_pool->sema_pending) == RET_OK);
+        }
+        return RET_TIMEOUT;
+      }
+    }
+  }
+
+  for (i = 0; i < reserved; i++) {
+    action_thread_pool_worker_t* iter = worker;
+
+    if (!in_pool) {
+      uint32_t index = (worker - thread_pool->workers) + i;
+      iter = thread_pool->workers + index % thread_pool->max_thread_nr;
+    }
+
+    if (action_thread_pool_worker_push(iter, actions[i]) == RET_OK) {
+      ENSURE(tk_semaphore_post(thread_pool->sema_work) == RET_OK);
+    } else {
+      /*内存不足时，在当前线程直接执行，保证提交的action都会被执行。*/
+      if (thread_pool->sema_pending != NULL) {
+        ENSURE(tk_semaphore_post(thread_pool->sema_pending) == RET_OK);
+      }
+      action_thread_pool_run_action(actions[i]);
+    }
+  }
+
+  for (i = reserved; i < nr; i++) {
+    action_thread_pool_run_action(actions[i]);
+  }
+
+  return RET_OK;
+}
+
+ret_t action_thread_pool_exec_batch(action_thread_pool_t* thread_pool, qaction_t** actions,
+                                    uint32_t nr) {
+  uint32_t i = 0;
+  return_value_if_fail(thread_pool != NULL && actions != NULL, RET_BAD_PARAMS);
+
+  for (i = 0; i < nr; i++) {
+    return_value_if_fail(actions[i] != NULL, RET_BAD_PARAMS);
+  }
+
+  if (thread_pool->work_stealing) {
+    return action_thread_pool_exec_batch_work_stealing(thread_pool, actions, nr);
+  }
+  return_value_if_fail(action_thread_pool_ensure_threads(thread_pool) == RET_OK, RET_FAIL);
+
+  if (thread_pool->queue->queue->full) {
+    action_thread_pool_create_thread(thread_pool);
+  }
+
+  return waitable_action_queue_send_batch(thread_pool->queue, actions, nr, 1000);
+}
+
 ret_t action_thread_pool_exec(action_thread_pool_t* thread_pool, qaction_t* action) {
   return_value_if_fail(thread_pool != NULL && action != NULL, RET_BAD_PARAMS);
+
+  if (thread_pool->work_stealing) {
+    return action_thread_pool_exec_batch_work_stealing(thread_pool, &action, 1);
+  }
   return_value_if_fail(action_thread_pool_ensure_threads(thread_pool) == RET_OK, RET_FAIL);
 
   if (thread_pool->queue->queue->full) {
@@ -146,6 +578,10 @@ ret_t action_thread_pool_destroy(action_thread_pool_t* thread_pool) {
   action_thread_t* thread = NULL;
   return_value_if_fail(thread_pool != NULL, RET_BAD_PARAMS);
 
+  if (thread_pool->work_stealing) {
+    return action_thread_pool_destroy_workers(thread_pool);
+  }
+
   for (i = 0; i < thread_pool->max_thread_nr; i++) {
     thread = thread_pool->threads[i];
     if (thread != NULL) {
@@ -26,9 +26,18 @@
 
 BEGIN_C_DECLS
 
+struct _action_thread_pool_worker_t;
+typedef struct _action_thread_pool_worker_t action_thread_pool_worker_t;
+
 /**
  * @class action_thread_pool_t
  * action线程池。
+ *
+ * 支持两种模式：
+ *
+ * * 共享队列模式(action\_thread\_pool\_create)。所有线程共享一个有界队列，线程数量按需增减。
+ * * 任务窃取模式(action\_thread\_pool\_create\_work\_stealing)。每个线程有自己的双端队列，
+ * 线程优先执行自己队列中的action，空闲时随机从其它线程的队列中窃取，减少对同一个队列的竞争。
  */
 typedef struct _action_thread_pool_t {
   /**
@@ -59,9 +68,31 @@ typedef struct _action_thread_pool_t {
    */
   tk_thread_priority_t priority;
 
+  /**
+   * @property {bool_t} work_stealing
+   * @annotation ["readable"]
+   * 是否为任务窃取模式。
+   */
+  bool_t work_stealing;
+
+  /**
+   * @property {uint32_t} max_pending_nr
+   * @annotation ["readable"]
+   * 任务窃取模式下，等待执行的action的最大个数(0表示不限)。
+   */
+  uint32_t max_pending_nr;
+
   /*private*/
   tk_mutex_t* mutex;
   waitable_action_queue_t* queue;
+
+  bool_t quit;
+  uint32_t next_worker;
+  tk_semaphore_t* sema_work;
+  tk_semaphore_t* sema_pending;
+  tk_semaphore_t* sema_ready;
+  action_thread_pool_worker_t* workers;
+
   action_thread_t* threads[1];
 } action_thread_pool_t;
 
@@ -93,6 +124,36 @@ action_thread_pool_t* action_thread_pool_create_ex(uint16_t max_thread_nr, uint1
                                                    uint32_t stack_size,
                                                    tk_thread_priority_t priority);
 
+/**
+ * @method action_thread_pool_create_work_stealing
+ * @annotation ["constructor"]
+ * 创建任务窃取模式的action_thread_pool对象。
+ *
+ * @param {uint16_t} thread_nr 线程数。
+ * @param {uint32_t} max_pending_nr 等待执行的action的最大个数，超过时提交者等待(0表示不限)。
+ *
+ * @return {action_thread_pool_t*} action_thread_pool对象。
+ */
+action_thread_pool_t* action_thread_pool_create_work_stealing(uint16_t thread_nr,
+                                                              uint32_t max_pending_nr);
+
+/**
+ * @method action_thread_pool_create_work_stealing_ex
+ * @annotation ["constructor"]
+ * 创建任务窃取模式的action_thread_pool对象。
+ *
+ * @param {uint16_t} thread_nr 线程数。
+ * @param {uint32_t} max_pending_nr 等待执行的action的最大个数，超过时提交者等待(0表示不限)。
+ * @param {uint32_t}  stack_size 栈的大小。
+ * @param {tk_thread_priority_t}  priority 优先级
+ *
+ * @return {action_thread_pool_t*} action_thread_pool对象。
+ */
+action_thread_pool_t* action_thread_pool_create_work_stealing_ex(uint16_t thread_nr,
+                                                                 uint32_t max_pending_nr,
+                                                                 uint32_t stack_size,
+                                                                 tk_thread_priority_t priority);
+
 /**
  * @method action_thread_pool_exec
  * 执行action。
@@ -104,6 +165,23 @@ action_thread_pool_t* action_thread_pool_create_ex(uint16_t max_thread_nr, uint1
  */
 ret_t action_thread_pool_exec(action_thread_pool_t* thread_pool, qaction_t* action);
 
+/**
+ * @method action_thread_pool_exec_batch
+ * 批量执行action。
+ *
+ * > 要么全部提交，要么全部不提交(失败时action仍由调用者负责)。
+ * > 任务窃取模式下一次分配到各个线程的队列中，设置了max\_pending\_nr时nr不能超过它。
+ * > 共享队列模式下一次放入共享队列，nr不能超过共享队列的容量(max\_thread\_nr * 5)。
+ *
+ * @param {action_thread_pool_t*} thread_pool action_thread_pool对象。
+ * @param {qaction_t**} actions action对象数组。
+ * @param {uint32_t} nr action的个数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t action_thread_pool_exec_batch(action_thread_pool_t* thread_pool, qaction_t** actions,
+                                    uint32_t nr);
+
 /**
  * @method action_thread_pool_destroy
  * 销毁。
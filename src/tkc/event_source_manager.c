@@ -66,6 +66,26 @@ ret_t event_source_manager_dispatch(event_source_manager_t* manager) {
   return RET_OK;
 }
 
+ret_t event_source_manager_wait(event_source_manager_t* manager, uint32_t max_time) {
+  return_value_if_fail(manager != NULL, RET_BAD_PARAMS);
+
+  if (manager->wait != NULL) {
+    return manager->wait(manager, max_time);
+  }
+
+  return RET_NOT_IMPL;
+}
+
+ret_t event_source_manager_wakeup(event_source_manager_t* manager) {
+  return_value_if_fail(manager != NULL, RET_BAD_PARAMS);
+
+  if (manager->wakeup != NULL) {
+    return manager->wakeup(manager);
+  }
+
+  return RET_NOT_IMPL;
+}
+
 ret_t event_source_manager_add(event_source_manager_t* manager, event_source_t* source) {
   return_value_if_fail(manager != NULL && source != NULL, RET_BAD_PARAMS);
   object_ref(OBJECT(source));
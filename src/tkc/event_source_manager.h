@@ -29,6 +29,8 @@ BEGIN_C_DECLS
 
 typedef ret_t (*event_source_manager_dispatch_t)(event_source_manager_t* manager);
 typedef ret_t (*event_source_manager_destroy_t)(event_source_manager_t* manager);
+typedef ret_t (*event_source_manager_wait_t)(event_source_manager_t* manager, uint32_t max_time);
+typedef ret_t (*event_source_manager_wakeup_t)(event_source_manager_t* manager);
 
 /**
  * @class event_source_manager_t
@@ -43,6 +45,8 @@ struct _event_source_manager_t {
 
   event_source_manager_dispatch_t dispatch;
   event_source_manager_destroy_t destroy;
+  event_source_manager_wait_t wait;
+  event_source_manager_wakeup_t wakeup;
 };
 
 /**
@@ -93,6 +97,29 @@ uint32_t event_source_manager_get_wakeup_time(event_source_manager_t* manager);
  */
 ret_t event_source_manager_dispatch(event_source_manager_t* manager);
 
+/**
+ * @method event_source_manager_wait
+ * 等待，直到有事件源就绪、被event\_source\_manager\_wakeup唤醒或者超时。
+ *
+ * > 超时时间取max\_time和全部事件源的唤醒时间中较小的一个。
+ * > 不支持等待的事件源管理器返回RET\_NOT\_IMPL，调用者自己决定睡眠的时间。
+ *
+ * @param {event_source_manager_t*} manager event_source_manager对象。
+ * @param {uint32_t} max_time 最长等待时间(ms)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t event_source_manager_wait(event_source_manager_t* manager, uint32_t max_time);
+
+/**
+ * @method event_source_manager_wakeup
+ * 唤醒正在event\_source\_manager\_wait中等待的线程(可以在其它线程中调用)。
+ * @param {event_source_manager_t*} manager event_source_manager对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t event_source_manager_wakeup(event_source_manager_t* manager);
+
 /**
  * @method event_source_manager_add
  *
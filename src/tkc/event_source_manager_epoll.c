@@ -0,0 +1,340 @@
+/**
+ * File:   event_source_manager_epoll.c
+ * Author: AWTK Develop Team
+ * Brief:  event manager manager implement with epoll
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/event_source_manager_epoll.h"
+
+#ifdef WITH_EVENT_SOURCE_EPOLL
+
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+
+#define EPOLL_EVENTS_NR 32
+
+typedef struct _epoll_fd_info_t {
+  int32_t fd;
+  event_source_t* source;
+  bool_t alive;
+} epoll_fd_info_t;
+
+typedef struct _event_source_manager_epoll_t {
+  event_source_manager_t manager;
+
+  int epoll_fd;
+  int timer_fd;
+  int wakeup_fd;
+
+  /*已经注册到epoll中的文件描述符*/
+  epoll_fd_info_t* fds;
+  uint32_t fds_nr;
+  uint32_t fds_capacity;
+
+  /*最近一次epoll_wait就绪的文件描述符*/
+  int32_t ready_fds[EPOLL_EVENTS_NR];
+  uint32_t ready_fds_nr;
+} event_source_manager_epoll_t;
+
+static epoll_fd_info_t* event_source_manager_epoll_find(event_source_manager_epoll_t* epoll,
+                                                        int32_t fd, event_source_t* source) {
+  uint32_t i = 0;
+
+  for (i = 0; i < epoll->fds_nr; i++) {
+    epoll_fd_info_t* iter = epoll->fds + i;
+    if (iter->fd == fd && iter->source == source) {
+      return iter;
+    }
+  }
+
+  return NULL;
+}
+
+static ret_t event_source_manager_epoll_register(event_source_manager_epoll_t* epoll, int32_t fd,
+                                                 event_source_t* source) {
+  struct epoll_event ev;
+  epoll_fd_info_t* info = NULL;
+
+  if (epoll->fds_nr >= epoll->fds_capacity) {
+    uint32_t capacity = epoll->fds_capacity + 8;
+    epoll_fd_info_t* fds = TKMEM_REALLOCT(epoll_fd_info_t, epoll->fds, capacity);
+    return_value_if_fail(fds != NULL, RET_OOM);
+
+    epoll->fds = fds;
+    epoll->fds_capacity = capacity;
+  }
+
+  memset(&ev, 0x00, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = fd;
+  if (epoll_ctl(epoll->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0 && errno != EEXIST) {
+    log_debug("epoll_ctl add %d failed(%d)\n", fd, errno);
+    return RET_FAIL;
+  }
+
+  info = epoll->fds + epoll->fds_nr++;
+  info->fd = fd;
+  info->source = source;
+  info->alive = TRUE;
+
+  return RET_OK;
+}
+
+/*事件源随时可能增加或删除，每次等待和分发前把有文件描述符的事件源同步到epoll中。*/
+static ret_t event_source_manager_epoll_sync(event_source_manager_epoll_t* epoll) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+  int32_t fd = 0;
+  event_source_manager_t* manager = &(epoll->manager);
+  event_source_t** sources = (event_source_t**)(manager->sources.elms);
+
+  for (i = 0; i < epoll->fds_nr; i++) {
+    epoll->fds[i].alive = FALSE;
+  }
+
+  for (i = 0; i < manager->sources.size; i++) {
+    fd = event_source_get_fd(sources[i]);
+    if (fd >= 0) {
+      epoll_fd_info_t* info = event_source_manager_epoll_find(epoll, fd, sources[i]);
+      if (info != NULL) {
+        info->alive = TRUE;
+      }
+    }
+  }
+
+  for (i = 0, k = 0; i < epoll->fds_nr; i++) {
+    epoll_fd_info_t* iter = epoll->fds + i;
+    if (iter->alive) {
+      epoll->fds[k++] = *iter;
+    } else {
+      /*文件描述符可能已经关闭，失败可以忽略。*/
+      epoll_ctl(epoll->epoll_fd, EPOLL_CTL_DEL, iter->fd, NULL);
+    }
+  }
+  epoll->fds_nr = k;
+
+  for (i = 0; i < manager->sources.size; i++) {
+    fd = event_source_get_fd(sources[i]);
+    if (fd >= 0 && event_source_manager_epoll_find(epoll, fd, sources[i]) == NULL) {
+      event_source_manager_epoll_register(epoll, fd, sources[i]);
+    }
+  }
+
+  return RET_OK;
+}
+
+static ret_t event_source_manager_epoll_poll(event_source_manager_epoll_t* epoll, int timeout) {
+  int32_t i = 0;
+  int32_t ret = 0;
+  uint64_t value = 0;
+  struct epoll_event events[EPOLL_EVENTS_NR];
+
+  epoll->ready_fds_nr = 0;
+  ret = epoll_wait(epoll->epoll_fd, events, EPOLL_EVENTS_NR, timeout);
+  if (ret < 0) {
+    if (errno != EINTR) {
+      perror("epoll_wait");
+      return RET_FAIL;
+    }
+    return RET_OK;
+  } else if (ret == 0) {
+    return RET_TIMEOUT;
+  }
+
+  for (i = 0; i < ret; i++) {
+    int32_t fd = events[i].data.fd;
+
+    if (fd == epoll->wakeup_fd || fd == epoll->timer_fd) {
+      if (read(fd, &value, sizeof(value)) < 0) {
+        log_debug("read %d failed(%d)\n", fd, errno);
+      }
+    } else {
+      epoll->ready_fds[epoll->ready_fds_nr++] = fd;
+    }
+  }
+
+  return RET_OK;
+}
+
+static bool_t event_source_manager_epoll_is_ready(event_source_manager_epoll_t* epoll, int32_t fd) {
+  uint32_t i = 0;
+
+  for (i = 0; i < epoll->ready_fds_nr; i++) {
+    if (epoll->ready_fds[i] == fd) {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+static ret_t event_source_manager_epoll_dispatch(event_source_manager_t* manager) {
+  uint32_t i = 0;
+  int32_t fd = 0;
+  event_source_t* iter = NULL;
+  event_source_t** sources = NULL;
+  event_source_manager_epoll_t* epoll = (event_source_manager_epoll_t*)manager;
+
+  event_source_manager_epoll_sync(epoll);
+  event_source_manager_epoll_poll(epoll, 0);
+
+  sources = (event_source_t**)(manager->dispatching_sources.elms);
+  for (i = 0; i < manager->dispatching_sources.size; i++) {
+    ret_t r = RET_OK;
+
+    iter = sources[i];
+    fd = event_source_get_fd(iter);
+    if (fd >= 0) {
+      if (!event_source_manager_epoll_is_ready(epoll, fd)) {
+        continue;
+      }
+    } else if (event_source_check(iter) != RET_OK) {
+      continue;
+    }
+
+    r = event_source_dispatch(iter);
+    if (r == RET_REMOVE) {
+      event_source_manager_remove(manager, iter);
+    }
+  }
+  epoll->ready_fds_nr = 0;
+
+  return RET_OK;
+}
+
+/*与event_source_manager_get_wakeup_time不同，这里不限制最长的时间。*/
+static uint32_t event_source_manager_epoll_get_wakeup_time(event_source_manager_t* manager,
+                                                           uint32_t max_time) {
+  uint32_t i = 0;
+  uint32_t t = 0;
+  uint32_t wakeup_time = max_time;
+  event_source_t** sources = (event_source_t**)(manager->sources.elms);
+
+  for (i = 0; i < manager->sources.size; i++) {
+    t = event_source_get_wakeup_time(sources[i]);
+    if (t < wakeup_time) {
+      wakeup_time = t;
+    }
+  }
+
+  return wakeup_time;
+}
+
+static ret_t event_source_manager_epoll_wait(event_source_manager_t* manager, uint32_t max_time) {
+  struct itimerspec its;
+  uint32_t wakeup_time = 0;
+  event_source_manager_epoll_t* epoll = (event_source_manager_epoll_t*)manager;
+
+  event_source_manager_epoll_sync(epoll);
+  wakeup_time = event_source_manager_epoll_get_wakeup_time(manager, max_time);
+  if (wakeup_time == 0) {
+    return RET_OK;
+  }
+
+  /*重新设置会清除之前到期的次数，timerfd就绪时说明已经到了唤醒时间。*/
+  memset(&its, 0x00, sizeof(its));
+  its.it_value.tv_sec = wakeup_time / 1000;
+  its.it_value.tv_nsec = (wakeup_time % 1000) * 1000000;
+  if (timerfd_settime(epoll->timer_fd, 0, &its, NULL) != 0) {
+    return event_source_manager_epoll_poll(epoll, wakeup_time);
+  }
+
+  /*只等待，就绪的事件源留给下一次dispatch处理。*/
+  return event_source_manager_epoll_poll(epoll, -1);
+}
+
+static ret_t event_source_manager_epoll_wakeup(event_source_manager_t* manager) {
+  uint64_t value = 1;
+  event_source_manager_epoll_t* epoll = (event_source_manager_epoll_t*)manager;
+
+  if (write(epoll->wakeup_fd, &value, sizeof(value)) != sizeof(value)) {
+    return RET_FAIL;
+  }
+
+  return RET_OK;
+}
+
+static ret_t event_source_manager_epoll_close(event_source_manager_epoll_t* epoll) {
+  if (epoll->epoll_fd >= 0) {
+    close(epoll->epoll_fd);
+  }
+  if (epoll->timer_fd >= 0) {
+    close(epoll->timer_fd);
+  }
+  if (epoll->wakeup_fd >= 0) {
+    close(epoll->wakeup_fd);
+  }
+  TKMEM_FREE(epoll->fds);
+
+  return RET_OK;
+}
+
+static ret_t event_source_manager_epoll_destroy(event_source_manager_t* manager) {
+  event_source_manager_epoll_t* epoll = (event_source_manager_epoll_t*)manager;
+  return_value_if_fail(manager != NULL && manager->dispatch != NULL, RET_BAD_PARAMS);
+
+  event_source_manager_epoll_close(epoll);
+  memset(epoll, 0x00, sizeof(event_source_manager_epoll_t));
+  TKMEM_FREE(epoll);
+
+  return RET_OK;
+}
+
+static ret_t event_source_manager_epoll_add_fd(event_source_manager_epoll_t* epoll, int fd) {
+  struct epoll_event ev;
+
+  memset(&ev, 0x00, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.fd = fd;
+
+  return epoll_ctl(epoll->epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0 ? RET_OK : RET_FAIL;
+}
+
+event_source_manager_t* event_source_manager_epoll_create(void) {
+  event_source_manager_t* manager = NULL;
+  event_source_manager_epoll_t* epoll = TKMEM_ZALLOC(event_source_manager_epoll_t);
+  return_value_if_fail(epoll != NULL, NULL);
+
+  epoll->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  epoll->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  epoll->wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  goto_error_if_fail(epoll->epoll_fd >= 0 && epoll->timer_fd >= 0 && epoll->wakeup_fd >= 0);
+  goto_error_if_fail(event_source_manager_epoll_add_fd(epoll, epoll->timer_fd) == RET_OK);
+  goto_error_if_fail(event_source_manager_epoll_add_fd(epoll, epoll->wakeup_fd) == RET_OK);
+
+  manager = &(epoll->manager);
+  event_source_manager_init(manager);
+  manager->dispatch = event_source_manager_epoll_dispatch;
+  manager->destroy = event_source_manager_epoll_destroy;
+  manager->wait = event_source_manager_epoll_wait;
+  manager->wakeup = event_source_manager_epoll_wakeup;
+
+  return manager;
+error:
+  event_source_manager_epoll_close(epoll);
+  TKMEM_FREE(epoll);
+
+  return NULL;
+}
+
+#endif /*WITH_EVENT_SOURCE_EPOLL*/
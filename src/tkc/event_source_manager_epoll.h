@@ -0,0 +1,64 @@
+/**
+ * File:   event_source_manager_epoll.h
+ * Author: AWTK Develop Team
+ * Brief:  event manager manager implement with epoll
+ *
+ * Copyright (c) 2018 - 2021  Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2021-06-20 AWTK Develop Team created
+ *
+ */
+
+#ifndef TK_EVENT_SOURCE_MANAGER_EPOLL_H
+#define TK_EVENT_SOURCE_MANAGER_EPOLL_H
+
+#include "tkc/event_source_manager.h"
+
+BEGIN_C_DECLS
+
+/*Linux下缺省启用，定义WITHOUT_EVENT_SOURCE_EPOLL可以禁用。*/
+#if defined(LINUX) && !defined(WITHOUT_EVENT_SOURCE_EPOLL) && !defined(WITH_EVENT_SOURCE_EPOLL)
+#define WITH_EVENT_SOURCE_EPOLL 1
+#endif /*LINUX*/
+
+#ifdef WITH_EVENT_SOURCE_EPOLL
+
+/**
+ * @class event_source_manager_epoll_t
+ * @parent event_source_manager_t
+ * @annotation ["fake"]
+ *
+ * 基于epoll的事件源管理器(Linux)。
+ *
+ * * 有文件描述符的事件源注册到epoll中，不再每次重建fd\_set。
+ * * event\_source\_manager\_wait用timerfd定时到最近的唤醒时间，用eventfd实现唤醒，
+ * 没有事件时一直阻塞，不再按固定的时间片轮询。
+ * * event\_source\_manager\_dispatch不阻塞，只分发已经就绪的事件源。
+ *
+ */
+
+/**
+ * @method event_source_manager_epoll_create
+ *
+ * 创建事件源管理器。
+ *
+ * @return {event_source_manager_t*} 返回事件源管理器对象，失败返回NULL。
+ *
+ */
+event_source_manager_t* event_source_manager_epoll_create(void);
+
+#endif /*WITH_EVENT_SOURCE_EPOLL*/
+
+END_C_DECLS
+
+#endif /*TK_EVENT_SOURCE_MANAGER_EPOLL_H*/
@@ -21,6 +21,9 @@
 
 #include "tkc/event_source_timer.h"
 
+/*最小的唤醒时间(毫秒)。*/
+#define EVENT_SOURCE_TIMER_MIN_WAKEUP_TIME 1
+
 static const object_vtable_t s_event_source_timer_vtable = {.type = "event_source_timer",
                                                             .desc = "event_source_timer",
                                                             .size = sizeof(event_source_timer_t)};
@@ -41,10 +44,16 @@ static ret_t event_source_timer_dispatch(event_source_t* source) {
 
 uint32_t event_source_timer_get_wakeup_time(event_source_t* source) {
   event_source_timer_t* event_source_timer = EVENT_SOURCE_TIMER(source);
-  uint64_t next_time = timer_manager_next_time(event_source_timer->timer_manager);
-  int64_t ret = next_time - event_source_timer->timer_manager->get_time();
+  timer_manager_t* timer_manager = event_source_timer->timer_manager;
+  uint64_t next_time = timer_manager_next_time(timer_manager);
+  int64_t ret = next_time - timer_manager->get_time();
+
+  if (ret > 0) {
+    return ret;
+  }
 
-  return ret > 0 ? ret : 0;
+  /*到期后已经dispatch过仍未触发的定时器，立即唤醒也无法触发，至少等待一会，避免空转。*/
+  return timer_manager->last_dispatch_time >= next_time ? EVENT_SOURCE_TIMER_MIN_WAKEUP_TIME : 0;
 }
 
 event_source_t* event_source_timer_create(timer_manager_t* timer_manager) {
@@ -31,6 +31,28 @@ struct _fscript_func_call_t {
 
 #define VALUE_TYPE_JSCRIPT_ID 128
 #define VALUE_TYPE_JSCRIPT_FUNC VALUE_TYPE_JSCRIPT_ID + 1
+#define VALUE_TYPE_FSCRIPT_ID VALUE_TYPE_JSCRIPT_ID + 2
+
+typedef enum _fscript_id_op_t {
+  FSCRIPT_ID_VAR = 0,
+  FSCRIPT_ID_FAST_VAR,
+  FSCRIPT_ID_FAST_VAR_PROP,
+  FSCRIPT_ID_BREAK,
+  FSCRIPT_ID_CONTINUE,
+  FSCRIPT_ID_RETURN
+} fscript_id_op_t;
+
+/*
+ * 编译后的标识符。
+ * 关键字和快速变量在创建时就识别出来，普通变量缓存它在obj中的位置，执行时不再比较字符串。
+ */
+typedef struct _fscript_id_t {
+  uint8_t op;
+  uint8_t fast_index;
+  bool_t is_dollar;
+  int32_t slot;
+  char* name;
+} fscript_id_t;
 
 static ret_t func_if(fscript_t* fscript, fscript_args_t* args, value_t* result);
 static ret_t func_while(fscript_t* fscript, fscript_args_t* args, value_t* result);
@@ -100,6 +122,13 @@ static ret_t func_args_init(fscript_args_t* args, uint16_t init_args_capacity) {
   return RET_OK;
 }
 
+static ret_t fscript_id_destroy(fscript_id_t* id) {
+  TKMEM_FREE(id->name);
+  TKMEM_FREE(id);
+
+  return RET_OK;
+}
+
 static ret_t fscript_func_call_destroy(fscript_func_call_t* call);
 static ret_t func_args_deinit(fscript_args_t* args) {
   uint32_t i = 0;
@@ -107,6 +136,9 @@ static ret_t func_args_deinit(fscript_args_t* args) {
     value_t* v = args->args + i;
     if (v->type == VALUE_TYPE_JSCRIPT_FUNC) {
       fscript_func_call_destroy(value_func(v));
+    } else if (v->type == VALUE_TYPE_FSCRIPT_ID) {
+      fscript_id_destroy((fscript_id_t*)(v->value.ptr));
+      v->free_handle = FALSE;
     } else {
       v->type = v->type == VALUE_TYPE_JSCRIPT_ID ? VALUE_TYPE_STRING : v->type;
     }
@@ -247,49 +279,54 @@ static ret_t fscript_set_var(fscript_t* fscript, const char* name, const value_t
   return ret;
 }
 
+static ret_t fscript_eval_id(fscript_t* fscript, fscript_id_t* id, value_t* d) {
+  ret_t ret = RET_OK;
+  const char* name = id->is_dollar ? id->name + 1 : id->name;
+
+  if (fscript->while_count > 0) {
+    if (id->op == FSCRIPT_ID_BREAK) {
+      fscript->breaked = TRUE;
+      return RET_OK;
+    } else if (id->op == FSCRIPT_ID_CONTINUE) {
+      fscript->continued = TRUE;
+      return RET_OK;
+    }
+  } else if (id->op == FSCRIPT_ID_RETURN) {
+    fscript->returned = TRUE;
+    value_set_int(d, 0);
+    return RET_OK;
+  }
+
+  if (id->op == FSCRIPT_ID_FAST_VAR) {
+    ret = value_copy(d, fscript->fast_vars + id->fast_index);
+  } else if (id->op == FSCRIPT_ID_FAST_VAR_PROP) {
+    ret = fscript_get_var(fscript, name, d);
+  } else {
+    ret = object_default_get_prop_by_slot(fscript->obj, name, d, &(id->slot));
+  }
+
+  if (ret != RET_OK && !id->is_dollar) {
+    /*if it is not $var, consider id as string*/
+    value_set_str(d, id->name);
+  }
+
+  return RET_OK;
+}
+
 static ret_t fscript_eval_arg(fscript_t* fscript, fscript_func_call_t* iter, uint32_t i,
                               value_t* d) {
-  value_t v;
   value_t* s = iter->args.args + i;
-  int32_t save_type = s->type;
-  value_set_str(&v, NULL);
   value_set_str(d, NULL);
-  if (s->type == VALUE_TYPE_JSCRIPT_ID) {
-    s->type = VALUE_TYPE_STRING;
-    if ((iter->func == func_set || iter->func == func_unset) && i == 0) {
-      value_copy(d, s); /*func_set accept id/str as first param*/
-    } else {
-      const char* name = value_str(s);
-      if (fscript->while_count > 0) {
-        if (tk_str_eq(name, "break")) {
-          fscript->breaked = TRUE;
-          s->type = save_type;
-          return RET_OK;
-        } else if (tk_str_eq(name, "continue")) {
-          fscript->continued = TRUE;
-          s->type = save_type;
-          return RET_OK;
-        }
-      } else if (tk_str_eq(name, "return")) {
-        fscript->returned = TRUE;
-        s->type = save_type;
-        value_set_int(d, 0);
-        return RET_OK;
-      }
-
-      if (fscript_get_var(fscript, name, d) != RET_OK) {
-        if (name == NULL || *name != '$') {
-          /*if it is not $var, consider id as string*/
-          value_copy(d, s);
-        }
-      }
-    }
+  if (s->type == VALUE_TYPE_FSCRIPT_ID) {
+    fscript_eval_id(fscript, (fscript_id_t*)(s->value.ptr), d);
+  } else if (s->type == VALUE_TYPE_JSCRIPT_ID) {
+    /*func_set accept id/str as first param*/
+    value_set_str(d, s->value.str);
   } else if (s->type == VALUE_TYPE_JSCRIPT_FUNC) {
     fscript_exec_func(fscript, value_func(s), d);
   } else {
     value_copy(d, s);
   }
-  s->type = save_type;
 
   return RET_OK;
 }
@@ -351,27 +388,45 @@ static ret_t fscript_exec_core_func(fscript_t* fscript, fscript_func_call_t* ite
 }
 
 static ret_t fscript_exec_ext_func(fscript_t* fscript, fscript_func_call_t* iter, value_t* result) {
-  value_t v;
   uint32_t i = 0;
   ret_t ret = RET_OK;
   fscript_args_t args;
+  uint32_t top = fscript->stack_top;
+  bool_t on_stack = top + iter->args.size <= fscript->stack_capacity;
 
-  value_set_int(&v, 0);
-  func_args_init(&args, iter->args.size);
+  memset(&args, 0x00, sizeof(args));
   args.size = iter->args.size;
-  return_value_if_fail((args.args != NULL || args.size == 0), RET_OOM);
-  for (i = 0; i < iter->args.size; i++) {
-    ret = fscript_eval_arg(fscript, iter, i, args.args + i);
+  args.capacity = iter->args.size;
+  if (on_stack) {
+    args.args = fscript->stack + top;
+    fscript->stack_top = top + args.size;
+  } else if (args.size > 0) {
+    /*在扩展函数中重入等情况，编译时无法预计，从堆上分配*/
+    args.args = TKMEM_ZALLOCN(value_t, args.size);
+    return_value_if_fail(args.args != NULL, RET_OOM);
+  }
+
+  value_set_int(result, 0);
+  for (i = 0; i < args.size; i++) {
+    fscript_eval_arg(fscript, iter, i, args.args + i);
     if (fscript->breaked || fscript->continued || fscript->returned) {
-      value_set_int(result, 0);
-      func_args_deinit(&args);
-      return RET_OK;
+      break;
     }
   }
 
-  value_set_int(result, 0);
-  ret = iter->func(fscript, &args, result);
-  func_args_deinit(&args);
+  if (i == args.size) {
+    ret = iter->func(fscript, &args, result);
+  }
+
+  for (i = 0; i < args.size; i++) {
+    value_reset(args.args + i);
+  }
+
+  if (on_stack) {
+    fscript->stack_top = top;
+  } else {
+    TKMEM_FREE(args.args);
+  }
 
   return ret;
 }
@@ -412,6 +467,7 @@ ret_t fscript_destroy(fscript_t* fscript) {
   str_reset(&(fscript->str));
   TKMEM_FREE(fscript->error_message);
   fscript_func_call_destroy(fscript->first);
+  TKMEM_FREE(fscript->stack);
   for (i = 0; i < ARRAY_SIZE(fscript->fast_vars); i++) {
     value_reset(fscript->fast_vars + i);
   }
@@ -1202,7 +1258,84 @@ static ret_t fexpr_parse(fscript_parser_t* parser, value_t* result) {
   return RET_OK;
 }
 
+static fscript_id_t* fscript_id_create(char* name) {
+  const char* var_name = name;
+  fscript_id_t* id = TKMEM_ZALLOC(fscript_id_t);
+  return_value_if_fail(id != NULL, NULL);
+
+  id->slot = -1;
+  id->name = name;
+  id->op = FSCRIPT_ID_VAR;
+  id->is_dollar = *name == '$';
+
+  if (tk_str_eq(name, "break")) {
+    id->op = FSCRIPT_ID_BREAK;
+  } else if (tk_str_eq(name, "continue")) {
+    id->op = FSCRIPT_ID_CONTINUE;
+  } else if (tk_str_eq(name, "return")) {
+    id->op = FSCRIPT_ID_RETURN;
+  } else {
+    if (id->is_dollar) {
+      var_name += 1;
+    }
+
+    if (is_fast_var(var_name)) {
+      id->fast_index = var_name[0] - 'a';
+      id->op = var_name[1] == '.' ? FSCRIPT_ID_FAST_VAR_PROP : FSCRIPT_ID_FAST_VAR;
+    }
+  }
+
+  return id;
+}
+
+/*
+ * 把标识符编译成fscript_id_t，同时计算执行时需要的参数栈深度：
+ * 扩展函数执行时，它的参数和参数中嵌套调用的参数同时存在。
+ */
+static ret_t fscript_func_call_compile(fscript_func_call_t* call, uint32_t* depth) {
+  fscript_func_call_t* iter = call;
+
+  *depth = 0;
+  while (iter != NULL) {
+    uint32_t i = 0;
+    uint32_t sub_depth = 0;
+    uint32_t call_depth = 0;
+
+    for (i = 0; i < iter->args.size; i++) {
+      value_t* v = iter->args.args + i;
+
+      if (v->type == VALUE_TYPE_JSCRIPT_FUNC) {
+        return_value_if_fail(fscript_func_call_compile(value_func(v), &call_depth) == RET_OK,
+                             RET_OOM);
+        sub_depth = tk_max(sub_depth, call_depth);
+      } else if (v->type == VALUE_TYPE_JSCRIPT_ID) {
+        fscript_id_t* id = NULL;
+        if ((iter->func == func_set || iter->func == func_unset) && i == 0) {
+          continue;
+        }
+
+        id = fscript_id_create((char*)(v->value.str));
+        return_value_if_fail(id != NULL, RET_OOM);
+        v->type = VALUE_TYPE_FSCRIPT_ID;
+        v->value.ptr = id;
+        v->free_handle = FALSE;
+      }
+    }
+
+    if (iter->func == func_if || iter->func == func_while) {
+      call_depth = sub_depth;
+    } else {
+      call_depth = iter->args.size + sub_depth;
+    }
+    *depth = tk_max(*depth, call_depth);
+    iter = iter->next;
+  }
+
+  return RET_OK;
+}
+
 fscript_t* fscript_create_impl(fscript_parser_t* parser) {
+  uint32_t depth = 0;
   fscript_t* fscript = TKMEM_ZALLOC(fscript_t);
   return_value_if_fail(fscript != NULL, NULL);
   fscript->str = parser->temp;
@@ -1213,6 +1346,18 @@ fscript_t* fscript_create_impl(fscript_parser_t* parser) {
   parser->first = NULL;
   parser->temp.str = NULL;
 
+  if (fscript_func_call_compile(fscript->first, &depth) != RET_OK) {
+    fscript_destroy(fscript);
+    return NULL;
+  }
+
+  if (depth > 0) {
+    fscript->stack = TKMEM_ZALLOCN(value_t, depth);
+    if (fscript->stack != NULL) {
+      fscript->stack_capacity = depth;
+    }
+  }
+
   return fscript;
 }
 
@@ -146,6 +146,10 @@ typedef struct _fscript_t {
   bool_t continued;
   bool_t returned;
   uint8_t while_count;
+  /*编译时算出的最大深度，执行时函数参数从这里分配*/
+  value_t* stack;
+  uint32_t stack_top;
+  uint32_t stack_capacity;
 } fscript_t;
 
 typedef ret_t (*fscript_func_t)(fscript_t* fscript, fscript_args_t* args, value_t* v);
@@ -395,3 +395,31 @@ object_default_t* object_default_cast(object_t* obj) {
 ret_t object_default_unref(object_t* obj) {
   return object_unref(obj);
 }
+
+ret_t object_default_get_prop_by_slot(object_t* obj, const char* name, value_t* v, int32_t* slot) {
+  int32_t index = 0;
+  object_default_t* o = NULL;
+  return_value_if_fail(obj != NULL && name != NULL && v != NULL && slot != NULL, RET_BAD_PARAMS);
+
+  if (obj->vt != &s_object_default_vtable || *name == '[' || *name == '#' ||
+      strchr(name, '.') != NULL) {
+    return object_get_prop(obj, name, v);
+  }
+
+  o = OBJECT_DEFAULT(obj);
+  index = *slot;
+  if (index >= 0 && index < o->props_size && tk_str_eq(o->props[index].name, name)) {
+    return value_copy(v, &(o->props[index].value));
+  }
+
+  value_set_str(v, NULL);
+  if (o->props_size > 0) {
+    index = object_default_find(o->props, o->props_size, name);
+    if (index >= 0 && index < o->props_size && tk_str_eq(o->props[index].name, name)) {
+      *slot = index;
+      return value_copy(v, &(o->props[index].value));
+    }
+  }
+
+  return RET_NOT_FOUND;
+}
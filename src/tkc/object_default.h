@@ -131,6 +131,24 @@ ret_t object_default_clear_props(object_t* obj);
  */
 value_t* object_default_find_prop(object_t* obj, tk_compare_t cmp, const void* data);
 
+/**
+ * @method object_default_get_prop_by_slot
+ *
+ * 获取属性的值，并用slot缓存属性在属性数组中的位置。
+ *
+ * > 下次用同一个slot获取时，如果该位置的属性名仍然匹配，直接返回，不再二分查找。
+ * > slot初始化为-1。obj不是object\_default对象时，等同于object\_get\_prop。
+ *
+ * @param {object_t*} obj 对象。
+ * @param {const char*} name 属性的名称。
+ * @param {value_t*} v 返回属性的值。
+ * @param {int32_t*} slot 属性位置的缓存。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ *
+ */
+ret_t object_default_get_prop_by_slot(object_t* obj, const char* name, value_t* v, int32_t* slot);
+
 object_default_t* object_default_cast(object_t* obj);
 #define OBJECT_DEFAULT(obj) object_default_cast(obj)
 
@@ -38,6 +38,10 @@
   }
 #endif
 
+/*队列中的日志按4字节对齐，头部为日志的长度，长度为0表示跳到队列开头。*/
+#define RLOG_RECORD_HEADER_SIZE sizeof(uint32_t)
+#define RLOG_RECORD_SIZE(len) (RLOG_RECORD_HEADER_SIZE + TK_ROUND_TO4(len))
+
 rlog_t* rlog_create(const char* filename_pattern, uint32_t max_size, uint32_t buff_size) {
   rlog_t* log = NULL;
   fs_stat_info_t fst;
@@ -71,6 +75,10 @@ rlog_t* rlog_create(const char* filename_pattern, uint32_t max_size, uint32_t bu
 
     if (log->filename_pattern != NULL) {
       log->fp = fp;
+      /*之后自己记录文件的大小，避免每次写入都要获取文件信息。*/
+      if (fs_file_stat(fp, &fst) == RET_OK) {
+        log->size = (uint32_t)(fst.size);
+      }
     } else {
       fs_file_close(fp);
       TKMEM_FREE(log);
@@ -82,32 +90,217 @@ rlog_t* rlog_create(const char* filename_pattern, uint32_t max_size, uint32_t bu
   return log;
 }
 
-ret_t rlog_write(rlog_t* log, const char* str) {
+static ret_t rlog_write_file(rlog_t* log, const char* str, uint32_t len) {
+  if ((log->size + len) > log->max_size) {
+    char filename0[MAX_PATH + 1];
+    char filename1[MAX_PATH + 1];
+
+    fs_file_close(log->fp);
+    memset(filename1, 0x00, sizeof(filename1));
+    tk_snprintf(filename1, MAX_PATH, log->filename_pattern, (int)1);
+    if (log->index == 1) {
+      memset(filename0, 0x00, sizeof(filename0));
+      tk_snprintf(filename0, MAX_PATH, log->filename_pattern, (int)0);
+      fs_remove_file(os_fs(), filename0);
+      fs_file_rename(os_fs(), filename1, filename0);
+    }
+    log->index = 1;
+    log->size = 0;
+    log->fp = fs_open_file(os_fs(), filename1, "wb+");
+  }
+
+  if (log->fp != NULL) {
+    fs_file_write(log->fp, str, len);
+    log->size += len;
+  }
+
+  return log->fp != NULL ? RET_OK : RET_FAIL;
+}
+
+static ret_t rlog_queue_reserve(rlog_t* log, uint32_t size, uint32_t* offset) {
+  uint32_t tail = 0;
+  uint32_t skip = 0;
+
+  if (log->queue_used == 0) {
+    log->queue_head = 0;
+  }
+
+  if (log->queue_used + size > log->queue_size) {
+    return RET_BUSY;
+  }
+
+  tail = (log->queue_head + log->queue_used) % log->queue_size;
+  if (tail >= log->queue_head && (log->queue_size - tail) < size) {
+    /*队列尾部放不下，跳过尾部的空间，从开头开始放。*/
+    if (log->queue_head < size) {
+      return RET_BUSY;
+    }
+
+    skip = log->queue_size - tail;
+    memset(log->queue + tail, 0x00, RLOG_RECORD_HEADER_SIZE);
+    tail = 0;
+  }
+
+  *offset = tail;
+  log->queue_used += skip + size;
+  log->queued += skip + size;
+
+  return RET_OK;
+}
+
+static ret_t rlog_queue_push(rlog_t* log, const char* str, uint32_t len) {
+  ret_t ret = RET_OK;
+  uint32_t used = 0;
+  uint32_t offset = 0;
+  uint32_t size = RLOG_RECORD_SIZE(len);
+  my_return_value_if_fail(size <= log->queue_size, RET_BAD_PARAMS);
+
+  if (len == 0) {
+    return RET_OK;
+  }
+
+  my_return_value_if_fail(tk_mutex_lock(log->queue_mutex) == RET_OK, RET_FAIL);
+  while (TRUE) {
+    used = log->queue_used;
+    ret = rlog_queue_reserve(log, size, &offset);
+    if (ret != RET_BUSY || !log->block_when_full) {
+      break;
+    }
+
+    log->waiters++;
+    tk_cond_wait(log->not_full, log->queue_mutex);
+    log->waiters--;
+  }
+
+  if (ret == RET_OK) {
+    memcpy(log->queue + offset, &len, RLOG_RECORD_HEADER_SIZE);
+    memcpy(log->queue + offset + RLOG_RECORD_HEADER_SIZE, str, len);
+
+    /*后台线程只在队列为空时等待。*/
+    if (used == 0) {
+      tk_cond_signal(log->not_empty);
+    }
+
+    /*tk_cond_signal只唤醒一个等待者，成功后唤醒下一个。*/
+    if (log->waiters > 0) {
+      tk_cond_signal(log->not_full);
+    }
+  } else {
+    log->dropped++;
+  }
+  tk_mutex_unlock(log->queue_mutex);
+
+  return ret;
+}
+
+static ret_t rlog_write_queued(rlog_t* log, uint32_t head, uint32_t used) {
   uint32_t len = 0;
-  fs_stat_info_t fst;
-  my_return_value_if_fail(log != NULL && log->fp != NULL && str != NULL, RET_BAD_PARAMS);
-  my_return_value_if_fail(fs_file_stat(log->fp, &fst) == RET_OK, RET_BAD_PARAMS);
 
-  if (tk_mutex_nest_lock(log->mutex) == RET_OK) {
-    len = strlen(str);
-    if ((fst.size + len) > log->max_size) {
-      char filename0[MAX_PATH + 1];
-      char filename1[MAX_PATH + 1];
-
-      fs_file_close(log->fp);
-      memset(filename1, 0x00, sizeof(filename1));
-      tk_snprintf(filename1, MAX_PATH, log->filename_pattern, (int)1);
-      if (log->index == 1) {
-        memset(filename0, 0x00, sizeof(filename0));
-        tk_snprintf(filename0, MAX_PATH, log->filename_pattern, (int)0);
-        fs_remove_file(os_fs(), filename0);
-        fs_file_rename(os_fs(), filename1, filename0);
+  while (used > 0) {
+    memcpy(&len, log->queue + head, RLOG_RECORD_HEADER_SIZE);
+    if (len == 0) {
+      used -= log->queue_size - head;
+      head = 0;
+      continue;
+    }
+
+    rlog_write_file(log, (const char*)(log->queue + head + RLOG_RECORD_HEADER_SIZE), len);
+    head = (head + RLOG_RECORD_SIZE(len)) % log->queue_size;
+    used -= RLOG_RECORD_SIZE(len);
+  }
+
+  if (log->fp != NULL) {
+    fs_file_sync(log->fp);
+  }
+
+  return RET_OK;
+}
+
+static void* rlog_write_thread(void* args) {
+  uint32_t i = 0;
+  uint32_t head = 0;
+  uint32_t used = 0;
+  rlog_t* log = (rlog_t*)args;
+
+  tk_mutex_lock(log->queue_mutex);
+  while (TRUE) {
+    while (log->queue_used == 0 && !log->quit) {
+      tk_cond_wait(log->not_empty, log->queue_mutex);
+    }
+
+    if (log->queue_used == 0) {
+      break;
+    }
+
+    /*写文件时不持有锁，其它线程可以继续往队列的空闲部分放日志。*/
+    head = log->queue_head;
+    used = log->queue_used;
+    tk_mutex_unlock(log->queue_mutex);
+
+    rlog_write_queued(log, head, used);
+
+    tk_mutex_lock(log->queue_mutex);
+    log->queue_head = (head + used) % log->queue_size;
+    log->queue_used -= used;
+    log->written += used;
+    if (log->waiters > 0) {
+      tk_cond_signal(log->not_full);
+    }
+
+    /*每写完一批唤醒全部等待flush的线程，由它们自己检查是否已经写完。*/
+    for (i = 0; i < log->flushers; i++) {
+      tk_cond_signal(log->flushed);
+    }
+  }
+  tk_mutex_unlock(log->queue_mutex);
+
+  return NULL;
+}
+
+rlog_t* rlog_create_async(const char* filename_pattern, uint32_t max_size, uint32_t buff_size,
+                          uint32_t queue_size, bool_t block_when_full) {
+  rlog_t* log = NULL;
+  my_return_value_if_fail(queue_size >= RLOG_RECORD_SIZE(buff_size), NULL);
+
+  log = rlog_create(filename_pattern, max_size, buff_size);
+  my_return_value_if_fail(log != NULL, NULL);
+
+  log->queue_size = TK_ROUND_TO4(queue_size);
+  log->block_when_full = block_when_full;
+  log->queue = (uint8_t*)TKMEM_ALLOC(log->queue_size);
+  log->queue_mutex = tk_mutex_create();
+  log->not_empty = tk_cond_create();
+  log->not_full = tk_cond_create();
+  log->flushed = tk_cond_create();
+
+  if (log->queue != NULL && log->queue_mutex != NULL && log->not_empty != NULL &&
+      log->not_full != NULL && log->flushed != NULL) {
+    log->thread = tk_thread_create(rlog_write_thread, log);
+    if (log->thread != NULL) {
+      tk_thread_set_name(log->thread, "rlog");
+      if (tk_thread_start(log->thread) == RET_OK) {
+        return log;
       }
-      log->index = 1;
-      log->fp = fs_open_file(os_fs(), filename1, "wb+");
+
+      tk_thread_destroy(log->thread);
+      log->thread = NULL;
     }
-    if (log->fp != NULL) {
-      fs_file_write(log->fp, str, len);
+  }
+  rlog_destroy(log);
+
+  return NULL;
+}
+
+ret_t rlog_write(rlog_t* log, const char* str) {
+  my_return_value_if_fail(log != NULL && str != NULL, RET_BAD_PARAMS);
+
+  if (log->thread != NULL) {
+    return rlog_queue_push(log, str, strlen(str));
+  }
+
+  my_return_value_if_fail(log->fp != NULL, RET_BAD_PARAMS);
+  if (tk_mutex_nest_lock(log->mutex) == RET_OK) {
+    if (rlog_write_file(log, str, strlen(str)) == RET_OK) {
       fs_file_sync(log->fp);
     }
     tk_mutex_nest_unlock(log->mutex);
@@ -119,7 +312,8 @@ ret_t rlog_write(rlog_t* log, const char* str) {
 ret_t rlog_print(rlog_t* log, const char* format, ...) {
   va_list va;
   ret_t ret = RET_OK;
-  my_return_value_if_fail(log != NULL && log->fp != NULL && format != NULL, RET_BAD_PARAMS);
+  my_return_value_if_fail(log != NULL && format != NULL, RET_BAD_PARAMS);
+  my_return_value_if_fail(log->thread != NULL || log->fp != NULL, RET_BAD_PARAMS);
   my_return_value_if_fail(log->buff_size > 0, RET_BAD_PARAMS);
 
   if (tk_mutex_nest_lock(log->mutex) == RET_OK) {
@@ -143,8 +337,53 @@ ret_t rlog_print(rlog_t* log, const char* format, ...) {
   return ret;
 }
 
+ret_t rlog_flush(rlog_t* log) {
+  uint32_t queued = 0;
+  my_return_value_if_fail(log != NULL, RET_BAD_PARAMS);
+
+  if (log->thread == NULL) {
+    return RET_OK;
+  }
+
+  my_return_value_if_fail(tk_mutex_lock(log->queue_mutex) == RET_OK, RET_FAIL);
+  queued = log->queued;
+  while ((int32_t)(log->written - queued) < 0) {
+    log->flushers++;
+    tk_cond_wait(log->flushed, log->queue_mutex);
+    log->flushers--;
+  }
+  tk_mutex_unlock(log->queue_mutex);
+
+  return RET_OK;
+}
+
 ret_t rlog_destroy(rlog_t* log) {
   my_return_value_if_fail(log != NULL, RET_BAD_PARAMS);
+
+  if (log->thread != NULL) {
+    tk_mutex_lock(log->queue_mutex);
+    log->quit = TRUE;
+    tk_cond_signal(log->not_empty);
+    tk_mutex_unlock(log->queue_mutex);
+
+    tk_thread_join(log->thread);
+    tk_thread_destroy(log->thread);
+  }
+
+  if (log->flushed != NULL) {
+    tk_cond_destroy(log->flushed);
+  }
+  if (log->not_full != NULL) {
+    tk_cond_destroy(log->not_full);
+  }
+  if (log->not_empty != NULL) {
+    tk_cond_destroy(log->not_empty);
+  }
+  if (log->queue_mutex != NULL) {
+    tk_mutex_destroy(log->queue_mutex);
+  }
+
+  TKMEM_FREE(log->queue);
   TKMEM_FREE(log->buff);
   fs_file_close(log->fp);
   TKMEM_FREE(log->filename_pattern);
@@ -23,6 +23,9 @@
 #define TK_RLOG_H
 
 #include "tkc/fs.h"
+#include "tkc/cond.h"
+#include "tkc/mutex.h"
+#include "tkc/thread.h"
 #include "tkc/mutex_nest.h"
 
 BEGIN_C_DECLS
@@ -36,6 +39,9 @@ BEGIN_C_DECLS
  *
  * > 为了实现简单，我们把日志文件分成0和1两个文件，先写文件0，到达指定最大值的一半时，再写文件1。
  * > 文件1到达指定最大值的一半时，删除文件0，并将文件1改名为文件0，重新创建文件1，继续写文件1，重复此过程。
+ *
+ * rlog\_create\_async创建的日志对象为异步模式：rlog\_write只把日志复制到队列中，
+ * 由后台线程批量写入文件和切换文件，调用者不会因为磁盘IO而阻塞。
  */
 typedef struct _rlog_t {
   /*private*/
@@ -44,9 +50,28 @@ typedef struct _rlog_t {
   char* filename_pattern;
 
   uint32_t index;
+  uint32_t size;
   uint32_t max_size;
   uint32_t buff_size;
   tk_mutex_nest_t* mutex;
+
+  /*异步模式*/
+  tk_thread_t* thread;
+  tk_mutex_t* queue_mutex;
+  tk_cond_t* not_empty;
+  tk_cond_t* not_full;
+  tk_cond_t* flushed;
+  uint8_t* queue;
+  uint32_t queue_size;
+  uint32_t queue_head;
+  uint32_t queue_used;
+  uint32_t queued;
+  uint32_t written;
+  uint32_t waiters;
+  uint32_t flushers;
+  uint32_t dropped;
+  bool_t block_when_full;
+  bool_t quit;
 } rlog_t;
 
 /**
@@ -68,6 +93,30 @@ typedef struct _rlog_t {
  */
 rlog_t* rlog_create(const char* filename_pattern, uint32_t max_size, uint32_t buff_size);
 
+/**
+ * @method rlog_create_async
+ * 创建异步模式的rlog对象。
+ *
+ * 日志先放入queue\_size字节的队列中，由后台线程写入文件。
+ * 队列满时，block\_when\_full为TRUE则等待队列有空间，否则丢弃该条日志并返回RET\_BUSY。
+ *
+ * ```c
+ * rlog_t* log = rlog_create_async("./logs/%d.log", 1020*1024, 256, 64*1024, FALSE);
+ * rlog_write(log, "hello\n");
+ * rlog_destroy(log);
+ * ```
+ *
+ * @param {const char*} filename_pattern 用来确定文件名的路径和文件名。
+ * @param {uint32_t} max_size log文件占用最大磁盘空间(字节)。
+ * @param {uint32_t} buff_size 用于指定print时的buff大小。
+ * @param {uint32_t} queue_size 队列的大小(字节)，单条日志不能超过队列的大小。
+ * @param {bool_t} block_when_full 队列满时是否等待。
+ *
+ * @return {rlog_t*} 返回rlog对象。
+ */
+rlog_t* rlog_create_async(const char* filename_pattern, uint32_t max_size, uint32_t buff_size,
+                          uint32_t queue_size, bool_t block_when_full);
+
 /**
  * @method rlog_write
  * 写入一条日志记录。
@@ -91,9 +140,19 @@ ret_t rlog_write(rlog_t* log, const char* str);
  */
 ret_t rlog_print(rlog_t* log, const char* format, ...);
 
+/**
+ * @method rlog_flush
+ * 等待已经写入的日志全部保存到文件中(异步模式)。
+ *
+ * @param {rlog_t*} log 日志对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t rlog_flush(rlog_t* log);
+
 /**
  * @method rlog_destroy
- * 销毁日志对象。
+ * 销毁日志对象(异步模式下先写完队列中的日志)。
  *
  * @param {rlog_t*} log 日志对象。
  *
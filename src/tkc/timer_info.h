@@ -130,6 +130,7 @@ struct _timer_info_t {
   /*private*/
   bool_t busy;
   uint16_t timer_info_type;
+  uint32_t heap_index;
   uint64_t last_dispatch_time;
   timer_manager_t* timer_manager;
 };
@@ -24,6 +24,214 @@
 
 static timer_manager_t* s_timer_manager;
 
+/*
+ * timers是按到期时间(start + duration)排序的最小堆，timer_info_t记录自己在堆中的位置。
+ * ids是按ID排序的数组，用于根据ID查找定时器。
+ */
+#define TIMER_MANAGER_INVALID_INDEX 0xffffffff
+
+/*一次分发中到期的定时器不超过这个数时，不需要分配内存。*/
+#ifndef TK_TIMER_DISPATCH_BATCH_NR
+#define TK_TIMER_DISPATCH_BATCH_NR 32
+#endif /*TK_TIMER_DISPATCH_BATCH_NR*/
+
+static inline uint64_t timer_info_expire_time(timer_info_t* timer) {
+  return timer->start + timer->duration;
+}
+
+static bool_t timer_manager_less(timer_info_t* a, timer_info_t* b) {
+  uint64_t ta = timer_info_expire_time(a);
+  uint64_t tb = timer_info_expire_time(b);
+
+  if (ta != tb) {
+    return ta < tb;
+  }
+
+  /*到期时间相同时，先添加的先触发。*/
+  return a->id < b->id;
+}
+
+static int timer_manager_compare_by_expire_time(const void* a, const void* b) {
+  timer_info_t* ta = *(timer_info_t**)a;
+  timer_info_t* tb = *(timer_info_t**)b;
+
+  if (timer_manager_less(ta, tb)) {
+    return -1;
+  } else if (timer_manager_less(tb, ta)) {
+    return 1;
+  }
+
+  return 0;
+}
+
+static void timer_manager_heap_set(timer_manager_t* timer_manager, uint32_t index,
+                                   timer_info_t* timer) {
+  timer_manager->timers.elms[index] = timer;
+  timer->heap_index = index;
+}
+
+static uint32_t timer_manager_sift_up(timer_manager_t* timer_manager, uint32_t index) {
+  void** elms = timer_manager->timers.elms;
+  timer_info_t* timer = TIMER_INFO(elms[index]);
+
+  while (index > 0) {
+    uint32_t parent = (index - 1) / 2;
+    if (!timer_manager_less(timer, TIMER_INFO(elms[parent]))) {
+      break;
+    }
+    timer_manager_heap_set(timer_manager, index, TIMER_INFO(elms[parent]));
+    index = parent;
+  }
+  timer_manager_heap_set(timer_manager, index, timer);
+
+  return index;
+}
+
+static uint32_t timer_manager_sift_down(timer_manager_t* timer_manager, uint32_t index) {
+  void** elms = timer_manager->timers.elms;
+  uint32_t size = timer_manager->timers.size;
+  timer_info_t* timer = TIMER_INFO(elms[index]);
+
+  while (TRUE) {
+    uint32_t child = index * 2 + 1;
+    if (child >= size) {
+      break;
+    }
+
+    if (child + 1 < size && timer_manager_less(TIMER_INFO(elms[child + 1]), TIMER_INFO(elms[child]))) {
+      child++;
+    }
+
+    if (!timer_manager_less(TIMER_INFO(elms[child]), timer)) {
+      break;
+    }
+    timer_manager_heap_set(timer_manager, index, TIMER_INFO(elms[child]));
+    index = child;
+  }
+  timer_manager_heap_set(timer_manager, index, timer);
+
+  return index;
+}
+
+/*定时器的到期时间改变后，调整它在堆中的位置。*/
+static ret_t timer_manager_heap_fix(timer_manager_t* timer_manager, timer_info_t* timer) {
+  uint32_t index = timer->heap_index;
+  return_value_if_fail(index < timer_manager->timers.size, RET_BAD_PARAMS);
+
+  index = timer_manager_sift_up(timer_manager, index);
+  timer_manager_sift_down(timer_manager, index);
+
+  return RET_OK;
+}
+
+static ret_t timer_manager_heap_build(timer_manager_t* timer_manager) {
+  uint32_t i = 0;
+  uint32_t size = timer_manager->timers.size;
+
+  for (i = 0; i < size; i++) {
+    timer_manager_heap_set(timer_manager, i, TIMER_INFO(timer_manager->timers.elms[i]));
+  }
+
+  for (i = size / 2; i > 0; i--) {
+    timer_manager_sift_down(timer_manager, i - 1);
+  }
+
+  return RET_OK;
+}
+
+/*返回第一个ID不小于id的位置。*/
+static uint32_t timer_manager_lower_bound(timer_manager_t* timer_manager, uint32_t id) {
+  uint32_t low = 0;
+  uint32_t high = timer_manager->ids.size;
+  void** elms = timer_manager->ids.elms;
+
+  while (low < high) {
+    uint32_t mid = low + (high - low) / 2;
+    if (TIMER_INFO(elms[mid])->id < id) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+static timer_info_t* timer_manager_find_by_id(timer_manager_t* timer_manager, uint32_t id) {
+  uint32_t index = timer_manager_lower_bound(timer_manager, id);
+
+  if (index < timer_manager->ids.size) {
+    timer_info_t* timer = TIMER_INFO(timer_manager->ids.elms[index]);
+    if (timer->id == id) {
+      return timer;
+    }
+  }
+
+  return NULL;
+}
+
+static ret_t timer_manager_remove_timer(timer_manager_t* timer_manager, timer_info_t* timer) {
+  timer_info_t* last = NULL;
+  uint32_t index = timer->heap_index;
+  return_value_if_fail(index < timer_manager->timers.size, RET_BAD_PARAMS);
+
+  darray_remove_index(&(timer_manager->ids), timer_manager_lower_bound(timer_manager, timer->id));
+
+  last = TIMER_INFO(darray_pop(&(timer_manager->timers)));
+  if (last != timer) {
+    timer_manager_heap_set(timer_manager, index, last);
+    timer_manager_heap_fix(timer_manager, last);
+  }
+
+  timer->heap_index = TIMER_MANAGER_INVALID_INDEX;
+  object_unref((object_t*)timer);
+
+  return RET_OK;
+}
+
+static ret_t timer_manager_remove_all(timer_manager_t* timer_manager, tk_compare_t compare,
+                                      void* ctx) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  darray_t removed;
+  darray_t* timers = &(timer_manager->timers);
+  darray_t* ids = &(timer_manager->ids);
+
+  darray_init(&removed, 0, (tk_destroy_t)object_unref, NULL);
+  for (i = 0; i < timers->size; i++) {
+    timer_info_t* iter = TIMER_INFO(timers->elms[i]);
+
+    if (compare(iter, ctx) == 0) {
+      iter->heap_index = TIMER_MANAGER_INVALID_INDEX;
+      darray_push(&removed, iter);
+    } else {
+      timers->elms[n++] = iter;
+    }
+  }
+
+  if (removed.size == 0) {
+    darray_deinit(&removed);
+    return RET_NOT_FOUND;
+  }
+  timers->size = n;
+
+  n = 0;
+  for (i = 0; i < ids->size; i++) {
+    timer_info_t* iter = TIMER_INFO(ids->elms[i]);
+    if (iter->heap_index != TIMER_MANAGER_INVALID_INDEX) {
+      ids->elms[n++] = iter;
+    }
+  }
+  ids->size = n;
+
+  timer_manager_heap_build(timer_manager);
+
+  /*数据结构调整完成后再释放，定时器销毁的回调函数中可以再次调用timer_manager的函数。*/
+  darray_deinit(&removed);
+
+  return RET_OK;
+}
+
 timer_manager_t* timer_manager(void) {
   return s_timer_manager;
 }
@@ -50,7 +258,8 @@ timer_manager_t* timer_manager_init(timer_manager_t* timer_manager, timer_get_ti
   timer_manager->next_timer_id = TK_INVALID_ID + 1;
   timer_manager->last_dispatch_time = get_time();
   timer_manager->get_time = get_time;
-  slist_init(&(timer_manager->timers), (tk_destroy_t)object_unref, timer_info_compare_by_id);
+  darray_init(&(timer_manager->timers), 0, (tk_destroy_t)object_unref, NULL);
+  darray_init(&(timer_manager->ids), 0, NULL, NULL);
 
   return timer_manager;
 }
@@ -58,7 +267,8 @@ timer_manager_t* timer_manager_init(timer_manager_t* timer_manager, timer_get_ti
 ret_t timer_manager_deinit(timer_manager_t* timer_manager) {
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
-  slist_deinit(&(timer_manager->timers));
+  darray_deinit(&(timer_manager->ids));
+  darray_deinit(&(timer_manager->timers));
 
   return RET_OK;
 }
@@ -73,9 +283,19 @@ ret_t timer_manager_destroy(timer_manager_t* timer_manager) {
 }
 
 ret_t timer_manager_append(timer_manager_t* timer_manager, timer_info_t* timer) {
+  uint32_t index = 0;
   return_value_if_fail(timer_manager != NULL && timer != NULL, RET_BAD_PARAMS);
 
-  return slist_append(&(timer_manager->timers), timer);
+  index = timer_manager_lower_bound(timer_manager, timer->id);
+  return_value_if_fail(darray_insert(&(timer_manager->ids), index, timer) == RET_OK, RET_OOM);
+
+  if (darray_push(&(timer_manager->timers), timer) != RET_OK) {
+    darray_remove_index(&(timer_manager->ids), index);
+    return RET_OOM;
+  }
+  timer_manager_sift_up(timer_manager, timer_manager->timers.size - 1);
+
+  return RET_OK;
 }
 
 uint32_t timer_manager_add(timer_manager_t* timer_manager, timer_func_t on_timer, void* ctx,
@@ -100,23 +320,27 @@ ret_t timer_manager_all_remove_by_ctx_and_type(timer_manager_t* timer_manager, u
   timer_info_t timer;
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
-  return slist_remove_with_compare(&(timer_manager->timers),
-                                   timer_info_init_dummy_with_ctx_and_type(&timer, type, ctx),
-                                   timer_info_compare_by_ctx_and_type, -1);
+  return timer_manager_remove_all(timer_manager, timer_info_compare_by_ctx_and_type,
+                                  timer_info_init_dummy_with_ctx_and_type(&timer, type, ctx));
 }
 
 ret_t timer_manager_all_remove_by_ctx(timer_manager_t* timer_manager, void* ctx) {
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
-  return slist_remove_with_compare(&(timer_manager->timers), ctx, timer_info_compare_by_ctx, -1);
+  return timer_manager_remove_all(timer_manager, timer_info_compare_by_ctx, ctx);
 }
 
 ret_t timer_manager_remove(timer_manager_t* timer_manager, uint32_t timer_id) {
-  timer_info_t timer;
+  timer_info_t* timer = NULL;
   return_value_if_fail(timer_id != TK_INVALID_ID, RET_BAD_PARAMS);
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
-  return slist_remove(&(timer_manager->timers), timer_info_init_dummy(&timer, timer_id));
+  timer = timer_manager_find_by_id(timer_manager, timer_id);
+  if (timer == NULL) {
+    return RET_NOT_FOUND;
+  }
+
+  return timer_manager_remove_timer(timer_manager, timer);
 }
 
 ret_t timer_manager_reset(timer_manager_t* timer_manager, uint32_t timer_id) {
@@ -124,61 +348,137 @@ ret_t timer_manager_reset(timer_manager_t* timer_manager, uint32_t timer_id) {
   return_value_if_fail(info != NULL, RET_NOT_FOUND);
   info->start = timer_manager->get_time();
 
-  return RET_OK;
+  return timer_manager_heap_fix(timer_manager, info);
+}
+
+ret_t timer_manager_modify(timer_manager_t* timer_manager, uint32_t timer_id, uint32_t duration) {
+  timer_info_t* info = (timer_info_t*)timer_manager_find(timer_manager, timer_id);
+  return_value_if_fail(info != NULL, RET_NOT_FOUND);
+
+  info->duration = duration;
+  info->start = timer_manager->get_time();
+
+  return timer_manager_heap_fix(timer_manager, info);
 }
 
 const timer_info_t* timer_manager_find(timer_manager_t* timer_manager, uint32_t timer_id) {
-  timer_info_t timer;
   return_value_if_fail(timer_id != TK_INVALID_ID, NULL);
   return_value_if_fail(timer_manager != NULL, NULL);
 
-  return slist_find(&(timer_manager->timers), timer_info_init_dummy(&timer, timer_id));
+  return timer_manager_find_by_id(timer_manager, timer_id);
+}
+
+/*
+ * 收集已经到期并且本轮还没有处理过的定时器。
+ * 子节点的到期时间不会早于父节点，父节点没有到期时不用再往下找。
+ */
+typedef struct _timer_manager_batch_t {
+  uint32_t nr;
+  uint32_t capacity;
+  timer_info_t** timers;
+  timer_info_t* buff[TK_TIMER_DISPATCH_BATCH_NR];
+} timer_manager_batch_t;
+
+static ret_t timer_manager_batch_push(timer_manager_batch_t* batch, timer_info_t* timer) {
+  if (batch->nr >= batch->capacity) {
+    uint32_t capacity = batch->capacity * 2;
+    timer_info_t** timers = TKMEM_ZALLOCN(timer_info_t*, capacity);
+    return_value_if_fail(timers != NULL, RET_OOM);
+
+    memcpy(timers, batch->timers, batch->nr * sizeof(timer_info_t*));
+    if (batch->timers != batch->buff) {
+      TKMEM_FREE(batch->timers);
+    }
+    batch->timers = timers;
+    batch->capacity = capacity;
+  }
+
+  batch->timers[batch->nr++] = (timer_info_t*)object_ref((object_t*)timer);
+
+  return RET_OK;
 }
 
-static ret_t timer_manager_dispatch_one(timer_manager_t* timer_manager, uint64_t now,
-                                        int32_t delta_time) {
-  slist_node_t* iter = timer_manager->timers.first;
+static ret_t timer_manager_collect(timer_manager_t* timer_manager, uint32_t index, uint64_t now,
+                                   timer_manager_batch_t* batch) {
+  timer_info_t* timer = NULL;
 
-  while (iter != NULL && !timer_info_is_available(TIMER_INFO(iter->data), now)) {
-    iter = iter->next;
+  if (index >= timer_manager->timers.size) {
+    return RET_OK;
   }
 
-  if (iter != NULL) {
-    timer_info_t* timer = (timer_info_t*)object_ref((object_t*)(iter->data));
-    return_value_if_fail(timer != NULL, RET_BAD_PARAMS);
+  /*子节点的到期时间不会比父节点早，父节点没到期就不用再往下找了。*/
+  timer = TIMER_INFO(timer_manager->timers.elms[index]);
+  if (timer_info_expire_time(timer) > now) {
+    return RET_OK;
+  }
 
-    timer->now = now;
-    if (!timer->suspend && (timer->start + timer->duration) <= now) {
-      if (timer_info_on_timer(timer, now) != RET_REPEAT) {
-        timer_manager_remove(timer_manager, timer->id);
-      } else {
-        timer->start = now;
+  if (timer_info_is_available(timer, now)) {
+    return_value_if_fail(timer_manager_batch_push(batch, timer) == RET_OK, RET_OOM);
+  }
+
+  timer_manager_collect(timer_manager, index * 2 + 1, now, batch);
+  timer_manager_collect(timer_manager, index * 2 + 2, now, batch);
+
+  return RET_OK;
+}
+
+static ret_t timer_manager_dispatch_some(timer_manager_t* timer_manager, uint64_t now) {
+  uint32_t i = 0;
+  timer_manager_batch_t batch;
+
+  batch.nr = 0;
+  batch.timers = batch.buff;
+  batch.capacity = ARRAY_SIZE(batch.buff);
+
+  timer_manager_collect(timer_manager, 0, now, &batch);
+  if (batch.nr == 0) {
+    return RET_DONE;
+  }
+
+  qsort(batch.timers, batch.nr, sizeof(timer_info_t*), timer_manager_compare_by_expire_time);
+  for (i = 0; i < batch.nr; i++) {
+    timer_info_t* timer = batch.timers[i];
+
+    /*前面的回调函数可能已经删除了该定时器，或者在子main loop中已经处理过了。*/
+    if (timer->heap_index != TIMER_MANAGER_INVALID_INDEX && timer_info_is_available(timer, now)) {
+      timer->now = now;
+      if (!timer->suspend && timer_info_expire_time(timer) <= now) {
+        if (timer_info_on_timer(timer, now) != RET_REPEAT) {
+          if (timer->heap_index != TIMER_MANAGER_INVALID_INDEX) {
+            timer_manager_remove_timer(timer_manager, timer);
+          }
+        } else {
+          timer->start = now;
+          if (timer->heap_index != TIMER_MANAGER_INVALID_INDEX) {
+            timer_manager_heap_fix(timer_manager, timer);
+          }
+        }
       }
     }
 
     object_unref((object_t*)timer);
+  }
 
-    return RET_OK;
+  if (batch.timers != batch.buff) {
+    TKMEM_FREE(batch.timers);
   }
 
-  return RET_DONE;
+  return RET_OK;
 }
 
 ret_t timer_manager_dispatch(timer_manager_t* timer_manager) {
   uint64_t now = 0;
-  int32_t delta_time = 0;
   return_value_if_fail(timer_manager != NULL, RET_BAD_PARAMS);
 
   now = timer_manager->get_time();
-  delta_time = now - timer_manager->last_dispatch_time;
+  timer_manager->last_dispatch_time = now;
 
-  if (timer_manager->timers.first == NULL) {
-    timer_manager->last_dispatch_time = now;
+  if (timer_manager->timers.size == 0) {
     return RET_OK;
   }
 
-  timer_manager->last_dispatch_time = now;
-  while (timer_manager_dispatch_one(timer_manager, now, delta_time) == RET_OK) {
+  /*回调函数中新增的定时器如果已经到期，也在本轮触发。*/
+  while (timer_manager_dispatch_some(timer_manager, now) == RET_OK) {
     if (timer_manager->last_dispatch_time != now) {
       log_debug("abort dispatch because sub main loop\n");
     }
@@ -190,22 +490,36 @@ ret_t timer_manager_dispatch(timer_manager_t* timer_manager) {
 uint32_t timer_manager_count(timer_manager_t* timer_manager) {
   return_value_if_fail(timer_manager != NULL, 0);
 
-  return slist_size(&(timer_manager->timers));
+  return timer_manager->timers.size;
 }
 
-uint64_t timer_manager_next_time(timer_manager_t* timer_manager) {
-  slist_node_t* iter = NULL;
-  uint64_t t = timer_manager->get_time() + 0xffff;
-  return_value_if_fail(timer_manager != NULL, t);
-
-  iter = timer_manager->timers.first;
-  while (iter != NULL) {
-    timer_info_t* timer = TIMER_INFO(iter->data);
-    if ((timer->start + timer->duration) < t) {
-      t = timer->start + timer->duration;
-    }
-    iter = iter->next;
+static uint64_t timer_manager_next_time_from(timer_manager_t* timer_manager, uint32_t index,
+                                             uint64_t t) {
+  timer_info_t* timer = NULL;
+
+  if (index >= timer_manager->timers.size) {
+    return t;
+  }
+
+  /*子节点的到期时间不会比父节点早，比当前结果晚的子树不用再找了。*/
+  timer = TIMER_INFO(timer_manager->timers.elms[index]);
+  if (timer_info_expire_time(timer) >= t) {
+    return t;
   }
 
+  /*挂起的和回调正在执行的定时器不会被触发，到期时间以它们的子节点为准。*/
+  if (!timer->suspend && !timer->busy) {
+    return timer_info_expire_time(timer);
+  }
+
+  t = timer_manager_next_time_from(timer_manager, index * 2 + 1, t);
+  t = timer_manager_next_time_from(timer_manager, index * 2 + 2, t);
+
   return t;
 }
+
+uint64_t timer_manager_next_time(timer_manager_t* timer_manager) {
+  return_value_if_fail(timer_manager != NULL, 0);
+
+  return timer_manager_next_time_from(timer_manager, 0, timer_manager->get_time() + 0xffff);
+}
@@ -22,7 +22,7 @@
 #ifndef TK_TIMER_MANAGER_H
 #define TK_TIMER_MANAGER_H
 
-#include "tkc/slist.h"
+#include "tkc/darray.h"
 #include "tkc/timer_info.h"
 
 BEGIN_C_DECLS
@@ -38,7 +38,11 @@ struct _timer_manager_t {
   uint64_t last_dispatch_time;
   timer_get_time_t get_time;
 
-  slist_t timers;
+  /*private*/
+  /*按到期时间排序的最小堆*/
+  darray_t timers;
+  /*按ID排序，用于查找*/
+  darray_t ids;
 };
 
 /**
@@ -140,6 +144,17 @@ ret_t timer_manager_all_remove_by_ctx(timer_manager_t* timer_manager, void* ctx)
  */
 ret_t timer_manager_reset(timer_manager_t* timer_manager, uint32_t timer_id);
 
+/**
+ * @method timer_manager_modify
+ * 修改定时器的时间间隔，修改之后定时器重新开始计时。
+ * @param {timer_manager_t*} timer_manager 定时器管理器对象。
+ * @param {uint32_t} timer_id timer_id。
+ * @param {uint32_t} duration 新的时间间隔。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t timer_manager_modify(timer_manager_t* timer_manager, uint32_t timer_id, uint32_t duration);
+
 /**
  * @method timer_manager_find
  * 查找指定ID的定时器。
@@ -170,7 +185,7 @@ uint32_t timer_manager_count(timer_manager_t* timer_manager);
 
 /**
  * @method timer_manager_next_time
- * 返回最近的定时器到期时间。
+ * 返回最近的定时器到期时间(挂起的和回调正在执行的定时器不计算在内)。
  * @param {timer_manager_t*} timer_manager 定时器管理器对象。
  *
  * @return {uint64_t} 返回最近的timer到期时间。
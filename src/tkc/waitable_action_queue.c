@@ -97,6 +97,43 @@ ret_t waitable_action_queue_send(waitable_action_queue_t* q, qaction_t* action,
   return ret;
 }
 
+ret_t waitable_action_queue_send_batch(waitable_action_queue_t* q, qaction_t** actions,
+                                       uint32_t nr, uint32_t timeout_ms) {
+  uint32_t i = 0;
+  uint32_t reserved = 0;
+  return_value_if_fail(q != NULL && actions != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(nr <= q->queue->capacity, RET_BAD_PARAMS);
+
+  /*先预留全部空位，预留不到时归还已预留的空位，保证要么全部发送，要么全部不发送。*/
+  for (reserved = 0; reserved < nr; reserved++) {
+    if (tk_semaphore_wait(q->sema_send, timeout_ms) != RET_OK) {
+      break;
+    }
+  }
+
+  if (reserved < nr) {
+    for (i = 0; i < reserved; i++) {
+      ENSURE(tk_semaphore_post(q->sema_send) == RET_OK);
+    }
+    return RET_TIMEOUT;
+  }
+
+  if (tk_mutex_lock(q->mutex) != RET_OK) {
+    for (i = 0; i < nr; i++) {
+      ENSURE(tk_semaphore_post(q->sema_send) == RET_OK);
+    }
+    return RET_FAIL;
+  }
+
+  for (i = 0; i < nr; i++) {
+    ENSURE(action_queue_send(q->queue, actions[i]) == RET_OK);
+    ENSURE(tk_semaphore_post(q->sema_recv) == RET_OK);
+  }
+  ENSURE(tk_mutex_unlock(q->mutex) == RET_OK);
+
+  return RET_OK;
+}
+
 ret_t waitable_action_queue_destroy(waitable_action_queue_t* q) {
   return_value_if_fail(q != NULL, RET_BAD_PARAMS);
 
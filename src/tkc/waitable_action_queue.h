@@ -77,6 +77,20 @@ ret_t waitable_action_queue_recv(waitable_action_queue_t* q, qaction_t** action,
 ret_t waitable_action_queue_send(waitable_action_queue_t* q, qaction_t* action,
                                  uint32_t timeout_ms);
 
+/**
+ * @method waitable_action_queue_send_batch
+ * 批量发送请求，要么全部发送，要么全部不发送(失败时action仍由调用者负责)。
+ *
+ * @param {waitable_action_queue_t*} q waitable_action_queue对象。
+ * @param {qaction_t**} actions action对象数组。
+ * @param {uint32_t} nr action的个数(不能超过队列的容量)。
+ * @param {uint32_t} timeout_ms 等待每个空位的超时时间(ms)
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t waitable_action_queue_send_batch(waitable_action_queue_t* q, qaction_t** actions,
+                                       uint32_t nr, uint32_t timeout_ms);
+
 /**
  * @method waitable_action_queue_destroy
  * 销毁。
@@ -206,14 +206,7 @@ ret_t wstr_insert(wstr_t* str, uint32_t offset, const wchar_t* text, uint32_t nr
 
   p = str->str;
   if (str->size > offset) {
-    uint32_t i = 0;
-    uint32_t s = str->size - 1;
-    uint32_t d = str->size + nr - 1;
-    uint32_t move_nr = str->size - offset;
-
-    for (i = 0; i < move_nr; i++, d--, s--) {
-      p[d] = p[s];
-    }
+    memmove(p + offset + nr, p + offset, (str->size - offset) * sizeof(wchar_t));
   }
   memcpy(p + offset, text, nr * sizeof(wchar_t));
   str->size += nr;
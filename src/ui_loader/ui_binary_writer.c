@@ -23,7 +23,13 @@
 #include "base/enums.h"
 #include "tkc/utf8.h"
 #include "tkc/value.h"
+#include "tkc/utils.h"
+#include "base/style.h"
 #include "base/ui_builder.h"
+#include "base/self_layouter.h"
+#include "base/children_layouter.h"
+#include "layouters/self_layouter_default.h"
+#include "layouters/children_layouter_default.h"
 #include "ui_loader/ui_loader_default.h"
 #include "ui_loader/ui_binary_writer.h"
 
@@ -39,10 +45,216 @@ static ret_t ui_binary_writer_on_widget_prop(ui_builder_t* b, const char* name,
   return wbuffer_write_string(writer->wbuffer, value);
 }
 
+static ret_t ui_binary_writer_write_prop_head(wbuffer_t* wbuffer, uint8_t type, widget_prop_id_t id,
+                                              const char* name) {
+  /*写入固定的编号，而不是widget_prop_id_t的值(它会随着增加属性而变化)。*/
+  uint8_t wire_id = ui_builder_prop_id_to_wire_id(id);
+
+  wbuffer_write_uint8(wbuffer, type);
+  wbuffer_write_uint8(wbuffer, wire_id);
+  if (wire_id == UI_PROP_WIRE_ID_NONE) {
+    return wbuffer_write_string(wbuffer, name);
+  }
+
+  return RET_OK;
+}
+
+static bool_t ui_binary_writer_is_int(const char* value) {
+  const char* p = value;
+
+  if (*p == '-') {
+    p++;
+  }
+
+  if (*p == '\0') {
+    return FALSE;
+  }
+
+  while (*p) {
+    if (!isdigit(*p)) {
+      return FALSE;
+    }
+    p++;
+  }
+
+  return TRUE;
+}
+
+static ret_t ui_binary_writer_write_self_layout(wbuffer_t* wbuffer, widget_prop_id_t id,
+                                                const char* name, const char* value) {
+  self_layouter_default_t* l = NULL;
+  self_layouter_t* layouter = value[0] ? self_layouter_create(value) : NULL;
+
+  if (!self_layouter_default_is_valid(layouter)) {
+    self_layouter_destroy(layouter);
+    return RET_NOT_IMPL;
+  }
+
+  l = (self_layouter_default_t*)layouter;
+  ui_binary_writer_write_prop_head(wbuffer, UI_PROP_TYPE_SELF_LAYOUT, id, name);
+  wbuffer_write_string(wbuffer, value);
+  wbuffer_write_uint8(wbuffer, l->x_attr);
+  wbuffer_write_uint8(wbuffer, l->y_attr);
+  wbuffer_write_uint8(wbuffer, l->w_attr);
+  wbuffer_write_uint8(wbuffer, l->h_attr);
+  wbuffer_write_double(wbuffer, l->x);
+  wbuffer_write_double(wbuffer, l->y);
+  wbuffer_write_double(wbuffer, l->w);
+  wbuffer_write_double(wbuffer, l->h);
+  self_layouter_destroy(layouter);
+
+  return RET_OK;
+}
+
+static ret_t ui_binary_writer_write_children_layout(wbuffer_t* wbuffer, widget_prop_id_t id,
+                                                    const char* name, const char* value) {
+  uint8_t flags = 0;
+  children_layouter_default_t* l = NULL;
+  children_layouter_t* layouter = value[0] ? children_layouter_create(value) : NULL;
+
+  if (layouter == NULL || !tk_str_eq(layouter->vt->type, CHILDREN_LAYOUTER_DEFAULT)) {
+    children_layouter_destroy(layouter);
+    return RET_NOT_IMPL;
+  }
+
+  l = (children_layouter_default_t*)layouter;
+  flags = (l->cols_is_width ? 0x01 : 0) | (l->rows_is_height ? 0x02 : 0) |
+          (l->keep_invisible ? 0x04 : 0) | (l->keep_disable ? 0x08 : 0);
+
+  ui_binary_writer_write_prop_head(wbuffer, UI_PROP_TYPE_CHILDREN_LAYOUT, id, name);
+  wbuffer_write_string(wbuffer, value);
+  wbuffer_write_uint16(wbuffer, l->rows);
+  wbuffer_write_uint16(wbuffer, l->cols);
+  wbuffer_write_uint8(wbuffer, l->x_margin);
+  wbuffer_write_uint8(wbuffer, l->y_margin);
+  wbuffer_write_uint8(wbuffer, l->spacing);
+  wbuffer_write_uint8(wbuffer, flags);
+  wbuffer_write_uint8(wbuffer, (uint8_t)(l->align_h));
+  children_layouter_destroy(layouter);
+
+  return RET_OK;
+}
+
+/*与widget_set_style一样，用style_normalize_value转换style的值。*/
+static ret_t ui_binary_writer_write_style(wbuffer_t* wbuffer, const char* name, const char* value) {
+  value_t v;
+  const char* style_name = strrchr(name, ':') + 1;
+
+  style_normalize_value(style_name, value, &v);
+  if (v.type == VALUE_TYPE_STRING) {
+    value_reset(&v);
+    return RET_NOT_IMPL;
+  }
+
+  if (v.type == VALUE_TYPE_UINT32 && strstr(style_name, "color") != NULL) {
+    ui_binary_writer_write_prop_head(wbuffer, UI_PROP_TYPE_COLOR, WIDGET_PROP_ID_NONE, name);
+    return wbuffer_write_uint32(wbuffer, value_uint32(&v));
+  }
+
+  ui_binary_writer_write_prop_head(wbuffer, UI_PROP_TYPE_INT, WIDGET_PROP_ID_NONE, name);
+  return wbuffer_write_int32(wbuffer, value_int(&v));
+}
+
+/*只转换含义与控件类型无关的属性，其它属性仍然保存为字符串。*/
+static ret_t ui_binary_writer_on_widget_prop_v2(ui_builder_t* b, const char* name,
+                                                const char* value) {
+  ret_t ret = RET_NOT_IMPL;
+  ui_binary_writer_t* writer = (ui_binary_writer_t*)b;
+  wbuffer_t* wbuffer = writer->wbuffer;
+  widget_prop_id_t id = widget_prop_id_from_name(name);
+
+  switch (id) {
+    case WIDGET_PROP_ID_X:
+    case WIDGET_PROP_ID_Y:
+    case WIDGET_PROP_ID_W:
+    case WIDGET_PROP_ID_H:
+    case WIDGET_PROP_ID_OPACITY:
+    case WIDGET_PROP_ID_DIRTY_RECT_TOLERANCE: {
+      if (ui_binary_writer_is_int(value)) {
+        ui_binary_writer_write_prop_head(wbuffer, UI_PROP_TYPE_INT, id, name);
+        ret = wbuffer_write_int32(wbuffer, tk_atoi(value));
+      }
+      break;
+    }
+    case WIDGET_PROP_ID_VISIBLE:
+    case WIDGET_PROP_ID_SENSITIVE:
+    case WIDGET_PROP_ID_FLOATING:
+    case WIDGET_PROP_ID_FOCUS:
+    case WIDGET_PROP_ID_FOCUSED:
+    case WIDGET_PROP_ID_FOCUSABLE:
+    case WIDGET_PROP_ID_WITH_FOCUS_STATE:
+    case WIDGET_PROP_ID_ENABLE:
+    case WIDGET_PROP_ID_FEEDBACK:
+    case WIDGET_PROP_ID_AUTO_ADJUST_SIZE: {
+      if (tk_str_eq(value, "true") || tk_str_eq(value, "false")) {
+        ui_binary_writer_write_prop_head(wbuffer, UI_PROP_TYPE_BOOL, id, name);
+        ret = wbuffer_write_uint8(wbuffer, tk_str_eq(value, "true"));
+      }
+      break;
+    }
+    case WIDGET_PROP_ID_SELF_LAYOUT: {
+      ret = ui_binary_writer_write_self_layout(wbuffer, id, name, value);
+      break;
+    }
+    case WIDGET_PROP_ID_LAYOUT:
+    case WIDGET_PROP_ID_CHILDREN_LAYOUT: {
+      ret = ui_binary_writer_write_children_layout(wbuffer, id, name, value);
+      break;
+    }
+    case WIDGET_PROP_ID_NONE: {
+      if (tk_str_start_with(name, "style:")) {
+        ret = ui_binary_writer_write_style(wbuffer, name, value);
+      }
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+
+  if (ret == RET_NOT_IMPL) {
+    ui_binary_writer_write_prop_head(wbuffer, UI_PROP_TYPE_STR, id, name);
+    ret = wbuffer_write_string(wbuffer, value);
+  }
+
+  return ret;
+}
+
+static ret_t ui_binary_writer_on_widget_prop_value(ui_builder_t* b, widget_prop_id_t id,
+                                                   const char* name, const value_t* value) {
+  char str[64];
+  ui_binary_writer_t* writer = (ui_binary_writer_t*)b;
+  wbuffer_t* wbuffer = writer->wbuffer;
+
+  switch (value->type) {
+    case VALUE_TYPE_BOOL: {
+      ui_binary_writer_write_prop_head(wbuffer, UI_PROP_TYPE_BOOL, id, name);
+      return wbuffer_write_uint8(wbuffer, value_bool(value));
+    }
+    case VALUE_TYPE_INT8:
+    case VALUE_TYPE_INT16:
+    case VALUE_TYPE_INT32:
+    case VALUE_TYPE_UINT8:
+    case VALUE_TYPE_UINT16: {
+      ui_binary_writer_write_prop_head(wbuffer, UI_PROP_TYPE_INT, id, name);
+      return wbuffer_write_int32(wbuffer, value_int32(value));
+    }
+    case VALUE_TYPE_FLOAT:
+    case VALUE_TYPE_FLOAT32:
+    case VALUE_TYPE_DOUBLE: {
+      ui_binary_writer_write_prop_head(wbuffer, UI_PROP_TYPE_FLOAT, id, name);
+      return wbuffer_write_double(wbuffer, value_double(value));
+    }
+    default: {
+      return ui_binary_writer_on_widget_prop_v2(b, name, value_str_ex(value, str, sizeof(str)));
+    }
+  }
+}
+
 static ret_t ui_binary_writer_on_widget_prop_end(ui_builder_t* b) {
   ui_binary_writer_t* writer = (ui_binary_writer_t*)b;
 
-  return wbuffer_write_uint8(writer->wbuffer, 0);
+  return wbuffer_write_uint8(writer->wbuffer, writer->version > 1 ? UI_PROP_TYPE_END : 0);
 }
 
 static ret_t ui_binary_writer_on_widget_end(ui_builder_t* b) {
@@ -51,18 +263,31 @@ static ret_t ui_binary_writer_on_widget_end(ui_builder_t* b) {
   return wbuffer_write_uint8(writer->wbuffer, 0);
 }
 
-ui_builder_t* ui_binary_writer_init(ui_binary_writer_t* writer, wbuffer_t* wbuffer) {
+ui_builder_t* ui_binary_writer_init_ex(ui_binary_writer_t* writer, wbuffer_t* wbuffer,
+                                       uint32_t version) {
   return_value_if_fail(writer != NULL && wbuffer != NULL, NULL);
+  return_value_if_fail(version == 1 || version == 2, NULL);
 
   memset(writer, 0x00, sizeof(ui_binary_writer_t));
 
   writer->wbuffer = wbuffer;
+  writer->version = version;
   writer->builder.on_widget_start = ui_binary_writer_on_widget_start;
-  writer->builder.on_widget_prop = ui_binary_writer_on_widget_prop;
   writer->builder.on_widget_prop_end = ui_binary_writer_on_widget_prop_end;
   writer->builder.on_widget_end = ui_binary_writer_on_widget_end;
 
-  wbuffer_write_uint32(wbuffer, UI_DATA_MAGIC);
+  if (version > 1) {
+    writer->builder.on_widget_prop = ui_binary_writer_on_widget_prop_v2;
+    writer->builder.on_widget_prop_value = ui_binary_writer_on_widget_prop_value;
+    wbuffer_write_uint32(wbuffer, UI_DATA_MAGIC_V2);
+  } else {
+    writer->builder.on_widget_prop = ui_binary_writer_on_widget_prop;
+    wbuffer_write_uint32(wbuffer, UI_DATA_MAGIC);
+  }
 
   return &(writer->builder);
 }
+
+ui_builder_t* ui_binary_writer_init(ui_binary_writer_t* writer, wbuffer_t* wbuffer) {
+  return ui_binary_writer_init_ex(writer, wbuffer, 1);
+}
@@ -33,17 +33,26 @@ BEGIN_C_DECLS
  *
  * 生成二进制格式的UI描述数据。
  *
+ * 用ui\_binary\_writer\_init\_ex可以生成v2格式(UI\_DATA\_MAGIC\_V2)：
+ *
+ * * 常用属性名用widget\_prop\_id\_t表示。
+ * * 常用的整数和布尔属性、style的颜色/整数/枚举值预先转换好类型。
+ * * 缺省布局器的self\_layout/children\_layout参数预先解析好。
+ *
+ * 加载时不用再比较属性名和解析字符串。
+ *
  */
 typedef struct _ui_binary_writer_t {
   ui_builder_t builder;
   wbuffer_t* wbuffer;
+  uint32_t version;
 } ui_binary_writer_t;
 
 /**
  * @method ui_binary_writer_init
  * @annotation ["constructor"]
  *
- * 初始化ui\_binary\_writer对象。
+ * 初始化ui\_binary\_writer对象(生成v1格式，全部属性都保存为字符串)。
  *
  * @param {ui_binary_writer_t*} writer writer对象。
  * @param {wbuffer_t*} wbuffer 保存结果的buffer。
@@ -52,6 +61,21 @@ typedef struct _ui_binary_writer_t {
  */
 ui_builder_t* ui_binary_writer_init(ui_binary_writer_t* writer, wbuffer_t* wbuffer);
 
+/**
+ * @method ui_binary_writer_init_ex
+ * @annotation ["constructor"]
+ *
+ * 初始化ui\_binary\_writer对象，并指定数据格式的版本。
+ *
+ * @param {ui_binary_writer_t*} writer writer对象。
+ * @param {wbuffer_t*} wbuffer 保存结果的buffer。
+ * @param {uint32_t} version 版本(1或2)。旧版本的加载器只能加载v1格式。
+ *
+ * @return {ui_builder_t*} 返回ui\_builder对象。
+ */
+ui_builder_t* ui_binary_writer_init_ex(ui_binary_writer_t* writer, wbuffer_t* wbuffer,
+                                       uint32_t version);
+
 END_C_DECLS
 
 #endif /*TK_UI_BINARY_WRITER_H*/
@@ -62,6 +62,28 @@ static ret_t ui_builder_default_on_widget_prop(ui_builder_t* b, const char* name
   return RET_OK;
 }
 
+/*属性名和值已经转换好，不用再比较属性名和解析字符串。*/
+static ret_t ui_builder_default_on_widget_prop_value(ui_builder_t* b, widget_prop_id_t id,
+                                                     const char* name, const value_t* value) {
+  if (value->type == VALUE_TYPE_POINTER) {
+    if (id == WIDGET_PROP_ID_SELF_LAYOUT) {
+      return widget_set_self_layouter(b->widget, (self_layouter_t*)value_pointer(value));
+    } else if (id == WIDGET_PROP_ID_LAYOUT || id == WIDGET_PROP_ID_CHILDREN_LAYOUT) {
+      return widget_set_children_layouter(b->widget, (children_layouter_t*)value_pointer(value));
+    }
+
+    return RET_NOT_IMPL;
+  }
+
+  if (id != WIDGET_PROP_ID_NONE) {
+    widget_set_prop_by_id(b->widget, id, value);
+  } else {
+    widget_set_prop(b->widget, name, value);
+  }
+
+  return RET_OK;
+}
+
 static ret_t ui_builder_default_on_widget_prop_end(ui_builder_t* b) {
   return RET_OK;
 }
@@ -107,6 +129,7 @@ ui_builder_t* ui_builder_default_create(const char* name) {
 
   builder->on_widget_start = ui_builder_default_on_widget_start;
   builder->on_widget_prop = ui_builder_default_on_widget_prop;
+  builder->on_widget_prop_value = ui_builder_default_on_widget_prop_value;
   builder->on_widget_prop_end = ui_builder_default_on_widget_prop_end;
   builder->on_widget_end = ui_builder_default_on_widget_end;
   builder->on_end = ui_builder_default_on_end;
@@ -21,8 +21,184 @@
 
 #include "tkc/mem.h"
 #include "tkc/buffer.h"
+#include "base/widget_prop_id.h"
+#include "layouters/self_layouter_default.h"
+#include "layouters/children_layouter_default.h"
 #include "ui_loader/ui_loader_default.h"
 
+static ret_t ui_loader_load_props_v1(rbuffer_t* rbuffer, ui_builder_t* b) {
+  const char* key = NULL;
+  const char* value = NULL;
+
+  return_value_if_fail(rbuffer_read_string(rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
+  while (*key) {
+    return_value_if_fail(rbuffer_read_string(rbuffer, &value) == RET_OK, RET_BAD_PARAMS);
+    ui_builder_on_widget_prop(b, key, value);
+    return_value_if_fail(rbuffer_read_string(rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
+  }
+
+  return RET_OK;
+}
+
+static self_layouter_t* ui_loader_read_self_layouter(rbuffer_t* rbuffer, const char* params) {
+  self_layouter_default_t* l = NULL;
+  self_layouter_t* layouter = self_layouter_default_create();
+  return_value_if_fail(layouter != NULL, NULL);
+
+  l = (self_layouter_default_t*)layouter;
+  str_set(&(layouter->params), params);
+  rbuffer_read_uint8(rbuffer, &(l->x_attr));
+  rbuffer_read_uint8(rbuffer, &(l->y_attr));
+  rbuffer_read_uint8(rbuffer, &(l->w_attr));
+  rbuffer_read_uint8(rbuffer, &(l->h_attr));
+  rbuffer_read_double(rbuffer, &(l->x));
+  rbuffer_read_double(rbuffer, &(l->y));
+  rbuffer_read_double(rbuffer, &(l->w));
+  goto_error_if_fail(rbuffer_read_double(rbuffer, &(l->h)) == RET_OK);
+
+  return layouter;
+error:
+  self_layouter_destroy(layouter);
+  return NULL;
+}
+
+static children_layouter_t* ui_loader_read_children_layouter(rbuffer_t* rbuffer,
+                                                             const char* params) {
+  uint8_t flags = 0;
+  uint8_t align_h = 0;
+  children_layouter_default_t* l = NULL;
+  children_layouter_t* layouter = children_layouter_default_create();
+  return_value_if_fail(layouter != NULL, NULL);
+
+  l = (children_layouter_default_t*)layouter;
+  str_set(&(layouter->params), params);
+  rbuffer_read_uint16(rbuffer, &(l->rows));
+  rbuffer_read_uint16(rbuffer, &(l->cols));
+  rbuffer_read_uint8(rbuffer, &(l->x_margin));
+  rbuffer_read_uint8(rbuffer, &(l->y_margin));
+  rbuffer_read_uint8(rbuffer, &(l->spacing));
+  rbuffer_read_uint8(rbuffer, &flags);
+  goto_error_if_fail(rbuffer_read_uint8(rbuffer, &align_h) == RET_OK);
+
+  l->cols_is_width = (flags & 0x01) != 0;
+  l->rows_is_height = (flags & 0x02) != 0;
+  l->keep_invisible = (flags & 0x04) != 0;
+  l->keep_disable = (flags & 0x08) != 0;
+  l->align_h = (align_h_t)align_h;
+
+  return layouter;
+error:
+  children_layouter_destroy(layouter);
+  return NULL;
+}
+
+/*布局参数已经解析好，builder支持时直接把布局器交给它，否则仍然使用字符串。*/
+static ret_t ui_loader_load_layout_v2(rbuffer_t* rbuffer, ui_builder_t* b, uint8_t type,
+                                      widget_prop_id_t id, const char* name) {
+  value_t v;
+  ret_t ret = RET_OK;
+  void* layouter = NULL;
+  const char* params = NULL;
+  return_value_if_fail(rbuffer_read_string(rbuffer, &params) == RET_OK, RET_BAD_PARAMS);
+
+  if (type == UI_PROP_TYPE_SELF_LAYOUT) {
+    layouter = ui_loader_read_self_layouter(rbuffer, params);
+  } else {
+    layouter = ui_loader_read_children_layouter(rbuffer, params);
+  }
+  return_value_if_fail(layouter != NULL, RET_BAD_PARAMS);
+
+  if (b->on_widget_prop_value != NULL) {
+    ret = ui_builder_on_widget_prop_value(b, id, name, value_set_pointer(&v, layouter));
+    if (ret == RET_OK) {
+      return RET_OK;
+    }
+  } else {
+    ui_builder_on_widget_prop(b, name, params);
+  }
+
+  if (type == UI_PROP_TYPE_SELF_LAYOUT) {
+    self_layouter_destroy((self_layouter_t*)layouter);
+  } else {
+    children_layouter_destroy((children_layouter_t*)layouter);
+  }
+
+  return RET_OK;
+}
+
+static ret_t ui_loader_load_props_v2(rbuffer_t* rbuffer, ui_builder_t* b) {
+  value_t v;
+  uint8_t type = 0;
+  uint8_t wire_id = 0;
+  const char* name = NULL;
+  widget_prop_id_t id = WIDGET_PROP_ID_NONE;
+
+  return_value_if_fail(rbuffer_read_uint8(rbuffer, &type) == RET_OK, RET_BAD_PARAMS);
+  while (type != UI_PROP_TYPE_END) {
+    return_value_if_fail(rbuffer_read_uint8(rbuffer, &wire_id) == RET_OK, RET_BAD_PARAMS);
+    if (wire_id == UI_PROP_WIRE_ID_NONE) {
+      id = WIDGET_PROP_ID_NONE;
+      return_value_if_fail(rbuffer_read_string(rbuffer, &name) == RET_OK, RET_BAD_PARAMS);
+    } else {
+      id = ui_builder_prop_id_from_wire_id(wire_id);
+      name = widget_prop_id_to_name(id);
+      return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+    }
+
+    switch (type) {
+      case UI_PROP_TYPE_STR: {
+        const char* str = NULL;
+        return_value_if_fail(rbuffer_read_string(rbuffer, &str) == RET_OK, RET_BAD_PARAMS);
+        value_set_str(&v, str);
+        break;
+      }
+      case UI_PROP_TYPE_INT: {
+        int32_t i = 0;
+        return_value_if_fail(rbuffer_read_int32(rbuffer, &i) == RET_OK, RET_BAD_PARAMS);
+        value_set_int32(&v, i);
+        break;
+      }
+      case UI_PROP_TYPE_FLOAT: {
+        double d = 0;
+        return_value_if_fail(rbuffer_read_double(rbuffer, &d) == RET_OK, RET_BAD_PARAMS);
+        value_set_double(&v, d);
+        break;
+      }
+      case UI_PROP_TYPE_BOOL: {
+        uint8_t b8 = 0;
+        return_value_if_fail(rbuffer_read_uint8(rbuffer, &b8) == RET_OK, RET_BAD_PARAMS);
+        value_set_bool(&v, b8 != 0);
+        break;
+      }
+      case UI_PROP_TYPE_COLOR: {
+        uint32_t c = 0;
+        return_value_if_fail(rbuffer_read_uint32(rbuffer, &c) == RET_OK, RET_BAD_PARAMS);
+        value_set_uint32(&v, c);
+        break;
+      }
+      case UI_PROP_TYPE_SELF_LAYOUT:
+      case UI_PROP_TYPE_CHILDREN_LAYOUT: {
+        return_value_if_fail(
+            ui_loader_load_layout_v2(rbuffer, b, type, id, name) == RET_OK,
+            RET_BAD_PARAMS);
+        break;
+      }
+      default: {
+        log_debug("%s: invalid prop type %d\n", __FUNCTION__, (int)type);
+        return RET_BAD_PARAMS;
+      }
+    }
+
+    if (type != UI_PROP_TYPE_SELF_LAYOUT && type != UI_PROP_TYPE_CHILDREN_LAYOUT) {
+      ui_builder_on_widget_prop_value(b, id, name, &v);
+    }
+
+    return_value_if_fail(rbuffer_read_uint8(rbuffer, &type) == RET_OK, RET_BAD_PARAMS);
+  }
+
+  return RET_OK;
+}
+
 ret_t ui_loader_load_default(ui_loader_t* loader, const uint8_t* data, uint32_t size,
                              ui_builder_t* b) {
   rbuffer_t rbuffer;
@@ -33,21 +209,18 @@ ret_t ui_loader_load_default(ui_loader_t* loader, const uint8_t* data, uint32_t
   return_value_if_fail(loader != NULL && data != NULL && b != NULL, RET_BAD_PARAMS);
   return_value_if_fail(rbuffer_init(&rbuffer, data, size) != NULL, RET_BAD_PARAMS);
   return_value_if_fail(rbuffer_read_uint32(&rbuffer, &magic) == RET_OK, RET_BAD_PARAMS);
-  return_value_if_fail(magic == UI_DATA_MAGIC, RET_BAD_PARAMS);
+  return_value_if_fail(magic == UI_DATA_MAGIC || magic == UI_DATA_MAGIC_V2, RET_BAD_PARAMS);
 
   ui_builder_on_start(b);
   while ((rbuffer.cursor + sizeof(desc)) <= rbuffer.capacity) {
-    const char* key = NULL;
-    const char* value = NULL;
     return_value_if_fail(rbuffer_read_binary(&rbuffer, &desc, sizeof(desc)) == RET_OK,
                          RET_BAD_PARAMS);
     ui_builder_on_widget_start(b, &desc);
 
-    return_value_if_fail(rbuffer_read_string(&rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
-    while (*key) {
-      return_value_if_fail(rbuffer_read_string(&rbuffer, &value) == RET_OK, RET_BAD_PARAMS);
-      ui_builder_on_widget_prop(b, key, value);
-      return_value_if_fail(rbuffer_read_string(&rbuffer, &key) == RET_OK, RET_BAD_PARAMS);
+    if (magic == UI_DATA_MAGIC_V2) {
+      return_value_if_fail(ui_loader_load_props_v2(&rbuffer, b) == RET_OK, RET_BAD_PARAMS);
+    } else {
+      return_value_if_fail(ui_loader_load_props_v1(&rbuffer, b) == RET_OK, RET_BAD_PARAMS);
     }
     ui_builder_on_widget_prop_end(b);
 
@@ -30,7 +30,12 @@ static ret_t widget_animator_prop_update(widget_animator_t* animator, float_t pe
   return_value_if_fail(prop != NULL, RET_BAD_PARAMS);
 
   new_prop = prop->from + (prop->to - prop->from) * percent;
-  widget_set_prop(animator->widget, prop->prop_name, value_set_double(&v, new_prop));
+  value_set_double(&v, new_prop);
+  if (prop->prop_id != WIDGET_PROP_ID_NONE) {
+    widget_set_prop_by_id(animator->widget, prop->prop_id, &v);
+  } else {
+    widget_set_prop(animator->widget, prop->prop_name, &v);
+  }
 
   return RET_OK;
 }
@@ -50,6 +55,7 @@ widget_animator_t* widget_animator_prop_create(widget_t* widget, uint32_t durati
   prop = (widget_animator_prop_t*)animator;
   animator->update = widget_animator_prop_update;
   tk_strncpy(prop->prop_name, prop_name, TK_NAME_LEN);
+  prop->prop_id = widget_prop_id_from_name(prop->prop_name);
 
   return animator;
 }
@@ -36,6 +36,8 @@ typedef struct _widget_animator_prop_t {
   double to;
   double from;
   char prop_name[TK_NAME_LEN + 1];
+  /*常用属性用ID访问，避免每帧比较属性名。*/
+  widget_prop_id_t prop_id;
 } widget_animator_prop_t;
 
 /**
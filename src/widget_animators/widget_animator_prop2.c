@@ -30,12 +30,20 @@ static ret_t widget_animator_prop2_update(widget_animator_t* animator, float_t p
 
   if (prop2->to1 != prop2->from1) {
     value_set_double(&v, prop2->from1 + (prop2->to1 - prop2->from1) * percent);
-    widget_set_prop(animator->widget, prop2->prop1_name, &v);
+    if (prop2->prop1_id != WIDGET_PROP_ID_NONE) {
+      widget_set_prop_by_id(animator->widget, prop2->prop1_id, &v);
+    } else {
+      widget_set_prop(animator->widget, prop2->prop1_name, &v);
+    }
   }
 
   if (prop2->to2 != prop2->from2) {
     value_set_double(&v, prop2->from2 + (prop2->to2 - prop2->from2) * percent);
-    widget_set_prop(animator->widget, prop2->prop2_name, &v);
+    if (prop2->prop2_id != WIDGET_PROP_ID_NONE) {
+      widget_set_prop_by_id(animator->widget, prop2->prop2_id, &v);
+    } else {
+      widget_set_prop(animator->widget, prop2->prop2_name, &v);
+    }
   }
 
   return RET_OK;
@@ -59,6 +67,8 @@ widget_animator_t* widget_animator_prop2_create(widget_t* widget, uint32_t durat
   animator->update = widget_animator_prop2_update;
   tk_strncpy(prop2->prop1_name, prop1_name, TK_NAME_LEN);
   tk_strncpy(prop2->prop2_name, prop2_name, TK_NAME_LEN);
+  prop2->prop1_id = widget_prop_id_from_name(prop2->prop1_name);
+  prop2->prop2_id = widget_prop_id_from_name(prop2->prop2_name);
 
   return animator;
 }
@@ -39,6 +39,9 @@ typedef struct _widget_animator_prop2_t {
   double from2;
   char prop1_name[TK_NAME_LEN + 1];
   char prop2_name[TK_NAME_LEN + 1];
+  /*常用属性用ID访问，避免每帧比较属性名。*/
+  widget_prop_id_t prop1_id;
+  widget_prop_id_t prop2_id;
 } widget_animator_prop2_t;
 
 /**
@@ -39,8 +39,16 @@ static ret_t image_on_paint_self(widget_t* widget, canvas_t* c) {
   }
 
   do {
-    if (image_base->image != NULL &&
-        widget_load_image(widget, image_base->image, &bitmap) == RET_OK) {
+    ret_t ret = RET_OK;
+
+    if (image->async_load) {
+      /*正在解码时只绘制背景，解码完成后控件会被重绘。*/
+      ret = widget_load_image_async(widget, image_base->image, &bitmap);
+    } else {
+      ret = widget_load_image(widget, image_base->image, &bitmap);
+    }
+
+    if (ret == RET_OK) {
       if (vg != NULL) {
         if (image_need_transform(widget)) {
           if (image->draw_type == IMAGE_DRAW_ICON || image->draw_type == IMAGE_DRAW_CENTER) {
@@ -78,6 +86,9 @@ static ret_t image_get_prop(widget_t* widget, const char* name, value_t* v) {
   if (tk_str_eq(name, WIDGET_PROP_DRAW_TYPE)) {
     value_set_int(v, image->draw_type);
     return RET_OK;
+  } else if (tk_str_eq(name, WIDGET_PROP_ASYNC_LOAD)) {
+    value_set_bool(v, image->async_load);
+    return RET_OK;
   } else {
     return image_base_get_prop(widget, name, v);
   }
@@ -97,6 +108,8 @@ static ret_t image_set_prop(widget_t* widget, const char* name, const value_t* v
     }
 
     return RET_OK;
+  } else if (tk_str_eq(name, WIDGET_PROP_ASYNC_LOAD)) {
+    return image_set_async_load(widget, value_bool(v));
   } else {
     return image_base_set_prop(widget, name, v);
   }
@@ -106,7 +119,8 @@ static const char* const s_image_properties[] = {WIDGET_PROP_IMAGE,      WIDGET_
                                                  WIDGET_PROP_SCALE_X,    WIDGET_PROP_SCALE_Y,
                                                  WIDGET_PROP_ANCHOR_X,   WIDGET_PROP_ANCHOR_Y,
                                                  WIDGET_PROP_ROTATION,   WIDGET_PROP_CLICKABLE,
-                                                 WIDGET_PROP_SELECTABLE, NULL};
+                                                 WIDGET_PROP_SELECTABLE, WIDGET_PROP_ASYNC_LOAD,
+                                                 NULL};
 
 static ret_t image_on_copy(widget_t* widget, widget_t* other) {
   image_t* image = IMAGE(widget);
@@ -115,6 +129,7 @@ static ret_t image_on_copy(widget_t* widget, widget_t* other) {
 
   image_base_on_copy(widget, other);
   image->draw_type = image_other->draw_type;
+  image->async_load = image_other->async_load;
 
   return RET_OK;
 }
@@ -154,6 +169,15 @@ ret_t image_set_draw_type(widget_t* widget, image_draw_type_t draw_type) {
   return widget_invalidate(widget, NULL);
 }
 
+ret_t image_set_async_load(widget_t* widget, bool_t async_load) {
+  image_t* image = IMAGE(widget);
+  return_value_if_fail(image != NULL, RET_BAD_PARAMS);
+
+  image->async_load = async_load;
+
+  return RET_OK;
+}
+
 widget_t* image_cast(widget_t* widget) {
   return_value_if_fail(WIDGET_IS_INSTANCE_OF(widget, image), NULL);
 
@@ -170,53 +170,84 @@ static ret_t progress_bar_on_destroy(widget_t* widget) {
   return RET_OK;
 }
 
-static ret_t progress_bar_get_prop(widget_t* widget, const char* name, value_t* v) {
+static ret_t progress_bar_get_prop_by_id(widget_t* widget, widget_prop_id_t id, value_t* v) {
   progress_bar_t* progress_bar = PROGRESS_BAR(widget);
-  return_value_if_fail(progress_bar != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
-
-  if (tk_str_eq(name, WIDGET_PROP_VALUE)) {
-    value_set_float(v, progress_bar->value);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_MAX)) {
-    value_set_float(v, progress_bar->max);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_FORMAT)) {
-    value_set_str(v, progress_bar->format);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_VERTICAL)) {
-    value_set_bool(v, progress_bar->vertical);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_SHOW_TEXT)) {
-    value_set_bool(v, progress_bar->show_text);
-    return RET_OK;
-  } else if (tk_str_eq(name, WIDGET_PROP_REVERSE)) {
-    value_set_bool(v, progress_bar->reverse);
-    return RET_OK;
+  return_value_if_fail(progress_bar != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (id) {
+    case WIDGET_PROP_ID_VALUE: {
+      value_set_float(v, progress_bar->value);
+      return RET_OK;
+    }
+    case WIDGET_PROP_ID_MAX: {
+      value_set_float(v, progress_bar->max);
+      return RET_OK;
+    }
+    case WIDGET_PROP_ID_FORMAT: {
+      value_set_str(v, progress_bar->format);
+      return RET_OK;
+    }
+    case WIDGET_PROP_ID_VERTICAL: {
+      value_set_bool(v, progress_bar->vertical);
+      return RET_OK;
+    }
+    case WIDGET_PROP_ID_SHOW_TEXT: {
+      value_set_bool(v, progress_bar->show_text);
+      return RET_OK;
+    }
+    case WIDGET_PROP_ID_REVERSE: {
+      value_set_bool(v, progress_bar->reverse);
+      return RET_OK;
+    }
+    default:
+      break;
   }
 
   return RET_NOT_FOUND;
 }
 
-static ret_t progress_bar_set_prop(widget_t* widget, const char* name, const value_t* v) {
+static ret_t progress_bar_get_prop(widget_t* widget, const char* name, value_t* v) {
   return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
-  if (tk_str_eq(name, WIDGET_PROP_VALUE)) {
-    return progress_bar_set_value(widget, value_float(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_MAX)) {
-    return progress_bar_set_max(widget, value_float(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_FORMAT)) {
-    return progress_bar_set_format(widget, value_str(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_VERTICAL)) {
-    return progress_bar_set_vertical(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_SHOW_TEXT)) {
-    return progress_bar_set_show_text(widget, value_bool(v));
-  } else if (tk_str_eq(name, WIDGET_PROP_REVERSE)) {
-    return progress_bar_set_reverse(widget, value_bool(v));
+  return progress_bar_get_prop_by_id(widget, widget_prop_id_from_name(name), v);
+}
+
+static ret_t progress_bar_set_prop_by_id(widget_t* widget, widget_prop_id_t id,
+                                         const value_t* v) {
+  return_value_if_fail(widget != NULL && v != NULL, RET_BAD_PARAMS);
+
+  switch (id) {
+    case WIDGET_PROP_ID_VALUE: {
+      return progress_bar_set_value(widget, value_float(v));
+    }
+    case WIDGET_PROP_ID_MAX: {
+      return progress_bar_set_max(widget, value_float(v));
+    }
+    case WIDGET_PROP_ID_FORMAT: {
+      return progress_bar_set_format(widget, value_str(v));
+    }
+    case WIDGET_PROP_ID_VERTICAL: {
+      return progress_bar_set_vertical(widget, value_bool(v));
+    }
+    case WIDGET_PROP_ID_SHOW_TEXT: {
+      return progress_bar_set_show_text(widget, value_bool(v));
+    }
+    case WIDGET_PROP_ID_REVERSE: {
+      return progress_bar_set_reverse(widget, value_bool(v));
+    }
+    default:
+      break;
   }
 
   return RET_NOT_FOUND;
 }
 
+static ret_t progress_bar_set_prop(widget_t* widget, const char* name, const value_t* v) {
+  return_value_if_fail(widget != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
+
+  return progress_bar_set_prop_by_id(widget, widget_prop_id_from_name(name), v);
+}
+
 static const char* s_progress_bar_clone_properties[] = {WIDGET_PROP_VALUE,     WIDGET_PROP_MAX,
                                                         WIDGET_PROP_FORMAT,    WIDGET_PROP_VERTICAL,
                                                         WIDGET_PROP_SHOW_TEXT, NULL};
@@ -229,7 +260,9 @@ TK_DECL_VTABLE(progress_bar) = {.size = sizeof(progress_bar_t),
                                 .on_paint_background = widget_on_paint_null,
                                 .on_destroy = progress_bar_on_destroy,
                                 .get_prop = progress_bar_get_prop,
-                                .set_prop = progress_bar_set_prop};
+                                .set_prop = progress_bar_set_prop,
+                                .get_prop_by_id = progress_bar_get_prop_by_id,
+                                .set_prop_by_id = progress_bar_set_prop_by_id};
 
 widget_t* progress_bar_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
   widget_t* widget = widget_create(parent, TK_REF_VTABLE(progress_bar), x, y, w, h);
@@ -630,15 +630,40 @@ static ret_t window_manager_update_cursor(widget_t* widget, int32_t x, int32_t y
   return RET_OK;
 }
 
-static ret_t window_manager_paint_normal(widget_t* widget, canvas_t* c) {
 #ifdef FRAGMENT_FRAME_BUFFER_SIZE
+static ret_t window_manager_paint_fragment(void* ctx, const void* data) {
+  widget_t* widget = WIDGET(ctx);
+  canvas_t* c = (canvas_t*)data;
+
+  ENSURE(widget_paint(widget, c) == RET_OK);
+  window_manager_paint_cursor(widget, c);
+
+  return RET_OK;
+}
+#endif /*FRAGMENT_FRAME_BUFFER_SIZE*/
+
+static ret_t window_manager_paint_dirty_rects(widget_t* widget, canvas_t* c) {
   uint32_t i = 0;
-  uint32_t y = 0;
-  uint32_t h = 0;
-  uint32_t tmp_h = 0;
-  uint32_t number = 0;
-#endif
+  window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(widget);
+  const dirty_rects_t* dirty_rects = &(wm->native_window->paint_rects);
+
+  if (!dirty_rects_should_paint_separately(dirty_rects)) {
+    ENSURE(widget_paint(widget, c) == RET_OK);
+    window_manager_paint_cursor(widget, c);
+
+    return RET_OK;
+  }
 
+  for (i = 0; i < dirty_rects->nr; i++) {
+    canvas_set_clip_rect(c, dirty_rects_get(dirty_rects, i));
+    ENSURE(widget_paint(widget, c) == RET_OK);
+    window_manager_paint_cursor(widget, c);
+  }
+
+  return RET_OK;
+}
+
+static ret_t window_manager_paint_normal(widget_t* widget, canvas_t* c) {
   uint64_t start_time = time_now_ms();
   window_manager_default_t* wm = WINDOW_MANAGER_DEFAULT(widget);
 
@@ -649,47 +674,18 @@ static ret_t window_manager_paint_normal(widget_t* widget, canvas_t* c) {
     window_manager_default_invalidate(widget, &fps_rect);
   }
 #ifdef FRAGMENT_FRAME_BUFFER_SIZE
-  if (wm->native_window->dirty_rect.w > 0 && wm->native_window->dirty_rect.h > 0) {
-    rect_t r = native_window_calc_dirty_rect(wm->native_window);
-    if (r.w > 0 && r.h > 0) {
-      assert(r.w <= FRAGMENT_FRAME_BUFFER_SIZE);
-      y = r.y;
-      h = r.h;
-      tmp_h = FRAGMENT_FRAME_BUFFER_SIZE / r.w;
-      number = r.h / tmp_h;
-
-      for (i = 0; i <= number; i++) {
-        r.y = y + i * tmp_h;
-        if (i == number) {
-          tmp_h = h % tmp_h;
-        }
-        r.h = tmp_h;
-        if (r.h == 0) {
-          break;
-        }
-
-        canvas_t* c = native_window_get_canvas(wm->native_window);
-        canvas_begin_frame(c, &r, LCD_DRAW_NORMAL);
-        wm->native_window->dirty = TRUE;
-        ENSURE(widget_paint(WIDGET(wm), c) == RET_OK);
-        window_manager_paint_cursor(widget, c);
-        canvas_end_frame(c);
-      }
-
-      native_window_update_last_dirty_rect(wm->native_window);
-    }
-    native_window_clear_dirty_rect(wm->native_window);
-  }
+  native_window_paint_fragments(wm->native_window, FRAGMENT_FRAME_BUFFER_SIZE,
+                                window_manager_paint_fragment, widget);
 #else
   if (native_window_begin_frame(wm->native_window, LCD_DRAW_NORMAL) == RET_OK) {
     if (widget->children == NULL || widget->children->size == 0) {
       color_t bg = color_init(0xff, 0xff, 0xff, 0xff);
       canvas_set_fill_color(c, bg);
       canvas_fill_rect(c, 0, 0, widget->w, widget->h);
+      window_manager_paint_cursor(widget, c);
     } else {
-      ENSURE(widget_paint(WIDGET(wm), c) == RET_OK);
+      window_manager_paint_dirty_rects(widget, c);
     }
-    window_manager_paint_cursor(widget, c);
     native_window_end_frame(wm->native_window);
   }
 #endif
@@ -206,14 +206,36 @@ static widget_t* window_manager_simple_find_target(widget_t* widget, xy_t x, xy_
   return window_manager_find_target(widget, NULL, x, y);
 }
 
+#ifdef FRAGMENT_FRAME_BUFFER_SIZE
+static ret_t window_manager_paint_fragment(void* ctx, const void* data) {
+  return widget_paint(WIDGET(ctx), (canvas_t*)data);
+}
+#endif /*FRAGMENT_FRAME_BUFFER_SIZE*/
+
 static ret_t window_manager_paint_normal(widget_t* widget, canvas_t* c) {
   uint64_t start_time = time_now_ms();
   window_manager_simple_t* wm = WINDOW_MANAGER_SIMPLE(widget);
 
+#ifdef FRAGMENT_FRAME_BUFFER_SIZE
+  native_window_paint_fragments(wm->native_window, FRAGMENT_FRAME_BUFFER_SIZE,
+                                window_manager_paint_fragment, widget);
+#else
   if (native_window_begin_frame(wm->native_window, LCD_DRAW_NORMAL) == RET_OK) {
-    ENSURE(widget_paint(WIDGET(wm), c) == RET_OK);
+    const dirty_rects_t* dirty_rects = &(wm->native_window->paint_rects);
+
+    if (dirty_rects_should_paint_separately(dirty_rects)) {
+      uint32_t i = 0;
+
+      for (i = 0; i < dirty_rects->nr; i++) {
+        canvas_set_clip_rect(c, dirty_rects_get(dirty_rects, i));
+        ENSURE(widget_paint(WIDGET(wm), c) == RET_OK);
+      }
+    } else {
+      ENSURE(widget_paint(WIDGET(wm), c) == RET_OK);
+    }
     native_window_end_frame(wm->native_window);
   }
+#endif /*FRAGMENT_FRAME_BUFFER_SIZE*/
   wm->last_paint_cost = time_now_ms() - start_time;
 
   return RET_OK;
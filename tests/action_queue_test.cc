@@ -1,5 +1,6 @@
 ﻿#include "gtest/gtest.h"
 #include "tkc/action_queue.h"
+#include "tkc/waitable_action_queue.h"
 
 #define NR 10
 
@@ -54,3 +55,33 @@ TEST(ActionQueue, multi) {
 
   action_queue_destroy(q);
 }
+
+TEST(ActionQueue, waitable_send_batch) {
+  uint32_t i = 0;
+  qaction_t* r = NULL;
+  qaction_t* actions[NR];
+  waitable_action_queue_t* q = waitable_action_queue_create(NR);
+
+  for (i = 0; i < NR; i++) {
+    actions[i] = qaction_create(qaction_dummy_exec, NULL, 0);
+    actions[i]->args[0] = i;
+  }
+
+  ASSERT_EQ(waitable_action_queue_send_batch(q, actions, NR + 1, 0), RET_BAD_PARAMS);
+  ASSERT_EQ(waitable_action_queue_send(q, actions[0], 0), RET_OK);
+
+  /*放不下时一个也不放。*/
+  ASSERT_EQ(waitable_action_queue_send_batch(q, actions, NR, 0), RET_TIMEOUT);
+  ASSERT_EQ(waitable_action_queue_recv(q, &r, 0), RET_OK);
+  ASSERT_EQ(r, actions[0]);
+  ASSERT_EQ(waitable_action_queue_recv(q, &r, 0), RET_FAIL);
+
+  ASSERT_EQ(waitable_action_queue_send_batch(q, actions, NR, 0), RET_OK);
+  for (i = 0; i < NR; i++) {
+    ASSERT_EQ(waitable_action_queue_recv(q, &r, 0), RET_OK);
+    ASSERT_EQ(r->args[0], i);
+    qaction_destroy(r);
+  }
+
+  waitable_action_queue_destroy(q);
+}
@@ -1,17 +1,21 @@
 #include "tkc/utils.h"
 #include "tkc/thread.h"
 #include "tkc/platform.h"
+#include "tkc/time_now.h"
 #include "tkc/action_thread_pool.h"
 
 #include <atomic>
 
-#define NR 10000 * 100
+#define NR 20000
+#define BATCH_NR 64
+/*共享队列的容量为THREAD_NR * 5，批量提交的个数不能超过它。*/
+#define SHARED_BATCH_NR 16
+#define THREAD_NR 4
 
 static std::atomic<int> exec_times;
 
 static ret_t qaction_dummy_on_event(qaction_t* action, event_t* e) {
   if (e->type == EVT_DONE) {
-    log_debug("done\n");
     qaction_destroy(action);
   }
 
@@ -19,25 +23,87 @@ static ret_t qaction_dummy_on_event(qaction_t* action, event_t* e) {
 }
 
 static ret_t qaction_dummy_exec(qaction_t* action) {
+  uint32_t i = 0;
+  uint32_t sum = 0;
+
+  /*模拟一点计算量*/
+  for (i = 0; i < 100; i++) {
+    sum += i * action->args[0];
+  }
+  action->args[0] = sum;
   exec_times++;
-  log_debug("exec: exec_times=%d\n", exec_times.load());
+
   return RET_OK;
 }
 
-void test() {
+static qaction_t* qaction_dummy_create(void) {
+  uint32_t arg = 1;
+  qaction_t* a = qaction_create(qaction_dummy_exec, &arg, sizeof(arg));
+  qaction_set_on_event(a, qaction_dummy_on_event);
+
+  return a;
+}
+
+static void wait_done(int nr) {
+  while (exec_times.load() < nr) {
+    sleep_ms(1);
+  }
+}
+
+static void bench(const char* name, action_thread_pool_t* pool, uint32_t batch_nr) {
   uint32_t i = 0;
-  action_thread_pool_t* pool = action_thread_pool_create(10, 2);
+  int submitted = 0;
+  uint64_t start = time_now_ms();
+  uint64_t cost = 0;
+
+  exec_times = 0;
+  if (batch_nr > 0) {
+    qaction_t* actions[BATCH_NR];
+
+    for (i = 0; i < NR; i += batch_nr) {
+      uint32_t k = 0;
+      uint32_t n = tk_min(batch_nr, NR - i);
 
-  for (i = 0; i < NR; i++) {
-    qaction_t* a = qaction_create(qaction_dummy_exec, NULL, 0);
-    qaction_set_on_event(a, qaction_dummy_on_event);
-    action_thread_pool_exec(pool, a);
+      for (k = 0; k < n; k++) {
+        actions[k] = qaction_dummy_create();
+      }
+      if (action_thread_pool_exec_batch(pool, actions, n) == RET_OK) {
+        submitted += n;
+      } else {
+        for (k = 0; k < n; k++) {
+          qaction_destroy(actions[k]);
+        }
+        log_debug("exec batch failed\n");
+      }
+    }
+  } else {
+    for (i = 0; i < NR; i++) {
+      qaction_t* a = qaction_dummy_create();
+
+      if (action_thread_pool_exec(pool, a) == RET_OK) {
+        submitted++;
+      } else {
+        qaction_destroy(a);
+        log_debug("exec failed\n");
+      }
+    }
   }
 
-  sleep_ms(2000);
+  wait_done(submitted);
+  cost = time_now_ms() - start;
 
   action_thread_pool_destroy(pool);
-  log_debug("exec_times=%d\n", exec_times.load());
+  log_debug("%-24s: %d actions in %u ms (%u actions/s)\n", name, exec_times.load(), (uint32_t)cost,
+            (uint32_t)(NR * 1000.0 / tk_max(cost, 1)));
+}
+
+void test() {
+  bench("shared queue", action_thread_pool_create(THREAD_NR, THREAD_NR), 0);
+  bench("shared queue(batch)", action_thread_pool_create(THREAD_NR, THREAD_NR), SHARED_BATCH_NR);
+  bench("work stealing", action_thread_pool_create_work_stealing(THREAD_NR, 0), 0);
+  bench("work stealing(batch)", action_thread_pool_create_work_stealing(THREAD_NR, 0), BATCH_NR);
+  bench("work stealing(limited)", action_thread_pool_create_work_stealing(THREAD_NR, 1000),
+        BATCH_NR);
 }
 
 #include "tkc/platform.h"
@@ -0,0 +1,162 @@
+#include "tkc/platform.h"
+#include "tkc/action_thread_pool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+static std::atomic<int> s_exec_times;
+static std::atomic<int> s_destroy_times;
+static action_thread_pool_t* s_pool = NULL;
+
+static ret_t qaction_test_on_event(qaction_t* action, event_t* e) {
+  if (e->type == EVT_DONE) {
+    s_destroy_times++;
+    qaction_destroy(action);
+  }
+
+  return RET_OK;
+}
+
+static ret_t qaction_test_exec(qaction_t* action) {
+  uint32_t sleep_time = action->args[0];
+
+  if (sleep_time > 0) {
+    sleep_ms(sleep_time);
+  }
+  s_exec_times++;
+
+  return RET_OK;
+}
+
+static qaction_t* qaction_test_create(uint32_t sleep_time) {
+  qaction_t* a = qaction_create(qaction_test_exec, &sleep_time, sizeof(sleep_time));
+  qaction_set_on_event(a, qaction_test_on_event);
+
+  return a;
+}
+
+static ret_t qaction_test_spawn_exec(qaction_t* action) {
+  uint32_t i = 0;
+  qaction_t* actions[4];
+
+  for (i = 0; i < ARRAY_SIZE(actions); i++) {
+    actions[i] = qaction_test_create(0);
+  }
+  s_exec_times++;
+
+  return action_thread_pool_exec_batch(s_pool, actions, ARRAY_SIZE(actions));
+}
+
+static void wait_exec_times(int nr) {
+  uint32_t i = 0;
+
+  for (i = 0; i < 1000 && s_exec_times.load() < nr; i++) {
+    sleep_ms(5);
+  }
+}
+
+TEST(ActionThreadPoolWorkStealing, basic) {
+  uint32_t i = 0;
+  action_thread_pool_t* pool = action_thread_pool_create_work_stealing(4, 0);
+
+  s_exec_times = 0;
+  s_destroy_times = 0;
+  ASSERT_EQ(pool != NULL, true);
+  ASSERT_EQ(pool->work_stealing, TRUE);
+  ASSERT_EQ(pool->max_thread_nr, 4u);
+
+  for (i = 0; i < 1000; i++) {
+    ASSERT_EQ(action_thread_pool_exec(pool, qaction_test_create(0)), RET_OK);
+  }
+
+  wait_exec_times(1000);
+  ASSERT_EQ(s_exec_times.load(), 1000);
+
+  action_thread_pool_destroy(pool);
+  ASSERT_EQ(s_destroy_times.load(), 1000);
+}
+
+TEST(ActionThreadPoolWorkStealing, batch) {
+  uint32_t i = 0;
+  qaction_t* actions[100];
+  action_thread_pool_t* pool = action_thread_pool_create_work_stealing(3, 0);
+
+  s_exec_times = 0;
+  s_destroy_times = 0;
+  for (i = 0; i < ARRAY_SIZE(actions); i++) {
+    actions[i] = qaction_test_create(i % 10 == 0 ? 1 : 0);
+  }
+  ASSERT_EQ(action_thread_pool_exec_batch(pool, actions, ARRAY_SIZE(actions)), RET_OK);
+  ASSERT_EQ(action_thread_pool_exec_batch(pool, actions, 0), RET_OK);
+  ASSERT_EQ(action_thread_pool_exec_batch(pool, NULL, 1), RET_BAD_PARAMS);
+
+  wait_exec_times(ARRAY_SIZE(actions));
+  ASSERT_EQ(s_exec_times.load(), 100);
+
+  action_thread_pool_destroy(pool);
+  ASSERT_EQ(s_destroy_times.load(), 100);
+}
+
+TEST(ActionThreadPoolWorkStealing, spawn) {
+  uint32_t i = 0;
+  s_pool = action_thread_pool_create_work_stealing(2, 0);
+
+  s_exec_times = 0;
+  s_destroy_times = 0;
+  for (i = 0; i < 10; i++) {
+    qaction_t* a = qaction_create(qaction_test_spawn_exec, NULL, 0);
+    qaction_set_on_event(a, qaction_test_on_event);
+    ASSERT_EQ(action_thread_pool_exec(s_pool, a), RET_OK);
+  }
+
+  wait_exec_times(50);
+  ASSERT_EQ(s_exec_times.load(), 50);
+
+  action_thread_pool_destroy(s_pool);
+  ASSERT_EQ(s_destroy_times.load(), 50);
+  s_pool = NULL;
+}
+
+TEST(ActionThreadPoolWorkStealing, max_pending) {
+  uint32_t i = 0;
+  qaction_t* actions[8];
+  action_thread_pool_t* pool = action_thread_pool_create_work_stealing(2, 4);
+
+  s_exec_times = 0;
+  s_destroy_times = 0;
+  ASSERT_EQ(pool->max_pending_nr, 4u);
+
+  for (i = 0; i < 20; i++) {
+    ASSERT_EQ(action_thread_pool_exec(pool, qaction_test_create(2)), RET_OK);
+  }
+
+  /*一次提交的个数超过上限，永远也放不下。*/
+  for (i = 0; i < ARRAY_SIZE(actions); i++) {
+    actions[i] = qaction_test_create(0);
+  }
+  ASSERT_EQ(action_thread_pool_exec_batch(pool, actions, ARRAY_SIZE(actions)), RET_BAD_PARAMS);
+  for (i = 0; i < ARRAY_SIZE(actions); i++) {
+    qaction_destroy(actions[i]);
+  }
+
+  wait_exec_times(20);
+  ASSERT_EQ(s_exec_times.load(), 20);
+
+  action_thread_pool_destroy(pool);
+  ASSERT_EQ(s_destroy_times.load(), 20);
+}
+
+TEST(ActionThreadPoolWorkStealing, destroy_pending) {
+  uint32_t i = 0;
+  action_thread_pool_t* pool = action_thread_pool_create_work_stealing(1, 0);
+
+  s_exec_times = 0;
+  s_destroy_times = 0;
+  for (i = 0; i < 50; i++) {
+    ASSERT_EQ(action_thread_pool_exec(pool, qaction_test_create(1)), RET_OK);
+  }
+
+  /*没有执行完的action在销毁时会被执行或者释放。*/
+  action_thread_pool_destroy(pool);
+  ASSERT_EQ(s_exec_times.load(), s_destroy_times.load());
+}
@@ -4,6 +4,9 @@
 #include "tkc/path.h"
 #include "tkc/utils.h"
 #include "base/system_info.h"
+#include <string>
+
+using std::string;
 
 TEST(AssetsManager, basic) {
   const asset_info_t* null_res = NULL;
@@ -274,6 +277,84 @@ TEST(AssetsManager, clearCache) {
   assets_manager_destroy(rm);
 }
 
+TEST(AssetsManager, index) {
+  uint32_t i = 0;
+  char name[TK_NAME_LEN + 1];
+  uint8_t data[4] = {1, 2, 3, 4};
+  const asset_info_t* r = NULL;
+  assets_manager_t* rm = assets_manager_create(10);
+
+  for (i = 0; i < 200; i++) {
+    tk_snprintf(name, sizeof(name), "data%u", i);
+    ASSERT_EQ(assets_manager_add_data(rm, name, ASSET_TYPE_DATA, ASSET_TYPE_DATA_BIN, data,
+                                      sizeof(data)),
+              RET_OK);
+    ASSERT_EQ(assets_manager_add_data(rm, name, ASSET_TYPE_DATA, ASSET_TYPE_DATA_TEXT, data,
+                                      sizeof(data)),
+              RET_OK);
+
+    /*边加边查，索引需要增量更新。*/
+    r = assets_manager_find_in_cache(rm, ASSET_TYPE_DATA, 0, name);
+    ASSERT_EQ(r != NULL, true);
+    ASSERT_EQ(r->subtype, ASSET_TYPE_DATA_BIN);
+  }
+  ASSERT_EQ(rm->assets.size, 400u);
+
+  for (i = 0; i < 200; i++) {
+    tk_snprintf(name, sizeof(name), "data%u", i);
+    r = assets_manager_find_in_cache(rm, ASSET_TYPE_DATA, 0, name);
+    ASSERT_EQ(r != NULL, true);
+    ASSERT_EQ(r->subtype, ASSET_TYPE_DATA_BIN);
+    ASSERT_EQ(string(r->name), string(name));
+
+    r = assets_manager_find_in_cache(rm, ASSET_TYPE_DATA, ASSET_TYPE_DATA_TEXT, name);
+    ASSERT_EQ(r != NULL, true);
+    ASSERT_EQ(r->subtype, ASSET_TYPE_DATA_TEXT);
+
+    ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_XML, 0, name) == NULL, true);
+  }
+  ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_DATA, 0, "data200") == NULL, true);
+
+  ASSERT_EQ(assets_manager_clear_cache_ex(rm, ASSET_TYPE_DATA, "data10"), RET_OK);
+  ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_DATA, 0, "data10") == NULL, true);
+  ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_DATA, 0, "data11") != NULL, true);
+  ASSERT_EQ(assets_manager_add_data(rm, "data10", ASSET_TYPE_DATA, ASSET_TYPE_DATA_TEXT, data,
+                                    sizeof(data)),
+            RET_OK);
+  r = assets_manager_find_in_cache(rm, ASSET_TYPE_DATA, 0, "data10");
+  ASSERT_EQ(r != NULL, true);
+  ASSERT_EQ(r->subtype, ASSET_TYPE_DATA_TEXT);
+
+  ASSERT_EQ(assets_manager_clear_cache(rm, ASSET_TYPE_DATA), RET_OK);
+  ASSERT_EQ(rm->assets.size, 0u);
+  ASSERT_EQ(assets_manager_find_in_cache(rm, ASSET_TYPE_DATA, 0, "data11") == NULL, true);
+
+  assets_manager_destroy(rm);
+}
+
+TEST(AssetsManager, cache_stat) {
+  const asset_info_t* r = NULL;
+  assets_manager_t* rm = assets_manager_create(10);
+  asset_info_t img1 = {ASSET_TYPE_IMAGE, ASSET_TYPE_IMAGE_BMP, TRUE, 100, 0, "img1"};
+
+  ASSERT_EQ(rm->cache_hits, 0u);
+  ASSERT_EQ(rm->cache_misses, 0u);
+  ASSERT_EQ(assets_manager_add(rm, &img1), RET_OK);
+
+  r = assets_manager_ref(rm, ASSET_TYPE_IMAGE, "img1");
+  ASSERT_EQ(r, &img1);
+  assets_manager_unref(rm, r);
+  ASSERT_EQ(rm->cache_hits, 1u);
+  ASSERT_EQ(rm->cache_misses, 0u);
+
+  r = assets_manager_ref(rm, ASSET_TYPE_IMAGE, "not_exist_image");
+  ASSERT_EQ(r == NULL, true);
+  ASSERT_EQ(rm->cache_hits, 1u);
+  ASSERT_EQ(rm->cache_misses, 1u);
+
+  assets_manager_destroy(rm);
+}
+
 TEST(AssetsManager, xml) {
   const asset_info_t* r = NULL;
   assets_manager_t* rm = assets_manager();
@@ -155,3 +155,23 @@ TEST(Bitmap, clone) {
 
   bitmap_destroy(b1);
 }
+
+TEST(Bitmap, update_from_rgba) {
+  bitmap_t* b = bitmap_create_ex(2, 1, 0, BITMAP_FMT_BGRA8888);
+  uint8_t opaque[] = {1, 2, 3, 0xff, 4, 5, 6, 0xff};
+  uint8_t trans[] = {1, 2, 3, 0x80, 4, 5, 6, 0xff};
+
+  ASSERT_EQ(bitmap_update_from_rgba(b, opaque, 4), RET_OK);
+  ASSERT_TRUE(b->flags & BITMAP_FLAG_OPAQUE);
+  ASSERT_TRUE(b->flags & BITMAP_FLAG_CHANGED);
+
+  uint8_t* p = bitmap_lock_buffer_for_read(b);
+  ASSERT_EQ(p[0], 3);
+  ASSERT_EQ(p[2], 1);
+  bitmap_unlock_buffer(b);
+
+  ASSERT_EQ(bitmap_update_from_rgba(b, trans, 4), RET_OK);
+  ASSERT_FALSE(b->flags & BITMAP_FLAG_OPAQUE);
+
+  bitmap_destroy(b);
+}
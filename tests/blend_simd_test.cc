@@ -0,0 +1,176 @@
+#include "base/pixel.h"
+#include "tkc/color.h"
+#include "base/bitmap.h"
+#include "blend/blend_simd.h"
+
+/*这些头文件是生成的，没有BEGIN_C_DECLS。*/
+BEGIN_C_DECLS
+#include "blend/fill_image_bgr565.h"
+#include "blend/fill_image_bgra8888.h"
+#include "blend/fill_image_rgba8888.h"
+#include "blend/blend_image_bgr565_rgba8888.h"
+#include "blend/blend_image_bgra8888_rgba8888.h"
+#include "blend/blend_image_bgra8888_bgra8888.h"
+#include "blend/blend_image_rgba8888_rgba8888.h"
+#include "blend/blend_image_rgba8888_bgra8888.h"
+END_C_DECLS
+
+#include "gtest/gtest.h"
+
+typedef ret_t (*blend_image_func_t)(bitmap_t* dst, bitmap_t* src, const rect_t* dst_r,
+                                    const rect_t* src_r, uint8_t a);
+typedef ret_t (*fill_rect_func_t)(bitmap_t* fb, const rect_t* dst, color_t c);
+
+static uint32_t s_seed = 1;
+
+static uint8_t test_rand(void) {
+  s_seed = s_seed * 1103515245 + 12345;
+
+  return (s_seed >> 16) & 0xff;
+}
+
+/*alpha的几种典型情况都要覆盖到：全透明、不透明、边界值和半透明。*/
+static uint8_t test_rand_alpha(void) {
+  static const uint8_t alphas[] = {0, 0x07, 0x08, 0x09, 0x40, 0x80, 0xf4, 0xf5, 0xf8, 0xf9, 0xff};
+  uint8_t r = test_rand();
+
+  if (r < 0x80) {
+    return 0xff;
+  } else if (r < 0xc0) {
+    return alphas[r % ARRAY_SIZE(alphas)];
+  } else {
+    return test_rand();
+  }
+}
+
+static bitmap_t* test_bitmap_create(uint32_t w, uint32_t h, uint32_t stride,
+                                    bitmap_format_t fmt) {
+  uint32_t i = 0;
+  uint32_t bpp = bitmap_get_bpp_of_format(fmt);
+  bitmap_t* b = bitmap_create_ex(w, h, bpp * (w + stride), fmt);
+  uint8_t* data = bitmap_lock_buffer_for_write(b);
+  uint32_t size = bitmap_get_line_length(b) * h;
+
+  for (i = 0; i < size; i++) {
+    if (bpp == 4 && (i % 4) == 3) {
+      data[i] = test_rand_alpha();
+    } else {
+      data[i] = test_rand();
+    }
+  }
+  bitmap_unlock_buffer(b);
+
+  return b;
+}
+
+static void test_bitmap_equal(bitmap_t* b1, bitmap_t* b2) {
+  uint8_t* d1 = bitmap_lock_buffer_for_read(b1);
+  uint8_t* d2 = bitmap_lock_buffer_for_read(b2);
+
+  ASSERT_EQ(bitmap_get_line_length(b1), bitmap_get_line_length(b2));
+  ASSERT_EQ(memcmp(d1, d2, bitmap_get_line_length(b1) * b1->h), 0);
+
+  bitmap_unlock_buffer(b1);
+  bitmap_unlock_buffer(b2);
+}
+
+static void test_blend(bitmap_format_t dfmt, bitmap_format_t sfmt, blend_image_func_t func) {
+  uint32_t i = 0;
+  uint32_t w = 37;
+  uint32_t h = 5;
+  static const uint8_t global_alphas[] = {0xff, 0xfa, 0xf8, 0x80, 0x20, 0x09, 0x08};
+
+  for (i = 0; i < ARRAY_SIZE(global_alphas) * 2; i++) {
+    uint8_t a = global_alphas[i / 2];
+    bool_t premulti = i % 2;
+    bitmap_t* src = test_bitmap_create(w, h, 3, sfmt);
+    bitmap_t* dst1 = test_bitmap_create(w, h, 1, dfmt);
+    bitmap_t* dst2 = bitmap_create_ex(w, h, dst1->line_length, dfmt);
+    rect_t r = rect_init(1, 1, w - 2, h - 1);
+
+    memcpy(bitmap_lock_buffer_for_write(dst2), bitmap_lock_buffer_for_read(dst1),
+           dst1->line_length * h);
+    bitmap_unlock_buffer(dst1);
+    bitmap_unlock_buffer(dst2);
+
+    if (premulti) {
+      src->flags |= BITMAP_FLAG_PREMULTI_ALPHA;
+    }
+
+    ASSERT_EQ(func(dst1, src, &r, &r, a), RET_OK);
+    ASSERT_EQ(blend_simd_image(dst2, src, &r, &r, a), RET_OK);
+    test_bitmap_equal(dst1, dst2);
+
+    bitmap_destroy(src);
+    bitmap_destroy(dst1);
+    bitmap_destroy(dst2);
+  }
+}
+
+static void test_fill(bitmap_format_t fmt, fill_rect_func_t func) {
+  uint32_t i = 0;
+  uint32_t w = 29;
+  uint32_t h = 4;
+
+  for (i = 0; i < 64; i++) {
+    color_t c = color_init(test_rand(), test_rand(), test_rand(), test_rand() % 0xf9);
+    bitmap_t* dst1 = test_bitmap_create(w, h, 2, fmt);
+    bitmap_t* dst2 = bitmap_create_ex(w, h, dst1->line_length, fmt);
+    rect_t r = rect_init(2, 1, w - 3, h - 1);
+
+    if (i % 4 == 0) {
+      c.rgba.r = 0;
+      c.rgba.g = 0;
+      c.rgba.b = 0;
+    }
+
+    memcpy(bitmap_lock_buffer_for_write(dst2), bitmap_lock_buffer_for_read(dst1),
+           dst1->line_length * h);
+    bitmap_unlock_buffer(dst1);
+    bitmap_unlock_buffer(dst2);
+
+    ASSERT_EQ(func(dst1, &r, c), RET_OK);
+    ASSERT_EQ(blend_simd_fill_rect(dst2, &r, c), RET_OK);
+    test_bitmap_equal(dst1, dst2);
+
+    bitmap_destroy(dst1);
+    bitmap_destroy(dst2);
+  }
+}
+
+TEST(BlendSimd, not_impl) {
+  bitmap_t* src = bitmap_create_ex(8, 8, 0, BITMAP_FMT_RGBA8888);
+  bitmap_t* dst = bitmap_create_ex(8, 8, 0, BITMAP_FMT_BGR888);
+  rect_t r = rect_init(0, 0, 8, 8);
+  rect_t r2 = rect_init(0, 0, 4, 4);
+
+  ASSERT_EQ(blend_simd_image(dst, src, &r, &r, 0xff), RET_NOT_IMPL);
+  ASSERT_EQ(blend_simd_fill_rect(dst, &r, color_init(0, 0, 0, 0x80)), RET_NOT_IMPL);
+  ASSERT_EQ(blend_simd_fill_rect(src, &r, color_init(0, 0, 0, 0xff)), RET_NOT_IMPL);
+  ASSERT_EQ(blend_simd_image(src, src, &r, &r2, 0xff), RET_NOT_IMPL);
+
+  bitmap_destroy(src);
+  bitmap_destroy(dst);
+}
+
+TEST(BlendSimd, blend) {
+  if (!blend_simd_enabled()) {
+    return;
+  }
+
+  test_blend(BITMAP_FMT_BGRA8888, BITMAP_FMT_RGBA8888, blend_image_bgra8888_rgba8888);
+  test_blend(BITMAP_FMT_BGRA8888, BITMAP_FMT_BGRA8888, blend_image_bgra8888_bgra8888);
+  test_blend(BITMAP_FMT_RGBA8888, BITMAP_FMT_RGBA8888, blend_image_rgba8888_rgba8888);
+  test_blend(BITMAP_FMT_RGBA8888, BITMAP_FMT_BGRA8888, blend_image_rgba8888_bgra8888);
+  test_blend(BITMAP_FMT_BGR565, BITMAP_FMT_RGBA8888, blend_image_bgr565_rgba8888);
+}
+
+TEST(BlendSimd, fill) {
+  if (!blend_simd_enabled()) {
+    return;
+  }
+
+  test_fill(BITMAP_FMT_BGRA8888, fill_bgra8888_rect);
+  test_fill(BITMAP_FMT_RGBA8888, fill_rgba8888_rect);
+  test_fill(BITMAP_FMT_BGR565, fill_bgr565_rect);
+}
@@ -0,0 +1,178 @@
+#include "base/dirty_rects.h"
+#include "gtest/gtest.h"
+
+TEST(DirtyRects, basic) {
+  dirty_rects_t dirty_rects;
+  rect_t r = rect_init(0, 0, 10, 10);
+
+  dirty_rects_init(&dirty_rects);
+  ASSERT_EQ(dirty_rects.nr, 0u);
+  ASSERT_EQ(dirty_rects_add(&dirty_rects, &r), RET_OK);
+  ASSERT_EQ(dirty_rects.nr, 1u);
+
+  r = rect_init(2, 2, 5, 5);
+  ASSERT_EQ(dirty_rects_add(&dirty_rects, &r), RET_OK);
+  ASSERT_EQ(dirty_rects.nr, 1u);
+  ASSERT_EQ(dirty_rects.max.w, 10);
+  ASSERT_EQ(dirty_rects.max.h, 10);
+
+  r = rect_init(0, 0, 0, 10);
+  ASSERT_EQ(dirty_rects_add(&dirty_rects, &r), RET_OK);
+  ASSERT_EQ(dirty_rects.nr, 1u);
+
+  ASSERT_EQ(dirty_rects_reset(&dirty_rects), RET_OK);
+  ASSERT_EQ(dirty_rects.nr, 0u);
+  ASSERT_EQ(dirty_rects.max.w, 0);
+}
+
+TEST(DirtyRects, far_apart) {
+  dirty_rects_t dirty_rects;
+  rect_t caret = rect_init(10, 10, 2, 20);
+  rect_t clock = rect_init(900, 560, 100, 30);
+
+  dirty_rects_init(&dirty_rects);
+  dirty_rects_add(&dirty_rects, &caret);
+  dirty_rects_add(&dirty_rects, &clock);
+
+  ASSERT_EQ(dirty_rects.nr, 2u);
+  ASSERT_EQ(dirty_rects.max.x, 10);
+  ASSERT_EQ(dirty_rects.max.y, 10);
+  ASSERT_EQ(dirty_rects.max.w, 990);
+  ASSERT_EQ(dirty_rects.max.h, 580);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 0)->w, 2);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 1)->w, 100);
+  ASSERT_TRUE(dirty_rects_get(&dirty_rects, 2) == NULL);
+}
+
+TEST(DirtyRects, merge_overlap) {
+  dirty_rects_t dirty_rects;
+  rect_t r1 = rect_init(0, 0, 100, 100);
+  rect_t r2 = rect_init(500, 0, 100, 100);
+  rect_t r3 = rect_init(50, 50, 500, 10);
+
+  dirty_rects_init(&dirty_rects);
+  dirty_rects_add(&dirty_rects, &r1);
+  dirty_rects_add(&dirty_rects, &r2);
+  ASSERT_EQ(dirty_rects.nr, 2u);
+
+  /*r3和r1/r2都相交，三个合并为一个。*/
+  dirty_rects_add(&dirty_rects, &r3);
+  ASSERT_EQ(dirty_rects.nr, 1u);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 0)->x, 0);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 0)->w, 600);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 0)->h, 100);
+}
+
+TEST(DirtyRects, merge_adjacent) {
+  dirty_rects_t dirty_rects;
+  rect_t r1 = rect_init(0, 0, 100, 30);
+  rect_t r2 = rect_init(0, 30, 100, 30);
+
+  dirty_rects_init(&dirty_rects);
+  dirty_rects_add(&dirty_rects, &r1);
+  dirty_rects_add(&dirty_rects, &r2);
+
+  ASSERT_EQ(dirty_rects.nr, 1u);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 0)->h, 60);
+}
+
+TEST(DirtyRects, full) {
+  uint32_t i = 0;
+  dirty_rects_t dirty_rects;
+
+  dirty_rects_init(&dirty_rects);
+  for (i = 0; i < TK_MAX_DIRTY_RECT_NR + 3; i++) {
+    rect_t r = rect_init(i * 100, i * 100, 10, 10);
+    dirty_rects_add(&dirty_rects, &r);
+    ASSERT_EQ(dirty_rects.nr <= TK_MAX_DIRTY_RECT_NR, true);
+  }
+
+  ASSERT_EQ(dirty_rects.max.x, 0);
+  ASSERT_EQ(dirty_rects.max.w, (int)((TK_MAX_DIRTY_RECT_NR + 2) * 100 + 10));
+  for (i = 0; i < TK_MAX_DIRTY_RECT_NR + 3; i++) {
+    uint32_t k = 0;
+    bool_t found = FALSE;
+    for (k = 0; k < dirty_rects.nr; k++) {
+      if (rect_contains(dirty_rects_get(&dirty_rects, k), i * 100 + 5, i * 100 + 5)) {
+        found = TRUE;
+      }
+    }
+    ASSERT_EQ(found, TRUE);
+  }
+}
+
+TEST(DirtyRects, disable_multiple) {
+  dirty_rects_t dirty_rects;
+  rect_t r1 = rect_init(0, 0, 10, 10);
+  rect_t r2 = rect_init(500, 500, 10, 10);
+
+  dirty_rects_init(&dirty_rects);
+  dirty_rects.disable_multiple = TRUE;
+  dirty_rects_add(&dirty_rects, &r1);
+  dirty_rects_add(&dirty_rects, &r2);
+
+  ASSERT_EQ(dirty_rects.nr, 1u);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 0)->w, 510);
+}
+
+TEST(DirtyRects, fix) {
+  dirty_rects_t dirty_rects;
+  rect_t r1 = rect_init(-10, -10, 20, 20);
+  rect_t r2 = rect_init(500, 500, 10, 10);
+  rect_t r3 = rect_init(90, 90, 20, 20);
+
+  dirty_rects_init(&dirty_rects);
+  dirty_rects_add(&dirty_rects, &r1);
+  dirty_rects_add(&dirty_rects, &r2);
+  dirty_rects_add(&dirty_rects, &r3);
+  ASSERT_EQ(dirty_rects.nr, 3u);
+
+  ASSERT_EQ(dirty_rects_fix(&dirty_rects, 100, 100), RET_OK);
+  ASSERT_EQ(dirty_rects.nr, 2u);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 0)->x, 0);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 0)->w, 10);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 1)->x, 90);
+  ASSERT_EQ(dirty_rects_get(&dirty_rects, 1)->w, 10);
+  ASSERT_EQ(dirty_rects.max.w, 100);
+}
+
+TEST(DirtyRects, fix_remove_all) {
+  dirty_rects_t dirty_rects;
+  rect_t r1 = rect_init(200, 0, 10, 10);
+  rect_t r2 = rect_init(500, 500, 10, 10);
+
+  dirty_rects_init(&dirty_rects);
+  dirty_rects_add(&dirty_rects, &r1);
+  dirty_rects_add(&dirty_rects, &r2);
+  ASSERT_EQ(dirty_rects.nr, 2u);
+
+  ASSERT_EQ(dirty_rects_fix(&dirty_rects, 100, 100), RET_OK);
+  ASSERT_EQ(dirty_rects.nr, 0u);
+  ASSERT_EQ(dirty_rects.max.w, 0);
+}
+
+TEST(DirtyRects, should_paint_separately) {
+  dirty_rects_t dirty_rects;
+  rect_t caret = rect_init(10, 10, 2, 20);
+  rect_t clock = rect_init(960, 570, 60, 20);
+  rect_t r1 = rect_init(0, 0, 100, 100);
+  rect_t r2 = rect_init(0, 110, 100, 100);
+
+  dirty_rects_init(&dirty_rects);
+  ASSERT_EQ(dirty_rects_should_paint_separately(&dirty_rects), FALSE);
+
+  dirty_rects_add(&dirty_rects, &caret);
+  ASSERT_EQ(dirty_rects_should_paint_separately(&dirty_rects), FALSE);
+
+  /*两个角落的小矩形，外接矩形几乎是整个屏幕。*/
+  dirty_rects_add(&dirty_rects, &clock);
+  ASSERT_EQ(dirty_rects.nr, 2u);
+  ASSERT_EQ(dirty_rects_should_paint_separately(&dirty_rects), TRUE);
+
+  /*两个矩形几乎占满外接矩形，合并为一个。*/
+  dirty_rects_reset(&dirty_rects);
+  dirty_rects_add(&dirty_rects, &r1);
+  dirty_rects_add(&dirty_rects, &r2);
+  ASSERT_EQ(dirty_rects.nr, 1u);
+  ASSERT_EQ(dirty_rects_should_paint_separately(&dirty_rects), FALSE);
+}
@@ -4,6 +4,7 @@
 #include "tkc/event_source_timer.h"
 #include "tkc/event_source_manager.h"
 #include "tkc/event_source_manager_default.h"
+#include "tkc/event_source_manager_epoll.h"
 
 TEST(EventSourceManager, basic) {
   idle_manager_t* tm = idle_manager_create();
@@ -42,3 +43,155 @@ TEST(EventSourceManager, tag) {
   event_source_manager_destroy(manager);
   idle_manager_destroy(tm);
 }
+
+TEST(EventSourceManager, default_no_wait) {
+  event_source_manager_t* manager = event_source_manager_default_create();
+
+  ASSERT_EQ(event_source_manager_wait(manager, 10), RET_NOT_IMPL);
+  ASSERT_EQ(event_source_manager_wakeup(manager), RET_NOT_IMPL);
+
+  event_source_manager_destroy(manager);
+}
+
+#ifdef WITH_EVENT_SOURCE_EPOLL
+#include <unistd.h>
+#include "tkc/thread.h"
+#include "tkc/platform.h"
+#include "tkc/time_now.h"
+#include "tkc/event_source_fd.h"
+
+static uint32_t s_epoll_fd_times = 0;
+static ret_t epoll_on_fd_data(event_source_t* source) {
+  char buff[32];
+  event_source_fd_t* fd_source = EVENT_SOURCE_FD(source);
+
+  s_epoll_fd_times++;
+  if (read(fd_source->fd, buff, sizeof(buff)) <= 0) {
+    return RET_REMOVE;
+  }
+
+  return RET_OK;
+}
+
+TEST(EventSourceManager, epoll_fd) {
+  int socks[2];
+  event_source_t* source = NULL;
+  event_source_manager_t* manager = event_source_manager_epoll_create();
+
+  ASSERT_TRUE(manager != NULL);
+  ASSERT_EQ(tk_socketpair(socks), 0);
+  s_epoll_fd_times = 0;
+  source = event_source_fd_create(socks[0], epoll_on_fd_data, NULL);
+  ASSERT_EQ(event_source_manager_add(manager, source), RET_OK);
+
+  ASSERT_EQ(event_source_manager_dispatch(manager), RET_OK);
+  ASSERT_EQ(s_epoll_fd_times, 0u);
+
+  ASSERT_EQ(write(socks[1], "a", 1), 1);
+  ASSERT_EQ(event_source_manager_wait(manager, 1000), RET_OK);
+  ASSERT_EQ(event_source_manager_dispatch(manager), RET_OK);
+  ASSERT_EQ(s_epoll_fd_times, 1u);
+
+  ASSERT_EQ(event_source_manager_dispatch(manager), RET_OK);
+  ASSERT_EQ(s_epoll_fd_times, 1u);
+
+  /*对端关闭后事件源返回RET_REMOVE。*/
+  close(socks[1]);
+  ASSERT_EQ(event_source_manager_dispatch(manager), RET_OK);
+  ASSERT_EQ(s_epoll_fd_times, 2u);
+  ASSERT_EQ(event_source_manager_exist(manager, source), FALSE);
+
+  close(socks[0]);
+  object_unref(OBJECT(source));
+  event_source_manager_destroy(manager);
+}
+
+static ret_t epoll_on_timer(const timer_info_t* info) {
+  return RET_REMOVE;
+}
+
+TEST(EventSourceManager, epoll_timer) {
+  uint64_t start = 0;
+  uint64_t cost = 0;
+  timer_manager_t* tm = timer_manager_create(time_now_ms);
+  event_source_t* source = event_source_timer_create(tm);
+  event_source_manager_t* manager = event_source_manager_epoll_create();
+
+  ASSERT_EQ(event_source_manager_add(manager, source), RET_OK);
+  timer_manager_add(tm, epoll_on_timer, NULL, 50);
+
+  start = time_now_ms();
+  ASSERT_EQ(event_source_manager_wait(manager, 5000), RET_OK);
+  cost = time_now_ms() - start;
+  ASSERT_GE(cost, 40u);
+  ASSERT_LT(cost, 1000u);
+
+  /*max_time比定时器更早。*/
+  timer_manager_add(tm, epoll_on_timer, NULL, 5000);
+  start = time_now_ms();
+  ASSERT_EQ(event_source_manager_wait(manager, 20), RET_OK);
+  cost = time_now_ms() - start;
+  ASSERT_LT(cost, 1000u);
+
+  object_unref(OBJECT(source));
+  event_source_manager_destroy(manager);
+  timer_manager_destroy(tm);
+}
+
+TEST(EventSourceManager, epoll_timer_suspend) {
+  uint64_t start = 0;
+  uint64_t cost = 0;
+  timer_info_t* timer = NULL;
+  timer_manager_t* tm = timer_manager_create(time_now_ms);
+  event_source_t* source = event_source_timer_create(tm);
+  event_source_manager_t* manager = event_source_manager_epoll_create();
+
+  ASSERT_EQ(event_source_manager_add(manager, source), RET_OK);
+  timer = (timer_info_t*)timer_manager_find(tm, timer_manager_add(tm, epoll_on_timer, NULL, 0));
+  timer->suspend = TRUE;
+  timer_manager_add(tm, epoll_on_timer, NULL, 50);
+  sleep_ms(5);
+
+  /*挂起的定时器已经过期，不应该导致立即返回。*/
+  start = time_now_ms();
+  ASSERT_EQ(event_source_manager_wait(manager, 5000), RET_OK);
+  cost = time_now_ms() - start;
+  ASSERT_GE(cost, 30u);
+  ASSERT_LT(cost, 1000u);
+
+  object_unref(OBJECT(source));
+  event_source_manager_destroy(manager);
+  timer_manager_destroy(tm);
+}
+
+static void* epoll_wakeup_thread(void* args) {
+  sleep_ms(50);
+  event_source_manager_wakeup((event_source_manager_t*)args);
+
+  return NULL;
+}
+
+TEST(EventSourceManager, epoll_wakeup) {
+  uint64_t start = 0;
+  uint64_t cost = 0;
+  event_source_manager_t* manager = event_source_manager_epoll_create();
+  tk_thread_t* thread = tk_thread_create(epoll_wakeup_thread, manager);
+
+  start = time_now_ms();
+  ASSERT_EQ(tk_thread_start(thread), RET_OK);
+  ASSERT_EQ(event_source_manager_wait(manager, 10000), RET_OK);
+  cost = time_now_ms() - start;
+  ASSERT_LT(cost, 5000u);
+
+  /*唤醒在等待之前发生时，等待立即返回。*/
+  ASSERT_EQ(event_source_manager_wakeup(manager), RET_OK);
+  start = time_now_ms();
+  ASSERT_EQ(event_source_manager_wait(manager, 10000), RET_OK);
+  cost = time_now_ms() - start;
+  ASSERT_LT(cost, 1000u);
+
+  tk_thread_join(thread);
+  tk_thread_destroy(thread);
+  event_source_manager_destroy(manager);
+}
+#endif /*WITH_EVENT_SOURCE_EPOLL*/
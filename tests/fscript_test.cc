@@ -1208,3 +1208,64 @@ TEST(FExr, syntax_check) {
 
   OBJECT_UNREF(obj);
 }
+
+TEST(FExr, exec_many_times) {
+  value_t v;
+  uint32_t i = 0;
+  object_t* obj = object_default_create();
+  fscript_t* fscript = fscript_create(obj, "b=0;while(b<3){b=b+1};abc+b");
+
+  for (i = 0; i < 10; i++) {
+    object_set_prop_int(obj, "abc", i);
+    /*插入新属性会改变abc在属性数组中的位置*/
+    if (i == 5) {
+      object_set_prop_int(obj, "aaa", i);
+    }
+    fscript_exec(fscript, &v);
+    ASSERT_EQ(value_int(&v), i + 3);
+    value_reset(&v);
+  }
+
+  object_remove_prop(obj, "abc");
+  fscript_exec(fscript, &v);
+  ASSERT_STREQ(value_str(&v), "abc3");
+  value_reset(&v);
+  ASSERT_EQ(fscript->stack_top, 0);
+
+  fscript_destroy(fscript);
+  OBJECT_UNREF(obj);
+}
+
+TEST(FExr, keywords_as_id) {
+  value_t v;
+  object_t* obj = object_default_create();
+
+  fscript_eval(obj, "break", &v);
+  ASSERT_STREQ(value_str(&v), "break");
+  value_reset(&v);
+
+  fscript_eval(obj, "set(continue, 1);continue+1", &v);
+  ASSERT_EQ(value_int(&v), 2);
+  value_reset(&v);
+
+  fscript_eval(obj, "$xyz", &v);
+  ASSERT_EQ(value_str(&v), (const char*)NULL);
+  value_reset(&v);
+
+  fscript_eval(obj, "a=1;a+1;return;a+2", &v);
+  ASSERT_EQ(value_int(&v), 0);
+  value_reset(&v);
+
+  OBJECT_UNREF(obj);
+}
+
+TEST(FExr, deep_nesting) {
+  value_t v;
+  object_t* obj = object_default_create();
+
+  fscript_eval(obj, "a=1;a+(a+(a+(a+(a+(a+(a+(a+(a+(a+a)))))))))", &v);
+  ASSERT_EQ(value_int(&v), 11);
+  value_reset(&v);
+
+  OBJECT_UNREF(obj);
+}
@@ -1,5 +1,9 @@
 ﻿#include "base/window.h"
+#include "base/canvas.h"
+#include "base/timer.h"
+#include "lcd_log.h"
 #include "gif_image/gif_image.h"
+#include "image_loader/image_loader_stb.h"
 #include "gtest/gtest.h"
 
 TEST(GifImage, basic) {
@@ -44,3 +48,43 @@ TEST(GifImage, state) {
 
   widget_destroy(w);
 }
+
+TEST(GifImage, stream) {
+  canvas_t c;
+  font_manager_t font_manager;
+  rect_t r = rect_init(0, 0, 800, 600);
+  lcd_t* lcd = lcd_log_init(800, 600);
+  widget_t* w = window_create(NULL, 0, 0, 0, 0);
+  widget_t* img = gif_image_create(w, 0, 0, 100, 100);
+  gif_image_t* gif_image = GIF_IMAGE(img);
+
+  font_manager_init(&font_manager, NULL);
+  canvas_init(&c, lcd, &font_manager);
+  canvas_begin_frame(&c, &r, LCD_DRAW_NORMAL);
+
+  widget_set_prop_str(img, WIDGET_PROP_IMAGE, "bee");
+  widget_on_paint_self(img, &c);
+
+  /*只保存一帧的位图，不再一次解码全部帧。*/
+  ASSERT_TRUE(gif_image->decoder != NULL);
+  ASSERT_EQ(gif_image->frame->w, gif_image->decoder->w);
+  ASSERT_EQ(gif_image->frame->h, gif_image->decoder->h);
+  ASSERT_NE(gif_image->timer_id, TK_INVALID_ID);
+
+  ASSERT_EQ(gif_decoder_next(gif_image->decoder), RET_OK);
+  ASSERT_EQ(gif_image->decoder->index, 1u);
+  gif_image_stop(img);
+  ASSERT_EQ(gif_image->decoder->index, 0u);
+
+  /*不是GIF文件时，使用原来的方式加载。*/
+  widget_set_prop_str(img, WIDGET_PROP_IMAGE, "earth");
+  widget_on_paint_self(img, &c);
+  ASSERT_TRUE(gif_image->decoder == NULL);
+  ASSERT_TRUE(gif_image->frame == NULL);
+
+  canvas_end_frame(&c);
+  widget_destroy(w);
+  canvas_reset(&c);
+  font_manager_deinit(&font_manager);
+  lcd_destroy(lcd);
+}
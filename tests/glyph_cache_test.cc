@@ -55,3 +55,46 @@ TEST(GlyphCache, shrink) {
 
   glyph_cache_deinit(c);
 }
+
+TEST(GlyphCache, lru) {
+  uint16_t i = 0;
+  uint16_t size = 10;
+  uint16_t nr = 16;
+  glyph_cache_t cache;
+  glyph_t g;
+  glyph_cache_t* c = glyph_cache_init(&cache, nr, (tk_destroy_t)glyph_destroy);
+
+  memset(&g, 0x00, sizeof(g));
+  for (i = 0; i < nr; i++) {
+    ASSERT_EQ(glyph_cache_add(c, i, size, glyph_clone(&g)), RET_OK);
+  }
+
+  /*访问0，使1成为最久未使用的。*/
+  ASSERT_EQ(glyph_cache_lookup(c, 0, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_add(c, nr, size, glyph_clone(&g)), RET_OK);
+  ASSERT_EQ(c->size, nr);
+
+  ASSERT_EQ(glyph_cache_lookup(c, 0, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 1, size, &g), RET_NOT_FOUND);
+  ASSERT_EQ(glyph_cache_lookup(c, nr, size, &g), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, nr, size + 1, &g), RET_NOT_FOUND);
+
+  for (i = 2; i < nr; i++) {
+    ASSERT_EQ(glyph_cache_lookup(c, i, size, &g), RET_OK);
+  }
+
+  ASSERT_EQ(glyph_cache_shrink(c, nr / 2), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 0, size, &g), RET_NOT_FOUND);
+  ASSERT_EQ(glyph_cache_lookup(c, nr, size, &g), RET_NOT_FOUND);
+  for (i = 2; i < nr / 2; i++) {
+    ASSERT_EQ(glyph_cache_lookup(c, i, size, &g), RET_NOT_FOUND);
+  }
+  for (i = nr / 2; i < nr; i++) {
+    ASSERT_EQ(glyph_cache_lookup(c, i, size, &g), RET_OK);
+  }
+
+  ASSERT_EQ(glyph_cache_add(c, 1, size, glyph_clone(&g)), RET_OK);
+  ASSERT_EQ(glyph_cache_lookup(c, 1, size, &g), RET_OK);
+
+  glyph_cache_deinit(c);
+}
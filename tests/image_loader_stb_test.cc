@@ -6,6 +6,9 @@
 #include "base/assets_manager.h"
 #include "tools/image_gen/image_gen.h"
 #include "image_loader/image_loader_stb.h"
+#include <string>
+
+using std::string;
 
 #define PNG_NAME TK_ROOT "/tests/testdata/test.png"
 #define JPG_NAME TK_ROOT "/tests/testdata/test.jpg"
@@ -105,3 +108,154 @@ TEST(ImageLoaderStb, rgba) {
   ASSERT_EQ(image.format, BITMAP_FMT_BGRA8888);
   bitmap_destroy(&image);
 }
+
+#define GIF_NAME TK_ROOT "/res/assets/default/raw/images/x1/bee.gif"
+
+/*每个像素前加一个clear code，码长固定为3位，不需要真正的LZW压缩。*/
+static void gif_add_frame(string& gif, uint8_t x, uint8_t w, uint8_t dispose, uint8_t color) {
+  uint32_t i = 0;
+  uint32_t bits = 0;
+  uint32_t nbits = 0;
+  string data;
+  uint8_t gce[] = {0x21, 0xf9, 0x04, (uint8_t)(dispose << 2), 10, 0, 0, 0};
+  uint8_t desc[] = {0x2c, x, 0, 0, 0, w, 0, 1, 0, 0, 2};
+
+  gif.append((const char*)gce, sizeof(gce));
+  gif.append((const char*)desc, sizeof(desc));
+
+  for (i = 0; i <= w; i++) {
+    uint32_t code = i < w ? ((4 | (color << 3)) & 0x3f) : 5;
+    uint32_t n = i < w ? 6 : 3;
+
+    bits |= code << nbits;
+    nbits += n;
+    while (nbits >= 8) {
+      data += (char)(bits & 0xff);
+      bits >>= 8;
+      nbits -= 8;
+    }
+  }
+  if (nbits > 0) {
+    data += (char)(bits & 0xff);
+  }
+
+  gif += (char)data.size();
+  gif += data;
+  gif += (char)0;
+}
+
+static string gif_create_disposal(void) {
+  string gif("GIF89a");
+  uint8_t header[] = {4, 0, 1, 0, 0x81, 0, 0};
+  uint8_t palette[] = {0, 0, 0, 0xff, 0, 0, 0, 0xff, 0, 0, 0, 0xff};
+
+  gif.append((const char*)header, sizeof(header));
+  gif.append((const char*)palette, sizeof(palette));
+
+  gif_add_frame(gif, 0, 4, 1, 1);
+  gif_add_frame(gif, 1, 2, 3, 2);
+  gif_add_frame(gif, 2, 2, 2, 3);
+  gif_add_frame(gif, 0, 1, 0, 2);
+  gif += (char)0x3b;
+
+  return gif;
+}
+
+static string gif_frame_colors(gif_decoder_t* decoder) {
+  uint32_t i = 0;
+  string colors;
+
+  for (i = 0; i < decoder->w * decoder->h; i++) {
+    const uint8_t* p = decoder->data + i * 4;
+
+    if (p[3] == 0) {
+      colors += '.';
+    } else if (p[0] == 0xff) {
+      colors += 'r';
+    } else if (p[1] == 0xff) {
+      colors += 'g';
+    } else if (p[2] == 0xff) {
+      colors += 'b';
+    } else {
+      colors += '?';
+    }
+  }
+
+  return colors;
+}
+
+TEST(GifDecoder, disposal) {
+  string gif = gif_create_disposal();
+  gif_decoder_t* decoder = gif_decoder_create((const uint8_t*)gif.c_str(), gif.size());
+
+  ASSERT_TRUE(decoder != NULL);
+  ASSERT_EQ(decoder->w, 4u);
+  ASSERT_EQ(decoder->h, 1u);
+  ASSERT_EQ(decoder->delay, 100u);
+  ASSERT_EQ(decoder->frames_nr, 0u);
+  ASSERT_EQ(gif_frame_colors(decoder), string("rrrr"));
+
+  ASSERT_EQ(gif_decoder_next(decoder), RET_OK);
+  ASSERT_EQ(decoder->index, 1u);
+  ASSERT_EQ(gif_frame_colors(decoder), string("rggr"));
+
+  /*3: 恢复为绘制上一帧之前的画面。*/
+  ASSERT_EQ(gif_decoder_next(decoder), RET_OK);
+  ASSERT_EQ(gif_frame_colors(decoder), string("rrbb"));
+
+  /*2: 恢复为背景(透明)。*/
+  ASSERT_EQ(gif_decoder_next(decoder), RET_OK);
+  ASSERT_EQ(gif_frame_colors(decoder), string("gr.."));
+
+  /*循环播放。*/
+  ASSERT_EQ(gif_decoder_next(decoder), RET_OK);
+  ASSERT_EQ(decoder->index, 0u);
+  ASSERT_EQ(decoder->frames_nr, 4u);
+  ASSERT_EQ(gif_frame_colors(decoder), string("rrrr"));
+
+  ASSERT_EQ(gif_decoder_next(decoder), RET_OK);
+  ASSERT_EQ(gif_frame_colors(decoder), string("rggr"));
+
+  ASSERT_EQ(gif_decoder_rewind(decoder), RET_OK);
+  ASSERT_EQ(decoder->index, 0u);
+  ASSERT_EQ(gif_frame_colors(decoder), string("rrrr"));
+
+  gif_decoder_destroy(decoder);
+}
+
+TEST(GifDecoder, invalid) {
+  const char* data = "not a gif";
+
+  ASSERT_TRUE(gif_decoder_create((const uint8_t*)data, strlen(data)) == NULL);
+}
+
+TEST(GifDecoder, bee) {
+  bitmap_t image;
+  uint32_t i = 0;
+  uint32_t size = 0;
+  uint8_t* data = (uint8_t*)file_read(GIF_NAME, &size);
+  ASSERT_TRUE(data != NULL);
+
+  ASSERT_EQ(stb_load_image(ASSET_TYPE_IMAGE_GIF, data, size, &image, FALSE, FALSE, FALSE), RET_OK);
+  gif_decoder_t* decoder = gif_decoder_create(data, size);
+  ASSERT_TRUE(decoder != NULL);
+  ASSERT_EQ(decoder->w, image.w);
+  ASSERT_EQ(decoder->h, image.gif_frame_h);
+
+  /*第一帧与一次解码全部帧的结果一致。*/
+  uint8_t* pixels = bitmap_lock_buffer_for_read(&image);
+  ASSERT_EQ(memcmp(decoder->data, pixels, decoder->w * decoder->h * 4), 0);
+  bitmap_unlock_buffer(&image);
+
+  for (i = 0; i < image.gif_frames_nr; i++) {
+    ASSERT_EQ(decoder->index, i);
+    ASSERT_EQ(decoder->delay, (uint32_t)(image.gif_delays[i]));
+    ASSERT_EQ(gif_decoder_next(decoder), RET_OK);
+  }
+  ASSERT_EQ(decoder->index, 0u);
+  ASSERT_EQ(decoder->frames_nr, image.gif_frames_nr);
+
+  gif_decoder_destroy(decoder);
+  bitmap_destroy(&image);
+  TKMEM_FREE(data);
+}
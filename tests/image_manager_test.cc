@@ -1,6 +1,8 @@
 ﻿#include <stdlib.h>
 #include "gtest/gtest.h"
 #include "base/image_manager.h"
+#include "tkc/utils.h"
+#include "tkc/platform.h"
 #include "image_loader/image_loader_stb.h"
 #include <string>
 
@@ -68,6 +70,134 @@ TEST(ImageManager, add) {
   ASSERT_EQ(image_manager_unload_unused(image_manager(), 0), RET_OK);
 }
 
+static ret_t add_image(image_manager_t* imm, const char* name) {
+  bitmap_t bmp;
+
+  bitmap_init(&bmp, 10, 10, BITMAP_FMT_RGBA8888, NULL);
+
+  return image_manager_add(imm, name, &bmp);
+}
+
+TEST(ImageManager, cache_stat) {
+  bitmap_t bmp;
+  image_manager_t* imm = image_manager_create();
+
+  ASSERT_EQ(add_image(imm, "a"), RET_OK);
+  ASSERT_EQ(add_image(imm, "b"), RET_OK);
+  ASSERT_EQ(imm->cache_mem_size, 800u);
+
+  ASSERT_EQ(image_manager_lookup(imm, "c", &bmp), RET_NOT_FOUND);
+  ASSERT_EQ(image_manager_lookup(imm, "a", &bmp), RET_OK);
+  ASSERT_EQ(imm->cache_hits, 1u);
+  ASSERT_EQ(imm->cache_misses, 1u);
+
+  ASSERT_EQ(image_manager_unload_bitmap(imm, &bmp), RET_OK);
+  ASSERT_EQ(imm->cache_mem_size, 400u);
+  ASSERT_EQ(image_manager_lookup(imm, "a", &bmp), RET_NOT_FOUND);
+  ASSERT_EQ(image_manager_lookup(imm, "b", &bmp), RET_OK);
+
+  ASSERT_EQ(image_manager_unload_all(imm), RET_OK);
+  ASSERT_EQ(imm->cache_mem_size, 0u);
+  ASSERT_EQ(image_manager_lookup(imm, "b", &bmp), RET_NOT_FOUND);
+
+  image_manager_destroy(imm);
+}
+
+TEST(ImageManager, cache_many) {
+  char name[32];
+  bitmap_t bmp;
+  uint32_t i = 0;
+  image_manager_t* imm = image_manager_create();
+
+  for (i = 0; i < 100; i++) {
+    tk_snprintf(name, sizeof(name), "image%u", i);
+    ASSERT_EQ(add_image(imm, name), RET_OK);
+  }
+
+  for (i = 0; i < 100; i++) {
+    tk_snprintf(name, sizeof(name), "image%u", i);
+    ASSERT_EQ(image_manager_lookup(imm, name, &bmp), RET_OK);
+    ASSERT_STREQ(bmp.name, name);
+  }
+  ASSERT_EQ(imm->cache_mem_size, 100u * 400u);
+
+  image_manager_destroy(imm);
+}
+
+TEST(ImageManager, cache_lru) {
+  bitmap_t bmp;
+  image_manager_t* imm = image_manager_create();
+
+  image_manager_set_cache_max_size(imm, 1000);
+  ASSERT_EQ(add_image(imm, "a"), RET_OK);
+  ASSERT_EQ(add_image(imm, "b"), RET_OK);
+
+  /*当前帧中用过的图片不会被淘汰，暂时超过最大内存。*/
+  ASSERT_EQ(add_image(imm, "c"), RET_OK);
+  ASSERT_EQ(imm->cache_evictions, 0u);
+  ASSERT_EQ(imm->cache_mem_size, 1200u);
+
+  /*新的一帧开始时淘汰最久没有使用的图片。*/
+  ASSERT_EQ(image_manager_begin_frame(imm), RET_OK);
+  ASSERT_EQ(imm->cache_evictions, 1u);
+  ASSERT_EQ(imm->cache_mem_size, 800u);
+  ASSERT_EQ(image_manager_lookup(imm, "a", &bmp), RET_NOT_FOUND);
+
+  ASSERT_EQ(image_manager_begin_frame(imm), RET_OK);
+  ASSERT_EQ(image_manager_lookup(imm, "b", &bmp), RET_OK);
+  ASSERT_EQ(add_image(imm, "d"), RET_OK);
+  ASSERT_EQ(imm->cache_evictions, 2u);
+  ASSERT_EQ(image_manager_lookup(imm, "c", &bmp), RET_NOT_FOUND);
+  ASSERT_EQ(image_manager_lookup(imm, "b", &bmp), RET_OK);
+  ASSERT_EQ(image_manager_lookup(imm, "d", &bmp), RET_OK);
+
+  ASSERT_EQ(image_manager_set_cache_max_size(imm, 0), RET_OK);
+  ASSERT_EQ(image_manager_begin_frame(imm), RET_OK);
+  ASSERT_EQ(imm->cache_evictions, 2u);
+
+  image_manager_destroy(imm);
+}
+
+static ret_t add_raster(image_manager_t* imm, const char* key) {
+  bitmap_t bmp;
+
+  bitmap_init(&bmp, 10, 10, BITMAP_FMT_RGBA8888, NULL);
+
+  return image_manager_add_raster(imm, key, &bmp);
+}
+
+TEST(ImageManager, raster) {
+  bitmap_t bmp;
+  image_manager_t* imm = image_manager_create();
+
+  ASSERT_EQ(image_manager_set_raster_cache_max_size(imm, 1000), RET_OK);
+  ASSERT_EQ(add_image(imm, "a"), RET_OK);
+  ASSERT_EQ(add_raster(imm, "svg:a"), RET_OK);
+  ASSERT_EQ(add_raster(imm, "svg:b"), RET_OK);
+  ASSERT_EQ(imm->raster_mem_size, 800u);
+  ASSERT_EQ(imm->cache_mem_size, 1200u);
+  ASSERT_EQ(image_manager_get_raster(imm, "svg:a", &bmp), RET_OK);
+  ASSERT_EQ(bmp.w, 10u);
+
+  /*只淘汰光栅化的位图，不影响普通图片。*/
+  ASSERT_EQ(add_raster(imm, "svg:c"), RET_OK);
+  ASSERT_EQ(image_manager_begin_frame(imm), RET_OK);
+  ASSERT_EQ(imm->raster_mem_size, 800u);
+  ASSERT_EQ(image_manager_get_raster(imm, "svg:b", &bmp), RET_NOT_FOUND);
+  ASSERT_EQ(image_manager_get_raster(imm, "svg:a", &bmp), RET_OK);
+  ASSERT_EQ(image_manager_lookup(imm, "a", &bmp), RET_OK);
+
+  /*超过最大内存的位图不缓存。*/
+  ASSERT_EQ(image_manager_begin_frame(imm), RET_OK);
+  ASSERT_EQ(image_manager_set_raster_cache_max_size(imm, 300), RET_OK);
+  ASSERT_EQ(imm->raster_mem_size, 0u);
+  ASSERT_EQ(add_raster(imm, "svg:d"), RET_FAIL);
+  ASSERT_EQ(image_manager_get_raster(imm, "svg:d", &bmp), RET_NOT_FOUND);
+  ASSERT_EQ(imm->cache_mem_size, 400u);
+
+  image_manager_destroy(imm);
+}
+
 TEST(ImageManager, locale) {
   bitmap_t bmp;
   memset(&bmp, 0x00, sizeof(bmp));
@@ -94,6 +224,119 @@ TEST(ImageManager, locale) {
   image_manager_destroy(imm);
 }
 
+static ret_t on_image_loaded(void* ctx, const char* name, ret_t result) {
+  uint32_t* loaded = (uint32_t*)ctx;
+
+  if (result == RET_OK) {
+    *loaded += 1;
+  }
+
+  return RET_OK;
+}
+
+static ret_t on_image_failed(void* ctx, const char* name, ret_t result) {
+  uint32_t* failed = (uint32_t*)ctx;
+
+  if (result != RET_OK) {
+    *failed += 1;
+  }
+
+  return RET_OK;
+}
+
+TEST(ImageManager, async) {
+  bitmap_t bmp;
+  uint32_t i = 0;
+  uint32_t loaded = 0;
+  image_manager_t* imm = image_manager_create();
+
+  memset(&bmp, 0x00, sizeof(bmp));
+  ret_t ret = image_manager_get_bitmap_async(imm, "checked", &bmp, on_image_loaded, &loaded);
+  ASSERT_TRUE(ret == RET_OK || ret == RET_BUSY);
+
+  if (ret == RET_BUSY) {
+    /*同一图片的请求合并到同一个解码任务中，相同的监听者只注册一次。*/
+    ASSERT_EQ(image_manager_is_async_loading(imm, "checked", on_image_loaded, &loaded), TRUE);
+    ASSERT_EQ(image_manager_get_bitmap_async(imm, "checked", &bmp, on_image_loaded, &loaded),
+              RET_BUSY);
+    ASSERT_EQ(image_manager_get_bitmap_async(imm, "checked", &bmp, on_image_loaded, &i),
+              RET_BUSY);
+    ASSERT_EQ(imm->async_jobs.size, 1u);
+    ASSERT_EQ(image_manager_lookup(imm, "checked", &bmp), RET_NOT_FOUND);
+
+    for (i = 0; i < 500 && loaded == 0; i++) {
+      sleep_ms(10);
+      image_manager_dispatch_async(imm);
+    }
+    ASSERT_EQ(loaded, 1u);
+    ASSERT_EQ(imm->async_jobs.size, 0u);
+    ASSERT_EQ(image_manager_is_async_loading(imm, "checked", on_image_loaded, &loaded), FALSE);
+  }
+
+  ASSERT_EQ(image_manager_lookup(imm, "checked", &bmp), RET_OK);
+  ASSERT_EQ(image_manager_get_bitmap_async(imm, "checked", &bmp, on_image_loaded, &loaded), RET_OK);
+  ASSERT_EQ(image_manager_get_bitmap_async(imm, "not found", &bmp, NULL, NULL), RET_NOT_FOUND);
+
+  image_manager_destroy(imm);
+}
+
+TEST(ImageManager, async_destroy_pending) {
+  bitmap_t bmp;
+  uint32_t loaded = 0;
+  uint32_t failed = 0;
+  uint32_t expected = 0;
+  image_manager_t* imm = image_manager_create();
+
+  memset(&bmp, 0x00, sizeof(bmp));
+  if (image_manager_get_bitmap_async(imm, "checked", &bmp, on_image_failed, &failed) == RET_BUSY) {
+    expected++;
+  }
+  if (image_manager_get_bitmap_async(imm, "unchecked", &bmp, on_image_loaded, &loaded) ==
+      RET_BUSY) {
+    ASSERT_EQ(image_manager_get_bitmap_async(imm, "unchecked", &bmp, on_image_failed, &failed),
+              RET_BUSY);
+    expected++;
+  }
+
+  /*销毁时等待后台任务结束，未分发的任务以失败回调，让监听者释放引用。*/
+  image_manager_destroy(imm);
+  ASSERT_EQ(loaded, 0u);
+  ASSERT_EQ(failed, expected);
+}
+
+TEST(ImageManager, async_failed) {
+  bitmap_t bmp;
+  uint32_t i = 0;
+  uint32_t failed = 0;
+  image_manager_t* imm = image_manager_create();
+  assets_manager_t* am = assets_manager_create(1);
+  asset_info_t* info = asset_info_create(ASSET_TYPE_IMAGE, ASSET_TYPE_IMAGE_PNG, "broken", 16);
+
+  memset(info->data, 0x5a, 16);
+  ASSERT_EQ(assets_manager_add(am, info), RET_OK);
+  image_manager_set_assets_manager(imm, am);
+
+  memset(&bmp, 0x00, sizeof(bmp));
+  ASSERT_EQ(image_manager_get_bitmap_async(imm, "broken", &bmp, on_image_failed, &failed),
+            RET_BUSY);
+  for (i = 0; i < 500 && failed == 0; i++) {
+    sleep_ms(10);
+    image_manager_dispatch_async(imm);
+  }
+  ASSERT_EQ(failed, 1u);
+
+  /*解码失败的图片不再重复解码。*/
+  ASSERT_EQ(image_manager_get_bitmap_async(imm, "broken", &bmp, on_image_failed, &failed),
+            RET_FAIL);
+  ASSERT_EQ(imm->async_jobs.size, 0u);
+
+  ASSERT_EQ(image_manager_unload_all(imm), RET_OK);
+  ASSERT_EQ(imm->async_failed.size, 0u);
+
+  image_manager_destroy(imm);
+  assets_manager_destroy(am);
+}
+
 #ifdef WITH_FS_RES
 TEST(ImageManager, fs) {
   bitmap_t bmp;
@@ -1,8 +1,11 @@
 ﻿#include "gtest/gtest.h"
 
 #include "tkc/thread.h"
+#include "tkc/platform.h"
+#include "tkc/time_now.h"
 #include "tkc/socket_pair.h"
 #include "streams/shdlc/iostream_shdlc.h"
+#include "streams/shdlc/ostream_shdlc.h"
 #include "streams/inet/iostream_tcp.h"
 #include "streams/noisy/iostream_noisy.h"
 
@@ -145,3 +148,211 @@ TEST(IOStreamSHDLC, noisy) {
   OBJECT_UNREF(b_io);
   OBJECT_UNREF(b_noisy);
 }
+
+#define WINDOW_DATA_SIZE (16 * 1024)
+#define WINDOW_WRITE_SIZE 256
+
+static uint8_t s_window_sbuff[WINDOW_DATA_SIZE];
+static uint8_t s_window_rbuff[WINDOW_DATA_SIZE];
+
+static void* server_thread_entry_window(void* args) {
+  tk_iostream_t* b_io = TK_IOSTREAM(args);
+  tk_ostream_t* os = tk_iostream_get_ostream(b_io);
+
+  for (uint32_t i = 0; i < WINDOW_DATA_SIZE; i += WINDOW_WRITE_SIZE) {
+    assert(tk_ostream_write(os, s_window_sbuff + i, WINDOW_WRITE_SIZE) == WINDOW_WRITE_SIZE);
+  }
+  assert(tk_ostream_flush(os) == RET_OK);
+
+  return NULL;
+}
+
+/*模拟链路延迟：收到的数据延迟delay_ms后再转发。*/
+typedef struct _relay_t {
+  tk_iostream_t* from;
+  tk_iostream_t* to;
+  uint32_t delay_ms;
+  bool_t quit;
+} relay_t;
+
+static void* relay_thread_entry(void* args) {
+  uint8_t buff[4096];
+  relay_t* relay = (relay_t*)args;
+  tk_istream_t* is = tk_iostream_get_istream(relay->from);
+  tk_ostream_t* os = tk_iostream_get_ostream(relay->to);
+
+  while (!relay->quit) {
+    int32_t n = 0;
+    if (tk_istream_wait_for_data(is, 10) != RET_OK) {
+      continue;
+    }
+
+    n = tk_istream_read(is, buff, sizeof(buff));
+    if (n <= 0) {
+      break;
+    }
+
+    sleep_ms(relay->delay_ms);
+    tk_ostream_write_len(os, buff, n, 3000);
+  }
+
+  return NULL;
+}
+
+/*通过有噪声和延迟的回环连接发送16K数据(每次写256字节)，返回耗时(us)。*/
+static uint64_t transfer_window(uint32_t window_size, uint32_t error_level, uint32_t delay_ms) {
+  int socks_a[2];
+  int socks_b[2];
+  uint64_t start = 0;
+  tk_socketpair(socks_a);
+  tk_socketpair(socks_b);
+  tk_iostream_t* a_tcp = tk_iostream_tcp_create(socks_a[0]);
+  tk_iostream_t* a_io = tk_iostream_shdlc_create(a_tcp);
+  tk_iostream_t* relay_a = tk_iostream_tcp_create(socks_a[1]);
+  tk_iostream_t* relay_b = tk_iostream_tcp_create(socks_b[0]);
+  tk_iostream_t* b_tcp = tk_iostream_tcp_create(socks_b[1]);
+  tk_iostream_t* b_noisy = tk_iostream_noisy_create(b_tcp);
+  tk_iostream_t* b_io = tk_iostream_shdlc_create(b_noisy);
+  tk_istream_t* is = tk_iostream_get_istream(a_io);
+  tk_ostream_t* os = tk_iostream_get_ostream(b_io);
+  relay_t to_a = {relay_b, relay_a, delay_ms, FALSE};
+  relay_t to_b = {relay_a, relay_b, delay_ms, FALSE};
+  tk_thread_t* t = tk_thread_create(server_thread_entry_window, b_io);
+  tk_thread_t* t_to_a = tk_thread_create(relay_thread_entry, &to_a);
+  tk_thread_t* t_to_b = tk_thread_create(relay_thread_entry, &to_b);
+
+  for (uint32_t i = 0; i < WINDOW_DATA_SIZE; i++) {
+    s_window_sbuff[i] = i % 7 == 0 ? random() / 256 : i;
+  }
+  memset(s_window_rbuff, 0x00, sizeof(s_window_rbuff));
+
+  object_set_prop_int(OBJECT(tk_iostream_get_ostream(b_noisy)), TK_OSTREAM_NOISY_PROP_ERROR_LEVEL,
+                      error_level);
+  object_set_prop_int(OBJECT(os), TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE, window_size);
+  tk_thread_start(t_to_a);
+  tk_thread_start(t_to_b);
+
+  start = time_now_us();
+  tk_thread_start(t);
+  EXPECT_EQ(tk_istream_read_len(is, s_window_rbuff, WINDOW_DATA_SIZE, 30000), WINDOW_DATA_SIZE);
+  tk_thread_join(t);
+  start = time_now_us() - start;
+
+  EXPECT_EQ(memcmp(s_window_rbuff, s_window_sbuff, WINDOW_DATA_SIZE), 0);
+  EXPECT_EQ(object_get_prop_bool(OBJECT(os), TK_OSTREAM_SHDLC_PROP_PEER_WINDOW, FALSE), TRUE);
+
+  to_a.quit = TRUE;
+  to_b.quit = TRUE;
+  tk_thread_join(t_to_a);
+  tk_thread_join(t_to_b);
+  tk_thread_destroy(t_to_a);
+  tk_thread_destroy(t_to_b);
+  tk_thread_destroy(t);
+
+  OBJECT_UNREF(a_tcp);
+  OBJECT_UNREF(a_io);
+  OBJECT_UNREF(relay_a);
+  OBJECT_UNREF(relay_b);
+  OBJECT_UNREF(b_tcp);
+  OBJECT_UNREF(b_io);
+  OBJECT_UNREF(b_noisy);
+
+  return start;
+}
+
+TEST(IOStreamSHDLC, window_props) {
+  int socks[2];
+  tk_socketpair(socks);
+  tk_iostream_t* a_tcp = tk_iostream_tcp_create(socks[0]);
+  tk_iostream_t* a_io = tk_iostream_shdlc_create(a_tcp);
+  tk_ostream_t* os = tk_iostream_get_ostream(a_io);
+
+  ASSERT_EQ(object_get_prop_int(OBJECT(os), TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE, 0), 1);
+  ASSERT_EQ(object_set_prop_int(OBJECT(os), TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE, 3), RET_OK);
+  ASSERT_EQ(object_get_prop_int(OBJECT(os), TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE, 0), 3);
+  ASSERT_EQ(object_set_prop_int(OBJECT(os), TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE, 100), RET_OK);
+  ASSERT_EQ(object_get_prop_int(OBJECT(os), TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE, 0),
+            SHDLC_MAX_WINDOW_SIZE);
+  ASSERT_EQ(object_get_prop_bool(OBJECT(os), TK_OSTREAM_SHDLC_PROP_PEER_WINDOW, TRUE), FALSE);
+
+  OBJECT_UNREF(a_tcp);
+  OBJECT_UNREF(a_io);
+  close(socks[1]);
+}
+
+TEST(IOStreamSHDLC, window_throughput) {
+  uint64_t stop_and_wait = transfer_window(1, 5, 2);
+  uint64_t window = transfer_window(SHDLC_MAX_WINDOW_SIZE, 5, 2);
+
+  printf("shdlc 16K over noisy loopback(2ms delay): window=1 %uus, window=%u %uus\n",
+         (uint32_t)stop_and_wait, SHDLC_MAX_WINDOW_SIZE, (uint32_t)window);
+}
+
+TEST(IOStreamSHDLC, window_clean) {
+  transfer_window(SHDLC_MAX_WINDOW_SIZE, 0, 0);
+}
+
+/*旧版本的接收方：忽略reserve位，每个包都回复reserve位为0的ACK。*/
+static void* old_peer_thread_entry(void* args) {
+  wbuffer_t wb;
+  wbuffer_t ack;
+  uint32_t size = 0;
+  uint8_t last_seqno = 0xff;
+  shdlc_header_t header = {0};
+  tk_iostream_t* io = TK_IOSTREAM(args);
+  tk_istream_t* is = tk_iostream_get_istream(io);
+  tk_ostream_t* os = tk_iostream_get_ostream(io);
+
+  wbuffer_init_extendable(&wb);
+  wbuffer_init_extendable(&ack);
+  while (size < sizeof(sbuff)) {
+    if (shdlc_read_data(is, &wb, 3000) != RET_OK) {
+      continue;
+    }
+
+    header.data = wb.data[0];
+    assert(header.s.type == SHDLC_DATA && !header.s.compressed);
+    if (header.s.seqno != last_seqno) {
+      memcpy(rbuff + size, wb.data + 1, wb.cursor - 1);
+      size += wb.cursor - 1;
+      last_seqno = header.s.seqno;
+    }
+
+    shdlc_write_ack(&ack, header.s.seqno);
+    tk_ostream_write_len(os, ack.data, ack.cursor, 3000);
+  }
+  wbuffer_deinit(&wb);
+  wbuffer_deinit(&ack);
+
+  return NULL;
+}
+
+TEST(IOStreamSHDLC, window_old_peer) {
+  int socks[2];
+  tk_socketpair(socks);
+  tk_iostream_t* a_tcp = tk_iostream_tcp_create(socks[0]);
+  tk_iostream_t* b_tcp = tk_iostream_tcp_create(socks[1]);
+  tk_iostream_t* b_io = tk_iostream_shdlc_create(b_tcp);
+  tk_ostream_t* os = tk_iostream_get_ostream(b_io);
+  tk_thread_t* t = tk_thread_create(old_peer_thread_entry, a_tcp);
+
+  gen_data();
+  memset(rbuff, 0x00, sizeof(rbuff));
+  tk_thread_start(t);
+
+  object_set_prop_int(OBJECT(os), TK_STREAM_PROP_COMPRESS_THRESHOLD, 0xffffffff);
+  object_set_prop_int(OBJECT(os), TK_OSTREAM_SHDLC_PROP_WINDOW_SIZE, SHDLC_MAX_WINDOW_SIZE);
+  for (uint32_t i = 0; i < sizeof(sbuff); i += 256) {
+    ASSERT_EQ(tk_ostream_write(os, sbuff + i, 256), 256);
+  }
+  ASSERT_EQ(tk_ostream_flush(os), RET_OK);
+
+  tk_thread_join(t);
+  tk_thread_destroy(t);
+  ASSERT_EQ(memcmp(rbuff, sbuff, sizeof(sbuff)), 0);
+  ASSERT_EQ(object_get_prop_bool(OBJECT(os), TK_OSTREAM_SHDLC_PROP_PEER_WINDOW, TRUE), FALSE);
+
+  OBJECT_UNREF(a_tcp);
+  OBJECT_UNREF(b_tcp);
+  OBJECT_UNREF(b_io);
+}
@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include "base/window.h"
+#include "base/layout.h"
+#include "widgets/view.h"
+#include "widgets/button.h"
+
+TEST(Layout, need_relayout) {
+  widget_t* w = window_create(NULL, 0, 0, 400, 300);
+  widget_t* v1 = view_create(w, 0, 0, 0, 0);
+  widget_t* b1 = button_create(v1, 0, 0, 0, 0);
+
+  ASSERT_TRUE(b1->need_relayout);
+  ASSERT_EQ(widget_layout(w), RET_OK);
+  ASSERT_FALSE(w->need_relayout);
+  ASSERT_FALSE(w->child_need_relayout);
+  ASSERT_FALSE(v1->need_relayout);
+  ASSERT_FALSE(b1->need_relayout);
+
+  /*父控件没有children_layout，只标记控件本身。*/
+  widget_set_need_relayout(b1);
+  ASSERT_TRUE(b1->need_relayout);
+  ASSERT_FALSE(v1->need_relayout);
+  ASSERT_TRUE(v1->child_need_relayout);
+  ASSERT_TRUE(w->child_need_relayout);
+  ASSERT_FALSE(w->need_relayout);
+  ASSERT_TRUE(WINDOW_BASE(w)->need_relayout);
+
+  /*父控件的布局依赖子控件，父控件也需要重新布局。*/
+  widget_layout(w);
+  widget_set_children_layout(v1, "default(r=1,c=0)");
+  ASSERT_TRUE(v1->need_relayout);
+  widget_layout(w);
+  widget_resize(b1, 10, 10);
+  ASSERT_TRUE(b1->need_relayout);
+  ASSERT_TRUE(v1->need_relayout);
+  ASSERT_FALSE(w->need_relayout);
+
+  widget_destroy(w);
+}
+
+TEST(Layout, if_needed) {
+  widget_t* w = window_create(NULL, 0, 0, 400, 300);
+  widget_t* root = view_create(w, 0, 0, 400, 300);
+  widget_t* v1 = view_create(root, 0, 0, 0, 0);
+  widget_t* v2 = view_create(root, 0, 0, 0, 0);
+  widget_t* b1 = button_create(v1, 0, 0, 0, 0);
+  widget_t* b2 = button_create(v2, 0, 0, 0, 0);
+
+  widget_set_self_layout_params(v1, "0", "0", "50%", "100%");
+  widget_set_self_layout_params(v2, "50%", "0", "50%", "100%");
+  widget_set_children_layout(v1, "default(r=1,c=1)");
+  widget_set_children_layout(v2, "default(r=1,c=1)");
+  ASSERT_EQ(widget_layout_if_needed(root), RET_OK);
+  ASSERT_EQ(b1->w, 200);
+  ASSERT_EQ(b2->w, 200);
+  ASSERT_EQ(b2->h, 300);
+
+  /*widget_move不需要重新布局，用来检查没有标记的子树是否被跳过。*/
+  widget_move(b1, 10, 10);
+  widget_set_children_layout(v2, "default(r=2,c=1)");
+  ASSERT_FALSE(v1->need_relayout);
+  ASSERT_FALSE(v1->child_need_relayout);
+  ASSERT_EQ(widget_layout_if_needed(root), RET_OK);
+  ASSERT_EQ(b1->x, 10);
+  ASSERT_EQ(b2->w, 200);
+  ASSERT_EQ(b2->h, 150);
+  ASSERT_FALSE(v2->need_relayout);
+  ASSERT_FALSE(root->child_need_relayout);
+
+  /*被标记的控件重新执行自身的布局。*/
+  widget_resize(v2, 100, 100);
+  ASSERT_TRUE(v2->need_relayout);
+  ASSERT_EQ(widget_layout_if_needed(root), RET_OK);
+  ASSERT_EQ(v2->w, 200);
+  ASSERT_EQ(b2->h, 150);
+  ASSERT_EQ(b1->x, 10);
+
+  /*显式调用widget_layout时布局全部控件。*/
+  ASSERT_EQ(widget_layout(root), RET_OK);
+  ASSERT_EQ(b1->x, 0);
+
+  widget_destroy(w);
+}
+
+TEST(Layout, if_needed_visible) {
+  widget_t* w = window_create(NULL, 0, 0, 400, 300);
+  widget_t* v1 = view_create(w, 0, 0, 400, 300);
+  widget_t* b1 = button_create(v1, 0, 0, 0, 100);
+  widget_t* b2 = button_create(v1, 0, 0, 0, 100);
+
+  widget_set_children_layout(v1, "default(r=0,c=1)");
+  widget_layout(v1);
+  ASSERT_EQ(b1->w, 400);
+  ASSERT_EQ(b2->y, 100);
+
+  widget_set_visible(b1, FALSE);
+  ASSERT_TRUE(v1->need_relayout);
+  ASSERT_EQ(widget_layout_if_needed(v1), RET_OK);
+  ASSERT_EQ(b2->y, 0);
+  ASSERT_EQ(b2->w, 400);
+
+  widget_destroy(w);
+}
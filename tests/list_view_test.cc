@@ -1,12 +1,20 @@
-﻿#include "scroll_view/list_view.h"
+﻿#include "tkc/utils.h"
+#include "scroll_view/list_view.h"
+#include "scroll_view/list_item.h"
+#include "scroll_view/scroll_bar.h"
+#include "scroll_view/scroll_view.h"
 #include "base/canvas.h"
 #include "base/widget.h"
 #include "base/layout.h"
 #include "widgets/button.h"
+#include "base/window.h"
 #include "font_dummy.h"
 #include "lcd_log.h"
 #include "gtest/gtest.h"
 #include <stdlib.h>
+#include <string>
+
+using std::string;
 
 TEST(ListView, basic) {
   value_t v1;
@@ -37,3 +45,108 @@ TEST(ListView, cast) {
 
   widget_destroy(w);
 }
+
+typedef struct _virtual_data_t {
+  uint32_t nr;
+  uint32_t bind_times;
+} virtual_data_t;
+
+static uint32_t virtual_data_get_items_nr(void* ctx) {
+  return ((virtual_data_t*)ctx)->nr;
+}
+
+static ret_t virtual_data_bind_item(void* ctx, widget_t* item, uint32_t index) {
+  char text[32];
+  virtual_data_t* data = (virtual_data_t*)ctx;
+
+  data->bind_times++;
+  tk_snprintf(text, sizeof(text), "%u", index);
+
+  return widget_set_text_utf8(item, text);
+}
+
+static string item_text(widget_t* item) {
+  char text[32];
+  widget_get_text_utf8(item, text, sizeof(text));
+
+  return string(text);
+}
+
+static uint32_t count_visible_items(widget_t* scroll_view) {
+  uint32_t visible_nr = 0;
+
+  WIDGET_FOR_EACH_CHILD_BEGIN(scroll_view, iter, i)
+  if (iter->visible) {
+    visible_nr++;
+  }
+  WIDGET_FOR_EACH_CHILD_END()
+
+  return visible_nr;
+}
+
+TEST(ListView, virtual_items) {
+  widget_t* item = NULL;
+  virtual_data_t data = {10000, 0};
+  widget_t* win = window_create(NULL, 0, 0, 200, 400);
+  widget_t* widget = list_view_create(win, 0, 0, 200, 400);
+  widget_t* scroll_view = scroll_view_create(widget, 0, 0, 200, 400);
+  list_view_t* list_view = LIST_VIEW(widget);
+
+  scroll_bar_create_mobile(widget, 190, 0, 10, 400);
+  list_item_create(scroll_view, 0, 0, 0, 40);
+  button_create(scroll_view, 0, 0, 0, 40);
+  list_view_set_item_height(widget, 40);
+
+  ASSERT_EQ(list_view_set_data_source(widget, virtual_data_get_items_nr, virtual_data_bind_item,
+                                      &data),
+            RET_OK);
+  ASSERT_EQ(list_view->items_nr, 10000u);
+  ASSERT_EQ(widget_count_children(scroll_view), 0);
+
+  /*可见10行，另外保留TK_LIST_VIEW_VIRTUAL_MARGIN_ROWS行。*/
+  widget_layout_children(widget);
+  ASSERT_EQ(SCROLL_VIEW(scroll_view)->virtual_h, 10000 * 40);
+  ASSERT_EQ(widget_count_children(scroll_view), 10 + 1 + TK_LIST_VIEW_VIRTUAL_MARGIN_ROWS);
+  ASSERT_EQ(data.bind_times, 10u + 1 + TK_LIST_VIEW_VIRTUAL_MARGIN_ROWS);
+
+  item = widget_get_child(scroll_view, 5);
+  ASSERT_EQ(item->y, 5 * 40);
+  ASSERT_EQ(item->w, 200);
+  ASSERT_EQ(item->h, 40);
+  ASSERT_EQ(item_text(item), string("5"));
+  ASSERT_EQ(list_view_get_item_index(widget, item), 5);
+
+  /*滚动一行，只绑定新出现的行。*/
+  data.bind_times = 0;
+  widget_set_prop_int(scroll_view, WIDGET_PROP_YOFFSET, 40);
+  ASSERT_EQ(data.bind_times, 1u);
+  ASSERT_EQ(item_text(item), string("5"));
+
+  /*跳到中间，列表项的个数不随数据个数增加。*/
+  data.bind_times = 0;
+  widget_set_prop_int(scroll_view, WIDGET_PROP_YOFFSET, 40000);
+  ASSERT_EQ(widget_count_children(scroll_view), 10 + 1 + 2 * TK_LIST_VIEW_VIRTUAL_MARGIN_ROWS);
+  ASSERT_EQ(data.bind_times, 10u + 1 + 2 * TK_LIST_VIEW_VIRTUAL_MARGIN_ROWS);
+
+  item = widget_get_child(scroll_view, 1000 % widget_count_children(scroll_view));
+  ASSERT_EQ(item->y, 40000);
+  ASSERT_EQ(item_text(item), string("1000"));
+  ASSERT_EQ(list_view_get_item_index(widget, item), 1000);
+
+  data.bind_times = 0;
+  widget_set_prop_int(scroll_view, WIDGET_PROP_YOFFSET, 40040);
+  ASSERT_EQ(data.bind_times, 1u);
+
+  /*数据变少后重新加载。*/
+  data.nr = 5;
+  ASSERT_EQ(list_view_reload(widget), RET_OK);
+  widget_layout_children(widget);
+  ASSERT_EQ(SCROLL_VIEW(scroll_view)->yoffset, 0);
+  ASSERT_EQ(count_visible_items(scroll_view), 5u);
+
+  ASSERT_EQ(list_view_set_data_source(widget, NULL, NULL, NULL), RET_OK);
+  ASSERT_EQ(list_view->items_nr, 0u);
+  ASSERT_EQ(widget_count_children(scroll_view), 0);
+
+  widget_destroy(win);
+}
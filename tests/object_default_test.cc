@@ -595,3 +595,33 @@ TEST(ObjectDefault, sub) {
   object_unref(a);
   object_unref(b);
 }
+
+TEST(ObjectDefault, get_prop_by_slot) {
+  value_t v;
+  int32_t slot = -1;
+  object_t* obj = object_default_create();
+
+  ASSERT_EQ(object_default_get_prop_by_slot(obj, "b", &v, &slot), RET_NOT_FOUND);
+  ASSERT_EQ(slot, -1);
+
+  object_set_prop_int(obj, "b", 2);
+  ASSERT_EQ(object_default_get_prop_by_slot(obj, "b", &v, &slot), RET_OK);
+  ASSERT_EQ(value_int(&v), 2);
+  ASSERT_EQ(slot, 0);
+
+  object_set_prop_int(obj, "a", 1);
+  ASSERT_EQ(object_default_get_prop_by_slot(obj, "b", &v, &slot), RET_OK);
+  ASSERT_EQ(value_int(&v), 2);
+  ASSERT_EQ(slot, 1);
+
+  object_set_prop_int(obj, "b", 3);
+  ASSERT_EQ(object_default_get_prop_by_slot(obj, "b", &v, &slot), RET_OK);
+  ASSERT_EQ(value_int(&v), 3);
+
+  ASSERT_EQ(object_remove_prop(obj, "b"), RET_OK);
+  ASSERT_EQ(object_default_get_prop_by_slot(obj, "b", &v, &slot), RET_NOT_FOUND);
+  ASSERT_EQ(object_default_get_prop_by_slot(obj, OBJECT_PROP_SIZE, &v, &slot), RET_OK);
+  ASSERT_EQ(value_int(&v), 1);
+
+  object_unref(obj);
+}
@@ -32,6 +32,34 @@ TEST(progress_bar, basic) {
   widget_destroy(s);
 }
 
+TEST(progress_bar, by_id) {
+  value_t v1;
+  value_t v2;
+  widget_t* s = progress_bar_create(NULL, 10, 20, 30, 40);
+
+  value_set_int(&v1, 20);
+  ASSERT_EQ(widget_set_prop_by_id(s, WIDGET_PROP_ID_VALUE, &v1), RET_OK);
+  ASSERT_EQ(widget_get_prop(s, WIDGET_PROP_VALUE, &v2), RET_OK);
+  ASSERT_EQ(value_int(&v1), value_int(&v2));
+  ASSERT_EQ(widget_get_prop_by_id(s, WIDGET_PROP_ID_VALUE, &v2), RET_OK);
+  ASSERT_EQ(value_int(&v1), value_int(&v2));
+
+  value_set_int(&v1, 200);
+  ASSERT_EQ(widget_set_prop_by_id(s, WIDGET_PROP_ID_MAX, &v1), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(s, WIDGET_PROP_MAX, 0), 200);
+
+  value_set_bool(&v1, TRUE);
+  ASSERT_EQ(widget_set_prop(s, WIDGET_PROP_SHOW_TEXT, &v1), RET_OK);
+  ASSERT_EQ(widget_get_prop_by_id(s, WIDGET_PROP_ID_SHOW_TEXT, &v2), RET_OK);
+  ASSERT_EQ(value_bool(&v2), TRUE);
+
+  value_set_int(&v1, 5);
+  ASSERT_EQ(widget_set_prop_by_id(s, WIDGET_PROP_ID_X, &v1), RET_OK);
+  ASSERT_EQ(s->x, 5);
+
+  widget_destroy(s);
+}
+
 TEST(progress_bar, max) {
   value_t v1;
   value_t v2;
@@ -1,4 +1,10 @@
-﻿#include "base/window.h"
+﻿#include "tkc/str.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "base/window.h"
+#include "base/canvas.h"
+#include "base/font_manager.h"
+#include "lcd/lcd_mem_rgba8888.h"
 #include "rich_text/rich_text.h"
 #include "gtest/gtest.h"
 
@@ -10,3 +16,139 @@ TEST(RichText, cast) {
 
   widget_destroy(w);
 }
+
+static void rich_text_check_same_layout(widget_t* w1, widget_t* w2) {
+  uint32_t i = 0;
+  rich_text_t* r1 = RICH_TEXT(w1);
+  rich_text_t* r2 = RICH_TEXT(w2);
+  rich_text_render_node_t* iter1 = r1->render_node;
+  rich_text_render_node_t* iter2 = r2->render_node;
+
+  ASSERT_EQ(r1->content_h, r2->content_h);
+  while (iter1 != NULL && iter2 != NULL) {
+    ASSERT_EQ(iter1->rect.x, iter2->rect.x);
+    ASSERT_EQ(iter1->rect.y, iter2->rect.y);
+    ASSERT_EQ(iter1->rect.w, iter2->rect.w);
+    ASSERT_EQ(iter1->rect.h, iter2->rect.h);
+    ASSERT_EQ(iter1->size, iter2->size);
+    ASSERT_EQ(iter1->align_h_w, iter2->align_h_w);
+    ASSERT_EQ(iter1->node->type, iter2->node->type);
+    if (iter1->node->type == RICH_TEXT_TEXT) {
+      ASSERT_EQ(wcsncmp(iter1->text, iter2->text, iter1->size), 0);
+      ASSERT_TRUE(iter1->text >= iter1->node->u.text.text);
+    }
+
+    iter1 = iter1->next;
+    iter2 = iter2->next;
+  }
+  ASSERT_TRUE(iter1 == NULL && iter2 == NULL);
+
+  ASSERT_EQ(r1->rows.size, r2->rows.size);
+  for (i = 0; i < r1->rows.size; i++) {
+    iter1 = (rich_text_render_node_t*)(r1->rows.elms[i]);
+    iter2 = (rich_text_render_node_t*)(r2->rows.elms[i]);
+    ASSERT_EQ(iter1->rect.y, iter2->rect.y);
+    if (i > 0) {
+      iter2 = (rich_text_render_node_t*)(r1->rows.elms[i - 1]);
+      ASSERT_GT(iter1->rect.y, iter2->rect.y + iter2->rect.h - 1);
+    }
+  }
+}
+
+TEST(RichText, append) {
+  str_t str;
+  canvas_t c;
+  uint32_t i = 0;
+  lcd_t* lcd = lcd_mem_rgba8888_create(320, 240, TRUE);
+  widget_t* win = window_create(NULL, 0, 0, 320, 240);
+  widget_t* w1 = rich_text_create(win, 0, 0, 200, 100);
+  widget_t* w2 = rich_text_create(win, 0, 0, 200, 100);
+  rich_text_render_node_t* head = NULL;
+
+  str_init(&str, 1000);
+  canvas_init(&c, lcd, font_manager());
+  for (i = 0; i < 60; i++) {
+    char line[128];
+    if (i % 7 == 3) {
+      tk_snprintf(line, sizeof(line), "<font color=\"red\" size=\"20\">error %u</font>\n", i);
+    } else if (i % 11 == 5) {
+      tk_snprintf(line, sizeof(line), "%u: \u4e2d\u6587\uff0c\u6362\u884c\u6d4b\u8bd5", i);
+    } else {
+      tk_snprintf(line, sizeof(line), "%u: the quick brown fox jumps over the lazy dog\n", i);
+    }
+    str_append(&str, line);
+
+    rich_text_set_text(w1, str.str);
+    widget_paint(w1, &c);
+    rich_text_set_text(w2, str.str);
+    widget_paint(w2, &c);
+    rich_text_check_same_layout(w1, w2);
+
+    if (head != NULL) {
+      /*前面的行没有重新排版。*/
+      ASSERT_TRUE(RICH_TEXT(w1)->render_node == head);
+      ASSERT_EQ(RICH_TEXT(w1)->yoffset, 20);
+    }
+    if (RICH_TEXT(w1)->rows.size > 2) {
+      head = RICH_TEXT(w1)->render_node;
+    }
+    widget_set_prop_int(w1, WIDGET_PROP_YOFFSET, 20);
+  }
+  ASSERT_TRUE(head != NULL);
+
+  /*不是追加的内容，重新排版。*/
+  rich_text_set_text(w1, "<font size=\"20\">hello</font> awtk");
+  widget_paint(w1, &c);
+  rich_text_set_text(w2, "<font size=\"20\">hello</font> awtk");
+  widget_paint(w2, &c);
+  rich_text_check_same_layout(w1, w2);
+  ASSERT_EQ(RICH_TEXT(w1)->yoffset, 0);
+
+  widget_destroy(win);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+  str_reset(&str);
+}
+
+TEST(RichText, append_perf) {
+  str_t str;
+  canvas_t c;
+  uint32_t i = 0;
+  uint64_t start = 0;
+  uint64_t full_cost = 0;
+  uint64_t append_cost = 0;
+  lcd_t* lcd = lcd_mem_rgba8888_create(320, 240, TRUE);
+  widget_t* win = window_create(NULL, 0, 0, 320, 240);
+  widget_t* w1 = rich_text_create(win, 0, 0, 300, 200);
+  widget_t* w2 = rich_text_create(win, 0, 0, 300, 200);
+
+  str_init(&str, 100000);
+  canvas_init(&c, lcd, font_manager());
+  for (i = 0; i < 500; i++) {
+    str_append(&str, "2021-06-20 12:00:00 [info] the quick brown fox jumps over the lazy dog\n");
+  }
+  rich_text_set_text(w1, str.str);
+  widget_paint(w1, &c);
+
+  start = time_now_us();
+  for (i = 0; i < 20; i++) {
+    str_append(&str, "2021-06-20 12:00:01 [warn] appended line\n");
+    rich_text_set_text(w1, str.str);
+    widget_paint(w1, &c);
+  }
+  append_cost = time_now_us() - start;
+
+  start = time_now_us();
+  rich_text_set_text(w2, str.str);
+  widget_paint(w2, &c);
+  full_cost = time_now_us() - start;
+  rich_text_check_same_layout(w1, w2);
+
+  log_debug("rich_text %u chars: full layout %uus, append %uus/20\n", w1->text.size,
+            (uint32_t)full_cost, (uint32_t)append_cost);
+
+  widget_destroy(win);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+  str_reset(&str);
+}
@@ -1,5 +1,6 @@
 ﻿#include "tkc/rlog.h"
 #include "tkc/mem.h"
+#include "tkc/time_now.h"
 #include "gtest/gtest.h"
 
 TEST(RLog, basic) {
@@ -33,3 +34,158 @@ TEST(RLog, basic1) {
   ASSERT_EQ(memcmp(data, "hello wolrd 0960", strlen("hello wolrd 0960")), 0);
   TKMEM_FREE(data);
 }
+
+TEST(RLog, async_basic1) {
+  uint32_t i = 0;
+  uint32_t size = 0;
+  char* data = NULL;
+  fs_remove_file(os_fs(), "tests/testdata/0.log");
+  fs_remove_file(os_fs(), "tests/testdata/1.log");
+  rlog_t* log = rlog_create_async("tests/testdata/%d.log", 1024, 64, 128, TRUE);
+  ASSERT_EQ(log != NULL, true);
+  for (i = 0; i < 1000; i++) {
+    ASSERT_EQ(rlog_print(log, "hello wolrd %04d\n", i), RET_OK);
+  }
+  ASSERT_EQ(rlog_flush(log), RET_OK);
+  ASSERT_EQ(log->index, 1);
+  ASSERT_EQ(log->dropped, 0);
+  rlog_destroy(log);
+
+  /*切换文件的时机与同步模式相同。*/
+  data = (char*)file_read("tests/testdata/0.log", &size);
+  ASSERT_EQ(memcmp(data, "hello wolrd 0900", strlen("hello wolrd 0900")), 0);
+  TKMEM_FREE(data);
+
+  data = (char*)file_read("tests/testdata/1.log", &size);
+  ASSERT_EQ(memcmp(data, "hello wolrd 0960", strlen("hello wolrd 0960")), 0);
+  TKMEM_FREE(data);
+}
+
+#define RLOG_THREAD_NR 4
+#define RLOG_LINE_NR 2000
+#define RLOG_LINE "0123456789012345678901234567890\n"
+
+static void* rlog_write_lines(void* args) {
+  uint32_t i = 0;
+  rlog_t* log = (rlog_t*)args;
+
+  for (i = 0; i < RLOG_LINE_NR; i++) {
+    rlog_write(log, RLOG_LINE);
+  }
+
+  return NULL;
+}
+
+static uint32_t rlog_write_in_threads(rlog_t* log) {
+  uint32_t i = 0;
+  uint64_t start = time_now_ms();
+  tk_thread_t* threads[RLOG_THREAD_NR];
+
+  for (i = 0; i < RLOG_THREAD_NR; i++) {
+    threads[i] = tk_thread_create(rlog_write_lines, log);
+    tk_thread_start(threads[i]);
+  }
+
+  for (i = 0; i < RLOG_THREAD_NR; i++) {
+    tk_thread_join(threads[i]);
+    tk_thread_destroy(threads[i]);
+  }
+
+  return (uint32_t)(time_now_ms() - start);
+}
+
+static void rlog_test_threads(bool_t async, bool_t block_when_full) {
+  uint32_t cost = 0;
+  uint32_t dropped = 0;
+  fs_stat_info_t st;
+  rlog_t* log = NULL;
+  uint32_t total = RLOG_THREAD_NR * RLOG_LINE_NR * strlen(RLOG_LINE);
+
+  fs_remove_file(os_fs(), "tests/testdata/0.log");
+  fs_remove_file(os_fs(), "tests/testdata/1.log");
+  if (async) {
+    log = rlog_create_async("tests/testdata/%d.log", total * 2, 64, 1024, block_when_full);
+  } else {
+    log = rlog_create("tests/testdata/%d.log", total * 2, 64);
+  }
+  ASSERT_EQ(log != NULL, true);
+
+  cost = rlog_write_in_threads(log);
+  dropped = log->dropped;
+  rlog_destroy(log);
+
+  ASSERT_EQ(fs_stat(os_fs(), "tests/testdata/0.log", &st), RET_OK);
+  ASSERT_EQ(st.size + dropped * strlen(RLOG_LINE), total);
+  if (block_when_full) {
+    ASSERT_EQ(dropped, 0);
+  }
+
+  log_debug("rlog async=%d block=%d: %u lines cost %ums dropped=%u\n", async, block_when_full,
+            RLOG_THREAD_NR * RLOG_LINE_NR, cost, dropped);
+}
+
+TEST(RLog, threads) {
+  rlog_test_threads(FALSE, TRUE);
+  rlog_test_threads(TRUE, TRUE);
+  rlog_test_threads(TRUE, FALSE);
+}
+
+static void* rlog_write_and_flush(void* args) {
+  uint32_t i = 0;
+  rlog_t* log = (rlog_t*)args;
+
+  for (i = 0; i < RLOG_LINE_NR / 10; i++) {
+    rlog_write(log, RLOG_LINE);
+    if ((i % 10) == 0) {
+      rlog_flush(log);
+    }
+  }
+  rlog_flush(log);
+
+  return NULL;
+}
+
+TEST(RLog, flush_in_threads) {
+  uint32_t i = 0;
+  fs_stat_info_t st;
+  tk_thread_t* threads[RLOG_THREAD_NR];
+  uint32_t total = RLOG_THREAD_NR * (RLOG_LINE_NR / 10) * strlen(RLOG_LINE);
+  rlog_t* log = NULL;
+
+  fs_remove_file(os_fs(), "tests/testdata/0.log");
+  fs_remove_file(os_fs(), "tests/testdata/1.log");
+  log = rlog_create_async("tests/testdata/%d.log", total * 2, 64, 128, TRUE);
+  ASSERT_EQ(log != NULL, true);
+
+  /*队列满时写日志的线程和flush的线程同时等待，都要能被唤醒。*/
+  for (i = 0; i < RLOG_THREAD_NR; i++) {
+    threads[i] = tk_thread_create(rlog_write_and_flush, log);
+    tk_thread_start(threads[i]);
+  }
+
+  for (i = 0; i < RLOG_THREAD_NR; i++) {
+    tk_thread_join(threads[i]);
+    tk_thread_destroy(threads[i]);
+  }
+
+  ASSERT_EQ(log->dropped, 0);
+  rlog_destroy(log);
+
+  ASSERT_EQ(fs_stat(os_fs(), "tests/testdata/0.log", &st), RET_OK);
+  ASSERT_EQ(st.size, total);
+}
+
+TEST(RLog, async_too_long) {
+  char str[256];
+  rlog_t* log = rlog_create_async("tests/testdata/%d.log", 1024, 64, 128, FALSE);
+  ASSERT_EQ(log != NULL, true);
+
+  memset(str, 'a', sizeof(str) - 1);
+  str[sizeof(str) - 1] = '\0';
+  ASSERT_EQ(rlog_write(log, str), RET_BAD_PARAMS);
+  ASSERT_EQ(rlog_write(log, ""), RET_OK);
+  ASSERT_EQ(rlog_flush(log), RET_OK);
+  rlog_destroy(log);
+
+  ASSERT_EQ(rlog_create_async("tests/testdata/%d.log", 1024, 64, 64, FALSE) == NULL, true);
+}
@@ -1,4 +1,8 @@
 ﻿#include "base/window.h"
+#include "base/canvas.h"
+#include "base/font_manager.h"
+#include "base/image_manager.h"
+#include "lcd/lcd_mem_rgba8888.h"
 #include "svg_image/svg_image.h"
 #include "gtest/gtest.h"
 
@@ -26,3 +30,75 @@ TEST(SvgImage, cast) {
 
   widget_destroy(w);
 }
+
+static uint32_t svg_image_paint_diff(widget_t* img, uint32_t* max_diff) {
+  canvas_t c;
+  uint32_t i = 0;
+  uint32_t nr = 0;
+  uint32_t painted = 0;
+  lcd_t* lcd1 = lcd_mem_rgba8888_create(100, 100, TRUE);
+  lcd_t* lcd2 = lcd_mem_rgba8888_create(100, 100, TRUE);
+  uint32_t raster_max_size = image_manager()->raster_max_size;
+  uint8_t* p1 = ((lcd_mem_t*)lcd1)->offline_fb;
+  uint8_t* p2 = ((lcd_mem_t*)lcd2)->offline_fb;
+
+  canvas_init(&c, lcd1, font_manager());
+  canvas_begin_frame(&c, NULL, LCD_DRAW_NORMAL);
+  widget_paint(img, &c);
+  canvas_end_frame(&c);
+  canvas_reset(&c);
+
+  image_manager_set_raster_cache_max_size(image_manager(), 0);
+  canvas_init(&c, lcd2, font_manager());
+  canvas_begin_frame(&c, NULL, LCD_DRAW_NORMAL);
+  widget_paint(img, &c);
+  canvas_end_frame(&c);
+  canvas_reset(&c);
+  image_manager_set_raster_cache_max_size(image_manager(), raster_max_size);
+
+  *max_diff = 0;
+  for (i = 0; i < 100 * 100 * 4; i++) {
+    uint32_t d = p1[i] > p2[i] ? p1[i] - p2[i] : p2[i] - p1[i];
+    if (d > 8) {
+      nr++;
+    }
+    if (p2[i] != 0) {
+      painted++;
+    }
+    *max_diff = tk_max(*max_diff, d);
+  }
+
+  lcd_destroy(lcd1);
+  lcd_destroy(lcd2);
+
+  return painted > 0 ? nr : 0xffffffff;
+}
+
+TEST(SvgImage, raster_cache) {
+  uint32_t nr = 0;
+  uint32_t max_diff = 0;
+  uint32_t hits = 0;
+  image_manager_t* imm = image_manager();
+  widget_t* w = window_create(NULL, 0, 0, 0, 0);
+  widget_t* img = svg_image_create(w, 0, 0, 100, 100);
+
+  image_manager_unload_all(imm);
+  svg_image_set_image(img, "ball");
+  nr = svg_image_paint_diff(img, &max_diff);
+  ASSERT_LT(nr, 100u * 100u * 4u / 100u);
+  ASSERT_GT(imm->raster_mem_size, 0u);
+
+  /*再次绘制时使用缓存的位图。*/
+  hits = imm->cache_hits;
+  svg_image_paint_diff(img, &max_diff);
+  ASSERT_EQ(imm->cache_hits, hits + 1);
+
+  /*旋转时按矢量图绘制。*/
+  image_manager_unload_all(imm);
+  image_set_rotation(img, 0.5f);
+  svg_image_paint_diff(img, &max_diff);
+  ASSERT_EQ(imm->raster_mem_size, 0u);
+  ASSERT_EQ(max_diff, 0u);
+
+  widget_destroy(w);
+}
@@ -1,4 +1,5 @@
 ﻿#include "tkc/str.h"
+#include "tkc/time_now.h"
 #include "gtest/gtest.h"
 #include "mledit/mledit.h"
 #include "base/text_edit.h"
@@ -150,3 +151,165 @@ TEST(TextEdit, get_rows_line) {
   canvas_reset(&c);
   lcd_destroy(lcd);
 }
+
+static void text_edit_check_same_as_full_layout(text_edit_t* text_edit, widget_t* w) {
+  uint32_t i = 0;
+  text_edit_state_t s1;
+  text_edit_state_t s2;
+  text_edit_t* full = text_edit_create(w, FALSE);
+  const uint32_t* lines1 = NULL;
+  const uint32_t* lines2 = NULL;
+
+  text_edit_set_max_rows(full, 1000);
+  text_edit_set_cursor(full, text_edit_get_cursor(text_edit));
+  text_edit_layout(full);
+  text_edit_get_state(text_edit, &s1);
+  text_edit_get_state(full, &s2);
+  ASSERT_EQ(s1.rows, s2.rows);
+  ASSERT_EQ(s1.cursor, s2.cursor);
+  ASSERT_EQ(s1.caret.x, s2.caret.x);
+  ASSERT_EQ(s1.caret.y, s2.caret.y);
+  ASSERT_EQ(s1.virtual_h, s2.virtual_h);
+
+  lines1 = text_edit_get_lines_of_each_row(text_edit);
+  lines2 = text_edit_get_lines_of_each_row(full);
+  for (i = 0; i < s1.rows; i++) {
+    ASSERT_EQ(lines1[i], lines2[i]);
+  }
+
+  for (i = 0; i <= w->text.size; i += 3) {
+    ASSERT_EQ(text_edit_get_height(text_edit, i), text_edit_get_height(full, i));
+  }
+
+  text_edit_destroy(full);
+}
+
+TEST(TextEdit, incremental_layout) {
+  canvas_t c;
+  uint32_t i = 0;
+  lcd_t* lcd = lcd_mem_rgba8888_create(150, 150, TRUE);
+  const wchar_t chars[] = L"ab cd\n\u4e2d\uff0c.";
+  widget_t* win = window_create(NULL, 0, 0, 0, 0);
+  widget_t* w = mledit_create(win, 10, 20, 100, 100);
+  text_edit_t* text_edit = text_edit_create(w, FALSE);
+
+  srand(1234);
+  canvas_init(&c, lcd, font_manager());
+  widget_set_prop_pointer(win, WIDGET_PROP_CANVAS, &c);
+  text_edit_set_max_rows(text_edit, 1000);
+  widget_set_text_utf8(w, "hello world\nit is ok\n\nthe last line is a little longer than others");
+  text_edit_set_canvas(text_edit, widget_get_canvas(w));
+  text_edit_check_same_as_full_layout(text_edit, w);
+
+  for (i = 0; i < 300; i++) {
+    uint32_t k = 0;
+    wchar_t str[8];
+    uint32_t len = rand() % 8;
+    uint32_t pos = rand() % (w->text.size + 1);
+
+    for (k = 0; k < len; k++) {
+      str[k] = chars[rand() % (ARRAY_SIZE(chars) - 1)];
+    }
+
+    switch (rand() % 4) {
+      case 0: {
+        /*通过编辑器插入*/
+        text_edit_set_cursor(text_edit, pos);
+        if (len > 0) {
+          text_edit_paste(text_edit, str, len);
+        }
+        break;
+      }
+      case 1: {
+        /*通过编辑器删除*/
+        text_edit_set_select(text_edit, pos, pos + len);
+        text_edit_cut(text_edit);
+        text_edit_layout(text_edit);
+        break;
+      }
+      case 2: {
+        /*直接修改控件的文本*/
+        if (len > 0 && pos < w->text.size) {
+          wstr_remove(&(w->text), pos, len);
+        }
+        if (len > 0 && w->text.size < 600) {
+          wstr_insert(&(w->text), tk_min(pos, w->text.size), str, len);
+        }
+        text_edit_invalidate_layout(text_edit);
+        text_edit_set_cursor(text_edit, tk_min(pos, w->text.size));
+        text_edit_layout(text_edit);
+        break;
+      }
+      default: {
+        /*只移动光标*/
+        text_edit_set_cursor(text_edit, pos);
+        break;
+      }
+    }
+
+    text_edit_check_same_as_full_layout(text_edit, w);
+    if (HasFatalFailure()) {
+      break;
+    }
+  }
+
+  widget_set_prop_pointer(win, WIDGET_PROP_CANVAS, NULL);
+  widget_destroy(win);
+  text_edit_destroy(text_edit);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+TEST(TextEdit, incremental_layout_perf) {
+  canvas_t c;
+  str_t str;
+  uint32_t i = 0;
+  uint64_t start = 0;
+  uint64_t full_cost = 0;
+  uint64_t incremental_cost = 0;
+  const uint32_t rows = 900;
+  lcd_t* lcd = lcd_mem_rgba8888_create(800, 480, TRUE);
+  widget_t* win = window_create(NULL, 0, 0, 0, 0);
+  widget_t* w = mledit_create(win, 0, 0, 400, 400);
+  text_edit_t* text_edit = text_edit_create(w, FALSE);
+
+  mledit_set_max_lines(w, 1000);
+  str_init(&str, 100000);
+  for (i = 0; i < rows; i++) {
+    str_append(&str, "2021-06-20 12:00:00 [info] the quick brown fox jumps over the lazy dog\n");
+  }
+
+  canvas_init(&c, lcd, font_manager());
+  widget_set_prop_pointer(win, WIDGET_PROP_CANVAS, &c);
+  /*行数正好用完，没有多余的行时也只重新排版修改过的行。*/
+  text_edit_set_max_rows(text_edit, rows);
+  widget_set_text_utf8(w, str.str);
+  text_edit_set_canvas(text_edit, widget_get_canvas(w));
+
+  start = time_now_us();
+  for (i = 0; i < 5; i++) {
+    text_edit_set_max_rows(text_edit, rows);
+    text_edit_layout(text_edit);
+  }
+  full_cost = time_now_us() - start;
+
+  start = time_now_us();
+  for (i = 0; i < 50; i++) {
+    text_edit_set_cursor(text_edit, w->text.size / 2 + i);
+    text_edit_paste(text_edit, L"x", 1);
+  }
+  incremental_cost = time_now_us() - start;
+  text_edit_check_same_as_full_layout(text_edit, w);
+
+  log_debug("text_edit layout %u chars: full %uus/5, insert char %uus/50\n", w->text.size,
+            (uint32_t)full_cost, (uint32_t)incremental_cost);
+  /*50次插入的时间比5次全部排版少，全部重新排版时是它的10倍。*/
+  ASSERT_LT(incremental_cost, full_cost);
+
+  widget_set_prop_pointer(win, WIDGET_PROP_CANVAS, NULL);
+  widget_destroy(win);
+  text_edit_destroy(text_edit);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+  str_reset(&str);
+}
@@ -0,0 +1,358 @@
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "base/canvas.h"
+#include "base/font_manager.h"
+#include "base/text_run_cache.h"
+#include "lcd_log.h"
+#include "gtest/gtest.h"
+
+static uint8_t s_glyph_data[] = {0x1, 0x2, 0x3, 0x4};
+
+typedef struct _font_test_t {
+  font_t base;
+  uint32_t get_glyph_times;
+} font_test_t;
+
+/*空格没有位图，'#'找不到字形，其它字符宽度为(字符 % 5 + 4)。*/
+static ret_t font_test_get_glyph(font_t* f, wchar_t chr, font_size_t font_size, glyph_t* g) {
+  font_test_t* font = (font_test_t*)f;
+
+  font->get_glyph_times++;
+  if (chr == '#') {
+    return RET_NOT_FOUND;
+  }
+
+  memset(g, 0x00, sizeof(glyph_t));
+  g->x = 1;
+  g->y = -(int16_t)(font_size / 2) - (chr % 3);
+  g->w = chr % 5 + 4;
+  g->h = font_size / 2;
+  g->advance = g->w + 1;
+  g->data = chr == ' ' ? NULL : s_glyph_data;
+
+  return RET_OK;
+}
+
+static font_vmetrics_t font_test_get_vmetrics(font_t* f, font_size_t font_size) {
+  font_vmetrics_t vmetrics = {(int16_t)font_size, -2, 0};
+
+  return vmetrics;
+}
+
+static bool_t font_test_match(font_t* f, const char* name, font_size_t font_size) {
+  return tk_str_eq(f->name, name);
+}
+
+static ret_t font_test_destroy(font_t* f) {
+  return RET_OK;
+}
+
+static font_t* font_test_init(font_test_t* font, const char* name) {
+  memset(font, 0x00, sizeof(font_test_t));
+  tk_strncpy(font->base.name, name, TK_NAME_LEN);
+  font->base.match = font_test_match;
+  font->base.get_glyph = font_test_get_glyph;
+  font->base.get_vmetrics = font_test_get_vmetrics;
+  font->base.destroy = font_test_destroy;
+
+  return &(font->base);
+}
+
+TEST(TextRunCache, basic) {
+  font_test_t font;
+  const text_run_t* run = NULL;
+  const wchar_t* str = L"ab c#";
+  text_run_cache_t* cache = text_run_cache_create(4);
+  font_t* f = font_test_init(&font, "test");
+
+  /*第一次未命中时不缓存。*/
+  ASSERT_TRUE(text_run_cache_get(cache, f, 20, str, wcslen(str)) == NULL);
+  ASSERT_EQ(cache->size, 0u);
+  ASSERT_EQ(cache->misses, 1u);
+
+  run = text_run_cache_get(cache, f, 20, str, wcslen(str));
+  ASSERT_TRUE(run != NULL);
+  ASSERT_EQ(cache->size, 1u);
+  ASSERT_EQ(cache->misses, 2u);
+  ASSERT_EQ(cache->hits, 0u);
+
+  /*a=97(w=6), b=98(w=7), ' '=32(w=6), c=99(w=8), '#'没有字形(4)*/
+  ASSERT_EQ(run->width, (6 + 2) + (7 + 2) + (6 + 2) + (8 + 2) + 4);
+  ASSERT_EQ(run->glyphs_nr, 3u);
+  ASSERT_EQ(run->glyphs[0].code, (wchar_t)'a');
+  ASSERT_EQ(run->glyphs[0].x, 1);
+  ASSERT_EQ(run->glyphs[1].code, (wchar_t)'b');
+  ASSERT_EQ(run->glyphs[1].x, 1 + 8);
+  ASSERT_EQ(run->glyphs[2].code, (wchar_t)'c');
+  ASSERT_EQ(run->glyphs[2].x, 1 + 8 + 9 + 8);
+  ASSERT_EQ(run->top, -12);
+  ASSERT_EQ(run->bottom, 0);
+
+  font.get_glyph_times = 0;
+  ASSERT_EQ(text_run_cache_get(cache, f, 20, str, wcslen(str)), run);
+  ASSERT_EQ(font.get_glyph_times, 0u);
+  ASSERT_EQ(cache->hits, 1u);
+
+  ASSERT_TRUE(text_run_cache_get(cache, f, 18, str, wcslen(str)) == NULL);
+  ASSERT_TRUE(text_run_cache_get(cache, f, 20, str, wcslen(str) - 1) == NULL);
+  ASSERT_EQ(cache->size, 1u);
+  ASSERT_EQ(cache->misses, 4u);
+
+  ASSERT_TRUE(text_run_cache_get(cache, f, 20, str, 0) == NULL);
+  ASSERT_TRUE(text_run_cache_get(cache, f, 20, str, 1) == NULL);
+  ASSERT_TRUE(text_run_cache_get(cache, f, 20, str, 1) == NULL);
+  ASSERT_EQ(cache->size, 1u);
+  ASSERT_EQ(cache->misses, 4u);
+
+  ASSERT_EQ(text_run_cache_find(cache, f, 20, str, wcslen(str)), run);
+  ASSERT_TRUE(text_run_cache_find(cache, f, 18, str, wcslen(str)) == NULL);
+  ASSERT_EQ(cache->size, 1u);
+  ASSERT_EQ(cache->misses, 4u);
+
+  ASSERT_EQ(text_run_cache_clear(cache), RET_OK);
+  ASSERT_EQ(cache->size, 0u);
+
+  text_run_cache_destroy(cache);
+}
+
+TEST(TextRunCache, line_break) {
+  font_test_t font;
+  const text_run_t* run = NULL;
+  const wchar_t* str = L"a\r\nb\n";
+  text_run_cache_t* cache = text_run_cache_create(4);
+  font_t* f = font_test_init(&font, "test");
+
+  text_run_cache_get(cache, f, 20, str, wcslen(str));
+  run = text_run_cache_get(cache, f, 20, str, wcslen(str));
+  ASSERT_TRUE(run != NULL);
+
+  /*绘制时\r\n当作一个空格，最后的换行符忽略。*/
+  ASSERT_EQ(run->glyphs_nr, 2u);
+  ASSERT_EQ(run->glyphs[1].code, (wchar_t)'b');
+  ASSERT_EQ(run->glyphs[1].x, 1 + 8 + 8);
+
+  /*测量时每个字符都计算在内。*/
+  ASSERT_EQ(run->width, (6 + 2) + ('\r' % 5 + 4 + 2) + ('\n' % 5 + 4 + 2) + (7 + 2) +
+                            ('\n' % 5 + 4 + 2));
+
+  text_run_cache_destroy(cache);
+}
+
+TEST(TextRunCache, lru) {
+  font_test_t font;
+  const text_run_t* run_a = NULL;
+  text_run_cache_t* cache = text_run_cache_create(2);
+  font_t* f = font_test_init(&font, "test");
+
+  text_run_cache_get(cache, f, 20, L"aa", 2);
+  run_a = text_run_cache_get(cache, f, 20, L"aa", 2);
+  text_run_cache_get(cache, f, 20, L"bb", 2);
+  text_run_cache_get(cache, f, 20, L"bb", 2);
+  ASSERT_EQ(text_run_cache_get(cache, f, 20, L"aa", 2), run_a);
+
+  /*bb最久没有使用，被淘汰。*/
+  text_run_cache_get(cache, f, 20, L"cc", 2);
+  text_run_cache_get(cache, f, 20, L"cc", 2);
+  ASSERT_EQ(cache->size, 2u);
+  ASSERT_EQ(cache->hits, 1u);
+
+  ASSERT_EQ(text_run_cache_get(cache, f, 20, L"aa", 2), run_a);
+  ASSERT_EQ(cache->hits, 2u);
+
+  text_run_cache_get(cache, f, 20, L"bb", 2);
+  ASSERT_EQ(cache->misses, 7u);
+  ASSERT_EQ(cache->size, 2u);
+  text_run_cache_destroy(cache);
+}
+
+TEST(TextRunCache, admission) {
+  uint32_t i = 0;
+  font_test_t font;
+  wchar_t str[4];
+  const text_run_t* run = NULL;
+  text_run_cache_t* cache = text_run_cache_create(2);
+  font_t* f = font_test_init(&font, "test");
+
+  text_run_cache_get(cache, f, 20, L"title", 5);
+  run = text_run_cache_get(cache, f, 20, L"title", 5);
+  ASSERT_TRUE(run != NULL);
+
+  /*只出现一次的文本不会把常用的文本段挤出缓存。*/
+  for (i = 0; i < 100; i++) {
+    str[0] = 'n';
+    str[1] = '0' + i / 10;
+    str[2] = '0' + i % 10;
+    ASSERT_TRUE(text_run_cache_get(cache, f, 20, str, 3) == NULL);
+  }
+  ASSERT_EQ(cache->size, 1u);
+  ASSERT_EQ(text_run_cache_get(cache, f, 20, L"title", 5), run);
+
+  text_run_cache_destroy(cache);
+}
+
+TEST(TextRunCache, remove_font) {
+  uint32_t i = 0;
+  font_test_t font1;
+  font_test_t font2;
+  text_run_cache_t* cache = text_run_cache_create(8);
+  font_t* f1 = font_test_init(&font1, "f1");
+  font_t* f2 = font_test_init(&font2, "f2");
+
+  for (i = 0; i < 2; i++) {
+    text_run_cache_get(cache, f1, 20, L"aa", 2);
+    text_run_cache_get(cache, f2, 20, L"aa", 2);
+    text_run_cache_get(cache, f1, 20, L"bb", 2);
+  }
+  ASSERT_EQ(cache->size, 3u);
+
+  ASSERT_EQ(text_run_cache_remove_font(cache, f1), RET_OK);
+  ASSERT_EQ(cache->size, 1u);
+
+  text_run_cache_get(cache, f2, 20, L"aa", 2);
+  ASSERT_EQ(cache->hits, 1u);
+
+  text_run_cache_get(cache, f1, 20, L"aa", 2);
+  ASSERT_EQ(cache->misses, 7u);
+
+  text_run_cache_destroy(cache);
+}
+
+TEST(TextRunCache, font_manager) {
+  font_test_t font;
+  font_manager_t fm;
+
+  font_manager_init(&fm, NULL);
+  ASSERT_TRUE(fm.text_run_cache != NULL);
+  font_manager_add_font(&fm, font_test_init(&font, "test"));
+
+  text_run_cache_get(fm.text_run_cache, &(font.base), 20, L"abc", 3);
+  text_run_cache_get(fm.text_run_cache, &(font.base), 20, L"abc", 3);
+  ASSERT_EQ(fm.text_run_cache->size, 1u);
+
+  ASSERT_EQ(font_manager_unload_font(&fm, "test", 20), RET_OK);
+  ASSERT_EQ(fm.text_run_cache->size, 0u);
+
+  font_manager_deinit(&fm);
+  ASSERT_TRUE(fm.text_run_cache == NULL);
+}
+
+static string draw_text(canvas_t* c, lcd_t* lcd, const wchar_t* str, xy_t x, xy_t y) {
+  lcd_log_reset(lcd);
+  canvas_draw_text(c, str, wcslen(str), x, y);
+
+  return lcd_log_get_commands(lcd);
+}
+
+TEST(TextRunCache, canvas) {
+  rect_t r;
+  canvas_t c;
+  font_test_t font;
+  font_manager_t fm;
+  text_run_cache_t* cache = NULL;
+  lcd_t* lcd = lcd_log_init(800, 600);
+  const wchar_t* strs[] = {L"hello world", L"a\r\nb\rc#d\n", L"clipped text clipped text"};
+  xy_t pos[][2] = {{110, 120}, {50, 110}, {95, 95}, {280, 290}, {100, 300}};
+  uint32_t i = 0;
+  uint32_t k = 0;
+
+  font_manager_init(&fm, NULL);
+  font_manager_add_font(&fm, font_test_init(&font, "test"));
+  canvas_init(&c, lcd, &fm);
+  canvas_set_font(&c, "test", 20);
+
+  r = rect_init(100, 100, 200, 200);
+  canvas_begin_frame(&c, &r, LCD_DRAW_NORMAL);
+
+  cache = fm.text_run_cache;
+  for (i = 0; i < ARRAY_SIZE(strs); i++) {
+    for (k = 0; k < ARRAY_SIZE(pos); k++) {
+      string expected;
+      string actual;
+      xy_t x = pos[k][0];
+      xy_t y = pos[k][1];
+
+      fm.text_run_cache = NULL;
+      expected = draw_text(&c, lcd, strs[i], x, y);
+      float_t w = canvas_measure_text(&c, strs[i], wcslen(strs[i]));
+
+      fm.text_run_cache = cache;
+      actual = draw_text(&c, lcd, strs[i], x, y);
+      ASSERT_EQ(actual, expected);
+      ASSERT_EQ(canvas_measure_text(&c, strs[i], wcslen(strs[i])), w);
+
+      /*再次绘制使用缓存的结果。*/
+      actual = draw_text(&c, lcd, strs[i], x, y);
+      ASSERT_EQ(actual, expected);
+    }
+  }
+
+  ASSERT_EQ(cache->size, ARRAY_SIZE(strs));
+  ASSERT_GT(cache->hits, 0u);
+
+  canvas_end_frame(&c);
+  canvas_reset(&c);
+  font_manager_deinit(&fm);
+  lcd_destroy(lcd);
+}
+
+/*编辑器排版时逐个字符测量宽度，这些调用不能经过文本段缓存。*/
+static uint64_t measure_per_char(canvas_t* c, const wchar_t* str, uint32_t nr, float_t* width) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+  uint64_t start = time_now_us();
+
+  *width = 0;
+  for (k = 0; k < 20; k++) {
+    for (i = 0; i < nr; i++) {
+      *width += canvas_measure_text(c, str + i, 1);
+    }
+  }
+
+  return time_now_us() - start;
+}
+
+TEST(TextRunCache, measure_per_char_perf) {
+  canvas_t c;
+  font_test_t font;
+  font_manager_t fm;
+  uint32_t i = 0;
+  float_t width = 0;
+  float_t expected_width = 0;
+  uint64_t cached_cost = 0;
+  uint64_t uncached_cost = 0;
+  text_run_cache_t* cache = NULL;
+  wchar_t str[4096];
+  lcd_t* lcd = lcd_log_init(800, 600);
+
+  for (i = 0; i < ARRAY_SIZE(str); i++) {
+    str[i] = 'a' + i % 26;
+  }
+
+  font_manager_init(&fm, NULL);
+  font_manager_add_font(&fm, font_test_init(&font, "test"));
+  canvas_init(&c, lcd, &fm);
+  canvas_set_font(&c, "test", 20);
+  cache = fm.text_run_cache;
+
+  fm.text_run_cache = NULL;
+  uncached_cost = measure_per_char(&c, str, ARRAY_SIZE(str), &expected_width);
+
+  fm.text_run_cache = cache;
+  cached_cost = measure_per_char(&c, str, ARRAY_SIZE(str), &width);
+  ASSERT_EQ(width, expected_width);
+  ASSERT_EQ(cache->size, 0u);
+  ASSERT_EQ(cache->hits + cache->misses, 0u);
+
+  /*测量整段文本也不会加入缓存。*/
+  canvas_measure_text(&c, str, 100);
+  canvas_measure_text(&c, str, 100);
+  ASSERT_EQ(cache->size, 0u);
+
+  log_debug("measure %u chars x 20: no cache %uus, cache %uus\n", (uint32_t)ARRAY_SIZE(str),
+            (uint32_t)uncached_cost, (uint32_t)cached_cost);
+  ASSERT_LT(cached_cost, uncached_cost * 2 + 1000);
+
+  canvas_reset(&c);
+  font_manager_deinit(&fm);
+  lcd_destroy(lcd);
+}
@@ -139,3 +139,75 @@ TEST(Theme, basic) {
     }
   }
 }
+
+TEST(Theme, index) {
+  uint8_t buff[40 * 10240];
+  uint32_t state_nr = 5;
+  uint32_t name_nr = 8;
+  theme_t t;
+  theme_t t0;
+  uint8_t buff0[sizeof(buff)];
+  theme_header_t* header = (theme_header_t*)buff0;
+
+  memset(&t, 0x00, sizeof(t));
+  memset(&t0, 0x00, sizeof(t0));
+  GenThemeData(buff, sizeof(buff), state_nr, name_nr);
+  memcpy(buff0, buff, sizeof(buff));
+  ASSERT_EQ(header->version, THEME_VERSION_INDEXED);
+  /*version为0时顺序查找，结果应该一样*/
+  header->version = 0;
+  t.data = buff;
+  t0.data = buff0;
+
+  for (int32_t i = 0; widget_types[i]; i++) {
+    const char* type = widget_types[i];
+    for (uint32_t state = 0; state < state_nr; state++) {
+      const uint8_t* data = theme_find_style(&t, type, TK_DEFAULT_STYLE, state_names[state]);
+      const uint8_t* data0 = theme_find_style(&t0, type, TK_DEFAULT_STYLE, state_names[state]);
+
+      ASSERT_EQ(data != NULL, true);
+      ASSERT_EQ(data - buff, data0 - buff0);
+      for (uint32_t k = 0; k < name_nr; k++) {
+        char name[32];
+        snprintf(name, sizeof(name), "%d", k);
+        ASSERT_EQ(style_data_get_int(data, name, -1), k);
+        ASSERT_EQ(style_data_get_str(data, name, NULL), (const char*)NULL);
+      }
+      ASSERT_EQ(style_data_get_int(data, "none", -1), -1);
+      ASSERT_EQ(style_data_get_int(data, NULL, -1), -1);
+    }
+  }
+
+  ASSERT_EQ(theme_find_style(&t, "none", TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL), (const uint8_t*)NULL);
+  ASSERT_EQ(theme_find_style(&t, WIDGET_TYPE_BUTTON, "none", WIDGET_STATE_NORMAL),
+            (const uint8_t*)NULL);
+  ASSERT_EQ(theme_find_style(&t, WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, NULL), (const uint8_t*)NULL);
+}
+
+TEST(Theme, indexDup) {
+  uint8_t buff[1024];
+  theme_t t;
+  const uint8_t* data = NULL;
+  ThemeGen g;
+  Style s1(WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  Style s2(WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  Style s3(WIDGET_TYPE_LABEL, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  wbuffer_t wbuffer;
+  wbuffer_t* b = wbuffer_init(&wbuffer, buff, sizeof(buff));
+
+  s1.AddValue("font_size", (int32_t)1);
+  s2.AddValue("font_size", (int32_t)2);
+  s3.AddValue("font_size", (int32_t)3);
+  g.AddStyle(s3);
+  g.AddStyle(s1);
+  g.AddStyle(s2);
+  g.Output(b);
+  wbuffer_deinit(b);
+
+  memset(&t, 0x00, sizeof(t));
+  t.data = buff;
+  data = theme_find_style(&t, WIDGET_TYPE_BUTTON, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  ASSERT_EQ(style_data_get_int(data, "font_size", 0), 1);
+  data = theme_find_style(&t, WIDGET_TYPE_LABEL, TK_DEFAULT_STYLE, WIDGET_STATE_NORMAL);
+  ASSERT_EQ(style_data_get_int(data, "font_size", 0), 3);
+}
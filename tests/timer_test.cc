@@ -232,3 +232,130 @@ TEST(Timer, addInTimer) {
 
   timer_manager_destroy(tm);
 }
+
+static ret_t timer_log_ctx(const timer_info_t* timer) {
+  char str[32];
+  tk_snprintf(str, sizeof(str), "%d:", (int)((char*)(timer->ctx) - (char*)NULL));
+  s_log += str;
+
+  return RET_OK;
+}
+
+TEST(Timer, order) {
+  uint32_t i = 0;
+  uint32_t ids[NR];
+  string log;
+  timer_set_time(0);
+  timer_manager_t* tm = timer_manager_create(timer_get_time);
+
+  /*乱序添加，按到期时间触发，到期时间相同的按添加顺序触发*/
+  for (i = 0; i < NR; i++) {
+    uint32_t duration = ((i * 37) % NR) / 2 + 1;
+    ids[i] = timer_manager_add(tm, timer_log_ctx, (char*)NULL + i, duration);
+  }
+  ASSERT_EQ(timer_manager_next_time(tm), 1);
+
+  for (i = 0; i < NR; i += 3) {
+    ASSERT_EQ(timer_manager_remove(tm, ids[i]), RET_OK);
+    ASSERT_EQ(timer_manager_find(tm, ids[i]) == NULL, true);
+  }
+  ASSERT_EQ(timer_manager_remove(tm, ids[0]), RET_NOT_FOUND);
+
+  for (uint32_t d = 1; d <= NR / 2; d++) {
+    for (i = 0; i < NR; i++) {
+      if ((i % 3) != 0 && ((i * 37) % NR) / 2 + 1 == d) {
+        char str[32];
+        tk_snprintf(str, sizeof(str), "%d:", (int)i);
+        log += str;
+      }
+    }
+  }
+
+  timer_clear_log();
+  timer_set_time(NR);
+  ASSERT_EQ(timer_manager_dispatch(tm), RET_OK);
+  ASSERT_EQ(timer_manager_count(tm), 0);
+  ASSERT_EQ(s_log, log);
+
+  timer_manager_destroy(tm);
+}
+
+TEST(Timer, modifyOrder) {
+  timer_set_time(0);
+  timer_manager_t* tm = timer_manager_create(timer_get_time);
+  uint32_t id1 = timer_manager_add(tm, timer_log_ctx, (char*)NULL + 1, 100);
+  uint32_t id2 = timer_manager_add(tm, timer_log_ctx, (char*)NULL + 2, 200);
+  timer_manager_add(tm, timer_log_ctx, (char*)NULL + 3, 300);
+
+  ASSERT_EQ(timer_manager_next_time(tm), 100);
+  ASSERT_EQ(timer_manager_modify(tm, id1, 400), RET_OK);
+  ASSERT_EQ(timer_manager_next_time(tm), 200);
+
+  timer_set_time(50);
+  ASSERT_EQ(timer_manager_modify(tm, id2, 10), RET_OK);
+  ASSERT_EQ(timer_manager_next_time(tm), 60);
+
+  timer_clear_log();
+  timer_set_time(300);
+  ASSERT_EQ(timer_manager_dispatch(tm), RET_OK);
+  ASSERT_EQ(s_log, "2:3:");
+  ASSERT_EQ(timer_manager_next_time(tm), 400);
+
+  ASSERT_EQ(timer_manager_reset(tm, id1), RET_OK);
+  ASSERT_EQ(timer_manager_next_time(tm), 700);
+
+  timer_set_time(700);
+  ASSERT_EQ(timer_manager_dispatch(tm), RET_OK);
+  ASSERT_EQ(s_log, "2:3:1:");
+  ASSERT_EQ(timer_manager_count(tm), 0);
+
+  timer_manager_destroy(tm);
+}
+
+TEST(Timer, nextTimeSuspend) {
+  timer_info_t* timer = NULL;
+  timer_set_time(0);
+  timer_manager_t* tm = timer_manager_create(timer_get_time);
+  uint32_t id1 = timer_manager_add(tm, timer_repeat, NULL, 10);
+  uint32_t id2 = timer_manager_add(tm, timer_repeat, NULL, 20);
+
+  timer_manager_add(tm, timer_repeat, NULL, 300);
+  ASSERT_EQ(timer_manager_next_time(tm), 10);
+
+  /*挂起的和正在执行的定时器不参与计算。*/
+  timer = (timer_info_t*)timer_manager_find(tm, id1);
+  timer->suspend = TRUE;
+  ASSERT_EQ(timer_manager_next_time(tm), 20);
+
+  timer = (timer_info_t*)timer_manager_find(tm, id2);
+  timer->busy = TRUE;
+  ASSERT_EQ(timer_manager_next_time(tm), 300);
+
+  timer->busy = FALSE;
+  ASSERT_EQ(timer_manager_next_time(tm), 20);
+
+  timer_manager_destroy(tm);
+}
+
+TEST(Timer, removeByCtx) {
+  uint32_t i = 0;
+  timer_set_time(0);
+  timer_manager_t* tm = timer_manager_create(timer_get_time);
+
+  for (i = 0; i < NR; i++) {
+    timer_manager_add(tm, timer_log_ctx, (char*)NULL + (i % 2), NR - i);
+  }
+
+  ASSERT_EQ(timer_manager_all_remove_by_ctx(tm, (char*)NULL + 1), RET_OK);
+  ASSERT_EQ(timer_manager_count(tm), NR / 2);
+  ASSERT_EQ(timer_manager_all_remove_by_ctx(tm, (char*)NULL + 1), RET_NOT_FOUND);
+  ASSERT_EQ(timer_manager_next_time(tm), 2);
+
+  timer_clear_log();
+  timer_set_time(NR);
+  ASSERT_EQ(timer_manager_dispatch(tm), RET_OK);
+  ASSERT_EQ(s_log, repeat_str("0:", NR / 2));
+  ASSERT_EQ(timer_manager_count(tm), 0);
+
+  timer_manager_destroy(tm);
+}
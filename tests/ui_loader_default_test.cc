@@ -2,8 +2,14 @@
 #include "ui_loader/ui_builder_default.h"
 #include "ui_loader/ui_binary_writer.h"
 #include "ui_loader/ui_loader_default.h"
+#include "ui_loader/ui_xml_writer.h"
 #include "gtest/gtest.h"
 
+#include <string>
+#include <algorithm>
+
+using std::string;
+
 #define INIT_DESC(tt, xx, yy, ww, hh) \
   desc.layout.x = xx;                 \
   desc.layout.y = yy;                 \
@@ -140,3 +146,190 @@ TEST(UILoader, ext) {
   widget_destroy(builder->root);
   ui_builder_destroy(builder);
 }
+
+static void write_typed_ui(ui_builder_t* writer) {
+  value_t v;
+  widget_desc_t desc;
+
+  memset(&desc, 0x00, sizeof(desc));
+  INIT_DESC("view", 0, 0, 400, 300);
+  ASSERT_EQ(ui_builder_on_widget_start(writer, &desc), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "name", "root"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "children_layout", "default(r=1,c=2,m=5,s=4)"),
+            RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "style:normal:bg_color", "#ff000080"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "style:normal:font_size", "20"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "style:normal:text_align_h", "right"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "style:normal:bg_image", "bg"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop_end(writer), RET_OK);
+
+  INIT_DESC("button", 0, 0, 80, 30);
+  ASSERT_EQ(ui_builder_on_widget_start(writer, &desc), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "name", "ok"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "text", "123"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "enable", "false"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "opacity", "128"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "foo", "bar"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop_value(writer, WIDGET_PROP_ID_NONE, "ratio",
+                                            value_set_double(&v, 1.5)),
+            RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop_end(writer), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_end(writer), RET_OK);
+
+  INIT_DESC("label", 0, 0, 80, 30);
+  ASSERT_EQ(ui_builder_on_widget_start(writer, &desc), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "name", "cancel"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "self_layout", "default(x=c,y=m,w=50%,h=30)"),
+            RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "visible", "true"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "floating", "true"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop_end(writer), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_end(writer), RET_OK);
+
+  ASSERT_EQ(ui_builder_on_widget_end(writer), RET_OK);
+}
+
+static widget_t* load_typed_ui(wbuffer_t* wbuffer) {
+  widget_t* root = NULL;
+  ui_builder_t* builder = ui_builder_default_create("");
+
+  ui_loader_load(default_ui_loader(), wbuffer->data, wbuffer->cursor, builder);
+  root = builder->root;
+  ui_builder_destroy(builder);
+  widget_layout(root);
+
+  return root;
+}
+
+TEST(UILoader, v2) {
+  value_t v;
+  wbuffer_t wbuffer1;
+  wbuffer_t wbuffer2;
+  ui_binary_writer_t writer1;
+  ui_binary_writer_t writer2;
+  color_t trans = color_init(0, 0, 0, 0);
+
+  write_typed_ui(ui_binary_writer_init_ex(&writer1, wbuffer_init_extendable(&wbuffer1), 1));
+  write_typed_ui(ui_binary_writer_init_ex(&writer2, wbuffer_init_extendable(&wbuffer2), 2));
+  ASSERT_LT(wbuffer2.cursor, wbuffer1.cursor);
+
+  widget_t* root1 = load_typed_ui(&wbuffer1);
+  widget_t* root2 = load_typed_ui(&wbuffer2);
+  ASSERT_TRUE(root1 != NULL && root2 != NULL);
+
+  widget_t* ok = widget_lookup(root2, "ok", TRUE);
+  widget_t* cancel = widget_lookup(root2, "cancel", TRUE);
+  ASSERT_TRUE(ok != NULL && cancel != NULL);
+  ASSERT_EQ(tk_str_eq(root2->name, "root"), TRUE);
+  ASSERT_EQ(ok->enable, FALSE);
+  ASSERT_EQ(ok->opacity, 128);
+  ASSERT_EQ(string(widget_get_prop_str(ok, "foo", "")), string("bar"));
+  ASSERT_EQ(widget_get_prop(ok, "ratio", &v), RET_OK);
+  ASSERT_EQ(value_double(&v), 1.5);
+  ASSERT_EQ(cancel->visible, TRUE);
+  ASSERT_EQ(cancel->floating, TRUE);
+  ASSERT_EQ(string(root2->children_layout->params.str), string("default(r=1,c=2,m=5,s=4)"));
+  ASSERT_EQ(string(cancel->self_layout->params.str), string("default(x=c,y=m,w=50%,h=30)"));
+  ASSERT_EQ(style_get_color(root2->astyle, STYLE_ID_BG_COLOR, trans).color,
+            color_init(0xff, 0, 0, 0x80).color);
+  ASSERT_EQ(style_get_int(root2->astyle, STYLE_ID_FONT_SIZE, 0), 20);
+  ASSERT_EQ(style_get_int(root2->astyle, STYLE_ID_TEXT_ALIGN_H, 0), ALIGN_H_RIGHT);
+  ASSERT_EQ(string(style_get_str(root2->astyle, STYLE_ID_BG_IMAGE, "")), string("bg"));
+
+  /*与v1格式加载的结果一致。*/
+  for (int32_t i = 0; i < 2; i++) {
+    widget_t* iter1 = widget_get_child(root1, i);
+    widget_t* iter2 = widget_get_child(root2, i);
+
+    ASSERT_EQ(iter1->x, iter2->x);
+    ASSERT_EQ(iter1->y, iter2->y);
+    ASSERT_EQ(iter1->w, iter2->w);
+    ASSERT_EQ(iter1->h, iter2->h);
+    ASSERT_EQ(iter1->enable, iter2->enable);
+    ASSERT_EQ(iter1->opacity, iter2->opacity);
+    ASSERT_EQ(iter1->floating, iter2->floating);
+  }
+  ASSERT_EQ(cancel->x, (400 - cancel->w) / 2);
+  ASSERT_EQ(cancel->w, 200);
+  ASSERT_EQ(ok->x, 5);
+  ASSERT_EQ(ok->w, (400 - 10 - 4) / 2);
+  ASSERT_EQ(style_get_color(root1->astyle, STYLE_ID_BG_COLOR, trans).color,
+            style_get_color(root2->astyle, STYLE_ID_BG_COLOR, trans).color);
+
+  widget_destroy(root1);
+  widget_destroy(root2);
+  wbuffer_deinit(&wbuffer1);
+  wbuffer_deinit(&wbuffer2);
+}
+
+TEST(UILoader, v2_wire_ids) {
+  wbuffer_t wbuffer;
+  widget_desc_t desc;
+  ui_binary_writer_t binary_writer;
+  const uint8_t enable[] = {UI_PROP_TYPE_BOOL, 5, 0};
+  ui_builder_t* writer =
+      ui_binary_writer_init_ex(&binary_writer, wbuffer_init_extendable(&wbuffer), 2);
+
+  /*编号写在UI数据中，不能改变。*/
+  ASSERT_EQ(ui_builder_prop_id_to_wire_id(WIDGET_PROP_ID_NONE), UI_PROP_WIRE_ID_NONE);
+  ASSERT_EQ(ui_builder_prop_id_to_wire_id(WIDGET_PROP_ID_ANIMATION), 1);
+  ASSERT_EQ(ui_builder_prop_id_to_wire_id(WIDGET_PROP_ID_ENABLE), 5);
+  ASSERT_EQ(ui_builder_prop_id_to_wire_id(WIDGET_PROP_ID_SELF_LAYOUT), 24);
+  ASSERT_EQ(ui_builder_prop_id_to_wire_id(WIDGET_PROP_ID_TEXT), 30);
+  ASSERT_EQ(ui_builder_prop_id_to_wire_id(WIDGET_PROP_ID_Y), 39);
+  ASSERT_EQ(ui_builder_prop_id_from_wire_id(30), WIDGET_PROP_ID_TEXT);
+  ASSERT_EQ(ui_builder_prop_id_from_wire_id(UI_PROP_WIRE_ID_NONE), WIDGET_PROP_ID_NONE);
+  ASSERT_EQ(ui_builder_prop_id_from_wire_id(0xff), WIDGET_PROP_ID_NONE);
+
+  memset(&desc, 0x00, sizeof(desc));
+  INIT_DESC("label", 0, 0, 80, 30);
+  ASSERT_EQ(ui_builder_on_widget_start(writer, &desc), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "enable", "false"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop_end(writer), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_end(writer), RET_OK);
+  ASSERT_TRUE(std::search(wbuffer.data, wbuffer.data + wbuffer.cursor, enable,
+                          enable + sizeof(enable)) != wbuffer.data + wbuffer.cursor);
+
+  wbuffer_deinit(&wbuffer);
+}
+
+TEST(UILoader, v2_to_xml) {
+  str_t str;
+  value_t v;
+  wbuffer_t wbuffer;
+  widget_desc_t desc;
+  ui_xml_writer_t xml_writer;
+  ui_binary_writer_t binary_writer;
+  ui_builder_t* writer =
+      ui_binary_writer_init_ex(&binary_writer, wbuffer_init_extendable(&wbuffer), 2);
+
+  memset(&desc, 0x00, sizeof(desc));
+  INIT_DESC("label", 0, 0, 80, 30);
+  ASSERT_EQ(ui_builder_on_widget_start(writer, &desc), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "self_layout", "default(x=c,y=m,w=50%,h=30)"),
+            RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "children_layout", "default(r=1,c=2)"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "style:normal:bg_color", "#ff000080"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "style:normal:text_align_h", "right"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "enable", "false"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop(writer, "text", "123"), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_prop_end(writer), RET_OK);
+  ASSERT_EQ(ui_builder_on_widget_end(writer), RET_OK);
+
+  /*ui_xml_writer只支持字符串的属性值，加载时转换成字符串。*/
+  ui_builder_t* builder = ui_xml_writer_init(&xml_writer, str_init(&str, 1024));
+  ASSERT_EQ(ui_loader_load(default_ui_loader(), wbuffer.data, wbuffer.cursor, builder), RET_OK);
+  ASSERT_TRUE(strstr(str.str, "self_layout=\"default(x=c,y=m,w=50%,h=30)\"") != NULL);
+  ASSERT_TRUE(strstr(str.str, "children_layout=\"default(r=1,c=2)\"") != NULL);
+  ASSERT_TRUE(strstr(str.str, "style:normal:bg_color=\"#ff000080\"") != NULL);
+  ASSERT_TRUE(strstr(str.str, "style:normal:text_align_h=\"3\"") != NULL);
+  ASSERT_TRUE(strstr(str.str, "enable=\"false\"") != NULL);
+  ASSERT_TRUE(strstr(str.str, "text=\"123\"") != NULL);
+
+  /*转换回来的枚举值是数字，仍然可以正确解析。*/
+  ASSERT_EQ(style_normalize_value(STYLE_ID_TEXT_ALIGN_H, "3", &v), RET_OK);
+  ASSERT_EQ(value_int(&v), ALIGN_H_RIGHT);
+
+  str_reset(&str);
+  wbuffer_deinit(&wbuffer);
+}
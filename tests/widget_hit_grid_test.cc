@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+#include "tkc/time_now.h"
+#include "base/window.h"
+#include "base/widget_hit_grid.h"
+#include "widgets/view.h"
+#include "widgets/button.h"
+
+#define GRID_COLS 25
+#define GRID_ROWS 20
+
+/*500个按钮排成网格，按钮之间有2像素的间隔。*/
+static widget_t* create_grid(widget_t* win) {
+  widget_t* view = view_create(win, 0, 0, 800, 600);
+
+  for (int32_t r = 0; r < GRID_ROWS; r++) {
+    for (int32_t c = 0; c < GRID_COLS; c++) {
+      button_create(view, c * 32, r * 30, 30, 28);
+    }
+  }
+
+  return view;
+}
+
+static uint32_t compare_all_points(widget_t* view) {
+  uint32_t hits = 0;
+
+  for (xy_t y = -10; y < 620; y += 3) {
+    for (xy_t x = -10; x < 820; x += 3) {
+      widget_t* target = NULL;
+
+      view->hit_grid = FALSE;
+      target = widget_find_target(view, x, y);
+      view->hit_grid = TRUE;
+      EXPECT_EQ(widget_find_target(view, x, y), target);
+      hits += target != NULL ? 1 : 0;
+    }
+  }
+
+  return hits;
+}
+
+TEST(WidgetHitGrid, same_as_linear) {
+  widget_t* win = window_create(NULL, 0, 0, 800, 600);
+  widget_t* view = create_grid(win);
+  widget_t* big = button_create(view, 100, 100, 300, 200);
+
+  /*z序低的大控件被上面的按钮遮住，禁用的按钮被跳过。*/
+  widget_restack(big, 0);
+  widget_set_enable(widget_get_child(view, 30), FALSE);
+  widget_set_sensitive(widget_get_child(view, 31), FALSE);
+
+  ASSERT_EQ(widget_set_hit_grid(view, TRUE), RET_OK);
+  ASSERT_GT(compare_all_points(view), 0u);
+  ASSERT_TRUE(view->grid != NULL);
+  ASSERT_TRUE(view->grid->usable);
+  ASSERT_GT(view->grid->cols, 1u);
+  ASSERT_GT(view->grid->rows, 1u);
+
+  ASSERT_EQ(widget_find_target(view, 105, 105), widget_get_child(view, 79));
+  ASSERT_EQ(widget_find_target(view, 127, 128), big);
+
+  ASSERT_EQ(widget_set_hit_grid(view, FALSE), RET_OK);
+  ASSERT_TRUE(view->grid == NULL);
+
+  widget_destroy(win);
+}
+
+TEST(WidgetHitGrid, invalidate) {
+  widget_t* win = window_create(NULL, 0, 0, 800, 600);
+  widget_t* view = create_grid(win);
+  widget_t* b = widget_get_child(view, 0);
+  widget_t* b2 = NULL;
+  value_t v;
+
+  widget_set_hit_grid(view, TRUE);
+  ASSERT_EQ(widget_find_target(view, 5, 5), b);
+
+  widget_move(b, 700, 700);
+  ASSERT_EQ(widget_find_target(view, 5, 5), (widget_t*)NULL);
+  ASSERT_EQ(widget_find_target(view, 705, 705), b);
+
+  widget_resize(b, 100, 100);
+  ASSERT_EQ(widget_find_target(view, 790, 790), b);
+
+  widget_set_prop(b, WIDGET_PROP_X, value_set_int(&v, 0));
+  widget_set_prop(b, WIDGET_PROP_Y, value_set_int(&v, 0));
+  ASSERT_EQ(widget_find_target(view, 30, 50), b);
+  ASSERT_EQ(widget_find_target(view, 50, 50), widget_get_child(view, 26));
+
+  widget_restack(b, widget_count_children(view) - 1);
+  ASSERT_EQ(widget_find_target(view, 50, 50), b);
+  widget_restack(b, 0);
+  ASSERT_EQ(widget_find_target(view, 50, 50), widget_get_child(view, 26));
+
+  widget_remove_child(view, b);
+  ASSERT_EQ(widget_find_target(view, 50, 50), widget_get_child(view, 25));
+  ASSERT_EQ(widget_find_target(view, 30, 50), (widget_t*)NULL);
+  widget_add_child(view, b);
+  ASSERT_EQ(widget_find_target(view, 50, 50), b);
+
+  b2 = button_create(view, 40, 40, 20, 20);
+  ASSERT_EQ(widget_find_target(view, 50, 50), b2);
+
+  compare_all_points(view);
+
+  widget_destroy(win);
+}
+
+static bool_t round_is_point_in(widget_t* widget, xy_t x, xy_t y) {
+  int32_t r = widget->w / 2;
+  int32_t dx = x - r;
+  int32_t dy = y - r;
+
+  return dx * dx + dy * dy <= r * r;
+}
+
+/*控件销毁是异步的，虚函数表不能放在栈上。*/
+static widget_vtable_t s_round_vtable;
+
+TEST(WidgetHitGrid, not_usable) {
+  widget_t* win = window_create(NULL, 0, 0, 800, 600);
+  widget_t* view = view_create(win, 0, 0, 800, 600);
+  widget_t* b = NULL;
+
+  /*子控件太少时不使用网格。*/
+  widget_set_hit_grid(view, TRUE);
+  b = button_create(view, 0, 0, 30, 30);
+  ASSERT_EQ(widget_find_target(view, 5, 5), b);
+  ASSERT_FALSE(view->grid->usable);
+
+  /*自定义is_point_in的子控件不使用网格。*/
+  for (int32_t i = 0; i < TK_WIDGET_HIT_GRID_MIN_CHILDREN; i++) {
+    button_create(view, i * 40, 100, 30, 30);
+  }
+  ASSERT_EQ(widget_find_target(view, 45, 105), widget_get_child(view, 2));
+  ASSERT_TRUE(view->grid->usable);
+
+  s_round_vtable.size = sizeof(widget_t);
+  s_round_vtable.type = "round";
+  s_round_vtable.is_point_in = round_is_point_in;
+  widget_create(view, &s_round_vtable, 0, 0, 100, 100);
+  ASSERT_EQ(widget_find_target(view, 45, 105), widget_get_child(view, 2));
+  ASSERT_FALSE(view->grid->usable);
+
+  widget_destroy(win);
+}
+
+TEST(WidgetHitGrid, benchmark) {
+  uint64_t start = 0;
+  uint32_t linear_cost = 0;
+  uint32_t grid_cost = 0;
+  uint32_t nr = 0;
+  widget_hit_grid_stats_t s1;
+  widget_hit_grid_stats_t s2;
+  widget_t* win = window_create(NULL, 0, 0, 800, 600);
+  widget_t* view = create_grid(win);
+  widget_t* linear_targets[GRID_ROWS * 2][GRID_COLS * 2];
+
+  ASSERT_EQ(widget_count_children(view), GRID_ROWS * GRID_COLS);
+
+  start = time_now_us();
+  for (int32_t k = 0; k < 20; k++) {
+    for (int32_t r = 0; r < GRID_ROWS * 2; r++) {
+      for (int32_t c = 0; c < GRID_COLS * 2; c++) {
+        linear_targets[r][c] = widget_find_target(view, c * 16 + 5, r * 15 + 5);
+      }
+    }
+  }
+  linear_cost = (uint32_t)(time_now_us() - start);
+
+  widget_set_hit_grid(view, TRUE);
+  widget_hit_grid_get_stats(&s1);
+  start = time_now_us();
+  for (int32_t k = 0; k < 20; k++) {
+    for (int32_t r = 0; r < GRID_ROWS * 2; r++) {
+      for (int32_t c = 0; c < GRID_COLS * 2; c++) {
+        ASSERT_EQ(widget_find_target(view, c * 16 + 5, r * 15 + 5), linear_targets[r][c]);
+        nr++;
+      }
+    }
+  }
+  grid_cost = (uint32_t)(time_now_us() - start);
+  widget_hit_grid_get_stats(&s2);
+
+  ASSERT_EQ(s2.builds - s1.builds, 1u);
+  ASSERT_EQ(s2.queries - s1.queries, nr);
+  /*遍历时平均要检查一半的子控件，使用网格后每次只检查几个。*/
+  ASSERT_LE(s2.tests - s1.tests, nr * 4);
+
+  printf("hit test %u times on %u children: linear=%uus grid=%uus\n", nr,
+         widget_count_children(view), linear_cost, grid_cost);
+
+  widget_destroy(win);
+}
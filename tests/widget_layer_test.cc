@@ -0,0 +1,224 @@
+#include "gtest/gtest.h"
+#include "base/idle.h"
+#include "base/window.h"
+#include "base/native_window.h"
+#include "base/system_info.h"
+#include "base/widget_layer.h"
+#include "base/window_manager.h"
+#include "widgets/view.h"
+#include "widgets/button.h"
+#include "font_dummy.h"
+#include "lcd_log.h"
+
+/*canvas_offline需要窗口管理器有native_window，测试时用一个只提供画布的native_window代替。*/
+static canvas_t* s_canvas = NULL;
+
+static canvas_t* native_window_test_get_canvas(native_window_t* win) {
+  return s_canvas;
+}
+
+static native_window_vtable_t s_native_window_test_vtable;
+
+class WidgetLayerTest : public testing::Test {
+ protected:
+  virtual void SetUp() {
+    memset(&nw, 0x00, sizeof(nw));
+    memset(&s_native_window_test_vtable, 0x00, sizeof(s_native_window_test_vtable));
+    s_native_window_test_vtable.type = "native_window_test";
+    s_native_window_test_vtable.get_canvas = native_window_test_get_canvas;
+    nw.vt = &s_native_window_test_vtable;
+
+    lcd = lcd_log_init(800, 600);
+    canvas_init(&c, lcd, font_manager());
+    s_canvas = &c;
+    widget_set_prop_pointer(window_manager(), WIDGET_PROP_NATIVE_WINDOW, &nw);
+
+    widget_layer_clear();
+    widget_layer_get_stats(&stats);
+  }
+
+  virtual void TearDown() {
+    widget_layer_set_max_mem_size(TK_WIDGET_LAYER_MAX_MEM_SIZE);
+    widget_set_prop_pointer(window_manager(), WIDGET_PROP_NATIVE_WINDOW, NULL);
+    s_canvas = NULL;
+    canvas_reset(&c);
+    lcd_destroy(lcd);
+  }
+
+  string paint(widget_t* widget) {
+    string cmds;
+    rect_t r = rect_init(0, 0, 800, 600);
+
+    canvas_begin_frame(&c, &r, LCD_DRAW_NORMAL);
+    lcd_log_reset(lcd);
+    widget_paint(widget, &c);
+    cmds = lcd_log_get_commands(lcd);
+    canvas_end_frame(&c);
+
+    return cmds;
+  }
+
+  canvas_t c;
+  lcd_t* lcd;
+  native_window_t nw;
+  widget_layer_stats_t stats;
+};
+
+static ret_t on_before_paint(void* ctx, event_t* e) {
+  uint32_t* count = (uint32_t*)ctx;
+  (*count)++;
+
+  return RET_OK;
+}
+
+TEST_F(WidgetLayerTest, basic) {
+  widget_layer_stats_t s;
+  uint32_t paint_count = 0;
+  uint32_t lcd_w = system_info()->lcd_w;
+  widget_t* w = window_create(NULL, 0, 0, 400, 300);
+  widget_t* view = view_create(w, 10, 20, 100, 50);
+  widget_t* b = button_create(view, 0, 0, 50, 20);
+
+  widget_on(b, EVT_BEFORE_PAINT, on_before_paint, &paint_count);
+  ASSERT_EQ(widget_get_prop_bool(view, WIDGET_PROP_CACHE, TRUE), FALSE);
+  ASSERT_EQ(widget_set_prop_bool(view, WIDGET_PROP_CACHE, TRUE), RET_OK);
+  ASSERT_EQ(widget_get_prop_bool(view, WIDGET_PROP_CACHE, FALSE), TRUE);
+
+  /*第一次绘制生成图层，按钮绘制到图层中。*/
+  ASSERT_EQ(paint(view), "dg(0,0,100,50,10,20,100,50);");
+  ASSERT_EQ(paint_count, 1u);
+  ASSERT_TRUE(view->layer != NULL && view->layer->valid);
+  ASSERT_EQ(system_info()->lcd_w, lcd_w);
+
+  widget_layer_get_stats(&s);
+  ASSERT_EQ(s.nr, stats.nr + 1);
+  ASSERT_EQ(s.mem_size, stats.mem_size + 100 * 50 * 4);
+  ASSERT_EQ(s.misses, stats.misses + 1);
+
+  /*内容没有变化时直接绘制图层。*/
+  ASSERT_EQ(paint(view), "dg(0,0,100,50,10,20,100,50);");
+  ASSERT_EQ(paint_count, 1u);
+  widget_layer_get_stats(&s);
+  ASSERT_EQ(s.hits, stats.hits + 1);
+
+  /*子控件变化时重新生成图层。*/
+  widget_invalidate(b, NULL);
+  ASSERT_FALSE(view->layer->valid);
+  paint(view);
+  ASSERT_EQ(paint_count, 2u);
+  widget_layer_get_stats(&s);
+  ASSERT_EQ(s.misses, stats.misses + 2);
+
+  /*样式变化时重新生成图层。*/
+  widget_set_need_update_style(view);
+  ASSERT_FALSE(view->layer->valid);
+  paint(view);
+  ASSERT_EQ(paint_count, 3u);
+
+  /*大小变化时重新创建图层的位图。*/
+  widget_resize(view, 120, 50);
+  paint(view);
+  ASSERT_EQ(paint_count, 4u);
+  widget_layer_get_stats(&s);
+  ASSERT_EQ(s.nr, stats.nr + 1);
+  ASSERT_EQ(s.mem_size, stats.mem_size + 120 * 50 * 4);
+
+  ASSERT_EQ(widget_set_cache(view, FALSE), RET_OK);
+  ASSERT_TRUE(view->layer == NULL);
+  widget_layer_get_stats(&s);
+  ASSERT_EQ(s.nr, stats.nr);
+  ASSERT_EQ(s.mem_size, stats.mem_size);
+
+  paint(view);
+  paint(view);
+  ASSERT_EQ(paint_count, 6u);
+  ASSERT_EQ(system_info()->lcd_w, lcd_w);
+
+  widget_destroy(w);
+}
+
+TEST_F(WidgetLayerTest, evict) {
+  widget_layer_stats_t s;
+  uint32_t paint_count = 0;
+  widget_t* w = window_create(NULL, 0, 0, 400, 300);
+  widget_t* v1 = view_create(w, 0, 0, 100, 50);
+  widget_t* v2 = view_create(w, 0, 100, 100, 50);
+  widget_t* v3 = view_create(w, 0, 200, 400, 100);
+  widget_t* b = button_create(v3, 0, 0, 50, 20);
+
+  widget_on(b, EVT_BEFORE_PAINT, on_before_paint, &paint_count);
+  widget_set_cache(v1, TRUE);
+  widget_set_cache(v2, TRUE);
+  widget_set_cache(v3, TRUE);
+  widget_layer_set_max_mem_size(100 * 50 * 4 + 100);
+
+  paint(v1);
+  paint(v2);
+  widget_layer_get_stats(&s);
+  ASSERT_EQ(s.nr, 1u);
+  ASSERT_EQ(s.mem_size, 100u * 50 * 4);
+  ASSERT_EQ(s.evictions, stats.evictions + 1);
+  ASSERT_TRUE(v1->layer->canvas == NULL);
+  ASSERT_TRUE(v2->layer->canvas != NULL);
+
+  paint(v2);
+  widget_layer_get_stats(&s);
+  ASSERT_EQ(s.hits, stats.hits + 1);
+
+  /*超过内存上限的控件直接绘制。*/
+  ASSERT_EQ(paint(v3).find("dg(0,0,400,100"), string::npos);
+  paint(v3);
+  ASSERT_EQ(paint_count, 2u);
+  ASSERT_TRUE(v2->layer->canvas != NULL);
+
+  /*降低上限时淘汰已有的图层。*/
+  widget_layer_set_max_mem_size(0);
+  widget_layer_get_stats(&s);
+  ASSERT_EQ(s.nr, 0u);
+  ASSERT_EQ(s.mem_size, 0u);
+  ASSERT_EQ(s.evictions, stats.evictions + 2);
+
+  widget_destroy(w);
+}
+
+TEST_F(WidgetLayerTest, destroy) {
+  widget_layer_stats_t s;
+  widget_t* w = window_create(NULL, 0, 0, 400, 300);
+  widget_t* view = view_create(w, 0, 0, 100, 50);
+
+  widget_set_cache(view, TRUE);
+  paint(view);
+  widget_layer_get_stats(&s);
+  ASSERT_EQ(s.nr, stats.nr + 1);
+
+  widget_destroy(w);
+  idle_dispatch();
+  widget_layer_get_stats(&s);
+  ASSERT_EQ(s.nr, stats.nr);
+  ASSERT_EQ(s.mem_size, stats.mem_size);
+}
+
+TEST(WidgetLayer, no_native_window) {
+  canvas_t c;
+  rect_t r = rect_init(0, 0, 800, 600);
+  lcd_t* lcd = lcd_log_init(800, 600);
+  widget_t* w = window_create(NULL, 0, 0, 400, 300);
+  widget_t* view = view_create(w, 0, 0, 100, 50);
+  widget_t* b = button_create(view, 0, 0, 50, 20);
+  uint32_t paint_count = 0;
+
+  /*不能创建离线画布时直接绘制控件。*/
+  canvas_init(&c, lcd, font_manager());
+  widget_on(b, EVT_BEFORE_PAINT, on_before_paint, &paint_count);
+  widget_set_cache(view, TRUE);
+
+  canvas_begin_frame(&c, &r, LCD_DRAW_NORMAL);
+  widget_paint(view, &c);
+  widget_paint(view, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(paint_count, 2u);
+
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "tkc/mem.h"
+#include "base/idle.h"
+#include "base/widget_pool.h"
+#include "widgets/label.h"
+#include "widgets/button.h"
+
+static ret_t on_click(void* ctx, event_t* e) {
+  return RET_OK;
+}
+
+static void destroy_widgets(widget_t** widgets, uint32_t nr) {
+  uint32_t i = 0;
+
+  for (i = 0; i < nr; i++) {
+    widget_destroy(widgets[i]);
+  }
+  idle_dispatch();
+}
+
+TEST(WidgetPool, reuse) {
+  widget_pool_stats_t s0;
+  widget_pool_stats_t s;
+  widget_t* l = NULL;
+  widget_t* old = NULL;
+  uint32_t size = 0;
+
+  /*先销毁其它用例延迟销毁的控件，避免它们在清空后再进入池。*/
+  idle_dispatch();
+  widget_pool_clear();
+  widget_pool_get_stats(&s0);
+  ASSERT_EQ(s0.cached_nr, 0u);
+
+  old = label_create(NULL, 10, 20, 30, 40);
+  widget_set_text(old, L"OK");
+  widget_set_name(old, "name");
+  widget_on(old, EVT_CLICK, on_click, NULL);
+  ASSERT_TRUE(old->pooled);
+  size = old->vt->size;
+  destroy_widgets(&old, 1);
+
+  widget_pool_get_stats(&s);
+  ASSERT_EQ(s.cached_nr, 1u);
+  ASSERT_EQ(s.cached_size, size);
+
+  /*重用刚销毁的对象，内容和新创建的一样。*/
+  l = label_create(NULL, 1, 2, 3, 4);
+  ASSERT_EQ(l, old);
+  ASSERT_EQ(l->x, 1);
+  ASSERT_EQ(l->h, 4);
+  ASSERT_TRUE(l->name == NULL);
+  ASSERT_EQ(l->text.size, 0u);
+  ASSERT_TRUE(l->emitter == NULL);
+  ASSERT_EQ(l->ref_count, 1);
+  ASSERT_EQ(l->opacity, 0xff);
+
+  widget_pool_get_stats(&s);
+  ASSERT_EQ(s.cached_nr, 0u);
+  ASSERT_EQ(s.cached_size, 0u);
+  ASSERT_EQ(s.reuses, s0.reuses + 1);
+  ASSERT_EQ(s.allocs, s0.allocs + 2);
+
+  widget_on(l, EVT_CLICK, on_click, NULL);
+  widget_pool_get_stats(&s);
+  ASSERT_EQ(s.emitter_reuses, s0.emitter_reuses + 1);
+  destroy_widgets(&l, 1);
+}
+
+TEST(WidgetPool, per_vtable) {
+  uint32_t i = 0;
+  widget_pool_stats_t s0;
+  widget_pool_stats_t s;
+  widget_t* labels[TK_WIDGET_POOL_MAX_NR + 4];
+  widget_t* button = NULL;
+
+  idle_dispatch();
+  widget_pool_clear();
+  widget_pool_get_stats(&s0);
+
+  for (i = 0; i < ARRAY_SIZE(labels); i++) {
+    labels[i] = label_create(NULL, 0, 0, 10, 10);
+  }
+  destroy_widgets(labels, ARRAY_SIZE(labels));
+
+  /*每种控件最多缓存TK_WIDGET_POOL_MAX_NR个。*/
+  widget_pool_get_stats(&s);
+  ASSERT_EQ(s.cached_nr, (uint32_t)TK_WIDGET_POOL_MAX_NR);
+
+  /*不同种类的控件不共用空闲对象。*/
+  button = button_create(NULL, 0, 0, 10, 10);
+  widget_pool_get_stats(&s);
+  ASSERT_EQ(s.reuses, s0.reuses);
+  destroy_widgets(&button, 1);
+
+  for (i = 0; i < ARRAY_SIZE(labels); i++) {
+    labels[i] = label_create(NULL, 0, 0, 10, 10);
+  }
+  widget_pool_get_stats(&s);
+  ASSERT_EQ(s.reuses, s0.reuses + TK_WIDGET_POOL_MAX_NR);
+  ASSERT_EQ(s.cached_nr, 1u);
+  destroy_widgets(labels, ARRAY_SIZE(labels));
+
+  ASSERT_EQ(widget_pool_clear(), RET_OK);
+  widget_pool_get_stats(&s);
+  ASSERT_EQ(s.cached_nr, 0u);
+  ASSERT_EQ(s.cached_size, 0u);
+}
+
+static const widget_vtable_t s_custom_vtable = {};
+
+TEST(WidgetPool, not_pooled) {
+  widget_pool_stats_t s0;
+  widget_pool_stats_t s;
+  widget_t* widget = (widget_t*)TKMEM_ZALLOC(widget_t);
+
+  /*自己分配内存的控件不放入对象池。*/
+  idle_dispatch();
+  widget_pool_clear();
+  widget_pool_get_stats(&s0);
+  widget_init(widget, NULL, &s_custom_vtable, 0, 0, 10, 10);
+  ASSERT_FALSE(widget->pooled);
+  destroy_widgets(&widget, 1);
+
+  widget_pool_get_stats(&s);
+  ASSERT_EQ(s.cached_nr, 0u);
+  ASSERT_EQ(s.allocs, s0.allocs);
+}
@@ -0,0 +1,94 @@
+#include "widgets/view.h"
+#include "base/widget_prop_id.h"
+#include "gtest/gtest.h"
+#include <string>
+
+using std::string;
+
+TEST(WidgetPropId, basic) {
+  ASSERT_EQ(widget_prop_id_from_name(WIDGET_PROP_X), WIDGET_PROP_ID_X);
+  ASSERT_EQ(widget_prop_id_from_name(WIDGET_PROP_VALUE), WIDGET_PROP_ID_VALUE);
+  ASSERT_EQ(widget_prop_id_from_name(WIDGET_PROP_ANIMATION), WIDGET_PROP_ID_ANIMATION);
+  ASSERT_EQ(widget_prop_id_from_name("not_exist"), WIDGET_PROP_ID_NONE);
+  ASSERT_EQ(widget_prop_id_from_name(""), WIDGET_PROP_ID_NONE);
+  ASSERT_EQ(widget_prop_id_from_name(NULL), WIDGET_PROP_ID_NONE);
+
+  ASSERT_EQ(string(widget_prop_id_to_name(WIDGET_PROP_ID_Y)), string(WIDGET_PROP_Y));
+  ASSERT_TRUE(widget_prop_id_to_name(WIDGET_PROP_ID_NONE) == NULL);
+  ASSERT_TRUE(widget_prop_id_to_name(WIDGET_PROP_ID_NR) == NULL);
+}
+
+TEST(WidgetPropId, all) {
+  uint32_t i = 0;
+  const char* last = NULL;
+
+  for (i = WIDGET_PROP_ID_NONE + 1; i < WIDGET_PROP_ID_NR; i++) {
+    const char* name = widget_prop_id_to_name((widget_prop_id_t)i);
+
+    ASSERT_TRUE(name != NULL);
+    ASSERT_EQ(widget_prop_id_from_name(name), (widget_prop_id_t)i);
+    if (last != NULL) {
+      ASSERT_LT(strcmp(last, name), 0);
+    }
+    last = name;
+  }
+}
+
+TEST(WidgetPropId, set_get) {
+  value_t v;
+  widget_t* w = view_create(NULL, 0, 0, 100, 100);
+
+  ASSERT_EQ(widget_set_prop_by_id(w, WIDGET_PROP_ID_X, value_set_int(&v, 10)), RET_OK);
+  ASSERT_EQ(w->x, 10);
+  ASSERT_EQ(widget_get_prop_int(w, WIDGET_PROP_X, 0), 10);
+
+  ASSERT_EQ(widget_set_prop_int(w, WIDGET_PROP_W, 20), RET_OK);
+  ASSERT_EQ(widget_get_prop_by_id(w, WIDGET_PROP_ID_W, &v), RET_OK);
+  ASSERT_EQ(value_int(&v), 20);
+
+  ASSERT_EQ(widget_set_prop_by_id(w, WIDGET_PROP_ID_NAME, value_set_str(&v, "abc")), RET_OK);
+  ASSERT_EQ(string(w->name), string("abc"));
+  ASSERT_EQ(widget_get_prop_by_id(w, WIDGET_PROP_ID_NAME, &v), RET_OK);
+  ASSERT_EQ(string(value_str(&v)), string("abc"));
+
+  ASSERT_EQ(widget_set_prop_by_id(w, WIDGET_PROP_ID_TEXT, value_set_str(&v, "hello")), RET_OK);
+  ASSERT_EQ(widget_get_prop_by_id(w, WIDGET_PROP_ID_TEXT, &v), RET_OK);
+  ASSERT_EQ(wcscmp(value_wstr(&v), L"hello"), 0);
+
+  ASSERT_EQ(widget_get_prop_by_id(w, WIDGET_PROP_ID_LAYOUT_W, &v), RET_OK);
+  ASSERT_EQ(value_int(&v), 20);
+
+  /*非内置属性保存到custom_props中，ID和名称两种方式访问结果一致。*/
+  ASSERT_EQ(widget_set_prop_by_id(w, WIDGET_PROP_ID_STEP, value_set_int(&v, 3)), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(w, WIDGET_PROP_STEP, 0), 3);
+
+  ASSERT_EQ(widget_set_prop_by_id(w, WIDGET_PROP_ID_NONE, &v), RET_BAD_PARAMS);
+  ASSERT_EQ(widget_get_prop_by_id(w, WIDGET_PROP_ID_NR, &v), RET_BAD_PARAMS);
+
+  widget_destroy(w);
+}
+
+static ret_t on_prop_changed(void* ctx, event_t* e) {
+  int32_t* count = (int32_t*)ctx;
+  prop_change_event_t* evt = (prop_change_event_t*)e;
+
+  if (tk_str_eq(evt->name, WIDGET_PROP_OPACITY)) {
+    *count = *count + 1;
+  }
+
+  return RET_OK;
+}
+
+TEST(WidgetPropId, event) {
+  value_t v;
+  int32_t count = 0;
+  widget_t* w = view_create(NULL, 0, 0, 100, 100);
+
+  widget_on(w, EVT_PROP_CHANGED, on_prop_changed, &count);
+  ASSERT_EQ(widget_set_prop_by_id(w, WIDGET_PROP_ID_OPACITY, value_set_int(&v, 128)), RET_OK);
+  ASSERT_EQ(widget_set_prop_int(w, WIDGET_PROP_OPACITY, 100), RET_OK);
+  ASSERT_EQ(count, 2);
+  ASSERT_EQ(w->opacity, 100);
+
+  widget_destroy(w);
+}
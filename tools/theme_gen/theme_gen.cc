@@ -26,6 +26,7 @@
 #include "tkc/buffer.h"
 #include "tkc/types_def.h"
 #include "tkc/mem.h"
+#include <algorithm>
 
 Style::Style() {
 }
@@ -81,19 +82,77 @@ bool Style::Merge(Style& other) {
   return true;
 }
 
+class StyleNameCompare {
+ public:
+  StyleNameCompare(const uint8_t* data) {
+    this->data = data;
+  }
+
+  bool operator()(uint16_t a, uint16_t b) const {
+    const style_name_value_t* nva = (const style_name_value_t*)(this->data + a);
+    const style_name_value_t* nvb = (const style_name_value_t*)(this->data + b);
+
+    return strcmp(nva->name, nvb->name) < 0;
+  }
+
+ private:
+  const uint8_t* data;
+};
+
+static ret_t style_output_index(wbuffer_t* wbuffer, uint32_t start, uint32_t nr) {
+  uint32_t i = 0;
+  uint32_t end = wbuffer->cursor;
+  uint8_t* data = wbuffer->data + start;
+  uint32_t offset = sizeof(uint32_t) + nr * sizeof(uint16_t);
+  vector<uint16_t> offsets;
+
+  if (end - start > 0xffff) {
+    /*偏移量只有16位，数据太大时不生成索引*/
+    memmove(data + sizeof(uint32_t), data + offset, end - start - offset);
+    wbuffer->cursor = start;
+    wbuffer_write_uint32(wbuffer, nr);
+    wbuffer->cursor = end - nr * sizeof(uint16_t);
+
+    return RET_OK;
+  }
+
+  for (i = 0; i < nr; i++) {
+    const style_name_value_t* nv = (const style_name_value_t*)(data + offset);
+
+    offsets.push_back(offset);
+    offset += sizeof(style_name_value_header_t) + nv->name_size + nv->value_size;
+  }
+
+  std::stable_sort(offsets.begin(), offsets.end(), StyleNameCompare(data));
+
+  wbuffer->cursor = start + sizeof(uint32_t);
+  for (i = 0; i < nr; i++) {
+    wbuffer_write_uint16(wbuffer, offsets[i]);
+  }
+  wbuffer->cursor = end;
+
+  return RET_OK;
+}
+
 ret_t Style::Output(wbuffer_t* wbuffer) {
+  uint32_t i = 0;
   uint32_t size = 0;
+  uint32_t start = wbuffer->cursor;
 
   size = uint_values.Size() + int_values.Size() + str_values.Size();
   log_debug("  size=%d widget_type=%s name=%s state=%s\n", size, this->widget_type.c_str(),
             this->name.c_str(), this->state.c_str());
 
-  wbuffer_write_uint32(wbuffer, size);
+  wbuffer_write_uint32(wbuffer, size | STYLE_DATA_FLAG_INDEXED);
+  for (i = 0; i < size; i++) {
+    wbuffer_write_uint16(wbuffer, 0);
+  }
+
   int_values.WriteToWbuffer(wbuffer);
   uint_values.WriteToWbuffer(wbuffer);
   str_values.WriteToWbuffer(wbuffer);
 
-  return RET_OK;
+  return style_output_index(wbuffer, start, size);
 }
 
 bool ThemeGen::AddStyle(const Style& style) {
@@ -102,17 +161,47 @@ bool ThemeGen::AddStyle(const Style& style) {
   return true;
 }
 
+class ThemeItemCompare {
+ public:
+  ThemeItemCompare(const theme_item_t* items) {
+    this->items = items;
+  }
+
+  bool operator()(uint32_t a, uint32_t b) const {
+    const theme_item_t* ia = this->items + a;
+    const theme_item_t* ib = this->items + b;
+    int32_t result = strcmp(ia->widget_type, ib->widget_type);
+
+    if (result == 0) {
+      result = strcmp(ia->name, ib->name);
+      if (result == 0) {
+        result = strcmp(ia->state, ib->state);
+      }
+    }
+
+    return result < 0;
+  }
+
+ private:
+  const theme_item_t* items;
+};
+
 ret_t ThemeGen::Output(wbuffer_t* wbuffer) {
+  uint32_t i = 0;
   uint32_t nr = this->styles.size();
   return_value_if_fail(nr > 0, RET_FAIL);
-  uint32_t data_start = sizeof(theme_header_t) + nr * sizeof(theme_item_t);
+  uint32_t items_size = sizeof(theme_header_t) + nr * sizeof(theme_item_t);
+  uint32_t data_start = items_size + nr * sizeof(uint32_t);
   theme_header_t* header = (theme_header_t*)TKMEM_ALLOC(data_start);
   memset(header, 0, data_start);
-  theme_item_t* item = (theme_item_t*)((uint8_t*)header + sizeof(theme_header_t));
+  theme_item_t* items = (theme_item_t*)((uint8_t*)header + sizeof(theme_header_t));
+  theme_item_t* item = items;
+  uint8_t* indexes = (uint8_t*)header + items_size;
+  vector<uint32_t> sorted;
   wbuffer_write_binary(wbuffer, header, data_start);
 
   header->magic = THEME_MAGIC;
-  header->version = 0;
+  header->version = THEME_VERSION_INDEXED;
   header->nr = nr;
 
   for (vector<Style>::iterator iter = this->styles.begin(); iter != this->styles.end(); iter++) {
@@ -124,6 +213,14 @@ ret_t ThemeGen::Output(wbuffer_t* wbuffer) {
     item++;
   }
 
+  for (i = 0; i < nr; i++) {
+    sorted.push_back(i);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(), ThemeItemCompare(items));
+  for (i = 0; i < nr; i++) {
+    save_uint32(indexes, sorted[i]);
+  }
+
   int32_t size = wbuffer->cursor;
   wbuffer->cursor = 0;
   wbuffer_write_binary(wbuffer, header, data_start);
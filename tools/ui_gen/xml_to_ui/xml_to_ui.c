@@ -24,6 +24,10 @@
 #include "tkc/mem.h"
 #include "common/utils.h"
 #include "base/assets_manager.h"
+#include "base/self_layouter_factory.h"
+#include "base/children_layouter_factory.h"
+#include "layouters/self_layouter_builtins.h"
+#include "layouters/children_layouter_builtins.h"
 #include "ui_loader/ui_binary_writer.h"
 #include "ui_loader/ui_loader_xml.h"
 
@@ -38,7 +42,7 @@ static ret_t gen_one(const char* in_filename, const char* out_filename, bool_t o
     ui_binary_writer_t ui_binary_writer;
     ui_loader_t* loader = xml_ui_loader();
     ui_builder_t* builder =
-        ui_binary_writer_init(&ui_binary_writer, wbuffer_init_extendable(&wbuffer));
+        ui_binary_writer_init_ex(&ui_binary_writer, wbuffer_init_extendable(&wbuffer), 2);
     str_init(&s, 0);
     do {
       ret = RET_FAIL;
@@ -149,6 +153,12 @@ int wmain(int argc, wchar_t* argv[]) {
     return 0;
   }
 
+  /*生成的二进制数据中预先解析好布局参数，需要注册布局器。*/
+  self_layouter_factory_set(self_layouter_factory_create());
+  children_layouter_factory_set(children_layouter_factory_create());
+  self_layouter_register_builtins();
+  children_layouter_register_builtins();
+
   str_t in_file;
   str_t out_file;
   str_t _res_name;
@@ -197,6 +207,11 @@ int wmain(int argc, wchar_t* argv[]) {
   str_reset(&_res_name);
   str_reset(&str_theme);
 
+  self_layouter_factory_destroy(self_layouter_factory());
+  self_layouter_factory_set(NULL);
+  children_layouter_factory_destroy(children_layouter_factory());
+  children_layouter_factory_set(NULL);
+
   return 0;
 }
 